@@ -15,7 +15,10 @@
 
 
 #include  <unistd.h>
+#include  <thread>
+#include  <atomic>
 #include  "vlsisapd/utilities/Path.h"
+#include  "vlsisapd/configuration/Configuration.h"
 #include  "hurricane/Warning.h"
 #include  "hurricane/Technology.h"
 #include  "hurricane/DataBase.h"
@@ -325,6 +328,89 @@ namespace CRL {
   }
 
 
+  size_t  AllianceFramework::prefetchCells ( const vector<string>& names, unsigned int mode )
+  {
+  // Read in memory, concurrently, the files of the cells that are about
+  // to be loaded. Only the file reading is done in parallel, the parsers
+  // themselves are still called serially by getCell() (the database is
+  // not thread-safe), they get the file contents through IoFile.
+
+    struct PrefetchJob {
+      vector<string>  _files;
+      string          _path;
+      string          _contents;
+    };
+
+    unsigned int threads = Cfg::getParamInt("misc.prefetchThreads",0)->asInt();
+    if (not threads) threads = std::thread::hardware_concurrency();
+    if (threads < 2) return 0;
+
+    SearchPath&    LIBRARIES = _environment.getLIBRARIES();
+    vector<string> directories;
+    for ( size_t i=0 ; i<LIBRARIES.getSize() ; ++i )
+      directories.push_back( LIBRARIES[i].getPath() );
+
+  // Build the list of candidate files on the main thread, in the same
+  // order as _readLocate() (extensions first, then search path).
+    vector<PrefetchJob> jobs;
+    for ( size_t iname=0 ; iname<names.size() ; ++iname ) {
+      Catalog::State* state = _catalog.getState( names[iname] );
+      if (state and state->isInMemory()) continue;
+
+      for ( int i=0 ; i<2 ; i++ ) {
+        unsigned int loadMode = (i) ? (mode & Catalog::State::Physical)
+                                    : (mode & Catalog::State::Logical );
+        if (not loadMode) continue;
+        if (state and state->getFlags(loadMode)) continue;
+
+        ParserFormatSlot& format = _parsers.getParserSlot( names[iname], loadMode, _environment );
+
+        jobs.push_back( PrefetchJob() );
+        for ( format.cbegin() ; !format.cend() ; format++ )
+          jobs.back()._files.push_back( names[iname] + "." + getString(format.getExt()) );
+      }
+    }
+    if (jobs.size() < 2) return 0;
+    if (threads > jobs.size()) threads = jobs.size();
+
+    std::atomic<size_t> next ( 0 );
+    auto worker = [&] () {
+      char buffer [65536];
+
+      for ( size_t ijob=next++ ; ijob<jobs.size() ; ijob=next++ ) {
+        PrefetchJob& job = jobs[ijob];
+
+        for ( size_t ifile=0 ; job._path.empty() and (ifile<job._files.size()) ; ++ifile ) {
+          for ( size_t idir=0 ; idir<directories.size() ; ++idir ) {
+            string path = directories[idir] + "/" + job._files[ifile];
+            FILE*  fd   = fopen( path.c_str(), "r" );
+            if (not fd) continue;
+
+            size_t bytes;
+            while ( (bytes = fread(buffer,1,sizeof(buffer),fd)) ) job._contents.append( buffer, bytes );
+            if (not ferror(fd)) job._path = path;
+            else                job._contents.clear();
+            fclose( fd );
+            break;
+          }
+        }
+      }
+    };
+
+    vector<std::thread> workers;
+    for ( unsigned int i=0 ; i<threads ; ++i ) workers.push_back( std::thread(worker) );
+    for ( size_t       i=0 ; i<workers.size() ; ++i ) workers[i].join();
+
+    size_t prefetcheds = 0;
+    for ( size_t ijob=0 ; ijob<jobs.size() ; ++ijob ) {
+      if (jobs[ijob]._path.empty()) continue;
+      if (IoFile::addPrefetched(jobs[ijob]._path,jobs[ijob]._contents)) ++prefetcheds;
+    }
+
+    return prefetcheds;
+  }
+
+
   AllianceLibrary* AllianceFramework::createLibrary ( const string& path, unsigned int& flags, string libName )
   {
     if ( libName.empty() ) libName = SearchPath::extractLibName(path);
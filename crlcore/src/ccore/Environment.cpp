@@ -674,6 +674,7 @@ namespace CRL {
     else if (  ( _IN_LO == "def"   ) && ( _IN_PH == "def") ) coherency = true;
     else if (  ( _IN_LO == "aux"   ) && ( _IN_PH == "aux") ) coherency = true;
     else if (  ( _IN_LO == "oa"    ) && ( _IN_PH == "oa" ) ) coherency = true;
+    else if (  ( _IN_LO == "hdb"   ) && ( _IN_PH == "hdb") ) coherency = true;
     if ( !coherency )
       throw Error ( badEnvironment, "Input", _IN_LO.c_str(), _IN_PH.c_str() );
 
@@ -684,6 +685,7 @@ namespace CRL {
     else if (  ( _OUT_LO == "def" ) && ( _OUT_PH == "def") ) coherency = true;
     else if (  ( _OUT_LO == "aux" ) && ( _OUT_PH == "aux") ) coherency = true;
     else if (  ( _OUT_LO == "oa"  ) && ( _OUT_PH == "oa" ) ) coherency = true;
+    else if (  ( _OUT_LO == "hdb" ) && ( _OUT_PH == "hdb") ) coherency = true;
     if ( !coherency )
       throw Error ( badEnvironment, "Output", _OUT_LO.c_str(), _OUT_PH.c_str() );
   }
@@ -22,6 +22,7 @@
 #include "Ap.h"
 #include "Vst.h"
 #include "Spice.h"
+#include "Hdb.h"
 #include "openaccess/OpenAccess.h"
 
 
@@ -173,6 +174,7 @@ namespace CRL {
     registerSlot ( "vst"  , (CellParser_t*)vstParser      , "vhdl" );
     registerSlot ( "spi"  , (CellParser_t*)spiceParser    , "spi"  );
     registerSlot ( "oa"   , (CellParser_t*)OpenAccess::oaCellParser  , "oa" );
+    registerSlot ( "hdb"  , (CellParser_t*)hdbParser      , "hdb"  );
   //registerSlot ( "oa"   , (LibraryParser_t*)OpenAccess::oaLibParser, "oa" );
   }
 
@@ -284,6 +286,7 @@ namespace CRL {
     registerSlot ( "vst", (CellDriver_t*)vstDriver      , "vst"      );
   //registerSlot ( "def", (CellDriver_t*)defDriver      , "def"      );
     registerSlot ( "spi", (CellDriver_t*)spiceDriver    , "spi"      );
+    registerSlot ( "hdb", (CellDriver_t*)hdbDriver      , "hdb"      );
   //registerSlot ( "oa" , (CellDriver_t*)OpenAccess::oaDriver, "oa");
   }
 
@@ -19,6 +19,7 @@
 #include  <cstdlib>
 #include  <cstring>
 #include  <iomanip>
+#include  <sys/stat.h>
 
 #include  <boost/program_options.hpp>
 namespace boptions = boost::program_options;
@@ -490,16 +491,76 @@ namespace CRL {
 // Class  :  "CRL::IoFile".
 
 
+  std::map<string,string>  IoFile::_prefetcheds;
+
+
+  bool  IoFile::addPrefetched ( const string& path, string& contents )
+  {
+    if (_prefetcheds.find(path) != _prefetcheds.end()) return false;
+    _prefetcheds[path].swap( contents );
+    return true;
+  }
+
+
+  void  IoFile::clearPrefetcheds ()
+  { _prefetcheds.clear(); }
+
+
+  bool  IoFile::readContents ( const string& path, string& contents )
+  {
+    contents.clear();
+
+    std::map<string,string>::iterator ifile = _prefetcheds.find( path );
+    if (ifile != _prefetcheds.end()) {
+      contents.swap( ifile->second );
+      _prefetcheds.erase( ifile );
+      return true;
+    }
+
+    FILE* fd = fopen( path.c_str(), "r" );
+    if (not fd) return false;
+
+    struct stat infos;
+    if (not fstat(fileno(fd),&infos)) contents.reserve( infos.st_size );
+
+    char   buffer [65536];
+    size_t bytes;
+    while ( (bytes = fread(buffer,1,sizeof(buffer),fd)) ) contents.append( buffer, bytes );
+
+    bool success = not ferror( fd );
+    fclose( fd );
+
+    if (not success) contents.clear();
+    return success;
+  }
+
+
   bool  IoFile::open ( const string& mode )
   {
     if ( isOpen() )
       throw Error ( "IoFile::Open():\n  Attempt to reopen file %s\n", _path.c_str() );
 
     _mode       = mode;
-    _file       = fopen ( _path.c_str(), mode.c_str() );
+    _file       = NULL;
     _lineNumber = 0;
     _eof        = false;
 
+    if ( mode == "r" ) {
+      std::map<string,string>::iterator ifile = _prefetcheds.find( _path );
+      if ( ifile != _prefetcheds.end() ) {
+        _buffer.swap( ifile->second );
+        _prefetcheds.erase( ifile );
+      // fmemopen() do not accept an empty buffer.
+        if ( not _buffer.empty() )
+          _file = fmemopen ( &_buffer[0], _buffer.size(), "r" );
+      }
+    }
+
+    if ( not _file ) {
+      _buffer.clear();
+      _file = fopen ( _path.c_str(), mode.c_str() );
+    }
+
     return _file;
   }
 
@@ -507,6 +568,7 @@ namespace CRL {
   void  IoFile::close ()
   {
     if ( isOpen() ) fclose ( _file );
+    _buffer.clear();
     _file       = NULL;
     _lineNumber = 0;
     _eof        = false;
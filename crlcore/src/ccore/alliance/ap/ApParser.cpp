@@ -38,22 +38,64 @@
 namespace {
 
 
-# define    LINE_SIZE    4096
-
-
   using namespace Hurricane;
   using namespace CRL;
 
 
+// -------------------------------------------------------------------
+// Class  :  "ApToken".
+//
+// A field of an AP line. Points directly into the file buffer, so it
+// is *not* NUL terminated.
+
+  class ApToken {
+    public:
+      inline explicit     ApToken    ( const char* begin=NULL, const char* end=NULL );
+      inline bool         empty      () const;
+      inline size_t       size       () const;
+      inline const char*  begin      () const;
+      inline const char*  end        () const;
+      inline bool         operator== ( const char*    ) const;
+      inline bool         operator!= ( const char*    ) const;
+      inline bool         operator== ( const ApToken& ) const;
+      inline string       str        () const;
+    private:
+      const char* _begin;
+      const char* _end;
+  };
+
+
+  inline              ApToken::ApToken    ( const char* begin, const char* end ) : _begin(begin), _end(end) { }
+  inline bool         ApToken::empty      () const { return _begin == _end; }
+  inline size_t       ApToken::size       () const { return _end - _begin; }
+  inline const char*  ApToken::begin      () const { return _begin; }
+  inline const char*  ApToken::end        () const { return _end; }
+  inline bool         ApToken::operator!= ( const char* s ) const { return not (*this == s); }
+  inline string       ApToken::str        () const { return string( _begin, _end ); }
+
+
+  inline bool  ApToken::operator== ( const char* s ) const
+  {
+    size_t length = strlen( s );
+    return (length == size()) and not memcmp( _begin, s, length );
+  }
+
+
+  inline bool  ApToken::operator== ( const ApToken& other ) const
+  { return (other.size() == size()) and not memcmp( _begin, other._begin, size() ); }
+
+
   class LayerInformation {
     public:
+            string _apName;
             Name   _layerName;
             bool   _isConnector;
             bool   _isBlockage;
       const Layer* _layer;
     public:
                    LayerInformation ();
-                   LayerInformation ( const Name&  layerName
+                   LayerInformation ( const string& apName
+                                    , const Name&  layerName
                                     , const bool   isConnector
                                     , const bool   isBlockage
                                     , const Layer* layer
@@ -65,18 +107,21 @@ namespace {
   };
 
 
-  LayerInformation::LayerInformation () : _layerName()
+  LayerInformation::LayerInformation () : _apName()
+                                        , _layerName()
                                         , _isConnector(false)
                                         , _isBlockage(false)
                                         , _layer(NULL)
   { }
 
 
-  LayerInformation::LayerInformation ( const Name&  layerName
+  LayerInformation::LayerInformation ( const string& apName
+                                     , const Name&  layerName
                                      , const bool   isConnector
                                      , const bool   isBlockage
                                      , const Layer* layer
-                                     ) : _layerName(layerName)
+                                     ) : _apName(apName)
+                                       , _layerName(layerName)
                                        , _isConnector(isConnector)
                                        , _isBlockage(isBlockage)
                                        , _layer(layer)
@@ -99,36 +144,123 @@ namespace {
   { return _layer; }
 
 
-  class LayerInformations : public map<const Name,LayerInformation> {
+// -------------------------------------------------------------------
+// Class  :  "LayerInformations".
+//
+// Read-only once built. Layers are searched directly with the AP token
+// (the table is small), without building a Name for each line.
+
+  class LayerInformations : public vector<LayerInformation> {
     public:
-      void        setTechnology  ( Technology* technology );
-      void        add            ( const Name& apLayer
-                                 , const Name& hLayer
-                                 , bool        isConnectorapLayer
-                                 , bool        isBlockage
-                                 );
+      static const LayerInformations& get  ();
+             const LayerInformation*  find ( const ApToken& apLayer ) const;
+    private:
+                                      LayerInformations ( Technology* technology );
+             void                     add               ( const string& apLayer
+                                                        , const Name&   hLayer
+                                                        , bool          isConnector
+                                                        , bool          isBlockage
+                                                        );
     private:
       Technology* _technology;
   };
 
 
-  void  LayerInformations::setTechnology ( Technology* technology )
-  { _technology = technology; }
+  const LayerInformations& LayerInformations::get ()
+  {
+    static const LayerInformations  layerInformations ( DataBase::getDB()->getTechnology() );
+    return layerInformations;
+  }
+
+
+  const LayerInformation* LayerInformations::find ( const ApToken& apLayer ) const
+  {
+    for ( size_t i=0 ; i<size() ; ++i ) {
+      if (apLayer == (*this)[i]._apName.c_str()) return &(*this)[i];
+    }
+    return NULL;
+  }
 
 
-  void  LayerInformations::add ( const Name& apLayer
-                               , const Name& hLayer
-                               , bool        isConnector
-                               , bool        isBlockage
+  void  LayerInformations::add ( const string& apLayer
+                               , const Name&   hLayer
+                               , bool          isConnector
+                               , bool          isBlockage
                                )
   {
-    insert ( make_pair( apLayer
-                      , LayerInformation(hLayer
-                                        ,isConnector
-                                        ,isBlockage
-                                        ,_technology->getLayer(hLayer))
-                      )
-           );
+    push_back ( LayerInformation(apLayer
+                                ,hLayer
+                                ,isConnector
+                                ,isBlockage
+                                ,_technology->getLayer(hLayer))
+              );
+  }
+
+
+  LayerInformations::LayerInformations ( Technology* technology )
+    : vector<LayerInformation>()
+    , _technology(technology)
+  {
+    add ( "NWELL"      , "NWELL"      , false, false );
+    add ( "PWELL"      , "PWELL"      , false, false );
+    add ( "NTIE"       , "NTIE"       , false, false );
+    add ( "PTIE"       , "PTIE"       , false, false );
+    add ( "NDIF"       , "NDIF"       , false, false );
+    add ( "PDIF"       , "PDIF"       , false, false );
+    add ( "NTRANS"     , "NTRANS"     , false, false );
+    add ( "PTRANS"     , "PTRANS"     , false, false );
+    add ( "POLY"       , "POLY"       , false, false );
+    add ( "POLY2"      , "POLY2"      , false, false );
+
+    add ( "ALU1"       , "METAL1"     , false, false );
+    add ( "ALU2"       , "METAL2"     , false, false );
+    add ( "ALU3"       , "METAL3"     , false, false );
+    add ( "ALU4"       , "METAL4"     , false, false );
+    add ( "ALU5"       , "METAL5"     , false, false );
+    add ( "ALU6"       , "METAL6"     , false, false );
+    add ( "ALU7"       , "METAL7"     , false, false );
+    add ( "ALU8"       , "METAL8"     , false, false );
+
+    add ( "CALU1"      , "METAL1"     ,  true, false );
+    add ( "CALU2"      , "METAL2"     ,  true, false );
+    add ( "CALU3"      , "METAL3"     ,  true, false );
+    add ( "CALU4"      , "METAL4"     ,  true, false );
+    add ( "CALU5"      , "METAL5"     ,  true, false );
+    add ( "CALU6"      , "METAL6"     ,  true, false );
+    add ( "CALU7"      , "METAL7"     ,  true, false );
+    add ( "CALU8"      , "METAL8"     ,  true, false );
+
+    add ( "TALU1"      , "BLOCKAGE1"  , false,  true );
+    add ( "TALU2"      , "BLOCKAGE2"  , false,  true );
+    add ( "TALU3"      , "BLOCKAGE3"  , false,  true );
+    add ( "TALU4"      , "BLOCKAGE4"  , false,  true );
+    add ( "TALU5"      , "BLOCKAGE5"  , false,  true );
+    add ( "TALU6"      , "BLOCKAGE6"  , false,  true );
+    add ( "TALU7"      , "BLOCKAGE7"  , false,  true );
+    add ( "TALU8"      , "BLOCKAGE8"  , false,  true );
+
+    add ( "CONT_BODY_N", "CONT_BODY_N", false, false );
+    add ( "CONT_BODY_P", "CONT_BODY_P", false, false );
+    add ( "CONT_DIF_N" , "CONT_DIF_N" , false, false );
+    add ( "CONT_DIF_P" , "CONT_DIF_P" , false, false );
+    add ( "CONT_POLY"  , "CONT_POLY"  , false, false );
+    add ( "CONT_POLY2" , "CONT_POLY2" , false, false );
+    add ( "CONT_VIA"   , "VIA12"      , false, false );
+    add ( "CONT_VIA1"  , "VIA12"      , false, false );
+    add ( "CONT_VIA2"  , "VIA23"      , false, false );
+    add ( "CONT_VIA3"  , "VIA34"      , false, false );
+    add ( "CONT_VIA4"  , "VIA45"      , false, false );
+    add ( "CONT_VIA5"  , "VIA56"      , false, false );
+    add ( "CONT_VIA6"  , "VIA67"      , false, false );
+    add ( "CONT_VIA7"  , "VIA78"      , false, false );
+    add ( "CONT_TURN1" , "METAL1"     , false, false );
+    add ( "CONT_TURN2" , "METAL2"     , false, false );
+    add ( "CONT_TURN3" , "METAL3"     , false, false );
+    add ( "CONT_TURN4" , "METAL4"     , false, false );
+    add ( "CONT_TURN5" , "METAL5"     , false, false );
+    add ( "CONT_TURN6" , "METAL6"     , false, false );
+    add ( "CONT_TURN7" , "METAL7"     , false, false );
+    add ( "CONT_TURN8" , "METAL8"     , false, false );
   }
 
 
@@ -153,27 +285,32 @@ namespace {
                             , DirectionLeft      =DirectionHorizontal|DirectionDecrease
                             , DirectionRight     =DirectionHorizontal|DirectionIncrease
                             };
-      static LayerInformations  _layerInformations;
-             AllianceFramework* _framework;
-             string             _cellPath;
-             Cell*              _cell;
-             Catalog::State*    _state;
-             double             _scaleRatio;
-             unsigned int       _anonymousId;
-             int                _parserState;
-             size_t             _lineNumber;
-             char               _rawLine[LINE_SIZE];
+             AllianceFramework*       _framework;
+       const LayerInformations&       _layerInformations;
+             string                   _cellPath;
+             Cell*                    _cell;
+             Catalog::State*          _state;
+             double                   _scaleRatio;
+             unsigned int             _anonymousId;
+             int                      _parserState;
+             size_t                   _lineNumber;
+             string                   _buffer;
+             ApToken                  _line;
+             vector<ApToken>          _fields;
+             ApToken                  _lastNetName;
+             Net*                     _lastNet;
 
     protected:
     // Internal: Methods.
-      static LayerInformation*  _getLayerInformation ( const Name& layerName );
-      inline DbU::Unit          _getUnit             ( long value );
-      inline DbU::Unit          _getUnit             ( const char* value );
-             vector<char*>      _splitString         ( char* s, char separator );
-             Net*               _getNet              ( const char* apName );
-             Net*               _getAnonymousNet     ();
-             Net*               _safeGetNet          ( const char* apName );
-             SegmentDirection   _getApSegDirection   ( const char* segDir );
+      inline const LayerInformation*  _getLayerInformation ( const ApToken& layerName );
+      inline DbU::Unit                _getUnit             ( long value );
+      inline DbU::Unit                _getUnit             ( const ApToken& value );
+             long                     _getLong             ( const ApToken& value, bool strict );
+             const vector<ApToken>&   _splitLine           ( char separator );
+             Net*                     _getNet              ( const ApToken& apName );
+             Net*                     _getAnonymousNet     ();
+             Net*                     _safeGetNet          ( const ApToken& apName );
+             SegmentDirection         _getApSegDirection   ( const ApToken& segDir );
              void               _parseVersion        ();
              void               _parseHeader         ();
              void               _parseAbutmentBox    ();
@@ -188,110 +325,43 @@ namespace {
   };
 
 
-  LayerInformations  ApParser::_layerInformations;
-
-
   ApParser::ApParser ( AllianceFramework* framework )
-    : _framework  (framework)
-    , _cellPath   ()
-    , _cell       (NULL)
-    , _state      (NULL)
-    , _scaleRatio (100.0)
-    , _anonymousId(0)
-    , _parserState(StateVersion)
-    , _lineNumber (0)
-  {
-    if ( _layerInformations.empty() ) {
-      _layerInformations.setTechnology ( DataBase::getDB()->getTechnology() );
-
-      _layerInformations.add ( "NWELL"      , "NWELL"      , false, false );
-      _layerInformations.add ( "PWELL"      , "PWELL"      , false, false );
-      _layerInformations.add ( "NTIE"       , "NTIE"       , false, false );
-      _layerInformations.add ( "PTIE"       , "PTIE"       , false, false );
-      _layerInformations.add ( "NDIF"       , "NDIF"       , false, false );
-      _layerInformations.add ( "PDIF"       , "PDIF"       , false, false );
-      _layerInformations.add ( "NTRANS"     , "NTRANS"     , false, false );
-      _layerInformations.add ( "PTRANS"     , "PTRANS"     , false, false );
-      _layerInformations.add ( "POLY"       , "POLY"       , false, false );
-      _layerInformations.add ( "POLY2"      , "POLY2"      , false, false );
-      
-      _layerInformations.add ( "ALU1"       , "METAL1"     , false, false );
-      _layerInformations.add ( "ALU2"       , "METAL2"     , false, false );
-      _layerInformations.add ( "ALU3"       , "METAL3"     , false, false );
-      _layerInformations.add ( "ALU4"       , "METAL4"     , false, false );
-      _layerInformations.add ( "ALU5"       , "METAL5"     , false, false );
-      _layerInformations.add ( "ALU6"       , "METAL6"     , false, false );
-      _layerInformations.add ( "ALU7"       , "METAL7"     , false, false );
-      _layerInformations.add ( "ALU8"       , "METAL8"     , false, false );
-
-      _layerInformations.add ( "CALU1"      , "METAL1"     ,  true, false );
-      _layerInformations.add ( "CALU2"      , "METAL2"     ,  true, false );
-      _layerInformations.add ( "CALU3"      , "METAL3"     ,  true, false );
-      _layerInformations.add ( "CALU4"      , "METAL4"     ,  true, false );
-      _layerInformations.add ( "CALU5"      , "METAL5"     ,  true, false );
-      _layerInformations.add ( "CALU6"      , "METAL6"     ,  true, false );
-      _layerInformations.add ( "CALU7"      , "METAL7"     ,  true, false );
-      _layerInformations.add ( "CALU8"      , "METAL8"     ,  true, false );
-
-      _layerInformations.add ( "TALU1"      , "BLOCKAGE1"  , false,  true );
-      _layerInformations.add ( "TALU2"      , "BLOCKAGE2"  , false,  true );
-      _layerInformations.add ( "TALU3"      , "BLOCKAGE3"  , false,  true );
-      _layerInformations.add ( "TALU4"      , "BLOCKAGE4"  , false,  true );
-      _layerInformations.add ( "TALU5"      , "BLOCKAGE5"  , false,  true );
-      _layerInformations.add ( "TALU6"      , "BLOCKAGE6"  , false,  true );
-      _layerInformations.add ( "TALU7"      , "BLOCKAGE7"  , false,  true );
-      _layerInformations.add ( "TALU8"      , "BLOCKAGE8"  , false,  true );
-
-      _layerInformations.add ( "CONT_BODY_N", "CONT_BODY_N", false, false );
-      _layerInformations.add ( "CONT_BODY_P", "CONT_BODY_P", false, false );
-      _layerInformations.add ( "CONT_DIF_N" , "CONT_DIF_N" , false, false );
-      _layerInformations.add ( "CONT_DIF_P" , "CONT_DIF_P" , false, false );
-      _layerInformations.add ( "CONT_POLY"  , "CONT_POLY"  , false, false );
-      _layerInformations.add ( "CONT_POLY2" , "CONT_POLY2" , false, false );
-      _layerInformations.add ( "CONT_VIA"   , "VIA12"      , false, false );
-      _layerInformations.add ( "CONT_VIA1"  , "VIA12"      , false, false );
-      _layerInformations.add ( "CONT_VIA2"  , "VIA23"      , false, false );
-      _layerInformations.add ( "CONT_VIA3"  , "VIA34"      , false, false );
-      _layerInformations.add ( "CONT_VIA4"  , "VIA45"      , false, false );
-      _layerInformations.add ( "CONT_VIA5"  , "VIA56"      , false, false );
-      _layerInformations.add ( "CONT_VIA6"  , "VIA67"      , false, false );
-      _layerInformations.add ( "CONT_VIA7"  , "VIA78"      , false, false );
-      _layerInformations.add ( "CONT_TURN1" , "METAL1"     , false, false );
-      _layerInformations.add ( "CONT_TURN2" , "METAL2"     , false, false );
-      _layerInformations.add ( "CONT_TURN3" , "METAL3"     , false, false );
-      _layerInformations.add ( "CONT_TURN4" , "METAL4"     , false, false );
-      _layerInformations.add ( "CONT_TURN5" , "METAL5"     , false, false );
-      _layerInformations.add ( "CONT_TURN6" , "METAL6"     , false, false );
-      _layerInformations.add ( "CONT_TURN7" , "METAL7"     , false, false );
-      _layerInformations.add ( "CONT_TURN8" , "METAL8"     , false, false );
-    }
-  }
+    : _framework        (framework)
+    , _layerInformations(LayerInformations::get())
+    , _cellPath         ()
+    , _cell             (NULL)
+    , _state            (NULL)
+    , _scaleRatio       (100.0)
+    , _anonymousId      (0)
+    , _parserState      (StateVersion)
+    , _lineNumber       (0)
+    , _buffer           ()
+    , _line             ()
+    , _fields           ()
+    , _lastNetName      ()
+    , _lastNet          (NULL)
+  { }
 
 
-  LayerInformation* ApParser::_getLayerInformation ( const Name& layerName )
-  {
-    map<const Name, LayerInformation>::iterator  it = _layerInformations.find ( layerName );
-    if ( it != _layerInformations.end() )
-      return &(it->second);
-
-    return NULL;
-  }
+  inline const LayerInformation* ApParser::_getLayerInformation ( const ApToken& layerName )
+  { return _layerInformations.find( layerName ); }
 
 
-  vector<char*>  ApParser::_splitString ( char* s, char separator )
+  const vector<ApToken>&  ApParser::_splitLine ( char separator )
   {
-    vector<char*>  fields;
-
-    fields.push_back ( s );
-    while ( *s != '\0' ) {
-      if ( *s == separator ) {
-        fields.push_back ( s+1 );
-        *s = '\0';
+  // Fields start after the record type and it's separator ("S ").
+    const char* field = std::min( _line.begin()+2, _line.end() );
+
+    _fields.clear();
+    for ( const char* s=field ; s<_line.end() ; ++s ) {
+      if (*s == separator) {
+        _fields.push_back( ApToken(field,s) );
+        field = s+1;
       }
-      s++;
     }
+    _fields.push_back( ApToken(field,_line.end()) );
 
-    return fields;
+    return _fields;
   }
 
 
@@ -301,38 +371,53 @@ namespace {
   }
 
 
-  inline DbU::Unit  ApParser::_getUnit ( const char* value )
+  long  ApParser::_getLong ( const ApToken& value, bool strict )
   {
-    char* end;
-    long  convert = strtol ( value, &end, 10 );
+    const char* s        = value.begin();
+    bool        negative = false;
+    long        convert  = 0;
+
+    while ( (s < value.end()) and isspace(*s) ) ++s;
+    if ( (s < value.end()) and ((*s == '-') or (*s == '+')) ) negative = (*s++ == '-');
+    while ( (s < value.end()) and isdigit(*s) ) convert = convert*10 + (*s++ - '0');
+    if (negative) convert = -convert;
 
-    if ( *end != '\0' )
+    if (strict and (s != value.end()))
       _printError ( false
                   , "Incomplete string to integer conversion for \"%s\" (%ld)."
-                  , value
+                  , value.str().c_str()
                   , convert
                   );
 
-    return _getUnit ( convert );
+    return convert;
   }
 
 
-  inline ApParser::SegmentDirection  ApParser::_getApSegDirection ( const char* value )
+  inline DbU::Unit  ApParser::_getUnit ( const ApToken& value )
   {
-    if ( *value == '\0' ) return DirectionUndefined;
+    return _getUnit ( _getLong(value,true) );
+  }
 
-    if ( string("UP"   ).compare(value) == 0 ) return DirectionUp;
-    if ( string("DOWN" ).compare(value) == 0 ) return DirectionDown;
-    if ( string("LEFT" ).compare(value) == 0 ) return DirectionLeft;
-    if ( string("RIGHT").compare(value) == 0 ) return DirectionRight;
+
+  inline ApParser::SegmentDirection  ApParser::_getApSegDirection ( const ApToken& value )
+  {
+    if ( value.empty() ) return DirectionUndefined;
+
+    if ( value == "UP"    ) return DirectionUp;
+    if ( value == "DOWN"  ) return DirectionDown;
+    if ( value == "LEFT"  ) return DirectionLeft;
+    if ( value == "RIGHT" ) return DirectionRight;
 
     return DirectionUndefined;
   }
 
 
-  Net* ApParser::_getNet ( const char* apName )
+  Net* ApParser::_getNet ( const ApToken& apName )
   {
-    string hName = apName;
+  // Components of a net are usually grouped, remember the last one.
+    if ( _lastNet and (apName == _lastNetName) ) return _lastNet;
+
+    string hName = apName.str();
 
     size_t  separator = hName.find ( ' ' );
     if ( separator != string::npos ) {
@@ -357,6 +442,9 @@ namespace {
       }
     }
 
+    _lastNetName = apName;
+    _lastNet     = net;
+
     return net;
   }
 
@@ -372,9 +460,9 @@ namespace {
   }
 
 
-  Net* ApParser::_safeGetNet ( const char* apName )
+  Net* ApParser::_safeGetNet ( const ApToken& apName )
   {
-    if ( ( apName[0] == '\0' ) || !strcmp(apName,"*") )
+    if ( apName.empty() or (apName == "*") )
       return _getAnonymousNet ();
 
     return _getNet ( apName );
@@ -383,10 +471,10 @@ namespace {
 
   void  ApParser::_parseVersion ()
   {
-    if ( strncmp(_rawLine,"V ALLIANCE : ",13) )
+    if ( (_line.size() < 13) or strncmp(_line.begin(),"V ALLIANCE : ",13) )
       _printError ( true, "Missing Alliance Version Header." );
 
-    int version = atoi ( _rawLine+13 );
+    int version = _getLong ( ApToken(_line.begin()+13,_line.end()), false );
     if ( version < 3 )
       _printError ( true, "AP version prior to 3 are not supporteds (version: %d).", version );
   }
@@ -394,15 +482,15 @@ namespace {
 
   void  ApParser::_parseHeader ()
   {
-    if ( _rawLine[0] != 'H' ) _printError ( true, "Missing Cell Header." );
+    if ( _line.begin()[0] != 'H' ) _printError ( true, "Missing Cell Header." );
           
-    vector<char*>  fields = _splitString ( _rawLine+2, ',' );
+    const vector<ApToken>& fields = _splitLine ( ',' );
 
     if ( fields.size() < 4 )
       _printError ( true, "Malformed header line." );
 
-    Name  cellName    = fields[0];
-          _scaleRatio = 1 / strtod ( fields[3], NULL );
+    Name  cellName    = fields[0].str();
+          _scaleRatio = 1 / strtod ( fields[3].str().c_str(), NULL );
 
     if ( cellName != _cell->getName() )
       _printError ( true
@@ -421,7 +509,7 @@ namespace {
       DbU::Unit  XAB2 = 10;
       DbU::Unit  YAB2 = 10;
 
-      vector<char*>  fields = _splitString ( _rawLine+2, ',' );
+      const vector<ApToken>& fields = _splitLine ( ',' );
       if ( fields.size() < 4 )
         _printError ( false, "Malformed Abutment Box line." );
       else {
@@ -439,131 +527,106 @@ namespace {
 
   void  ApParser::_parseReference ()
   {
-    static DbU::Unit  XREF, YREF;
-
-    vector<char*>  fields = _splitString ( _rawLine+2, ',' );
+    const vector<ApToken>& fields = _splitLine ( ',' );
     if ( fields.size() < 4 )
       _printError ( false, "Malformed Reference line." );
     else {
-      XREF = _getUnit ( fields[0] );
-      YREF = _getUnit ( fields[1] );
+      DbU::Unit  XREF = _getUnit ( fields[0] );
+      DbU::Unit  YREF = _getUnit ( fields[1] );
 
-      if ( !strcmp(fields[2],"ref_ref") )
-        Reference::create ( _cell, fields[3], XREF, YREF  );
+      if ( fields[2] == "ref_ref" )
+        Reference::create ( _cell, fields[3].str(), XREF, YREF  );
     }
   }
 
 
   void  ApParser::_parseConnector ()
   {
-    static DbU::Unit             XCON, YCON, WIDTH;
-    static int                   index;
-           string                pinName;
-    static Net*                  net;
-  //static Pin*                  pin;
-    static LayerInformation*     layerInfo;
-    static Pin::AccessDirection  accessDirection;
-    static Name                  orientation;
-    static Name                  NORTH = "NORTH";
-    static Name                  SOUTH = "SOUTH";
-    static Name                  EAST  = "EAST";
-    static Name                  WEST  = "WEST";
-
-    vector<char*>  fields = _splitString( _rawLine+2, ',' );
+    const vector<ApToken>& fields = _splitLine( ',' );
     if (fields.size() < 7)
       _printError ( false, "Malformed Connector line." );
     else {
-      XCON        = _getUnit( fields[0] );
-      YCON        = _getUnit( fields[1] );
-      WIDTH       = _getUnit( fields[2] );
-      orientation = fields[5];
+      DbU::Unit  XCON  = _getUnit( fields[0] );
+      DbU::Unit  YCON  = _getUnit( fields[1] );
+      DbU::Unit  WIDTH = _getUnit( fields[2] );
 
-      index       = -1;
-      if (fields[4][0] != '\0') index = atoi( fields[4] );
+      int index = -1;
+      if (not fields[4].empty()) index = _getLong( fields[4], false );
 
-      size_t length = strlen( fields[3] );
-      if (length > 1000) {
+      if (fields[3].size() > 1000) {
         _printError ( false, "Connector name too long (exceed 1000 characters)." );
         return;
       }
 
-      pinName = fields[3];
-      size_t bindex = pinName.find(' ');
+      string pinName = fields[3].str();
+      size_t bindex  = pinName.find(' ');
       if (bindex != string::npos) {
         pinName[ bindex ] = '(';
         pinName += ')';
       }
       if (index >= 0) {
-        pinName += '.' + string(fields[4]);
+        pinName += '.' + fields[4].str();
       }
 
-      net       = _getNet             ( fields[3] );
-      layerInfo = _getLayerInformation( fields[6] );
+      Net*                    net       = _getNet             ( fields[3] );
+      const LayerInformation* layerInfo = _getLayerInformation( fields[6] );
 
-      if      (orientation == NORTH) accessDirection = Pin::AccessDirection::NORTH;
-      else if (orientation == SOUTH) accessDirection = Pin::AccessDirection::SOUTH;
-      else if (orientation == WEST ) accessDirection = Pin::AccessDirection::WEST;
-      else if (orientation == EAST ) accessDirection = Pin::AccessDirection::EAST;
-      else accessDirection = Pin::AccessDirection::UNDEFINED;
+      Pin::AccessDirection accessDirection = Pin::AccessDirection::UNDEFINED;
+      if      (fields[5] == "NORTH") accessDirection = Pin::AccessDirection::NORTH;
+      else if (fields[5] == "SOUTH") accessDirection = Pin::AccessDirection::SOUTH;
+      else if (fields[5] == "WEST" ) accessDirection = Pin::AccessDirection::WEST;
+      else if (fields[5] == "EAST" ) accessDirection = Pin::AccessDirection::EAST;
 
       if (layerInfo and net) {
         net->setExternal( true );
-        /*pin =*/ Pin::create( net
-                             , pinName
-                             , accessDirection
-                             , Pin::PlacementStatus::PLACED
-                             , layerInfo->getLayer()
-                             , XCON
-                             , YCON
-                             , WIDTH
-                             , WIDTH
-                             );
+        Pin::create( net
+                   , pinName
+                   , accessDirection
+                   , Pin::PlacementStatus::PLACED
+                   , layerInfo->getLayer()
+                   , XCON
+                   , YCON
+                   , WIDTH
+                   , WIDTH
+                   );
       }
-      if (not net )       _printError( false, "Unknown net name <%s>."  , fields[5] );
-      if (not layerInfo ) _printError( false, "Unknown layer name <%s>.", fields[6] );
+      if (not net )       _printError( false, "Unknown net name <%s>."  , fields[3].str().c_str() );
+      if (not layerInfo ) _printError( false, "Unknown layer name <%s>.", fields[6].str().c_str() );
     }
   }
 
 
   void  ApParser::_parseVia ()
   {
-    static DbU::Unit         XVIA, YVIA;
-    static Net*              net;
-    static LayerInformation* layerInfo;
-
-    vector<char*>  fields = _splitString ( _rawLine+2, ',' );
+    const vector<ApToken>& fields = _splitLine ( ',' );
     if ( fields.size() < 4 )
       _printError ( false, "Malformed VIA line." );
     else {
-      XVIA      = _getUnit ( fields[0] );
-      YVIA      = _getUnit ( fields[1] );
-      net       = _safeGetNet          ( fields[3] );
-      layerInfo = _getLayerInformation ( fields[2] );
+      DbU::Unit               XVIA      = _getUnit ( fields[0] );
+      DbU::Unit               YVIA      = _getUnit ( fields[1] );
+      Net*                    net       = _safeGetNet          ( fields[3] );
+      const LayerInformation* layerInfo = _getLayerInformation ( fields[2] );
 
       if ( layerInfo )
         Contact::create ( net, layerInfo->getLayer(), XVIA, YVIA );
       else
-        _printError ( false, "Unknown layer name <%s>.", fields[2] );
+        _printError ( false, "Unknown layer name <%s>.", fields[2].str().c_str() );
     }
   }
 
 
   void  ApParser::_parseBigVia ()
   {
-    static DbU::Unit              XVIA, YVIA, WIDTH, HEIGHT;
-    static Net*              net;
-    static LayerInformation* layerInfo;
-
-    vector<char*>  fields = _splitString ( _rawLine+2, ',' );
+    const vector<ApToken>& fields = _splitLine ( ',' );
     if ( fields.size() < 6 )
       _printError ( false, "Malformed big VIA line." );
     else {
-      XVIA      = _getUnit ( fields[0] );
-      YVIA      = _getUnit ( fields[1] );
-      WIDTH     = _getUnit ( fields[2] );
-      HEIGHT    = _getUnit ( fields[3] );
-      net       = _safeGetNet          ( fields[5] );
-      layerInfo = _getLayerInformation ( fields[4] );
+      DbU::Unit               XVIA      = _getUnit ( fields[0] );
+      DbU::Unit               YVIA      = _getUnit ( fields[1] );
+      DbU::Unit               WIDTH     = _getUnit ( fields[2] );
+      DbU::Unit               HEIGHT    = _getUnit ( fields[3] );
+      Net*                    net       = _safeGetNet          ( fields[5] );
+      const LayerInformation* layerInfo = _getLayerInformation ( fields[4] );
 
 
       if ( layerInfo ) {
@@ -573,30 +636,25 @@ namespace {
 
         Contact::create ( net, layerInfo->getLayer(), XVIA, YVIA, WIDTH-shrink, HEIGHT-shrink );
       } else
-        _printError ( false, "Unknown layer name <%s>.", fields[4] );
+        _printError ( false, "Unknown layer name <%s>.", fields[4].str().c_str() );
     }
   }
 
 
   void  ApParser::_parseSegment ()
   {
-    static DbU::Unit         X1, Y1, X2, Y2, WIDTH;
-    static Net*              net;
-    static LayerInformation* layerInfo;
-    static SegmentDirection  segDir;
-
-    vector<char*>  fields = _splitString ( _rawLine+2, ',' );
+    const vector<ApToken>& fields = _splitLine ( ',' );
     if ( fields.size() < 8 )
       _printError ( false, "Malformed Segment line." );
     else {
-      X1        = _getUnit    ( fields[0] );
-      Y1        = _getUnit    ( fields[1] );
-      X2        = _getUnit    ( fields[2] );
-      Y2        = _getUnit    ( fields[3] );
-      WIDTH     = _getUnit    ( fields[4] );
-      net       = _safeGetNet ( fields[5] );
-      segDir    = _getApSegDirection   ( fields[6] );
-      layerInfo = _getLayerInformation ( fields[7] );
+      DbU::Unit               X1        = _getUnit    ( fields[0] );
+      DbU::Unit               Y1        = _getUnit    ( fields[1] );
+      DbU::Unit               X2        = _getUnit    ( fields[2] );
+      DbU::Unit               Y2        = _getUnit    ( fields[3] );
+      DbU::Unit               WIDTH     = _getUnit    ( fields[4] );
+      Net*                    net       = _safeGetNet ( fields[5] );
+      SegmentDirection        segDir    = _getApSegDirection   ( fields[6] );
+      const LayerInformation* layerInfo = _getLayerInformation ( fields[7] );
 
       if ( layerInfo ) {
         Segment* segment = NULL;
@@ -628,49 +686,33 @@ namespace {
         }
       }
       else
-        _printError ( false, "Unknown layer name <%s>.", fields[7] );
+        _printError ( false, "Unknown layer name <%s>.", fields[7].str().c_str() );
     }
   }
 
 
   void  ApParser::_parseInstance ()
   {
-    static DbU::Unit  XINS, YINS;
-    static Name    masterCellName;
-    static Name    instanceName;
-    static Name    orientName;
-    static Transformation::Orientation
-                   orient         = Transformation::Orientation::ID;
-    static Name    NOSYM          = "NOSYM";
-    static Name    SYM_X          = "SYM_X";
-    static Name    SYM_Y          = "SYM_Y";
-    static Name    SYMXY          = "SYMXY";
-    static Name    ROT_P          = "ROT_P";
-    static Name    ROT_M          = "ROT_M";
-    static Name    SY_RM          = "SY_RM";
-    static Name    SY_RP          = "SY_RP";
-    static string  padreal        = "padreal";
-
-    vector<char*>  fields = _splitString ( _rawLine+2, ',' );
+    const vector<ApToken>& fields = _splitLine ( ',' );
     if ( fields.size() < 5 )
       _printError ( false, "Malformed instance line." );
     else {
-      XINS           = _getUnit ( fields[0] );
-      YINS           = _getUnit ( fields[1] );
-      masterCellName = fields[2];
-      instanceName   = fields[3];
-      orientName     = fields[4];
-
-      if      (orientName == "NOSYM") orient = Transformation::Orientation::ID;
-      else if (orientName == "ROT_P") orient = Transformation::Orientation::R1;
-      else if (orientName == "SYMXY") orient = Transformation::Orientation::R2;
-      else if (orientName == "ROT_M") orient = Transformation::Orientation::R3;
-      else if (orientName == "SYM_X") orient = Transformation::Orientation::MX;
-      else if (orientName == "SY_RM") orient = Transformation::Orientation::XR;
-      else if (orientName == "SYM_Y") orient = Transformation::Orientation::MY;
-      else if (orientName == "SY_RP") orient = Transformation::Orientation::YR;
+      DbU::Unit  XINS           = _getUnit ( fields[0] );
+      DbU::Unit  YINS           = _getUnit ( fields[1] );
+      Name       masterCellName = fields[2].str();
+      Name       instanceName   = fields[3].str();
+
+      Transformation::Orientation orient = Transformation::Orientation::ID;
+      if      (fields[4] == "NOSYM") orient = Transformation::Orientation::ID;
+      else if (fields[4] == "ROT_P") orient = Transformation::Orientation::R1;
+      else if (fields[4] == "SYMXY") orient = Transformation::Orientation::R2;
+      else if (fields[4] == "ROT_M") orient = Transformation::Orientation::R3;
+      else if (fields[4] == "SYM_X") orient = Transformation::Orientation::MX;
+      else if (fields[4] == "SY_RM") orient = Transformation::Orientation::XR;
+      else if (fields[4] == "SYM_Y") orient = Transformation::Orientation::MY;
+      else if (fields[4] == "SY_RP") orient = Transformation::Orientation::YR;
       else
-        _printError ( false, "Unknown orientation (%s).", getString(orientName).c_str() );
+        _printError ( false, "Unknown orientation (%s).", fields[4].str().c_str() );
 
       Instance* instance = _cell->getInstance ( instanceName );
       if ( instance ) {
@@ -683,7 +725,7 @@ namespace {
           );
         instance->setPlacementStatus ( Instance::PlacementStatus::FIXED );
       } else {
-        bool            ignoreInstance = (getString(masterCellName).substr(0,7) == padreal);
+        bool            ignoreInstance = (fields[2].size() >= 7) and not strncmp(fields[2].begin(),"padreal",7);
         Catalog::State* instanceState  = _framework->getCatalog()->getState ( masterCellName );
         if ( not ignoreInstance and ( not instanceState or (not instanceState->isFeed()) ) ) {
           _printError ( false
@@ -727,7 +769,7 @@ namespace {
 
   void  ApParser::_printWarning ( const char* format, ... )
   {
-    static char     formatted [ 8192 ];
+           char     formatted [ 8192 ];
            va_list  args;
 
     va_start ( args, format );
@@ -741,7 +783,7 @@ namespace {
 
   void  ApParser::_printError ( bool interrupt, const char* format, ... )
   {
-    static char     formatted [ 8192 ];
+           char     formatted [ 8192 ];
            va_list  args;
 
     va_start ( args, format );
@@ -774,8 +816,10 @@ namespace {
     if ( _state->isFlattenLeaf() ) _cell->setFlattenLeaf ( true );
     if ( _framework->isPad(_cell) ) _state->setPad ( true );
 
-    IoFile fileStream ( cellPath );
-    fileStream.open ( "r" );
+  // The whole file is read in one buffer, lines and fields are only
+  // pointers into it.
+    if ( not IoFile::readContents(cellPath,_buffer) )
+      throw Error ( "ApParser::loadFromFile(): Unable to read <%s>.", cellPath.c_str() );
 
     UpdateSession::open();
 
@@ -785,13 +829,21 @@ namespace {
     _lineNumber  = 0;
     _parserState = StateVersion;
     _scaleRatio  = 100.0;
+    _lastNet     = NULL;
+
+    const char* cursor    = _buffer.data();
+    const char* bufferEnd = _buffer.data() + _buffer.size();
 
     try {
-      while ( !fileStream.eof() ) {
-        fileStream.readLine ( _rawLine, LINE_SIZE );
+      while ( true ) {
+        const char* eol = (const char*)memchr ( cursor, '\n', bufferEnd-cursor );
+        if ( not eol ) eol = bufferEnd;
+
+        _line  = ApToken ( cursor, eol );
+        cursor = std::min ( eol+1, bufferEnd );
         _lineNumber++;
 
-        if ( _rawLine[0] == '\0' ) {
+        if ( _line.empty() ) {
           if ( _parserState == StateEOF ) break;
 
           _printError ( true, "Premature end of file." );
@@ -799,7 +851,7 @@ namespace {
           if ( _parserState == StateEOF )
             _printError ( true, "Garbage after EOF." );
         }
-        if ( !strcmp(_rawLine,"EOF") ) { _parserState = StateEOF; continue; }
+        if ( _line == "EOF" ) { _parserState = StateEOF; continue; }
 
         if ( _parserState == StateVersion ) {
           _parseVersion ();
@@ -814,7 +866,7 @@ namespace {
         }
 
         if ( _parserState == StateBody ) {
-          switch ( _rawLine[0] ) {
+          switch ( _line.begin()[0] ) {
             case 'A': _parseAbutmentBox (); break;
             case 'R': _parseReference   (); break;
             case 'V': _parseVia         (); break;
@@ -840,7 +892,7 @@ namespace {
     if (materializationState) Go::disableAutoMaterialization ();
     _cell->updatePlacedFlag();
 
-    fileStream.close ();
+    _buffer.clear ();
   }
 
 
@@ -44,17 +44,13 @@ using namespace CRL;
 
 
 // Symbols from Flex which should be substituted.
-#define    yyrestart    VSTrestart
 #define    yytext       VSTtext
 #define    yywrap       VSTwrap
-#define    yyin         VSTin
 
 
 extern int   yylex               ();
 extern int   yywrap              ();
-extern void  yyrestart           ( FILE* );
 extern char* yytext;
-extern FILE* yyin;
 
 namespace {
 
@@ -65,9 +61,24 @@ namespace {
 
 namespace Vst {
 
-  extern void  incVhdLineNumber ();
-  extern void  ClearIdentifiers ();
-         void  checkForIeee     ( bool ieeeEnabled );
+  extern void    incVhdLineNumber ();
+  extern void    ClearIdentifiers ();
+  extern string* InternIdentifier ( const char* );
+  extern void*   scanBuffer       ( char* buffer, size_t size );
+  extern void    deleteBuffer     ( void* );
+         void    checkForIeee     ( bool ieeeEnabled );
+
+
+  // Scan a whole file buffer (see scanBuffer()), the scanner buffer is
+  // released even if the parser throws.
+
+  class ScanBuffer {
+    public:
+       ScanBuffer ( string& contents ) : _buffer(scanBuffer(&contents[0],contents.size())) { }
+      ~ScanBuffer () { deleteBuffer( _buffer ); }
+    private:
+      void* _buffer;
+  };
 
 
   enum TokenConstants { VhdlTo     =  1
@@ -429,7 +440,7 @@ identifier_path
 
 path_element
     : Identifier { Vst::states->_identifiersList.push_back( $1 ); }
-    | ALL        { Vst::states->_identifiersList.push_back( new string("all") ); }
+    | ALL        { Vst::states->_identifiersList.push_back( Vst::InternIdentifier("all") ); }
     ;
 
 entity_declaration
@@ -1386,8 +1397,13 @@ void  vstParser ( const string cellPath, Cell *cell )
   Vst::states->_state->setLogical ( true );
   Vst::states->_cell = cell;
 
-  IoFile ccell ( cellPath );
-  ccell.open ( "r" );
+// The scanner works in place on the whole file, which needs two ending
+// NUL characters. The first pass only lowercase identifiers, so the
+// second pass can re-scan the same buffer.
+  string contents;
+  if ( not IoFile::readContents(cellPath,contents) )
+    throw Error ( "CParsVst() VHDL Parser:\n  Unable to read <%s>.\n", cellPath.c_str() );
+  contents.append ( 2, '\0' );
 
   if (Vst::states->_behavioral) {
     cmess2 << "     " << tab << "+ " << cellPath << " [behavioral]" << endl;
@@ -1395,11 +1411,18 @@ void  vstParser ( const string cellPath, Cell *cell )
     cmess2 << "     " << tab << "+ " << cellPath << " [models]" << endl; tab++;
 
   // 1.0 step: Build the ordered list of model (Cell) required by the instances.
-    yyin = ccell.getFile ();
-    if ( !firstCall ) yyrestart ( VSTin );
-    yyparse ();
+    {
+      Vst::ScanBuffer scanner ( contents );
+      yyparse ();
+    }
   
-  // 1.5 step: Load, in order, the model Cells (recursive).
+  // 1.5 step: Load, in order, the model Cells (recursive). Their files
+  //           are first read in memory concurrently.
+    vector<string> models;
+    for ( size_t i=0 ; i<Vst::states->_cellQueue.size() ; ++i )
+      models.push_back ( getString(Vst::states->_cellQueue[i]) );
+    Vst::framework->prefetchCells ( models, Catalog::State::Views );
+
     while ( !Vst::states->_cellQueue.empty() ) {
       if ( !Vst::framework->getCell ( getString(Vst::states->_cellQueue.front())
                                     , Catalog::State::Views
@@ -1417,19 +1440,19 @@ void  vstParser ( const string cellPath, Cell *cell )
 
   Vst::states->_firstPass     = false;
   Vst::states->_vhdLineNumber = 1;
-  ccell.close ();
 
 // 2.0 step: Now really read and build the Cell.
-  ccell.open  ( "r" );
-  yyin = ccell.getFile ();
-  yyrestart ( VSTin );
-  UpdateSession::open ();
-  yyparse ();
-  UpdateSession::close ();
+  {
+    Vst::ScanBuffer scanner ( contents );
+    UpdateSession::open ();
+    yyparse ();
+    UpdateSession::close ();
+  }
   Vst::ClearIdentifiers ();
   Vst::states.pop_back();
 
-  ccell.close ();
+// Drop the prefetched files that have not been used.
+  if ( Vst::states.empty() ) IoFile::clearPrefetcheds ();
 }
 
 
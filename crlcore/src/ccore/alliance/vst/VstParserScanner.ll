@@ -38,8 +38,11 @@ using namespace std;
 
 namespace Vst {
 
-  extern void  ClearIdentifiers ();
-  extern void  incVhdLineNumber ();
+  extern void    ClearIdentifiers ();
+  extern string* InternIdentifier ( const char* );
+  extern void*   scanBuffer       ( char* buffer, size_t size );
+  extern void    deleteBuffer     ( void* );
+  extern void    incVhdLineNumber ();
 
 }
 
@@ -175,24 +178,42 @@ namespace {
     }
 
 
-    class Identifiers : public vector<string*> {
+    // Identifiers and literals are interned: a given text is allocated
+    // only once per parsed file, and shared by all it's occurrences.
+
+    struct CStringLess {
+      bool operator() ( const char* lhs, const char* rhs ) const { return strcmp(lhs,rhs) < 0; }
+    };
+
+
+    class Identifiers : public map<const char*,string*,CStringLess> {
       public:
         ~Identifiers ();
-        void clear   ();
+        string* intern  ( const char* );
+        void    clear   ();
     };
 
 
     Identifiers::~Identifiers () {
-      for ( unsigned int i=0 ; i < size() ; i++ )
-        delete (*this)[i];
+      clear ();
+    }
+
+
+    string* Identifiers::intern ( const char* text ) {
+      iterator it = find ( text );
+      if ( it != end() ) return it->second;
+
+      string* identifier = new string ( text );
+      insert ( make_pair(identifier->c_str(),identifier) );
+      return identifier;
     }
 
 
     void  Identifiers::clear () {
-      for ( unsigned int i=0 ; i < size() ; i++ )
-        delete (*this)[i];
+      for ( iterator it=begin() ; it != end() ; ++it )
+        delete it->second;
 
-      vector<string*>::clear ();
+      map<const char*,string*,CStringLess>::clear ();
     }
 
 
@@ -263,33 +284,28 @@ base_specifier            (B|b|O|o|X|x)
 
       if ( it != vhdlKeywords.end() ) { return it->second; }
 
-      VSTlval._text = new string ( yytext );
-      identifiers.push_back ( VSTlval._text );
+      VSTlval._text = identifiers.intern ( yytext );
 
       return Identifier;
     }
 
 ({decimal_literal})|({base}#{based_integer}(\.{based_integer})?#({exponent})?)|({base}:{based_integer}(\.{based_integer})?:({exponent})?)  {
-      VSTlval._text = new string ( yytext );
-      identifiers.push_back ( VSTlval._text );
+      VSTlval._text = identifiers.intern ( yytext );
       return AbstractLit;
     }
 
 '({graphic_character}|\"|\%)'  {
-      VSTlval._text = new string ( yytext );
-      identifiers.push_back ( VSTlval._text );
+      VSTlval._text = identifiers.intern ( yytext );
       return CharacterLit;
     }
 
 (\"({graphic_character}|(\"\")|\%)*\")|(\%({graphic_character}|(\%\%)|\")*\%)  {
-      VSTlval._text = new string ( yytext );
-      identifiers.push_back ( VSTlval._text );
+      VSTlval._text = identifiers.intern ( yytext );
       return StringLit;
     }
 
 {base_specifier}(\"{extended_digit}(_?{extended_digit})*\"|\%{extended_digit}(_?{extended_digit})*\%)  {
-      VSTlval._text = new string ( yytext );
-      identifiers.push_back ( VSTlval._text );
+      VSTlval._text = identifiers.intern ( yytext );
       return BitStringLit;
     }
 
@@ -311,6 +327,22 @@ namespace Vst {
   { identifiers.clear (); }
 
 
+  string* InternIdentifier ( const char* text )
+  { return identifiers.intern ( text ); }
+
+
+  // The scanner works directly on the file buffer, which must ends
+  // with two NUL characters (included in size). The buffer is modified
+  // (identifiers are lowercased in place).
+
+  void* scanBuffer ( char* buffer, size_t size )
+  { return yy_scan_buffer ( buffer, size ); }
+
+
+  void  deleteBuffer ( void* buffer )
+  { yy_delete_buffer ( (YY_BUFFER_STATE)buffer ); }
+
+
 }  // Vst namespace.
 
 
@@ -88,6 +88,7 @@ namespace CRL {
              Cell*                    getCell                  ( const string& name
                                                                , unsigned int  mode
                                                                , unsigned int  depth=(unsigned int)-1 );
+             size_t                   prefetchCells            ( const vector<string>& names, unsigned int mode );
              Cell*                    createCell               ( const string& name, AllianceLibrary* library=NULL );
              void                     saveCell                 ( Cell* , unsigned int mode );
              unsigned int             loadLibraryCells         ( Library* );
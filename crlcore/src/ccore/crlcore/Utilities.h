@@ -22,6 +22,7 @@
 #include <ostream>
 #include <iostream>
 #include <string>
+#include <map>
 #include "vlsisapd/utilities/Path.h"
 #include "hurricane/Commons.h"
 #include "hurricane/Error.h"
@@ -75,12 +76,21 @@ namespace CRL {
 // Class  :  "CRL::IoFile ()".
 //
 // Class wrapper for the C FILE* stream.
+//
+// Files contents can be prefetched (read in memory beforehand, possibly
+// concurrently). A prefetched file is consumed by the first IoFile
+// opening it for reading, which then reads from the memory copy, or by
+// readContents(), which loads a whole file in one buffer.
 
 
   class IoFile {
     public:
     // Constructors.
       inline         IoFile        ( string path="<unbound>" );
+    // Prefetching.
+      static bool    addPrefetched   ( const string& path, string& contents );
+      static void    clearPrefetcheds();
+      static bool    readContents    ( const string& path, string& contents );
     // Methods
       inline bool    isOpen        () const;
       inline bool    eof           () const;
@@ -97,11 +107,13 @@ namespace CRL {
 
     private:
     // Internal - Attributes.
+      static std::map<string,string>  _prefetcheds;
              FILE*   _file;
              string  _path;
              string  _mode;
              size_t  _lineNumber;
              bool    _eof;
+             string  _buffer;
 
     // Internal - Constructor.
                      IoFile       ( const IoFile& );
@@ -126,7 +138,8 @@ namespace CRL {
                                                        , _path(path)
                                                        , _mode("")
                                                        , _lineNumber(0)
-                                                       , _eof(false) {}
+                                                       , _eof(false)
+                                                       , _buffer() {}
   inline bool    IoFile::isOpen         () const { return _file!=NULL; }
   inline bool    IoFile::eof            () const { return _eof; }
   inline FILE*   IoFile::getFile        () { return _file; }
@@ -0,0 +1,40 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |          Alliance / Hurricane  Interface                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :   "./hdb/Hdb.h"                                  |
+// +-----------------------------------------------------------------+
+
+
+#ifndef CRL_HDB_H
+#define CRL_HDB_H
+
+#include  <string>
+
+namespace Hurricane {
+  class Cell;
+}
+
+
+namespace CRL {
+
+  using std::string;
+  using Hurricane::Cell;
+
+// -------------------------------------------------------------------
+// functions.
+
+  void  hdbParser ( const string cellPath, Cell* cell );
+  void  hdbDriver ( const string cellPath, Cell* cell, unsigned int& saveState );
+
+}
+
+#endif  // CRL_HDB_H
@@ -0,0 +1,484 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |          Alliance / Hurricane  Interface                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :   "./hdb/HdbDriver.cpp"                          |
+// +-----------------------------------------------------------------+
+
+
+#include  <cstdio>
+#include  <cstring>
+#include  <map>
+#include  <unordered_map>
+#include  <vector>
+
+#include  "hurricane/Error.h"
+#include  "hurricane/Warning.h"
+#include  "hurricane/DataBase.h"
+#include  "hurricane/Technology.h"
+#include  "hurricane/Library.h"
+#include  "hurricane/Cell.h"
+#include  "hurricane/Instance.h"
+#include  "hurricane/DeepNet.h"
+#include  "hurricane/Plug.h"
+#include  "hurricane/Pin.h"
+#include  "hurricane/Contact.h"
+#include  "hurricane/Horizontal.h"
+#include  "hurricane/Vertical.h"
+#include  "hurricane/Pad.h"
+#include  "hurricane/RoutingPad.h"
+#include  "hurricane/Reference.h"
+#include  "hurricane/NetExternalComponents.h"
+
+#include  "crlcore/Utilities.h"
+#include  "crlcore/Catalog.h"
+#include  "crlcore/AllianceFramework.h"
+#include  "Hdb.h"
+#include  "HdbFormat.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+  using namespace CRL;
+
+
+  const uint32_t  HdbPending = HdbNone - 1;
+
+
+  bool  writeSection ( FILE* file, const void* data, size_t size )
+  {
+    static const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    if (size and (fwrite(data,1,size,file) != size)) return false;
+    size_t pad = hdbAlign(size) - size;
+    return (not pad) or (fwrite(padding,1,pad,file) == pad);
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "HdbWriter".
+
+  class HdbWriter {
+    public:
+                         HdbWriter     ( Cell* );
+              void       save          ( const string& path );
+    private:
+              uint32_t   _getString    ( const string& );
+      inline  uint32_t   _getString    ( const Name& );
+      inline  uint32_t   _getIndex     ( const Entity* ) const;
+      inline  void       _setIndex     ( const Entity*, uint32_t );
+              uint32_t   _getPath      ( const Path& );
+              void       _collectCell  ( Cell* );
+              void       _addCell      ( Cell* );
+              uint32_t   _addComponent ( Component* );
+    private:
+      Cell*                               _topCell;
+      unordered_map<string,uint32_t>      _stringIndexes;
+      vector<uint32_t>                    _strings;
+      vector<char>                        _stringData;
+      vector<uint32_t>                    _indexes;
+      map<const SharedPath*,uint32_t>     _pathIndexes;
+      vector<Cell*>                       _cellOrder;
+      vector<HdbCell>                     _cells;
+      vector<HdbNet>                      _nets;
+      vector<HdbInstance>                 _instances;
+      vector<HdbComponent>                _components;
+      vector<HdbReference>                _references;
+      vector<HdbPath>                     _paths;
+      vector<uint32_t>                    _pathInstances;
+  };
+
+
+  HdbWriter::HdbWriter ( Cell* cell )
+    : _topCell      (cell)
+    , _stringIndexes()
+    , _strings      ()
+    , _stringData   ()
+    , _indexes      ()
+    , _pathIndexes  ()
+    , _cellOrder    ()
+    , _cells        ()
+    , _nets         ()
+    , _instances    ()
+    , _components   ()
+    , _references   ()
+    , _paths        ()
+    , _pathInstances()
+  { }
+
+
+  inline uint32_t  HdbWriter::_getString ( const Name& name )
+  { return _getString( getString(name) ); }
+
+
+  inline uint32_t  HdbWriter::_getIndex ( const Entity* entity ) const
+  {
+    if (not entity) return HdbNone;
+    unsigned int id = entity->getId();
+    return (id < _indexes.size()) ? _indexes[id] : HdbNone;
+  }
+
+
+  inline void  HdbWriter::_setIndex ( const Entity* entity, uint32_t index )
+  {
+    unsigned int id = entity->getId();
+    if (id >= _indexes.size()) _indexes.resize( id+1, HdbNone );
+    _indexes[id] = index;
+  }
+
+
+  uint32_t  HdbWriter::_getString ( const string& s )
+  {
+    unordered_map<string,uint32_t>::iterator istring = _stringIndexes.find( s );
+    if (istring != _stringIndexes.end()) return istring->second;
+
+    uint32_t index = _strings.size();
+    _strings.push_back( _stringData.size() );
+    _stringData.insert( _stringData.end(), s.begin(), s.end() );
+    _stringData.push_back( '\0' );
+    _stringIndexes.insert( make_pair(s,index) );
+    return index;
+  }
+
+
+  uint32_t  HdbWriter::_getPath ( const Path& path )
+  {
+    if (path.isEmpty()) return HdbNone;
+
+    map<const SharedPath*,uint32_t>::iterator ipath = _pathIndexes.find( path._getSharedPath() );
+    if (ipath != _pathIndexes.end()) return ipath->second;
+
+    HdbPath record;
+    record._firstInstance = _pathInstances.size();
+    record._nbInstances   = 0;
+    for ( Instance* instance : path.getInstances() ) {
+      _pathInstances.push_back( _getIndex(instance) );
+      ++record._nbInstances;
+    }
+
+    uint32_t index = _paths.size();
+    _paths.push_back( record );
+    _pathIndexes.insert( make_pair(path._getSharedPath(),index) );
+    return index;
+  }
+
+
+  void  HdbWriter::_collectCell ( Cell* cell )
+  {
+    if (_getIndex(cell) != HdbNone) return;
+
+    _setIndex( cell, HdbPending );
+    for ( Instance* instance : cell->getInstances() )
+      _collectCell( instance->getMasterCell() );
+
+    _setIndex( cell, _cellOrder.size() );
+    _cellOrder.push_back( cell );
+  }
+
+
+  void  HdbWriter::_addCell ( Cell* cell )
+  {
+    static const unsigned int cellFlags    = Cell::Flags::Terminal
+                                           | Cell::Flags::FlattenLeaf
+                                           | Cell::Flags::Pad
+                                           | Cell::Flags::Feed
+                                           | Cell::Flags::FlattenedNets
+                                           | Cell::Flags::Placed
+                                           | Cell::Flags::Routed;
+    static const unsigned int catalogFlags = Catalog::State::FlattenLeaf
+                                           | Catalog::State::Feed
+                                           | Catalog::State::Pad
+                                           | Catalog::State::GDS;
+
+    Catalog::State* state = AllianceFramework::get()->getCatalog()->getState( cell->getName() );
+    const Box&      ab    = cell->getAbutmentBox();
+
+    HdbCell record;
+    memset( &record, 0, sizeof(HdbCell) );
+    record._name           = _getString( cell->getName() );
+    record._library        = _getString( cell->getLibrary()->getName() );
+    record._flags          = (unsigned int)cell->getFlags() & cellFlags;
+    record._catalogFlags   = (state) ? state->getFlags(catalogFlags) : 0;
+    record._abutmentBox[0] = ab.getXMin();
+    record._abutmentBox[1] = ab.getYMin();
+    record._abutmentBox[2] = ab.getXMax();
+    record._abutmentBox[3] = ab.getYMax();
+
+    record._firstInstance = _instances.size();
+    for ( Instance* instance : cell->getInstances() ) {
+      const Transformation& transf = instance->getTransformation();
+
+      HdbInstance hdbInstance;
+      hdbInstance._name            = _getString( instance->getName() );
+      hdbInstance._masterCell      = _getIndex( instance->getMasterCell() );
+      hdbInstance._tx              = transf.getTx();
+      hdbInstance._ty              = transf.getTy();
+      hdbInstance._orientation     = transf.getOrientation().getCode();
+      hdbInstance._placementStatus = instance->getPlacementStatus().getCode();
+
+      _setIndex( instance, _instances.size() );
+      _instances.push_back( hdbInstance );
+    }
+    record._nbInstances = _instances.size() - record._firstInstance;
+
+    record._firstNet = _nets.size();
+    for ( Net* net : cell->getNets() ) {
+      HdbNet hdbNet;
+      hdbNet._name      = _getString( net->getName() );
+      hdbNet._flags     = 0;
+      hdbNet._type      = net->getType().getCode();
+      hdbNet._direction = net->getDirection().getCode();
+      hdbNet._rootPath  = HdbNone;
+      hdbNet._rootNet   = HdbNone;
+      if (net->isExternal ()) hdbNet._flags |= HdbNetExternal;
+      if (net->isGlobal   ()) hdbNet._flags |= HdbNetGlobal;
+      if (net->isAutomatic()) hdbNet._flags |= HdbNetAutomatic;
+      if (net->isDeepNet()) {
+        Occurrence rootOccurrence = static_cast<DeepNet*>(net)->getRootNetOccurrence();
+        hdbNet._flags    |= HdbNetDeep;
+        hdbNet._rootPath  = _getPath ( rootOccurrence.getPath() );
+        hdbNet._rootNet   = _getIndex( rootOccurrence.getEntity() );
+      }
+
+      _setIndex( net, _nets.size() );
+      _nets.push_back( hdbNet );
+    }
+    record._nbNets = _nets.size() - record._firstNet;
+
+    record._firstComponent = _components.size();
+    for ( Instance* instance : cell->getInstances() ) {
+      for ( Plug* plug : instance->getPlugs() ) _addComponent( plug );
+    }
+    for ( Net* net : cell->getNets() ) {
+      for ( Component* component : net->getComponents() ) _addComponent( component );
+    }
+    record._nbComponents = _components.size() - record._firstComponent;
+
+    record._firstReference = _references.size();
+    for ( Reference* reference : cell->getReferences() ) {
+      HdbReference hdbReference;
+      hdbReference._name = _getString( reference->getName() );
+      hdbReference._type = reference->getType();
+      hdbReference._x    = reference->getPoint().getX();
+      hdbReference._y    = reference->getPoint().getY();
+      _references.push_back( hdbReference );
+    }
+    record._nbReferences = _references.size() - record._firstReference;
+
+    _cells.push_back( record );
+  }
+
+
+  uint32_t  HdbWriter::_addComponent ( Component* component )
+  {
+    if (not component) return HdbNone;
+
+    uint32_t index = _getIndex( component );
+    if (index == HdbPending) return HdbNone;  // Anchor loop, use absolute coordinates.
+    if (index != HdbNone   ) return index;
+
+    _setIndex( component, HdbPending );
+
+    HdbComponent record;
+    memset( &record, 0, sizeof(HdbComponent) );
+    record._net    = _getIndex( component->getNet() );
+    record._layer  = HdbNone;
+    record._source = HdbNone;
+    record._target = HdbNone;
+    record._name   = HdbNone;
+    if (NetExternalComponents::isExternal(component)) record._flags |= HdbExternal;
+
+    Plug*       plug       = dynamic_cast<Plug*      >( component );
+    RoutingPad* routingPad = dynamic_cast<RoutingPad*>( component );
+    Pin*        pin        = dynamic_cast<Pin*       >( component );
+    Contact*    contact    = dynamic_cast<Contact*   >( component );
+    Horizontal* horizontal = dynamic_cast<Horizontal*>( component );
+    Vertical*   vertical   = dynamic_cast<Vertical*  >( component );
+    Pad*        pad        = dynamic_cast<Pad*       >( component );
+
+    if (plug) {
+      record._type   = HdbPlug;
+      record._source = _getIndex( plug->getInstance () );
+      record._target = _getIndex( plug->getMasterNet() );
+    } else if (routingPad) {
+      Occurrence occurrence = routingPad->getOccurrence();
+      Component* entity     = static_cast<Component*>( occurrence.getEntity() );
+
+      record._type   = HdbRoutingPad;
+      record._source = _getPath( occurrence.getPath() );
+      record._target = (occurrence.getPath().isEmpty()) ? _addComponent(entity) : _getIndex(entity);
+    } else if (pin) {
+      record._type      = HdbPin;
+      record._layer     = _getString( pin->getLayer()->getName() );
+      record._name      = _getString( pin->getName() );
+      record._extra     = pin->getAccessDirection().getCode()
+                        | (pin->getPlacementStatus().getCode() << 8);
+      record._values[0] = pin->getX();
+      record._values[1] = pin->getY();
+      record._values[2] = pin->getWidth();
+      record._values[3] = pin->getHeight();
+    } else if (contact) {
+      record._type      = HdbContact;
+      record._layer     = _getString( contact->getLayer()->getName() );
+      record._source    = _addComponent( contact->getAnchor() );
+      record._values[0] = contact->getX();
+      record._values[1] = contact->getY();
+      record._values[2] = contact->getDx();
+      record._values[3] = contact->getDy();
+      record._values[4] = contact->getWidth();
+      record._values[5] = contact->getHeight();
+    } else if (horizontal) {
+      record._type      = HdbHorizontal;
+      record._layer     = _getString( horizontal->getLayer()->getName() );
+      record._source    = _addComponent( horizontal->getSource() );
+      record._target    = _addComponent( horizontal->getTarget() );
+      record._values[0] = horizontal->getY();
+      record._values[1] = horizontal->getWidth();
+      record._values[2] = horizontal->getDxSource();
+      record._values[3] = horizontal->getDxTarget();
+      record._values[4] = horizontal->getSourceX();
+      record._values[5] = horizontal->getTargetX();
+    } else if (vertical) {
+      record._type      = HdbVertical;
+      record._layer     = _getString( vertical->getLayer()->getName() );
+      record._source    = _addComponent( vertical->getSource() );
+      record._target    = _addComponent( vertical->getTarget() );
+      record._values[0] = vertical->getX();
+      record._values[1] = vertical->getWidth();
+      record._values[2] = vertical->getDySource();
+      record._values[3] = vertical->getDyTarget();
+      record._values[4] = vertical->getSourceY();
+      record._values[5] = vertical->getTargetY();
+    } else if (pad) {
+      const Box& bb = pad->getBoundingBox();
+      record._type      = HdbPad;
+      record._layer     = _getString( pad->getLayer()->getName() );
+      record._values[0] = bb.getXMin();
+      record._values[1] = bb.getYMin();
+      record._values[2] = bb.getXMax();
+      record._values[3] = bb.getYMax();
+    } else {
+      cerr << Warning( "hdbDriver(): %s is not supported, skipped."
+                     , getString(component).c_str() ) << endl;
+      _setIndex( component, HdbNone );
+      return HdbNone;
+    }
+
+    index = _components.size();
+    _setIndex( component, index );
+    _components.push_back( record );
+    return index;
+  }
+
+
+  void  HdbWriter::save ( const string& path )
+  {
+    _collectCell( _topCell );
+    for ( size_t icell=0 ; icell<_cellOrder.size() ; ++icell )
+      _addCell( _cellOrder[icell] );
+
+    HdbHeader header;
+    memset( &header, 0, sizeof(HdbHeader) );
+    memcpy( header._magic, HdbMagic, 4 );
+    header._version    = HdbVersion;
+    header._endianness = HdbEndianness;
+    header._precision  = DbU::getPrecision();
+    header._resolution = DbU::getResolution();
+    header._technology = _getString( DataBase::getDB()->getTechnology()->getName() );
+    header._topCell    = _getIndex( _topCell );
+
+    HdbSection* sections[9] = { &header._strings
+                              , &header._stringData
+                              , &header._cells
+                              , &header._nets
+                              , &header._instances
+                              , &header._components
+                              , &header._references
+                              , &header._paths
+                              , &header._pathInstances
+                              };
+    const void* datas   [9] = { _strings      .data()
+                              , _stringData   .data()
+                              , _cells        .data()
+                              , _nets         .data()
+                              , _instances    .data()
+                              , _components   .data()
+                              , _references   .data()
+                              , _paths        .data()
+                              , _pathInstances.data()
+                              };
+    size_t      counts  [9] = { _strings      .size()
+                              , _stringData   .size()
+                              , _cells        .size()
+                              , _nets         .size()
+                              , _instances    .size()
+                              , _components   .size()
+                              , _references   .size()
+                              , _paths        .size()
+                              , _pathInstances.size()
+                              };
+    size_t      sizes   [9] = { sizeof(uint32_t)
+                              , sizeof(char)
+                              , sizeof(HdbCell)
+                              , sizeof(HdbNet)
+                              , sizeof(HdbInstance)
+                              , sizeof(HdbComponent)
+                              , sizeof(HdbReference)
+                              , sizeof(HdbPath)
+                              , sizeof(uint32_t)
+                              };
+
+    uint64_t offset = hdbAlign( sizeof(HdbHeader) );
+    for ( size_t i=0 ; i<9 ; ++i ) {
+      sections[i]->_offset = offset;
+      sections[i]->_count  = counts[i];
+      offset += hdbAlign( counts[i]*sizes[i] );
+    }
+    header._size = offset;
+
+    FILE* file = fopen( path.c_str(), "wb" );
+    if (not file)
+      throw Error( "hdbDriver(): Cannot open \"%s\" for writing.", path.c_str() );
+
+    bool written = writeSection( file, &header, sizeof(HdbHeader) );
+    for ( size_t i=0 ; written and (i<9) ; ++i )
+      written = writeSection( file, datas[i], counts[i]*sizes[i] );
+    fclose( file );
+
+    if (not written)
+      throw Error( "hdbDriver(): Error while writing \"%s\".", path.c_str() );
+
+    cmess2 << "     " << tab << "+ " << path << " ("
+           << _cells.size() << " cells, "
+           << _instances.size() << " instances, "
+           << _components.size() << " components)" << endl;
+  }
+
+
+} // Anonymous namespace.
+
+
+namespace CRL {
+
+
+  void  hdbDriver ( const string cellPath, Cell* cell, unsigned int& saveState )
+  {
+    HdbWriter writer ( cell );
+    writer.save( cellPath );
+
+  // Both views are in the snapshot.
+    saveState |= Catalog::State::Views;
+  }
+
+
+} // CRL namespace.
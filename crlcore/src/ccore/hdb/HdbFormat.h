@@ -0,0 +1,190 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |          Alliance / Hurricane  Interface                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :   "./hdb/HdbFormat.h"                            |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  CRL_HDB_FORMAT_H
+#define  CRL_HDB_FORMAT_H
+
+#include <stdint.h>
+
+
+namespace CRL {
+
+
+// -------------------------------------------------------------------
+// Hurricane DataBase snapshot (.hdb).
+//
+// One file holds a Cell and all the Cells it instanciates, down to the
+// leaf cells, so the whole sub-tree is restored without calling any
+// other parser. Cells are stored bottom-up: a master Cell always comes
+// before the Cells which instanciate it.
+//
+// Every object is referenced by its index in its table (cells, nets,
+// instances, components, paths or strings), tables are global to the
+// file. A Cell record holds the ranges of its own nets, instances,
+// components and references. Names and layers are indexes in the string
+// table, which is a table of offsets relative to the start of the
+// string blob (NUL terminated strings).
+//
+// Inside a Cell, components are sorted so that an anchor (Contact) or
+// an hook target (Segment) always comes before the components attached
+// to it. RoutingPads refer to their occurrence through a path (list of
+// instances) and the component index of the occurrence entity, which
+// lies in a Cell stored before.
+//
+// DbU values are stored raw, so the snapshot can only be read back with
+// the same DbU precision and resolution. Sections start on an 8 bytes
+// boundary, all values are in the native byte order.
+
+
+  const char      HdbMagic[4]      = { 'H', 'D', 'B', 'S' };
+  const uint32_t  HdbVersion       = 1;
+  const uint32_t  HdbEndianness    = 0x01020304;
+  const uint32_t  HdbNone          = 0xffffffff;
+
+
+  enum HdbComponentType { HdbPlug       = 1
+                        , HdbContact    = 2
+                        , HdbPin        = 3
+                        , HdbHorizontal = 4
+                        , HdbVertical   = 5
+                        , HdbPad        = 6
+                        , HdbRoutingPad = 7
+                        };
+
+  enum HdbNetFlags      { HdbNetExternal  = 0x0001
+                        , HdbNetGlobal    = 0x0002
+                        , HdbNetAutomatic = 0x0004
+                        , HdbNetDeep      = 0x0008
+                        };
+
+  enum HdbComponentFlags{ HdbExternal     = 0x0001
+                        };
+
+
+  struct HdbSection {
+    uint64_t  _offset;                // From the start of the file.
+    uint64_t  _count;                 // In records (or bytes for the blob).
+  };
+
+
+  struct HdbHeader {
+    char        _magic[4];
+    uint32_t    _version;
+    uint32_t    _endianness;
+    uint32_t    _precision;           // DbU::getPrecision().
+    double      _resolution;          // DbU::getResolution().
+    uint32_t    _technology;          // String, name of the Technology.
+    uint32_t    _topCell;             // Cell, root of the snapshot.
+    HdbSection  _strings;             // uint32_t offsets in the blob.
+    HdbSection  _stringData;          // char.
+    HdbSection  _cells;               // HdbCell.
+    HdbSection  _nets;                // HdbNet.
+    HdbSection  _instances;           // HdbInstance.
+    HdbSection  _components;          // HdbComponent.
+    HdbSection  _references;          // HdbReference.
+    HdbSection  _paths;               // HdbPath.
+    HdbSection  _pathInstances;       // uint32_t instance indexes.
+    uint64_t    _size;                // Of the whole file.
+  };
+
+
+  struct HdbCell {
+    uint32_t  _name;
+    uint32_t  _library;               // String, name of the owning Library.
+    uint32_t  _flags;                 // Cell::Flags (states only).
+    uint32_t  _catalogFlags;          // Catalog::State flags (FlattenLeaf, Feed, Pad, GDS).
+    int64_t   _abutmentBox[4];
+    uint32_t  _firstNet;
+    uint32_t  _nbNets;
+    uint32_t  _firstInstance;
+    uint32_t  _nbInstances;
+    uint32_t  _firstComponent;
+    uint32_t  _nbComponents;
+    uint32_t  _firstReference;
+    uint32_t  _nbReferences;
+  };
+
+
+  struct HdbNet {
+    uint32_t  _name;
+    uint32_t  _flags;                 // HdbNetFlags.
+    uint32_t  _type;                  // Net::Type::Code.
+    uint32_t  _direction;             // Net::Direction::Code.
+    uint32_t  _rootPath;              // DeepNet only: path of the root net occurrence,
+    uint32_t  _rootNet;               //   and the root net itself.
+  };
+
+
+  struct HdbInstance {
+    uint32_t  _name;
+    uint32_t  _masterCell;
+    int64_t   _tx;
+    int64_t   _ty;
+    uint32_t  _orientation;           // Transformation::Orientation::Code.
+    uint32_t  _placementStatus;       // Instance::PlacementStatus::Code.
+  };
+
+
+// Meaning of the fields depending on the component type:
+//
+//   Type        | _source    | _target     | _values
+//   ------------+------------+-------------+---------------------------------------
+//   Plug        | instance   | master net  |
+//   Contact     | anchor     |             | x, y, dx, dy, width, height
+//   Pin         |            |             | x, y, width, height
+//   Horizontal  | source     | target      | y, width, dxSource, dxTarget, xSource, xTarget
+//   Vertical    | source     | target      | x, width, dySource, dyTarget, ySource, yTarget
+//   Pad         |            |             | xMin, yMin, xMax, yMax
+//   RoutingPad  | path       | entity      |
+//
+// The absolute source/target coordinates of segments and position of
+// contacts are used when the hook or the anchor cannot be restored.
+// For a Pin, _extra is the access direction | (placement status << 8).
+
+  struct HdbComponent {
+    uint32_t  _type;                  // HdbComponentType.
+    uint32_t  _flags;                 // HdbComponentFlags.
+    uint32_t  _net;
+    uint32_t  _layer;                 // String, name of the layer.
+    uint32_t  _source;
+    uint32_t  _target;
+    uint32_t  _name;                  // Pin only.
+    uint32_t  _extra;
+    int64_t   _values[6];
+  };
+
+
+  struct HdbReference {
+    uint32_t  _name;
+    uint32_t  _type;                  // Reference::Type.
+    int64_t   _x;
+    int64_t   _y;
+  };
+
+
+  struct HdbPath {
+    uint32_t  _firstInstance;         // In the path instances table, head first.
+    uint32_t  _nbInstances;
+  };
+
+
+  inline uint64_t  hdbAlign ( uint64_t size )
+  { return (size + 7) & ~(uint64_t)7; }
+
+
+}  // CRL namespace.
+
+#endif  // CRL_HDB_FORMAT_H
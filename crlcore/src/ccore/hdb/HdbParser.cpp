@@ -0,0 +1,665 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |          Alliance / Hurricane  Interface                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :   "./hdb/HdbParser.cpp"                          |
+// +-----------------------------------------------------------------+
+
+
+#include  <cstring>
+#include  <map>
+#include  <vector>
+#include  <fcntl.h>
+#include  <unistd.h>
+#include  <sys/stat.h>
+#include  <sys/mman.h>
+
+#include  "hurricane/Error.h"
+#include  "hurricane/Warning.h"
+#include  "hurricane/DataBase.h"
+#include  "hurricane/Technology.h"
+#include  "hurricane/Library.h"
+#include  "hurricane/Cell.h"
+#include  "hurricane/Instance.h"
+#include  "hurricane/HyperNet.h"
+#include  "hurricane/DeepNet.h"
+#include  "hurricane/Plug.h"
+#include  "hurricane/Pin.h"
+#include  "hurricane/Contact.h"
+#include  "hurricane/Horizontal.h"
+#include  "hurricane/Vertical.h"
+#include  "hurricane/Pad.h"
+#include  "hurricane/RoutingPad.h"
+#include  "hurricane/Reference.h"
+#include  "hurricane/NetExternalComponents.h"
+#include  "hurricane/UpdateSession.h"
+
+#include  "crlcore/Utilities.h"
+#include  "crlcore/Catalog.h"
+#include  "crlcore/AllianceLibrary.h"
+#include  "crlcore/AllianceFramework.h"
+#include  "Hdb.h"
+#include  "HdbFormat.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+  using namespace CRL;
+
+
+// -------------------------------------------------------------------
+// Class  :  "HdbReader".
+//
+// The snapshot is mapped in memory and the records are read in place.
+// Cells already in memory are not rebuilt: their nets and instances are
+// bound by name and their components looked up only when referenced
+// (by a RoutingPad or a Plug).
+
+  class HdbReader {
+    public:
+                                HdbReader          ( AllianceFramework* );
+                               ~HdbReader          ();
+              void              load               ( const string& path, Cell* );
+    private:
+      template<typename T>
+      inline  const T*          _section           ( const HdbSection& ) const;
+      inline  const Name&       _getName           ( uint32_t ) const;
+              const Layer*      _getLayer          ( uint32_t );
+              void              _open              ( const string& path );
+              void              _close             ();
+              Cell*             _getCell           ( uint32_t, Cell* topCell );
+              Path              _getPath           ( uint32_t );
+              void              _bindCell          ( uint32_t );
+              void              _buildCell         ( uint32_t );
+              Component*        _getComponent      ( uint32_t );
+              Component*        _lookupComponent   ( uint32_t );
+              Component*        _createComponent   ( uint32_t );
+    private:
+      AllianceFramework*            _framework;
+      Technology*                   _technology;
+      string                        _path;
+      const char*                   _data;
+      size_t                        _size;
+      const HdbHeader*              _header;
+      vector<Name>                  _names;
+      map<uint32_t,const Layer*>    _layers;
+      vector<Cell*>                 _cells;
+      vector<bool>                  _builts;
+      vector<Net*>                  _nets;
+      vector<Instance*>             _instances;
+      vector<Component*>            _components;
+      vector<bool>                  _resolveds;
+  };
+
+
+  HdbReader::HdbReader ( AllianceFramework* framework )
+    : _framework (framework)
+    , _technology(DataBase::getDB()->getTechnology())
+    , _path      ()
+    , _data      (NULL)
+    , _size      (0)
+    , _header    (NULL)
+    , _names     ()
+    , _layers    ()
+    , _cells     ()
+    , _builts    ()
+    , _nets      ()
+    , _instances ()
+    , _components()
+    , _resolveds ()
+  { }
+
+
+  HdbReader::~HdbReader ()
+  { _close(); }
+
+
+  template<typename T>
+  inline const T* HdbReader::_section ( const HdbSection& section ) const
+  { return reinterpret_cast<const T*>( _data + section._offset ); }
+
+
+  inline const Name& HdbReader::_getName ( uint32_t index ) const
+  {
+    if (index >= _names.size())
+      throw Error( "hdbParser(): String index %u out of range in \"%s\".", index, _path.c_str() );
+    return _names[index];
+  }
+
+
+  const Layer* HdbReader::_getLayer ( uint32_t index )
+  {
+    map<uint32_t,const Layer*>::iterator ilayer = _layers.find( index );
+    if (ilayer != _layers.end()) return ilayer->second;
+
+    const Layer* layer = _technology->getLayer( _getName(index) );
+    if (not layer)
+      throw Error( "hdbParser(): Unknown layer \"%s\" in \"%s\"."
+                 , getString(_getName(index)).c_str(), _path.c_str() );
+    _layers.insert( make_pair(index,layer) );
+    return layer;
+  }
+
+
+  void  HdbReader::_open ( const string& path )
+  {
+    _path = path;
+
+    int fd = open( path.c_str(), O_RDONLY );
+    if (fd < 0)
+      throw Error( "hdbParser(): Cannot open \"%s\".", path.c_str() );
+
+    struct stat status;
+    if ( (fstat(fd,&status) < 0) or ((size_t)status.st_size < sizeof(HdbHeader)) ) {
+      ::close( fd );
+      throw Error( "hdbParser(): \"%s\" is not a DataBase snapshot (too small).", path.c_str() );
+    }
+
+    _size = status.st_size;
+    void* data = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+    if (data == MAP_FAILED) {
+      _size = 0;
+      throw Error( "hdbParser(): Cannot map \"%s\" in memory.", path.c_str() );
+    }
+    _data   = static_cast<const char*>( data );
+    _header = reinterpret_cast<const HdbHeader*>( _data );
+
+    if (memcmp(_header->_magic,HdbMagic,sizeof(HdbMagic)))
+      throw Error( "hdbParser(): \"%s\" is not a DataBase snapshot (bad magic).", path.c_str() );
+    if (_header->_endianness != HdbEndianness)
+      throw Error( "hdbParser(): \"%s\" has been written on a machine of different endianness.", path.c_str() );
+    if (_header->_version != HdbVersion)
+      throw Error( "hdbParser(): \"%s\" has format version %u, expected %u."
+                 , path.c_str(), _header->_version, HdbVersion );
+    if ( (_header->_precision != DbU::getPrecision()) or (_header->_resolution != DbU::getResolution()) )
+      throw Error( "hdbParser(): \"%s\" has been written with another DbU precision or resolution."
+                 , path.c_str() );
+
+    const HdbSection* sections[9] = { &_header->_strings
+                                    , &_header->_stringData
+                                    , &_header->_cells
+                                    , &_header->_nets
+                                    , &_header->_instances
+                                    , &_header->_components
+                                    , &_header->_references
+                                    , &_header->_paths
+                                    , &_header->_pathInstances
+                                    };
+    size_t            sizes   [9] = { sizeof(uint32_t)
+                                    , sizeof(char)
+                                    , sizeof(HdbCell)
+                                    , sizeof(HdbNet)
+                                    , sizeof(HdbInstance)
+                                    , sizeof(HdbComponent)
+                                    , sizeof(HdbReference)
+                                    , sizeof(HdbPath)
+                                    , sizeof(uint32_t)
+                                    };
+    bool corrupted = (_header->_size != _size) or (_header->_topCell >= _header->_cells._count);
+    for ( size_t i=0 ; not corrupted and (i<9) ; ++i ) {
+      corrupted = (sections[i]->_offset > _size)
+               or (sections[i]->_count  > (_size - sections[i]->_offset) / sizes[i]);
+    }
+    if (corrupted)
+      throw Error( "hdbParser(): \"%s\" is truncated or corrupted.", path.c_str() );
+
+    const uint32_t* offsets = _section<uint32_t>( _header->_strings );
+    const char*     blob    = _section<char>    ( _header->_stringData );
+    size_t          bytes   = _header->_stringData._count;
+    if (bytes and blob[bytes-1])
+      throw Error( "hdbParser(): \"%s\" has an unterminated string table.", path.c_str() );
+
+    _names.reserve( _header->_strings._count );
+    for ( size_t i=0 ; i<_header->_strings._count ; ++i ) {
+      if (offsets[i] >= bytes)
+        throw Error( "hdbParser(): \"%s\" has a corrupted string table.", path.c_str() );
+      _names.push_back( Name(blob+offsets[i]) );
+    }
+
+  // The cells records ranges are trusted afterwards, check them once.
+    const HdbCell* cells = _section<HdbCell>( _header->_cells );
+    for ( size_t i=0 ; i<_header->_cells._count ; ++i ) {
+      const HdbCell& cell = cells[i];
+      if (   (cell._firstNet       + (uint64_t)cell._nbNets       > _header->_nets      ._count)
+          or (cell._firstInstance  + (uint64_t)cell._nbInstances  > _header->_instances ._count)
+          or (cell._firstComponent + (uint64_t)cell._nbComponents > _header->_components._count)
+          or (cell._firstReference + (uint64_t)cell._nbReferences > _header->_references._count) )
+        throw Error( "hdbParser(): Corrupted cell %u in \"%s\".", (unsigned int)i, path.c_str() );
+    }
+
+    if (_technology->getName() != _getName(_header->_technology))
+      cerr << Warning( "hdbParser(): \"%s\" has been written with technology \"%s\" (current is \"%s\")."
+                     , path.c_str()
+                     , getString(_getName(_header->_technology)).c_str()
+                     , getString(_technology->getName()).c_str() ) << endl;
+
+    _cells     .resize( _header->_cells     ._count, NULL );
+    _builts    .resize( _header->_cells     ._count, false );
+    _nets      .resize( _header->_nets      ._count, NULL );
+    _instances .resize( _header->_instances ._count, NULL );
+    _components.resize( _header->_components._count, NULL );
+    _resolveds .resize( _header->_components._count, false );
+  }
+
+
+  void  HdbReader::_close ()
+  {
+    if (_data) munmap( const_cast<char*>(_data), _size );
+    _data   = NULL;
+    _header = NULL;
+    _size   = 0;
+  }
+
+
+  Cell* HdbReader::_getCell ( uint32_t icell, Cell* topCell )
+  {
+    const HdbCell&  record  = _section<HdbCell>( _header->_cells )[ icell ];
+    const Name&     name    = _getName( record._name );
+    Catalog*        catalog = _framework->getCatalog();
+    Catalog::State* state   = NULL;
+    Cell*           cell    = NULL;
+
+    if (icell == _header->_topCell) {
+      CatalogProperty* property
+        = static_cast<CatalogProperty*>( topCell->getProperty(CatalogProperty::getPropertyName()) );
+      if (not property)
+        throw Error( "hdbParser(): Missing CatalogProperty in cell %s.", getString(topCell->getName()).c_str() );
+      if (topCell->getName() != name)
+        cerr << Warning( "hdbParser(): Loading snapshot of <%s> into cell <%s>."
+                       , getString(name).c_str(), getString(topCell->getName()).c_str() ) << endl;
+      state = property->getState();
+      cell  = topCell;
+    } else {
+      state = catalog->getState( name, true );
+      if (state->getCell()) return state->getCell();
+
+      unsigned int     flags    = 0;
+      AllianceLibrary* alibrary = _framework->getAllianceLibrary( _getName(record._library), flags );
+      Library*         library  = (alibrary) ? alibrary->getLibrary() : topCell->getLibrary();
+
+      cell = Cell::create( library, name );
+      state->setCell( cell );
+      cell->put( CatalogProperty::create(state) );
+    }
+
+    static const unsigned int cellFlags = Cell::Flags::Terminal
+                                        | Cell::Flags::FlattenLeaf
+                                        | Cell::Flags::Pad
+                                        | Cell::Flags::Feed
+                                        | Cell::Flags::FlattenedNets
+                                        | Cell::Flags::Placed
+                                        | Cell::Flags::Routed;
+
+    cell->resetFlags( cellFlags );
+    cell->setFlags  ( record._flags & cellFlags );
+    state->setFlags ( record._catalogFlags, true );
+    state->setFlags ( Catalog::State::Views|Catalog::State::InMemory, true );
+
+    _builts[icell] = true;
+    return cell;
+  }
+
+
+  Path  HdbReader::_getPath ( uint32_t index )
+  {
+    if (index == HdbNone) return Path();
+    if (index >= _header->_paths._count)
+      throw Error( "hdbParser(): Path index %u out of range in \"%s\".", index, _path.c_str() );
+
+    const HdbPath&  record    = _section<HdbPath>( _header->_paths )[ index ];
+    const uint32_t* instances = _section<uint32_t>( _header->_pathInstances );
+    Path            path;
+
+    if (record._firstInstance + (uint64_t)record._nbInstances > _header->_pathInstances._count)
+      throw Error( "hdbParser(): Corrupted path %u in \"%s\".", index, _path.c_str() );
+
+    for ( uint32_t i=0 ; i<record._nbInstances ; ++i ) {
+      uint32_t  iinstance = instances[ record._firstInstance+i ];
+      Instance* instance  = (iinstance < _instances.size()) ? _instances[iinstance] : NULL;
+      if (not instance) return Path();
+      path = Path( path, instance );
+    }
+    return path;
+  }
+
+
+  void  HdbReader::_bindCell ( uint32_t icell )
+  {
+    const HdbCell&     record    = _section<HdbCell    >( _header->_cells     )[ icell ];
+    const HdbNet*      nets      = _section<HdbNet     >( _header->_nets      );
+    const HdbInstance* instances = _section<HdbInstance>( _header->_instances );
+    Cell*              cell      = _cells[icell];
+
+    for ( uint32_t i=record._firstInstance ; i<record._firstInstance+record._nbInstances ; ++i )
+      _instances[i] = cell->getInstance( _getName(instances[i]._name) );
+
+    for ( uint32_t i=record._firstNet ; i<record._firstNet+record._nbNets ; ++i )
+      _nets[i] = cell->getNet( _getName(nets[i]._name) );
+  }
+
+
+  void  HdbReader::_buildCell ( uint32_t icell )
+  {
+    const HdbCell&      record     = _section<HdbCell     >( _header->_cells      )[ icell ];
+    const HdbNet*       nets       = _section<HdbNet      >( _header->_nets       );
+    const HdbInstance*  instances  = _section<HdbInstance >( _header->_instances  );
+    const HdbReference* references = _section<HdbReference>( _header->_references );
+    Cell*               cell       = _cells[icell];
+
+    cell->setAbutmentBox( Box( record._abutmentBox[0], record._abutmentBox[1]
+                             , record._abutmentBox[2], record._abutmentBox[3] ) );
+
+    for ( uint32_t i=record._firstInstance ; i<record._firstInstance+record._nbInstances ; ++i ) {
+      const HdbInstance& hdbInstance = instances[i];
+      Cell*              masterCell  = (hdbInstance._masterCell < icell) ? _cells[hdbInstance._masterCell] : NULL;
+      if (not masterCell)
+        throw Error( "hdbParser(): Instance <%s> of <%s> has an invalid model in \"%s\"."
+                   , getString(_getName(hdbInstance._name)).c_str()
+                   , getString(cell->getName()).c_str()
+                   , _path.c_str() );
+
+      _instances[i] = cell->getInstance( _getName(hdbInstance._name) );
+      if (_instances[i]) continue;
+
+      _instances[i] = Instance::create( cell
+                                      , _getName(hdbInstance._name)
+                                      , masterCell
+                                      , Transformation( hdbInstance._tx
+                                                      , hdbInstance._ty
+                                                      , Transformation::Orientation
+                                                          ((Transformation::Orientation::Code)hdbInstance._orientation) )
+                                      , Instance::PlacementStatus
+                                          ((Instance::PlacementStatus::Code)hdbInstance._placementStatus)
+                                      , false  // The snapshot hierarchy is acyclic.
+                                      );
+    }
+
+    for ( uint32_t i=record._firstNet ; i<record._firstNet+record._nbNets ; ++i ) {
+      const HdbNet& hdbNet = nets[i];
+      Net*          net    = cell->getNet( _getName(hdbNet._name) );
+
+      if (not net and (hdbNet._flags & HdbNetDeep)) {
+        Net* rootNet = (hdbNet._rootNet < i) ? _nets[hdbNet._rootNet] : NULL;
+        Path path    = _getPath( hdbNet._rootPath );
+        if (rootNet and not path.isEmpty()) {
+          HyperNet hyperNet ( Occurrence(rootNet,path) );
+          net = DeepNet::create( hyperNet );
+        }
+      }
+      if (not net) net = Net::create( cell, _getName(hdbNet._name) );
+
+      net->setExternal ( hdbNet._flags & HdbNetExternal  );
+      net->setGlobal   ( hdbNet._flags & HdbNetGlobal    );
+      net->setAutomatic( hdbNet._flags & HdbNetAutomatic );
+      net->setType     ( Net::Type     ((Net::Type::Code     )hdbNet._type     ) );
+      net->setDirection( Net::Direction((Net::Direction::Code)hdbNet._direction) );
+      _nets[i] = net;
+    }
+
+    for ( uint32_t i=record._firstComponent ; i<record._firstComponent+record._nbComponents ; ++i ) {
+      _components[i] = _createComponent( i );
+      _resolveds [i] = true;
+    }
+
+    for ( uint32_t i=record._firstReference ; i<record._firstReference+record._nbReferences ; ++i ) {
+      Reference::create( cell
+                       , _getName(references[i]._name)
+                       , references[i]._x
+                       , references[i]._y
+                       , (Reference::Type)references[i]._type );
+    }
+  }
+
+
+  Component* HdbReader::_getComponent ( uint32_t index )
+  {
+    if (index >= _components.size()) return NULL;
+    if (not _resolveds[index]) {
+      _components[index] = _lookupComponent( index );
+      _resolveds [index] = true;
+    }
+    return _components[index];
+  }
+
+
+  Component* HdbReader::_lookupComponent ( uint32_t index )
+  {
+  // The component belongs to a Cell which was already in memory, find it
+  // back from its net and geometry.
+    const HdbComponent& record = _section<HdbComponent>( _header->_components )[ index ];
+
+    if (record._type == HdbPlug) {
+      Instance* instance  = (record._source < _instances.size()) ? _instances[record._source] : NULL;
+      Net*      masterNet = (record._target < _nets     .size()) ? _nets     [record._target] : NULL;
+      return (instance and masterNet) ? instance->getPlug(masterNet) : NULL;
+    }
+
+    Net* net = (record._net < _nets.size()) ? _nets[record._net] : NULL;
+    if (not net or (record._layer == HdbNone)) return NULL;
+
+    const Layer* layer = _getLayer( record._layer );
+    for ( Component* component : net->getComponents() ) {
+      if (component->getLayer() != layer) continue;
+
+      switch ( record._type ) {
+        case HdbContact:
+        case HdbPin: {
+          Contact* contact = dynamic_cast<Contact*>( component );
+          if ( contact
+             and ((record._type == HdbPin) == (dynamic_cast<Pin*>(contact) != NULL))
+             and (contact->getX() == record._values[0])
+             and (contact->getY() == record._values[1]) ) return contact;
+          break;
+        }
+        case HdbHorizontal: {
+          Horizontal* horizontal = dynamic_cast<Horizontal*>( component );
+          if ( horizontal
+             and (horizontal->getY      () == record._values[0])
+             and (horizontal->getSourceX() == record._values[4])
+             and (horizontal->getTargetX() == record._values[5]) ) return horizontal;
+          break;
+        }
+        case HdbVertical: {
+          Vertical* vertical = dynamic_cast<Vertical*>( component );
+          if ( vertical
+             and (vertical->getX      () == record._values[0])
+             and (vertical->getSourceY() == record._values[4])
+             and (vertical->getTargetY() == record._values[5]) ) return vertical;
+          break;
+        }
+        case HdbPad: {
+          Pad* pad = dynamic_cast<Pad*>( component );
+          if ( pad
+             and (pad->getBoundingBox() == Box( record._values[0], record._values[1]
+                                              , record._values[2], record._values[3] )) ) return pad;
+          break;
+        }
+      }
+    }
+    return NULL;
+  }
+
+
+  Component* HdbReader::_createComponent ( uint32_t index )
+  {
+    const HdbComponent& record    = _section<HdbComponent>( _header->_components )[ index ];
+    Net*                net       = (record._net < _nets.size()) ? _nets[record._net] : NULL;
+    Component*          component = NULL;
+
+    if ( (record._type != HdbPlug) and not net )
+      throw Error( "hdbParser(): Component %u has no net in \"%s\".", index, _path.c_str() );
+
+    switch ( record._type ) {
+      case HdbPlug: {
+        Instance* instance  = (record._source < _instances.size()) ? _instances[record._source] : NULL;
+        Net*      masterNet = (record._target < _nets     .size()) ? _nets     [record._target] : NULL;
+        Plug*     plug      = (instance and masterNet) ? instance->getPlug(masterNet) : NULL;
+        if (plug and net) plug->setNet( net );
+        component = plug;
+        break;
+      }
+      case HdbContact: {
+        Component* anchor = (record._source < index) ? _getComponent(record._source) : NULL;
+        if (anchor)
+          component = Contact::create( anchor
+                                     , _getLayer(record._layer)
+                                     , record._values[2]
+                                     , record._values[3]
+                                     , record._values[4]
+                                     , record._values[5] );
+        else
+          component = Contact::create( net
+                                     , _getLayer(record._layer)
+                                     , record._values[0]
+                                     , record._values[1]
+                                     , record._values[4]
+                                     , record._values[5] );
+        break;
+      }
+      case HdbPin:
+        component = Pin::create( net
+                               , _getName(record._name)
+                               , Pin::AccessDirection((Pin::AccessDirection::Code)(record._extra & 0xff))
+                               , Pin::PlacementStatus((Pin::PlacementStatus::Code)(record._extra >> 8))
+                               , _getLayer(record._layer)
+                               , record._values[0]
+                               , record._values[1]
+                               , record._values[2]
+                               , record._values[3] );
+        break;
+      case HdbHorizontal:
+      case HdbVertical: {
+        Component* source = (record._source < index) ? _getComponent(record._source) : NULL;
+        Component* target = (record._target < index) ? _getComponent(record._target) : NULL;
+        Segment*   segment;
+
+      // Segments are created unhooked, with relative coordinates only for
+      // the restored hooks, then attached.
+        if (record._type == HdbHorizontal)
+          segment = Horizontal::create( net
+                                      , _getLayer(record._layer)
+                                      , record._values[0]
+                                      , record._values[1]
+                                      , record._values[ (source) ? 2 : 4 ]
+                                      , record._values[ (target) ? 3 : 5 ] );
+        else
+          segment = Vertical::create( net
+                                    , _getLayer(record._layer)
+                                    , record._values[0]
+                                    , record._values[1]
+                                    , record._values[ (source) ? 2 : 4 ]
+                                    , record._values[ (target) ? 3 : 5 ] );
+
+        if (source) segment->getSourceHook()->attach( source->getBodyHook() );
+        if (target) segment->getTargetHook()->attach( target->getBodyHook() );
+        component = segment;
+        break;
+      }
+      case HdbPad:
+        component = Pad::create( net
+                               , _getLayer(record._layer)
+                               , Box( record._values[0], record._values[1]
+                                    , record._values[2], record._values[3] ) );
+        break;
+      case HdbRoutingPad: {
+        Path       path   = _getPath( record._source );
+        Component* entity = _getComponent( record._target );
+        if (not entity) {
+          cerr << Warning( "hdbParser(): Cannot restore the occurrence of a RoutingPad of <%s> in \"%s\"."
+                         , getString(net->getName()).c_str(), _path.c_str() ) << endl;
+          break;
+        }
+
+        if (dynamic_cast<Plug*>(entity) or dynamic_cast<Contact*>(entity)) {
+          component = RoutingPad::create( net, Occurrence(entity,path) );
+        } else if (not path.isEmpty()) {
+          Plug* plug = path.getTailInstance()->getPlug( entity->getNet() );
+          if (plug) {
+            RoutingPad* routingPad = RoutingPad::create( net, Occurrence(plug,path.getHeadPath()) );
+            routingPad->setExternalComponent( entity );
+            component = routingPad;
+          }
+        }
+        if (not component)
+          cerr << Warning( "hdbParser(): Invalid occurrence for a RoutingPad of <%s> in \"%s\"."
+                         , getString(net->getName()).c_str(), _path.c_str() ) << endl;
+        break;
+      }
+      default:
+        throw Error( "hdbParser(): Component %u has unknown type %u in \"%s\"."
+                   , index, record._type, _path.c_str() );
+    }
+
+    if (component and (record._flags & HdbExternal))
+      NetExternalComponents::setExternal( component );
+
+    return component;
+  }
+
+
+  void  HdbReader::load ( const string& path, Cell* topCell )
+  {
+    if (not topCell) throw Error( "hdbParser(): Cell argument is NULL." );
+
+    _open( path );
+
+    UpdateSession::open();
+
+    bool  materializationState = Go::autoMaterializationIsDisabled();
+    Go::disableAutoMaterialization();
+
+    try {
+      for ( uint32_t icell=0 ; icell<_cells.size() ; ++icell ) {
+        _cells[icell] = _getCell( icell, topCell );
+        if (_builts[icell]) _buildCell( icell );
+        else                _bindCell ( icell );
+        if (icell == _header->_topCell) break;
+      }
+    } catch ( ... ) {
+      Go::enableAutoMaterialization();
+      UpdateSession::close();
+      if (materializationState) Go::disableAutoMaterialization();
+      _close();
+      throw;
+    }
+
+  // Build the QuadTrees once every component is created.
+    Go::enableAutoMaterialization();
+    for ( uint32_t icell=0 ; icell<_cells.size() ; ++icell ) {
+      if (_builts[icell]) _cells[icell]->materialize();
+    }
+
+    UpdateSession::close();
+
+    if (materializationState) Go::disableAutoMaterialization();
+    _close();
+  }
+
+
+} // Anonymous namespace.
+
+
+namespace CRL {
+
+
+  void  hdbParser ( const string cellPath, Cell* cell )
+  {
+    cmess2 << "     " << tab << "+ " << cellPath << endl;
+
+    HdbReader reader ( AllianceFramework::get() );
+    reader.load( cellPath, cell );
+  }
+
+
+} // CRL namespace.
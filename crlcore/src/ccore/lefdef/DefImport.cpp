@@ -17,6 +17,9 @@
 #include  <cstdio>
 #include  <cstring>
 #include  <memory>
+#include  <thread>
+#include  <atomic>
+#include  <unordered_map>
 #if HAVE_LEFDEF
 #  include  "lefrReader.hpp"
 #  include  "defrReader.hpp"
@@ -26,6 +29,8 @@
 #include  "hurricane/DataBase.h"
 #include  "hurricane/Technology.h"
 #include  "hurricane/Net.h"
+#include  "hurricane/Plug.h"
+#include  "hurricane/Instance.h"
 #include  "hurricane/NetExternalComponents.h"
 #include  "hurricane/Contact.h"
 #include  "hurricane/Horizontal.h"
@@ -62,6 +67,65 @@ namespace {
   }
 
 
+// -------------------------------------------------------------------
+// DEF import stages.
+//
+// 1. The (serial) Si2 DEF reader still tokenizes and parses the whole
+//    file, its callbacks only fill flat records (no database object is
+//    created while reading).
+// 2. The records are resolved: names are translated and placements
+//    computed in parallel, master Cells are looked up once per model
+//    and Plugs are found in parallel through read-only look-up tables.
+// 3. The database objects are created serially (Hurricane is not
+//    thread-safe) in one batch, with the auto-materialization disabled.
+//    The Cell is materialized once at the end.
+
+
+  struct DefComponentRecord {
+    string                           _id;
+    string                           _model;
+    int                              _x;
+    int                              _y;
+    int                              _orient;
+    Instance::PlacementStatus::Code  _status;
+    Cell*                            _masterCell;
+    Transformation                   _placement;
+    Instance*                        _instance;
+  };
+
+
+  struct DefPinRecord {
+    string  _name;
+    string  _net;
+  };
+
+
+  struct DefConnectionRecord {
+    string  _instance;
+    string  _pin;
+  };
+
+
+  struct DefPathRecord {
+    int     _type;                    // DEFIPATH_* code.
+    string  _name;                    // Layer or via name.
+    int     _x;                       // Width for DEFIPATH_WIDTH.
+    int     _y;
+  };
+
+
+// One DEF path (ROUTED or NEW): the wire state restarts with each one.
+  typedef  vector<DefPathRecord>  DefPath;
+
+
+  struct DefNetRecord {
+    string                       _name;
+    vector<DefConnectionRecord>  _connections;
+    vector<DefPath>              _wiring;
+    vector<Plug*>                _plugs;
+  };
+
+
   class DefParser {
     public:
       static AllianceFramework* getFramework             ();
@@ -83,7 +147,6 @@ namespace {
       inline size_t             getPitchs                () const;
       inline size_t             getSlices                () const;
       inline const Box&         getFitOnCellsDieArea     () const;
-      inline Net*               getPrebuildNet           () const;
       inline string             getBusBits               () const;
              Net*               lookupNet                ( const string& );
       inline vector<string>&    getErrors                ();
@@ -92,22 +155,28 @@ namespace {
       inline void               clearErrors              ();
       inline void               setPitchs                ( size_t );
       inline void               setSlices                ( size_t );
-      inline void               setPrebuildNet           ( Net* );
       inline void               setBusBits               ( string );
              void               addNetLookup             ( const string& netName, Net* );
-             void               toHurricaneName          ( string& );
+             void               toHurricaneName          ( string& ) const;
       inline void               mergeToFitOnCellsDieArea ( const Box& );
     private:                                         
       static int                _busBitCbk               ( defrCallbackType_e, const char*   , defiUserData );
       static int                _designEndCbk            ( defrCallbackType_e, void*         , defiUserData );
       static int                _dieAreaCbk              ( defrCallbackType_e, defiBox*      , defiUserData );
+      static int                _pinStartCbk             ( defrCallbackType_e, int           , defiUserData );
       static int                _pinCbk                  ( defrCallbackType_e, defiPin*      , defiUserData );
+      static int                _componentStartCbk       ( defrCallbackType_e, int           , defiUserData );
       static int                _componentCbk            ( defrCallbackType_e, defiComponent*, defiUserData );
-      static int                _componentEndCbk         ( defrCallbackType_e, void*         , defiUserData );
+      static int                _netStartCbk             ( defrCallbackType_e, int           , defiUserData );
       static int                _netCbk                  ( defrCallbackType_e, defiNet*      , defiUserData );
-      static int                _netEndCbk               ( defrCallbackType_e, void*         , defiUserData );
       static int                _pathCbk                 ( defrCallbackType_e, defiPath*     , defiUserData );
              Cell*              _createCell              ( const char* name );
+             void               _commit                  ();
+             int                _commitComponents        ();
+             void               _commitPins              ();
+             int                _commitNets              ();
+             void               _commitWiring            ( Net*, const vector<DefPath>& );
+             void               _commitPath              ( Net*, const DefPath& );
     private:
       static double             _defUnits;
       static AllianceFramework* _framework;
@@ -119,9 +188,12 @@ namespace {
              size_t             _pitchs;
              size_t             _slices;
              Box                _fitOnCellsDieArea;
-             Net*               _prebuildNet;
              map<string,Net*>   _netsLookup;
              vector<string>     _errors;
+             vector<DefComponentRecord>  _components;
+             vector<DefPinRecord>        _pins;
+             vector<DefNetRecord>        _nets;
+             vector<DefPath>             _wiring;
   };
 
 
@@ -129,6 +201,40 @@ namespace {
   AllianceFramework* DefParser::_framework = NULL;
 
 
+// Run function(ithread,begin,end) on consecutive chunks of [0:size[,
+// spread over all the cores. A chunk always starts on a multiple of
+// ChunkSize, so begin/ChunkSize numbers it.
+
+  const size_t  ChunkSize = 4096;
+
+
+  template<typename Function>
+  void  parallelFor ( size_t size, unsigned int threads, Function function )
+  {
+    if ( (threads < 2) or (size <= ChunkSize) ) {
+      if (size) function( 0, 0, size );
+      return;
+    }
+
+    std::atomic<size_t> next ( 0 );
+    auto worker = [&] ( unsigned int ithread ) {
+      for ( size_t begin=next.fetch_add(ChunkSize) ; begin<size ; begin=next.fetch_add(ChunkSize) )
+        function( ithread, begin, std::min(begin+ChunkSize,size) );
+    };
+
+    vector<std::thread> workers;
+    for ( unsigned int i=0 ; i<threads ; ++i ) workers.push_back( std::thread(worker,i) );
+    for ( size_t       i=0 ; i<workers.size() ; ++i ) workers[i].join();
+  }
+
+
+  unsigned int  getThreads ()
+  {
+    unsigned int threads = std::thread::hardware_concurrency();
+    return (threads) ? threads : 1;
+  }
+
+
   DefParser::DefParser ( string& file, AllianceLibrary* library, unsigned int flags )
     : _file             (file)
     , _flags            (flags)
@@ -138,20 +244,24 @@ namespace {
     , _pitchs           (0)
     , _slices           (0)
     , _fitOnCellsDieArea()
-    , _prebuildNet      (NULL)
     , _netsLookup       ()
     , _errors           ()
+    , _components       ()
+    , _pins             ()
+    , _nets             ()
+    , _wiring           ()
   {
-    defrInit               ();
-    defrSetBusBitCbk       ( _busBitCbk );
-    defrSetDesignEndCbk    ( _designEndCbk );
-    defrSetDieAreaCbk      ( _dieAreaCbk );
-    defrSetPinCbk          ( _pinCbk );
-    defrSetComponentCbk    ( _componentCbk );
-    defrSetComponentEndCbk ( _componentEndCbk );
-    defrSetNetCbk          ( _netCbk );
-    defrSetNetEndCbk       ( _netEndCbk );
-    defrSetPathCbk         ( _pathCbk );
+    defrInit                 ();
+    defrSetBusBitCbk         ( _busBitCbk );
+    defrSetDesignEndCbk      ( _designEndCbk );
+    defrSetDieAreaCbk        ( _dieAreaCbk );
+    defrSetStartPinsCbk      ( _pinStartCbk );
+    defrSetPinCbk            ( _pinCbk );
+    defrSetComponentStartCbk ( _componentStartCbk );
+    defrSetComponentCbk      ( _componentCbk );
+    defrSetNetStartCbk       ( _netStartCbk );
+    defrSetNetCbk            ( _netCbk );
+    defrSetPathCbk           ( _pathCbk );
   }
 
 
@@ -171,13 +281,11 @@ namespace {
   inline size_t             DefParser::getPitchs                () const { return _pitchs; }
   inline size_t             DefParser::getSlices                () const { return _slices; }
   inline const Box&         DefParser::getFitOnCellsDieArea     () const { return _fitOnCellsDieArea; }
-  inline Net*               DefParser::getPrebuildNet           () const { return _prebuildNet; }
   inline vector<string>&    DefParser::getErrors                () { return _errors; }
   inline void               DefParser::pushError                ( const string& error ) { _errors.push_back(error); }
   inline void               DefParser::clearErrors              () { return _errors.clear(); }
   inline void               DefParser::setPitchs                ( size_t pitchs ) { _pitchs=pitchs; }
   inline void               DefParser::setSlices                ( size_t slices ) { _slices=slices; }
-  inline void               DefParser::setPrebuildNet           ( Net* net ) { _prebuildNet=net; }
   inline void               DefParser::setBusBits               ( string busbits ) { _busBits = busbits; }
   inline void               DefParser::mergeToFitOnCellsDieArea ( const Box& box ) { _fitOnCellsDieArea.merge(box); }
 
@@ -201,7 +309,7 @@ namespace {
   }
 
 
-  void  DefParser::toHurricaneName ( string& defName )
+  void  DefParser::toHurricaneName ( string& defName ) const
   {
     if (_busBits != "()") {
       if (defName[defName.size()-1] == _busBits[1]) {
@@ -292,13 +400,7 @@ namespace {
   int  DefParser::_designEndCbk ( defrCallbackType_e c, void*, lefiUserData ud )
   {
     DefParser* parser = (DefParser*)ud;
-
-    if (      (parser->getFlags() & DefImport::FitAbOnCells)
-       and not parser->getFitOnCellsDieArea().isEmpty() ) {
-      parser->getCell()->setAbutmentBox ( parser->getFitOnCellsDieArea() );
-    }
-      
-    return 0;
+    return parser->flushErrors ();
   }
 
 
@@ -316,23 +418,30 @@ namespace {
   }
 
 
+  int  DefParser::_pinStartCbk ( defrCallbackType_e c, int number, lefiUserData ud )
+  {
+    DefParser* parser = (DefParser*)ud;
+    parser->_pins.reserve ( number );
+    return 0;
+  }
+
+
   int  DefParser::_pinCbk ( defrCallbackType_e c, defiPin* pin, lefiUserData ud )
   {
     DefParser* parser = (DefParser*)ud;
 
-  //cout << "     - Pin " << pin->pinName() << ":" << pin->netName() << endl;
+    parser->_pins.push_back ( DefPinRecord() );
+    parser->_pins.back()._name = pin->pinName();
+    parser->_pins.back()._net  = pin->netName();
 
-    string netName = pin->netName();
-    parser->toHurricaneName( netName );
+    return 0;
+  }
 
-    Net* hnet = parser->getCell()->getNet ( netName );
-    if ( hnet == NULL ) {
-      hnet = Net::create ( parser->getCell(), netName );
-      parser->addNetLookup ( netName, hnet );
-      if ( netName.compare(pin->pinName()) != 0 )
-         parser->addNetLookup ( pin->pinName(), hnet );
-    }
 
+  int  DefParser::_componentStartCbk ( defrCallbackType_e c, int number, lefiUserData ud )
+  {
+    DefParser* parser = (DefParser*)ud;
+    parser->_components.reserve ( number );
     return 0;
   }
 
@@ -341,177 +450,304 @@ namespace {
   {
     DefParser* parser = (DefParser*)ud;
 
-    string componentName = component->name();
-    string componentId   = component->id();
+    parser->_components.push_back ( DefComponentRecord() );
+    DefComponentRecord& record = parser->_components.back();
 
-    Cell* masterCell = DefParser::getFramework()->getCell ( componentName, Catalog::State::Views );
-    if ( masterCell == NULL ) {
-      ostringstream message;
-      message << "Unknown model/Cell (LEF MACRO) " << componentName << " in <%s>.";
-      parser->pushError ( message.str() );
-      return 0;
-    }
+    record._id         = component->id();
+    record._model      = component->name();
+    record._x          = 0;
+    record._y          = 0;
+    record._orient     = 0;
+    record._status     = Instance::PlacementStatus::UNPLACED;
+    record._masterCell = NULL;
+    record._instance   = NULL;
 
-    Transformation            placement;
-    Instance::PlacementStatus state     ( Instance::PlacementStatus::UNPLACED );
     if ( component->isPlaced() or component->isFixed() ) {
-      state = (component->isPlaced()) ? Instance::PlacementStatus::PLACED
-                                      : Instance::PlacementStatus::FIXED;
-
-      placement = getTransformation ( masterCell->getAbutmentBox()
-                                    , fromDefUnits(component->placementX())
-                                    , fromDefUnits(component->placementY())
-                                    , fromDefOrientation ( component->placementOrient() )
-                                    );
-    }
-
-    Instance* instance = Instance::create ( parser->getCell()
-                                          , componentId
-                                          , masterCell
-                                          , placement
-                                          , state
-                                          );
-    if ( state != Instance::PlacementStatus::UNPLACED ) {
-      parser->mergeToFitOnCellsDieArea ( instance->getAbutmentBox() );
+      record._status = (component->isPlaced()) ? Instance::PlacementStatus::PLACED
+                                               : Instance::PlacementStatus::FIXED;
+      record._x      = component->placementX();
+      record._y      = component->placementY();
+      record._orient = component->placementOrient();
     }
 
     return 0;
   }
 
 
-  int  DefParser::_componentEndCbk ( defrCallbackType_e c, void*, lefiUserData ud )
+  int  DefParser::_netStartCbk ( defrCallbackType_e c, int number, lefiUserData ud )
   {
     DefParser* parser = (DefParser*)ud;
-    return parser->flushErrors ();
+    parser->_nets.reserve ( number );
+    return 0;
   }
 
 
   int  DefParser::_netCbk ( defrCallbackType_e c, defiNet* net, lefiUserData ud )
   {
-    static size_t netCount = 0;
-
     DefParser* parser = (DefParser*)ud;
 
-  //cout << "     - Net " << net->name() << endl;
+    parser->_nets.push_back ( DefNetRecord() );
+    DefNetRecord& record = parser->_nets.back();
 
-    string name = net->name();
-    parser->toHurricaneName( name );
-    
-    Net* hnet = parser->lookupNet ( name );
-    if ( hnet == NULL )
-      hnet = Net::create ( parser->getCell(), name );
+    record._name = net->name();
+    record._wiring.swap ( parser->_wiring );
 
-    if ( parser->getPrebuildNet() != NULL ) {
-      Name prebuildAlias = parser->getPrebuildNet()->getName();
-      hnet->merge ( parser->getPrebuildNet() );
-      hnet->removeAlias ( prebuildAlias );
-      parser->setPrebuildNet ( NULL );
-    }
+    int numConnections = net->numConnections();
+    record._connections.reserve ( numConnections );
+    for ( int icon=0 ; icon<numConnections ; ++icon ) {
+    // Connect to an external pin.
+      if ( strcmp(net->instance(icon),"PIN") == 0 ) continue;
 
-    if (name.size() > 78) {
-      name.erase ( 0, name.size()-75 );
-      name.insert( 0, 3, '.' );
-    }
-    name.insert( 0, "<" );
-    name.insert( name.size(), ">" );
-    if (name.size() < 80) name.insert( name.size(), 80-name.size(), ' ' );
-
-    if (tty::enabled()) {
-      cmess2 << "          "
-             << tty::bold  << setw(7)  << setfill('0') << ++netCount << ":" << setfill(' ')
-             << tty::reset << setw(80) << name << tty::cr;
-      cmess2.flush ();
+      record._connections.push_back ( DefConnectionRecord() );
+      record._connections.back()._instance = net->instance(icon);
+      record._connections.back()._pin      = net->pin(icon);
     }
 
-    int numConnections = net->numConnections();
-    for ( int icon=0 ; icon<numConnections ; ++icon ) {
-      string instanceName = net->instance(icon);
-      string pinName      = net->pin(icon);
+    return 0;
+  }
 
-    // Connect to an external pin.
-      if ( instanceName.compare("PIN") == 0 ) continue;
-      parser->toHurricaneName( pinName );
-
-      Instance* instance = parser->getCell()->getInstance ( instanceName );
-      if ( instance == NULL ) {
-        ostringstream message;
-        message << "Unknown instance (DEF COMPONENT) <" << instanceName << "> in <%s>.";
-        parser->pushError ( message.str() );
-        continue;
+
+// Called before the net callback, for each path of the net. The paths
+// are kept apart until the net callback takes them.
+
+  int  DefParser::_pathCbk ( defrCallbackType_e c, defiPath* path, lefiUserData ud )
+  {
+    DefParser*    parser      = (DefParser*)ud;
+    DefPathRecord element;
+    int           elementType;
+    int           defext;
+
+    parser->_wiring.push_back ( DefPath() );
+    DefPath& elements = parser->_wiring.back();
+
+    path->initTraverse ();
+    while ( (elementType = path->next()) != DEFIPATH_DONE ) {
+      element._type = elementType;
+      element._name.clear();
+      element._x    = 0;
+      element._y    = 0;
+
+      switch ( elementType ) {
+        case DEFIPATH_LAYER:      element._name = path->getLayer(); break;
+        case DEFIPATH_WIDTH:      element._x    = path->getWidth(); break;
+        case DEFIPATH_POINT:      path->getPoint ( &element._x, &element._y ); break;
+        case DEFIPATH_FLUSHPOINT: path->getFlushPoint ( &element._x, &element._y, &defext ); break;
+        case DEFIPATH_VIA:        element._name = path->getVia(); break;
+        default: continue;
       }
+      elements.push_back ( element );
+    }
+
+    return 0;
+  }
+
 
-      Net* masterNet = instance->getMasterCell()->getNet ( pinName );
-      if ( masterNet == NULL ) {
-        ostringstream message;
-        message << "Unknown PIN <" << pinName << "> in instance <"
-                << instanceName << "> (LEF MACRO) in <%s>.";
-        parser->pushError ( message.str() );
-        continue;
+  int  DefParser::_commitComponents ()
+  {
+    unsigned int threads = getThreads();
+
+  // Master Cells are looked up (and possibly loaded) once per model.
+    map<string,Cell*> models;
+    for ( size_t i=0 ; i<_components.size() ; ++i ) {
+      DefComponentRecord& record = _components[i];
+
+      map<string,Cell*>::iterator imodel = models.find( record._model );
+      if ( imodel == models.end() ) {
+        Cell* masterCell = DefParser::getFramework()->getCell ( record._model, Catalog::State::Views );
+        if ( masterCell == NULL ) {
+          ostringstream message;
+          message << "Unknown model/Cell (LEF MACRO) " << record._model << " in <%s>.";
+          pushError ( message.str() );
+        }
+        imodel = models.insert( make_pair(record._model,masterCell) ).first;
       }
+      record._masterCell = imodel->second;
+    }
 
-      instance->getPlug(masterNet)->setNet(hnet);
+  // Placements only read the master Cells abutment boxes.
+    vector<Box> fitBoxes ( threads );
+    parallelFor ( _components.size(), threads
+                , [&] ( unsigned int ithread, size_t begin, size_t end ) {
+                    for ( size_t i=begin ; i<end ; ++i ) {
+                      DefComponentRecord& record = _components[i];
+                      if ( not record._masterCell
+                         or (record._status == Instance::PlacementStatus::UNPLACED) ) continue;
+
+                      const Box& abox = record._masterCell->getAbutmentBox();
+                      record._placement = getTransformation ( abox
+                                                            , fromDefUnits(record._x)
+                                                            , fromDefUnits(record._y)
+                                                            , fromDefOrientation(record._orient)
+                                                            );
+                      fitBoxes[ithread].merge( record._placement.getBox(abox) );
+                    }
+                  } );
+    for ( size_t i=0 ; i<fitBoxes.size() ; ++i ) mergeToFitOnCellsDieArea( fitBoxes[i] );
+
+    for ( size_t i=0 ; i<_components.size() ; ++i ) {
+      DefComponentRecord& record = _components[i];
+      if ( not record._masterCell ) continue;
+
+      record._instance = Instance::create ( _cell
+                                          , record._id
+                                          , record._masterCell
+                                          , record._placement
+                                          , record._status
+                                          );
     }
 
-    return 0;
+    cmess2 << "     - " << _components.size() << " components." << endl;
+    return flushErrors ();
   }
 
 
-  int  DefParser::_netEndCbk ( defrCallbackType_e c, void*, lefiUserData ud )
+  void  DefParser::_commitPins ()
   {
-    DefParser* parser = (DefParser*)ud;
-    if (tty::enabled()) cmess2 << endl;
-    return parser->flushErrors ();
+    for ( size_t i=0 ; i<_pins.size() ; ++i ) {
+      string netName = _pins[i]._net;
+      toHurricaneName( netName );
+
+      Net* hnet = _cell->getNet ( netName );
+      if ( hnet == NULL ) {
+        hnet = Net::create ( _cell, netName );
+        addNetLookup ( netName, hnet );
+        if ( netName.compare(_pins[i]._name) != 0 )
+           addNetLookup ( _pins[i]._name, hnet );
+      }
+    }
   }
 
 
-  int  DefParser::_pathCbk ( defrCallbackType_e c, defiPath* path, lefiUserData ud )
+  int  DefParser::_commitNets ()
   {
+    unsigned int threads = getThreads();
+
+  // Read-only look-up tables for the parallel Plug resolution.
+    unordered_map<string,Instance*> instances;
+    instances.reserve ( _components.size() );
+    for ( size_t i=0 ; i<_components.size() ; ++i ) {
+      if (_components[i]._instance)
+        instances.insert( make_pair(_components[i]._id,_components[i]._instance) );
+    }
 
-    DefParser*  parser       = (DefParser*)ud;
-    Technology* technology   = DataBase::getDB()->getTechnology();
-    Net*        hnet         = parser->getPrebuildNet();
+    map< Cell*, unordered_map<string,Net*> >  masterNets;
+    for ( size_t i=0 ; i<_components.size() ; ++i ) {
+      Cell* masterCell = _components[i]._masterCell;
+      if ( not masterCell or (masterNets.find(masterCell) != masterNets.end()) ) continue;
+
+      unordered_map<string,Net*>& nets = masterNets[ masterCell ];
+      forEach ( Net*, inet, masterCell->getNets() )
+        nets.insert( make_pair(getString(inet->getName()),*inet) );
+
+    // Like Cell::getNet(), also resolve the aliases, after the main names.
+      forEach ( Net*, inet, masterCell->getNets() ) {
+        forEach ( NetAliasHook*, ialias, inet->getAliases() )
+          nets.insert( make_pair(getString(ialias->getName()),*inet) );
+      }
+    }
 
-    if ( hnet == NULL ) {
-      hnet = Net::create ( parser->getCell(), "__prebuild__" );
-      parser->setPrebuildNet ( hnet );
+  // Errors are kept per chunk, to be reported in the nets order.
+    vector< vector<string> > errors ( (_nets.size()+ChunkSize-1) / ChunkSize );
+    parallelFor ( _nets.size(), threads
+                , [&] ( unsigned int, size_t begin, size_t end ) {
+                    for ( size_t i=begin ; i<end ; ++i ) {
+                      DefNetRecord& record = _nets[i];
+                      toHurricaneName( record._name );
+
+                      record._plugs.reserve( record._connections.size() );
+                      for ( size_t icon=0 ; icon<record._connections.size() ; ++icon ) {
+                        DefConnectionRecord& connection = record._connections[icon];
+                        toHurricaneName( connection._pin );
+
+                        unordered_map<string,Instance*>::const_iterator iinstance
+                          = instances.find( connection._instance );
+                        if ( iinstance == instances.end() ) {
+                          ostringstream message;
+                          message << "Unknown instance (DEF COMPONENT) <" << connection._instance << "> in <%s>.";
+                          errors[begin/ChunkSize].push_back( message.str() );
+                          continue;
+                        }
+
+                        Instance*                                  instance = iinstance->second;
+                        const unordered_map<string,Net*>&          nets     = masterNets.find( instance->getMasterCell() )->second;
+                        unordered_map<string,Net*>::const_iterator inet     = nets.find( connection._pin );
+                        if ( inet == nets.end() ) {
+                          ostringstream message;
+                          message << "Unknown PIN <" << connection._pin << "> in instance <"
+                                  << connection._instance << "> (LEF MACRO) in <%s>.";
+                          errors[begin/ChunkSize].push_back( message.str() );
+                          continue;
+                        }
+
+                        record._plugs.push_back( instance->getPlug(inet->second) );
+                      }
+                    }
+                  } );
+    for ( size_t i=0 ; i<errors.size() ; ++i )
+      _errors.insert( _errors.end(), errors[i].begin(), errors[i].end() );
+
+    for ( size_t i=0 ; i<_nets.size() ; ++i ) {
+      DefNetRecord& record = _nets[i];
+
+      Net* hnet = lookupNet ( record._name );
+      if ( hnet == NULL )
+        hnet = Net::create ( _cell, record._name );
+
+      for ( size_t iplug=0 ; iplug<record._plugs.size() ; ++iplug )
+        record._plugs[iplug]->setNet( hnet );
+
+      _commitWiring ( hnet, record._wiring );
     }
 
+    cmess2 << "     - " << _nets.size() << " nets." << endl;
+    return flushErrors ();
+  }
+
+
+  void  DefParser::_commitWiring ( Net* hnet, const vector<DefPath>& wiring )
+  {
+    for ( size_t i=0 ; i<wiring.size() ; ++i ) _commitPath ( hnet, wiring[i] );
+  }
+
+
+  void  DefParser::_commitPath ( Net* hnet, const DefPath& path )
+  {
+    if ( path.empty() ) return;
+
+    Technology*  technology  = DataBase::getDB()->getTechnology();
     Contact*     source      = NULL;
     Contact*     target      = NULL;
     const Layer* layer       = NULL;
     const Layer* viaLayer    = NULL;
     DbU::Unit    width       = DbU::lambda(2.0);
-    DbU::Unit    x, y;
-    int          defx, defy, defext;
-    int          elementType;
+    DbU::Unit    x           = 0;
+    DbU::Unit    y           = 0;
 
-    path->initTraverse ();
-    while ( (elementType = path->next()) != DEFIPATH_DONE ) {
+    for ( size_t i=0 ; i<path.size() ; ++i ) {
+      const DefPathRecord& element = path[i];
       bool createSegment = false;
       bool createVia     = false;
 
-      switch ( elementType ) {
+      switch ( element._type ) {
         case DEFIPATH_LAYER:
-          layer = technology->getLayer ( path->getLayer() );
+          layer = technology->getLayer ( element._name );
           break;
         case DEFIPATH_WIDTH:
-          width = fromDefUnits(path->getWidth());
+          width = fromDefUnits(element._x);
           break;
         case DEFIPATH_POINT:
-          path->getPoint ( &defx, &defy );
-          x = fromDefUnits ( defx );
-          y = fromDefUnits ( defy );
+          x = fromDefUnits ( element._x );
+          y = fromDefUnits ( element._y );
           createSegment = true;
           break;
         case DEFIPATH_FLUSHPOINT:
-          path->getFlushPoint ( &defx, &defy, &defext );
-          x = fromDefUnits ( defx );
-          y = fromDefUnits ( defy );
+          x = fromDefUnits ( element._x );
+          y = fromDefUnits ( element._y );
           target = NULL;
           createSegment = true;
           break;
         case DEFIPATH_VIA:
-          viaLayer  = technology->getLayer ( path->getVia() );
+          viaLayer  = technology->getLayer ( element._name );
           createVia = true;
           break;
       }
@@ -527,7 +763,7 @@ namespace {
           } else {
             ostringstream message;
             message << "Non-manhattan segment in net <" << hnet->getName() << ">.";
-            parser->pushError ( message.str() );
+            pushError ( message.str() );
           }
         }
       }
@@ -540,8 +776,31 @@ namespace {
         }
       }
     }
+  }
 
-    return 0;
+
+  void  DefParser::_commit ()
+  {
+    bool materializationState = Go::autoMaterializationIsDisabled ();
+    Go::disableAutoMaterialization ();
+
+  // As when the Cell was built while parsing, errors in the components
+  // stop the load before the pins and nets.
+    if (_commitComponents() == 0) {
+      _commitPins ();
+      _commitNets ();
+    }
+
+    if ( (getFlags() & DefImport::FitAbOnCells) and not getFitOnCellsDieArea().isEmpty() )
+      _cell->setAbutmentBox ( getFitOnCellsDieArea() );
+
+    Go::enableAutoMaterialization ();
+    _cell->materialize ();
+    if (materializationState) Go::disableAutoMaterialization ();
+
+    _components.clear ();
+    _pins      .clear ();
+    _nets      .clear ();
   }
 
 
@@ -569,6 +828,8 @@ namespace {
 
     fclose ( defStream );
 
+    parser->_commit ();
+
     return parser->getCell();
   }
 
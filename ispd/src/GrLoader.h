@@ -0,0 +1,134 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC/LIP6 2008-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |    I s p d   G l o b a l   r o u t i n g  -  M a i n   G U I    |
+// |                                                                 |
+// |  Author      :                       Damien Dupuis              |
+// |  E-mail      :               Damien.Dupuis@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :       "./GrLoader.h"                             |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  ISPD_GR_LOADER_H
+#define  ISPD_GR_LOADER_H
+
+#include  <string>
+#include  <vector>
+#include  "hurricane/DbU.h"
+
+namespace Hurricane {
+  class Cell;
+  class Layer;
+  class Net;
+  class RoutingPad;
+}
+
+namespace Knik {
+  class KnikEngine;
+}
+
+
+namespace Ispd {
+
+  using std::string;
+  using std::vector;
+  using Hurricane::DbU;
+  using Hurricane::Cell;
+  using Hurricane::Layer;
+  using Hurricane::Net;
+  using Hurricane::RoutingPad;
+  using Knik::KnikEngine;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Ispd::GrLoader".
+//
+// Loader for the ISPD'07/'08 global routing benchmarks (".gr") and
+// their solutions. Creates the Cell, its KnikEngine and the routing
+// graph, then the nets (with their precongestion) and the obstacles.
+
+  class GrLoader {
+    public:
+      enum ParserState { StateGrid
+                       , StateVerti
+                       , StateHoriz
+                       , StateWidth
+                       , StateSpacing
+                       , StateVia
+                       , StateDim
+                       , StateNet
+                       , StateObs
+                       , StateEOF
+                       };
+      static const size_t  LineSize = 4096;
+    public:
+                          GrLoader          ( unsigned congestion    = 1
+                                            , unsigned precongestion = 2
+                                            , float    edgeCost      = 3.0 );
+             Cell*        load              ( const string& filePath, bool createRings=true );
+             void         loadSolution      ( const string& filePath );
+      inline Cell*        getCell           () const;
+      inline KnikEngine*  getKnik           () const;
+      inline unsigned     getNbNets         () const;
+      inline unsigned     getNbGCellsX      () const;
+      inline unsigned     getNbGCellsY      () const;
+    private:
+             void         _printWarning     ( const char* format, ... );
+             void         _printError       ( bool interrupt, const char* format, ... );
+             long         _getLong          ( const char* );
+             void         _parseGrid        ();
+             void         _parseVerti       ();
+             void         _parseHoriz       ();
+             void         _parseWidth       ();
+             void         _parseSpacing     ();
+             void         _parseVia         ();
+             void         _parseDim         ();
+             void         _parseNets        ();
+             void         _parseNet         ( Net*&, unsigned& nbPins );
+             void         _parseNode        ( Net*, RoutingPad*& firstRoutingPad );
+             void         _parseObs         ();
+             void         _parseObstacle    ();
+    private:
+      unsigned          _congestion;
+      unsigned          _precongestion;
+      float             _edgeCost;
+      Cell*             _cell;
+      KnikEngine*       _knik;
+      string            _filePath;
+      int               _parserState;
+      size_t            _lineNumber;
+      char              _rawLine[LineSize];
+      unsigned          _nbGCellsX;
+      unsigned          _nbGCellsY;
+      unsigned          _nbLayers;
+      DbU::Unit         _lowerLeftX;
+      DbU::Unit         _lowerLeftY;
+      DbU::Unit         _tileWidth;
+      DbU::Unit         _tileHeight;
+      vector<unsigned>  _vertiCap;
+      vector<unsigned>  _horizCap;
+      vector<unsigned>  _minWidth;
+      vector<unsigned>  _minSpacing;
+      vector<unsigned>  _viaSpacing;
+      unsigned          _nbNets;
+      unsigned          _nbObs;
+      Layer*            _layers[2];
+      bool              _createRings;
+  };
+
+
+  inline Cell*        GrLoader::getCell      () const { return _cell; }
+  inline KnikEngine*  GrLoader::getKnik      () const { return _knik; }
+  inline unsigned     GrLoader::getNbNets    () const { return _nbNets; }
+  inline unsigned     GrLoader::getNbGCellsX () const { return _nbGCellsX; }
+  inline unsigned     GrLoader::getNbGCellsY () const { return _nbGCellsY; }
+
+
+}  // Ispd namespace.
+
+#endif  // ISPD_GR_LOADER_H
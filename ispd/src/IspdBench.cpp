@@ -0,0 +1,687 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC/LIP6 2008-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |    I s p d   G l o b a l   r o u t i n g  -  B e n c h          |
+// |                                                                 |
+// |  Author      :                       Damien Dupuis              |
+// |  E-mail      :               Damien.Dupuis@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :       "./IspdBench.cpp"                          |
+// +-----------------------------------------------------------------+
+
+
+#include  <unistd.h>
+#include  <sys/types.h>
+#include  <sys/wait.h>
+#include  <sys/resource.h>
+#include  <cerrno>
+#include  <cstring>
+#include  <cstdlib>
+#include  <chrono>
+#include  <random>
+#include  <fstream>
+#include  <sstream>
+#include  <iomanip>
+#include  <algorithm>
+#include  <boost/program_options.hpp>
+#include  <boost/filesystem.hpp>
+namespace poptions = boost::program_options;
+namespace bfs      = boost::filesystem;
+
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "hurricane/Cell.h"
+#include "hurricane/UpdateSession.h"
+using namespace Hurricane;
+
+#include "crlcore/Utilities.h"
+#include "crlcore/AllianceFramework.h"
+using namespace CRL;
+
+#include "knik/KnikEngine.h"
+#include "knik/Graph.h"
+#include "knik/Edge.h"
+using namespace Knik;
+
+#include "GrLoader.h"
+using namespace Ispd;
+
+
+namespace {
+
+
+// -------------------------------------------------------------------
+// Benchmark results.
+//
+// Each benchmark is run in a forked process (so the peak RSS is its
+// own and a crash does not stop the suite). The child sends back this
+// plain structure through a pipe.
+
+  enum Stage { StageLoad=0, StageRoute, StageRipup, StageTotal, StageCount };
+
+  const char* StageNames[StageCount] = { "load", "route", "ripup", "total" };
+
+
+  struct BenchResult {
+    int                 _status;              // 0: Ok, 1: failed, 2: crashed.
+    unsigned            _gcellsX;
+    unsigned            _gcellsY;
+    unsigned            _nets;
+    unsigned            _iterations;
+    double              _times[StageCount];   // Wall time (s).
+    long                _peakRss;             // Kb.
+    unsigned long long  _totalOverflow;       // In tracks.
+    unsigned long long  _maxOverflow;
+    unsigned long long  _overflowedEdges;
+    unsigned long long  _wireLength;          // In GCell crossings.
+  };
+
+
+  struct Benchmark {
+    string       _name;
+    string       _path;                       // Without the ".gr" extension.
+    BenchResult  _result;
+  };
+
+
+  struct Tolerances {
+    double  _time;
+    double  _minTime;
+    double  _memory;
+    double  _wireLength;
+    double  _overflow;
+  };
+
+
+  class WallClock {
+    public:
+      inline         WallClock () : _start(std::chrono::steady_clock::now()) { }
+      inline double  elapsed   () const
+      { return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count(); }
+    private:
+      std::chrono::steady_clock::time_point  _start;
+  };
+
+
+// -------------------------------------------------------------------
+// Synthetic benchmark generation.
+//
+// Spec: "<cols>x<rows>:<nets>[:<capacity>[:<seed>]]". Most of the nets
+// are local (like in real placements), a few span the whole grid.
+// Only the raw generator output is used to draw (never the standard
+// distributions), so a given spec gives the same file on every system.
+
+  string  generateBenchmark ( const string& spec, const string& workDir )
+  {
+    unsigned  cols     = 0;
+    unsigned  rows     = 0;
+    unsigned  nbNets   = 0;
+    unsigned  capacity = 10;
+    unsigned  seed     = 1;
+
+    if (   (sscanf(spec.c_str(), "%ux%u:%u:%u:%u", &cols, &rows, &nbNets, &capacity, &seed) < 3)
+       or  (cols < 2) or (rows < 2) or (nbNets == 0) or (capacity == 0) )
+      throw Error( "generateBenchmark(): Invalid synthetic benchmark spec \"%s\",\n"
+                   "        expected <cols>x<rows>:<nets>[:<capacity>[:<seed>]]."
+                 , spec.c_str() );
+
+    ostringstream name;
+    name << "synth_" << cols << "x" << rows << "_" << nbNets << "_" << capacity << "_" << seed;
+
+    string   path     = (bfs::path(workDir) / name.str()).string();
+    string   fileName = path + ".gr";
+    ofstream out      ( fileName.c_str() );
+    if (not out)
+      throw Error( "generateBenchmark(): Cannot open \"%s\" for writing.", fileName.c_str() );
+
+    const unsigned tile = 10;
+
+    out << "grid " << cols << " " << rows << " 2\n"
+        << "vertical capacity 0 "   << 2*capacity << "\n"
+        << "horizontal capacity "   << 2*capacity << " 0\n"
+        << "minimum width 1 1\n"
+        << "minimum spacing 1 1\n"
+        << "via spacing 1 1\n"
+        << "0 0 " << tile << " " << tile << "\n"
+        << "num net " << nbNets << "\n";
+
+    std::mt19937  rng     ( seed );
+    unsigned      maxSpan = std::max( 2u, std::min(cols,rows) / 8 );
+
+    for ( unsigned inet=0 ; inet<nbNets ; ++inet ) {
+      unsigned degree = 2;
+      if (rng() % 100 >= 60) degree += rng() % 8;
+
+      unsigned span = 1 + rng() % maxSpan;
+      if (rng() % 100 < 2) span = std::max( cols, rows );
+
+      unsigned xCenter = rng() % cols;
+      unsigned yCenter = rng() % rows;
+
+      out << "n" << inet << " " << inet << " " << degree << " 1\n";
+      for ( unsigned ipin=0 ; ipin<degree ; ++ipin ) {
+        int x = (int)xCenter + (int)(rng() % (2*span+1)) - (int)span;
+        int y = (int)yCenter + (int)(rng() % (2*span+1)) - (int)span;
+        x = std::min( std::max(x,0), (int)cols-1 );
+        y = std::min( std::max(y,0), (int)rows-1 );
+
+        out << (x*tile + tile/2) << " " << (y*tile + tile/2) << " 1\n";
+      }
+    }
+    out << "0\n";
+    out.close();
+
+    return path;
+  }
+
+
+// -------------------------------------------------------------------
+// Benchmark run (in the child process).
+
+  void  computeQoR ( KnikEngine* knik, BenchResult& result )
+  {
+    const vector<Edge*>& edges = knik->getRoutingGraph()->getAllEdges();
+
+    for ( size_t i=0 ; i<edges.size() ; ++i ) {
+      unsigned occupancy = edges[i]->getRealOccupancy();
+      unsigned capacity  = edges[i]->getCapacity();
+
+      result._wireLength += occupancy;
+      if (occupancy > capacity) {
+        unsigned long long overflow = occupancy - capacity;
+        result._totalOverflow += overflow;
+        result._overflowedEdges++;
+        if (overflow > result._maxOverflow) result._maxOverflow = overflow;
+      }
+    }
+  }
+
+
+  void  runBenchmark ( const Benchmark& benchmark, bool ripup, BenchResult& result )
+  {
+    WallClock total;
+    WallClock load;
+
+    UpdateSession::open();
+    GrLoader loader;
+    Cell*    cell = loader.load( benchmark._path );
+    UpdateSession::close();
+
+    if (not cell or not loader.getKnik())
+      throw Error( "runBenchmark(): Unable to load \"%s\".", benchmark._path.c_str() );
+
+    result._times[StageLoad] = load.elapsed();
+    result._gcellsX          = loader.getNbGCellsX();
+    result._gcellsY          = loader.getNbGCellsY();
+    result._nets             = loader.getNbNets();
+
+    KnikEngine* knik = loader.getKnik();
+
+    WallClock route;
+    knik->Route( map<Name,Net*>() );
+    result._times[StageRoute] = route.elapsed();
+
+    WallClock ripupClock;
+    if (ripup) {
+      bool done = knik->analyseRouting();
+      while ( not done ) {
+        knik->unrouteOvSegments();
+        knik->reroute();
+        result._iterations++;
+        done = knik->analyseRouting();
+      }
+    }
+    result._times[StageRipup] = ripupClock.elapsed();
+    result._times[StageTotal] = total.elapsed();
+
+    computeQoR( knik, result );
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF,&usage) == 0)
+      result._peakRss = usage.ru_maxrss;
+  }
+
+
+  void  forkBenchmark ( Benchmark& benchmark, bool ripup )
+  {
+    memset( &benchmark._result, 0, sizeof(BenchResult) );
+    benchmark._result._status = 2;
+
+    int fds[2];
+    if (pipe(fds) < 0)
+      throw Error( "forkBenchmark(): Unable to create pipe (%s).", strerror(errno) );
+
+    cout.flush();
+    cerr.flush();
+
+    pid_t pid = fork();
+    if (pid < 0)
+      throw Error( "forkBenchmark(): Unable to fork (%s).", strerror(errno) );
+
+    if (pid == 0) {
+      close( fds[0] );
+
+      BenchResult result;
+      memset( &result, 0, sizeof(BenchResult) );
+      try {
+        runBenchmark( benchmark, ripup, result );
+      }
+      catch ( Error& e ) {
+        cerr << e.what() << endl;
+        result._status = 1;
+      }
+      catch ( ... ) {
+        cerr << "[ERROR] Abnormal termination of \"" << benchmark._name << "\"." << endl;
+        result._status = 1;
+      }
+      cout.flush();
+      cerr.flush();
+
+      ssize_t written = write( fds[1], &result, sizeof(BenchResult) );
+      close( fds[1] );
+      _exit( (written == (ssize_t)sizeof(BenchResult)) ? 0 : 1 );
+    }
+
+    close( fds[1] );
+
+    size_t  received = 0;
+    char*   buffer   = (char*)&benchmark._result;
+    while ( received < sizeof(BenchResult) ) {
+      ssize_t count = read( fds[0], buffer+received, sizeof(BenchResult)-received );
+      if (count < 0 and errno == EINTR) continue;
+      if (count <= 0) break;
+      received += count;
+    }
+    close( fds[0] );
+
+    int status = 0;
+    waitpid( pid, &status, 0 );
+
+    if ( (received != sizeof(BenchResult)) or not WIFEXITED(status) or WEXITSTATUS(status) ) {
+      memset( &benchmark._result, 0, sizeof(BenchResult) );
+      benchmark._result._status = 2;
+    }
+  }
+
+
+// -------------------------------------------------------------------
+// Reports.
+
+  const char* getStatusName ( int status )
+  {
+    switch ( status ) {
+      case 0:  return "ok";
+      case 1:  return "failed";
+    }
+    return "crashed";
+  }
+
+
+  void  writeCsv ( const string& fileName, const vector<Benchmark>& benchmarks )
+  {
+    ofstream out ( fileName.c_str() );
+    if (not out)
+      throw Error( "writeCsv(): Cannot open \"%s\" for writing.", fileName.c_str() );
+
+    out << "benchmark,status,gcells_x,gcells_y,nets,iterations";
+    for ( size_t i=0 ; i<StageCount ; ++i ) out << "," << StageNames[i] << "_s";
+    out << ",peak_rss_kb,total_overflow,max_overflow,overflowed_edges,wirelength\n";
+
+    for ( size_t i=0 ; i<benchmarks.size() ; ++i ) {
+      const BenchResult& result = benchmarks[i]._result;
+
+      out << benchmarks[i]._name
+          << "," << getStatusName(result._status)
+          << "," << result._gcellsX
+          << "," << result._gcellsY
+          << "," << result._nets
+          << "," << result._iterations;
+      for ( size_t j=0 ; j<StageCount ; ++j )
+        out << "," << fixed << setprecision(3) << result._times[j];
+      out << "," << result._peakRss
+          << "," << result._totalOverflow
+          << "," << result._maxOverflow
+          << "," << result._overflowedEdges
+          << "," << result._wireLength
+          << "\n";
+    }
+  }
+
+
+  void  writeJson ( const string& fileName, const vector<Benchmark>& benchmarks )
+  {
+    ofstream out ( fileName.c_str() );
+    if (not out)
+      throw Error( "writeJson(): Cannot open \"%s\" for writing.", fileName.c_str() );
+
+    out << "{\n  \"benchmarks\": [\n";
+    for ( size_t i=0 ; i<benchmarks.size() ; ++i ) {
+      const BenchResult& result = benchmarks[i]._result;
+
+      out << "    { \"benchmark\": \""       << benchmarks[i]._name << "\""
+          << ", \"status\": \""              << getStatusName(result._status) << "\""
+          << ", \"gcells_x\": "              << result._gcellsX
+          << ", \"gcells_y\": "              << result._gcellsY
+          << ", \"nets\": "                  << result._nets
+          << ", \"iterations\": "            << result._iterations
+          << ",\n      \"times\": {";
+      for ( size_t j=0 ; j<StageCount ; ++j )
+        out << ((j) ? ", " : " ") << "\"" << StageNames[j] << "\": "
+            << fixed << setprecision(3) << result._times[j];
+      out << " }"
+          << ",\n      \"peak_rss_kb\": "        << result._peakRss
+          << ", \"total_overflow\": "           << result._totalOverflow
+          << ", \"max_overflow\": "             << result._maxOverflow
+          << ", \"overflowed_edges\": "         << result._overflowedEdges
+          << ", \"wirelength\": "               << result._wireLength
+          << " }" << ((i+1 < benchmarks.size()) ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+  }
+
+
+  void  printReport ( const vector<Benchmark>& benchmarks )
+  {
+    cout << "\n"
+         << left  << setw(32) << "Benchmark"
+         << right << setw(8)  << "Status"
+         << setw(6)  << "Iter"
+         << setw(10) << "Route(s)"
+         << setw(10) << "Ripup(s)"
+         << setw(10) << "Total(s)"
+         << setw(12) << "RSS(Mb)"
+         << setw(12) << "Overflow"
+         << setw(8)  << "MaxOv"
+         << setw(14) << "WireLength" << "\n";
+
+    for ( size_t i=0 ; i<benchmarks.size() ; ++i ) {
+      const BenchResult& result = benchmarks[i]._result;
+
+      cout << left  << setw(32) << benchmarks[i]._name
+           << right << setw(8)  << getStatusName(result._status)
+           << setw(6)  << result._iterations
+           << fixed << setprecision(2)
+           << setw(10) << result._times[StageRoute]
+           << setw(10) << result._times[StageRipup]
+           << setw(10) << result._times[StageTotal]
+           << setw(12) << ((double)result._peakRss / 1024.0)
+           << setw(12) << result._totalOverflow
+           << setw(8)  << result._maxOverflow
+           << setw(14) << result._wireLength << "\n";
+    }
+    cout << endl;
+  }
+
+
+// -------------------------------------------------------------------
+// Baseline comparison.
+//
+// The baseline is a CSV file previously written by --csv. Run times are
+// only compared above a minimal duration (shorter ones are noise).
+
+  typedef map< string, map<string,string> >  Baseline;
+
+
+  vector<string>  splitCsv ( const string& line )
+  {
+    vector<string>  fields;
+    istringstream   stream ( line );
+    string          field;
+
+    while ( getline(stream,field,',') ) fields.push_back( field );
+    return fields;
+  }
+
+
+  void  readBaseline ( const string& fileName, Baseline& baseline )
+  {
+    ifstream in ( fileName.c_str() );
+    if (not in)
+      throw Error( "readBaseline(): Cannot open \"%s\".", fileName.c_str() );
+
+    string line;
+    if (not getline(in,line))
+      throw Error( "readBaseline(): \"%s\" is empty.", fileName.c_str() );
+
+    vector<string> header = splitCsv( line );
+    while ( getline(in,line) ) {
+      vector<string> fields = splitCsv( line );
+      if (fields.size() != header.size()) continue;
+
+      map<string,string>& row = baseline[ fields[0] ];
+      for ( size_t i=1 ; i<fields.size() ; ++i ) row[ header[i] ] = fields[i];
+    }
+  }
+
+
+  double  getBaselineValue ( const map<string,string>& row, const string& column )
+  {
+    map<string,string>::const_iterator it = row.find( column );
+    if (it == row.end()) return -1.0;
+    return atof( (*it).second.c_str() );
+  }
+
+
+  bool  checkValue ( const string& benchmark
+                   , const string& column
+                   , double        reference
+                   , double        value
+                   , double        tolerance )
+  {
+    if (reference < 0.0) return true;
+    if (value <= reference*(1.0+tolerance)) return true;
+
+    cout << "  - " << left << setw(32) << benchmark << " " << setw(16) << column
+         << " regressed: " << value << " (baseline: " << reference
+         << ", tolerance: " << (tolerance*100.0) << "%)" << endl;
+    return false;
+  }
+
+
+  bool  compareBaseline ( const vector<Benchmark>& benchmarks
+                        , const Baseline&          baseline
+                        , const Tolerances&        tolerances )
+  {
+    bool passed = true;
+
+    cout << "  o  Comparing against baseline." << endl;
+
+    for ( size_t i=0 ; i<benchmarks.size() ; ++i ) {
+      const string&      name   = benchmarks[i]._name;
+      const BenchResult& result = benchmarks[i]._result;
+
+      Baseline::const_iterator ibase = baseline.find( name );
+      if (ibase == baseline.end()) {
+        cout << "  - " << left << setw(32) << name << " not in baseline, skipped." << endl;
+        continue;
+      }
+      const map<string,string>& row = (*ibase).second;
+
+      if (result._status) {
+        map<string,string>::const_iterator istatus = row.find( "status" );
+        if ( (istatus == row.end()) or ((*istatus).second == "ok") ) {
+          cout << "  - " << left << setw(32) << name << " "
+               << getStatusName(result._status) << " (ok in baseline)." << endl;
+          passed = false;
+        }
+        continue;
+      }
+
+      for ( size_t j=0 ; j<StageCount ; ++j ) {
+        string column = string(StageNames[j]) + "_s";
+        double base   = getBaselineValue( row, column );
+        if (base < tolerances._minTime) continue;
+        passed &= checkValue( name, column, base, result._times[j], tolerances._time );
+      }
+      passed &= checkValue( name, "peak_rss_kb"
+                          , getBaselineValue(row,"peak_rss_kb"), result._peakRss
+                          , tolerances._memory );
+      passed &= checkValue( name, "total_overflow"
+                          , getBaselineValue(row,"total_overflow"), result._totalOverflow
+                          , tolerances._overflow );
+      passed &= checkValue( name, "max_overflow"
+                          , getBaselineValue(row,"max_overflow"), result._maxOverflow
+                          , tolerances._overflow );
+      passed &= checkValue( name, "wirelength"
+                          , getBaselineValue(row,"wirelength"), result._wireLength
+                          , tolerances._wireLength );
+    }
+
+    cout << "  o  Baseline comparison " << ((passed) ? "passed." : "FAILED.") << endl;
+    return passed;
+  }
+
+
+// -------------------------------------------------------------------
+// Benchmark collection.
+
+  void  addBenchmarks ( const string& path, vector<Benchmark>& benchmarks )
+  {
+    bfs::path  bpath ( path );
+    vector<bfs::path> files;
+
+    if (bfs::is_directory(bpath)) {
+      for ( bfs::directory_iterator it(bpath) ; it != bfs::directory_iterator() ; ++it ) {
+        if (bfs::is_regular_file(it->status()) and (it->path().extension() == ".gr"))
+          files.push_back( it->path() );
+      }
+      sort( files.begin(), files.end() );
+    } else {
+      if (bpath.extension() != ".gr") bpath = bfs::path( path + ".gr" );
+      if (not bfs::exists(bpath))
+        throw Error( "addBenchmarks(): No benchmark \"%s\".", bpath.string().c_str() );
+      files.push_back( bpath );
+    }
+
+    for ( size_t i=0 ; i<files.size() ; ++i ) {
+      Benchmark benchmark;
+      benchmark._name = files[i].stem().string();
+      benchmark._path = (files[i].parent_path() / files[i].stem()).string();
+      memset( &benchmark._result, 0, sizeof(BenchResult) );
+      benchmarks.push_back( benchmark );
+    }
+  }
+
+
+} // End of anonymous namespace.
+
+
+
+
+// x-----------------------------------------------------------------x
+// |                      Fonctions Definitions                      |
+// x-----------------------------------------------------------------x
+
+
+// -------------------------------------------------------------------
+// Function  :  "main()".
+
+int main ( int argc, char *argv[] )
+{
+  int  returnCode = 0;
+
+  try {
+    unsigned int    traceLevel;
+    bool            verbose1;
+    bool            verbose2;
+    bool            coreDump;
+    bool            singlePass;
+    string          workDir;
+    vector<string>  benchPaths;
+    vector<string>  generateSpecs;
+    Tolerances      tolerances;
+
+    poptions::options_description options ("Command line arguments & options");
+    options.add_options()
+      ( "help,h"              , "Print this help." )
+      ( "verbose,v"           , poptions::bool_switch(&verbose1)->default_value(false)
+                              , "First level of verbosity.")
+      ( "very-verbose,V"      , poptions::bool_switch(&verbose2)->default_value(false)
+                              , "Second level of verbosity.")
+      ( "core-dump,D"         , poptions::bool_switch(&coreDump)->default_value(false)
+                              , "Enable core dumping.")
+      ( "trace-level,l"       , poptions::value<unsigned int>(&traceLevel)->default_value(1000)
+                              , "Set the level of trace, trace messages with a level superior to "
+                                "<arg> will be printed on <stderr>." )
+      ( "bench,b"             , poptions::value< vector<string> >(&benchPaths)
+                              , "An ISPD benchmark (\".gr\" file) or a directory of benchmarks." )
+      ( "generate,g"          , poptions::value< vector<string> >(&generateSpecs)
+                              , "Generate a synthetic benchmark: <cols>x<rows>:<nets>[:<capacity>[:<seed>]]." )
+      ( "work-dir,w"          , poptions::value<string>(&workDir)->default_value(".")
+                              , "Directory where the synthetic benchmarks are written." )
+      ( "single-pass,k"       , poptions::bool_switch(&singlePass)->default_value(false)
+                              , "Only perform the initial routing pass (no rip-up & re-route).")
+      ( "csv"                 , poptions::value<string>()
+                              , "Write the results in a CSV file." )
+      ( "json"                , poptions::value<string>()
+                              , "Write the results in a JSON file." )
+      ( "baseline"            , poptions::value<string>()
+                              , "Compare the results against a CSV file of a previous run." )
+      ( "time-tolerance"      , poptions::value<double>(&tolerances._time)->default_value(0.10)
+                              , "Allowed run time increase over the baseline (ratio)." )
+      ( "min-time"            , poptions::value<double>(&tolerances._minTime)->default_value(0.5)
+                              , "Baseline stage times under this (in seconds) are not compared." )
+      ( "memory-tolerance"    , poptions::value<double>(&tolerances._memory)->default_value(0.10)
+                              , "Allowed peak RSS increase over the baseline (ratio)." )
+      ( "wirelength-tolerance", poptions::value<double>(&tolerances._wireLength)->default_value(0.01)
+                              , "Allowed wirelength increase over the baseline (ratio)." )
+      ( "overflow-tolerance"  , poptions::value<double>(&tolerances._overflow)->default_value(0.0)
+                              , "Allowed overflow increase over the baseline (ratio)." );
+
+    poptions::variables_map arguments;
+    poptions::store  ( poptions::parse_command_line(argc,argv,options), arguments );
+    poptions::notify ( arguments );
+
+    if ( arguments.count("help") or (benchPaths.empty() and generateSpecs.empty()) ) {
+      cout << options << endl;
+      exit ( 0 );
+    }
+
+    System::get()->setCatchCore ( not coreDump );
+    if ( verbose1 ) mstream::enable ( mstream::Verbose1 );
+    if ( verbose2 ) mstream::enable ( mstream::Verbose2 );
+    ltracelevel ( traceLevel );
+
+    AllianceFramework* af = AllianceFramework::create ();
+
+    vector<Benchmark> benchmarks;
+    for ( size_t i=0 ; i<generateSpecs.size() ; ++i )
+      addBenchmarks ( generateBenchmark(generateSpecs[i],workDir), benchmarks );
+    for ( size_t i=0 ; i<benchPaths.size() ; ++i )
+      addBenchmarks ( benchPaths[i], benchmarks );
+
+    for ( size_t i=0 ; i<benchmarks.size() ; ++i ) {
+      cmess1 << "  o  Benchmark " << benchmarks[i]._name
+             << " [" << (i+1) << "/" << benchmarks.size() << "]" << endl;
+      forkBenchmark ( benchmarks[i], not singlePass );
+      if ( benchmarks[i]._result._status ) returnCode = 1;
+    }
+
+    printReport ( benchmarks );
+
+    if ( arguments.count("csv" ) ) writeCsv  ( arguments["csv" ].as<string>(), benchmarks );
+    if ( arguments.count("json") ) writeJson ( arguments["json"].as<string>(), benchmarks );
+
+    if ( arguments.count("baseline") ) {
+      Baseline baseline;
+      readBaseline ( arguments["baseline"].as<string>(), baseline );
+      if ( not compareBaseline(benchmarks,baseline,tolerances) ) returnCode = 1;
+    }
+
+    af->destroy();
+  }
+  catch ( Error& e ) {
+    cerr << e.what() << endl;
+    exit ( 1 );
+  }
+  catch ( ... ) {
+    cout << "[ERROR] Abnormal termination: unmanaged exception.\n" << endl;
+    exit ( 2 );
+  }
+
+  return returnCode;
+}
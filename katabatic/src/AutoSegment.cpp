@@ -164,6 +164,16 @@ namespace {
   }
 
 
+  // Expected wire width of a segment already put on a routing layer
+  // (i.e. by Knik layer assignment), default width when out of the gauge.
+  DbU::Unit  getLayerWireWidth ( const Layer* layer, DbU::Unit defaultWidth )
+  {
+    size_t depth = Session::getLayerDepth( layer );
+    if (depth >= Session::getRoutingGauge()->getDepth()) return defaultWidth;
+    return Session::getWireWidth( depth );
+  }
+
+
   // ---------------------------------------------------------------
   // Class  :  "AttractorsMap".
 
@@ -315,6 +325,7 @@ namespace Katabatic {
     , _optimalMin     (0)
     , _optimalMax     (0)
     , _reduceds       (0)
+    , _epoch          (0)
     , _sourcePosition (0)
     , _targetPosition (0)
     , _userConstraints(false)
@@ -693,6 +704,26 @@ namespace Katabatic {
   }
 
 
+  void  AutoSegment::setLayer ( const Layer* layer )
+  {
+    unsigned int depth = Session::getLayerDepth( layer );
+
+  // Keep the "pass through" counters of the crossed GCells up to date.
+  // The end GCells are included as moveULeft()/moveURight() may have
+  // registered the segment in them, changeSegmentDepth() only updates
+  // the GCells the segment is actually registered in.
+    if (depth != _depth) {
+      vector<GCell*> gcells;
+      getGCells( gcells );
+      for ( size_t i=0 ; i<gcells.size() ; ++i )
+        gcells[i]->changeSegmentDepth( this, _depth, depth );
+    }
+
+    base()->setLayer( layer );
+    _depth = depth;
+  }
+
+
   void  AutoSegment::sourceDetach ()
   {
     AutoContact* source = getAutoSource();
@@ -2028,7 +2059,7 @@ namespace Katabatic {
           horizontal->setLayer( horizontalLayer );
           horizontal->setWidth( horizontalWidth );
         } else {
-          if (horizontal->getWidth() != horizontalWidth) {
+          if (horizontal->getWidth() != getLayerWireWidth(horizontal->getLayer(),horizontalWidth)) {
             cerr << Warning("Segment %s has non-default width %s."
                            ,getString(horizontal).c_str()
                            ,DbU::getValueString(horizontal->getWidth()).c_str()) << endl;
@@ -2041,14 +2072,15 @@ namespace Katabatic {
       segment->_postCreate();
     } else if (vertical) {
       if (vertical->getLayer() != verticalLayer) {
-        if (Session::getKatabatic()->isGMetal(vertical->getLayer()) )
-        vertical->setLayer( verticalLayer );
-        vertical->setWidth( verticalWidth );
-      } else {
-        if (vertical->getWidth() != verticalWidth) {
+        if (Session::getKatabatic()->isGMetal(vertical->getLayer()) ) {
+          vertical->setLayer( verticalLayer );
+          vertical->setWidth( verticalWidth );
+        } else {
+          if (vertical->getWidth() != getLayerWireWidth(vertical->getLayer(),verticalWidth)) {
             cerr << Warning("Segment %s has non-default width %s."
                            ,getString(vertical).c_str()
                            ,DbU::getValueString(vertical->getWidth()).c_str()) << endl;
+          }
         }
       }
 
@@ -73,6 +73,8 @@ namespace Katabatic {
     , _extensionCaps  ()
     , _saturateRatio  (Cfg::getParamPercentage("katabatic.saturateRatio",80.0)->asDouble())
     , _saturateRp     (Cfg::getParamInt       ("katabatic.saturateRp"   ,8   )->asInt())
+    , _loadThreads    (Cfg::getParamInt       ("katabatic.loadThreads"  ,0   )->asInt())
+    , _gcellSnapshots (Cfg::getParamBool      ("katabatic.gcellSnapshots",false)->asBool())
     , _globalThreshold(0)
     , _allowedDepth   (0)
     , _hEdgeCapacity  (0)
@@ -134,6 +136,8 @@ namespace Katabatic {
     , _rg                (NULL)
     , _extensionCaps     (other._extensionCaps)
     , _saturateRatio     (other._saturateRatio)
+    , _loadThreads       (other._loadThreads)
+    , _gcellSnapshots    (other._gcellSnapshots)
     , _globalThreshold   (other._globalThreshold)
     , _allowedDepth      (other._allowedDepth)
   {
@@ -277,6 +281,14 @@ namespace Katabatic {
   { return _saturateRp; }
 
 
+  unsigned int  ConfigurationConcrete::getLoadThreads () const
+  { return _loadThreads; }
+
+
+  bool  ConfigurationConcrete::getGCellSnapshots () const
+  { return _gcellSnapshots; }
+
+
   DbU::Unit  ConfigurationConcrete::getGlobalThreshold () const
   { return _globalThreshold; }
 
@@ -316,6 +328,14 @@ namespace Katabatic {
   { _saturateRp = threshold; }
 
 
+  void  ConfigurationConcrete::setLoadThreads ( unsigned int threads )
+  { _loadThreads = threads; }
+
+
+  void  ConfigurationConcrete::setGCellSnapshots ( bool state )
+  { _gcellSnapshots = state; }
+
+
   void  ConfigurationConcrete::setGlobalThreshold ( DbU::Unit threshold )
   { _globalThreshold = threshold; }
 
@@ -332,6 +352,8 @@ namespace Katabatic {
     cout << Dots::asString    ("     - Top routing layer"           ,topLayerName) << endl;
     cout << Dots::asPercentage("     - GCell saturation threshold"  ,_saturateRatio) << endl;
     cout << Dots::asDouble    ("     - Long global length threshold",DbU::toLambda(_globalThreshold)) << endl;
+    cout << Dots::asUInt      ("     - Loading threads (0:all cores)",_loadThreads) << endl;
+    cout << Dots::asBool      ("     - GCellGrid snapshots"         ,_gcellSnapshots) << endl;
   }
 
 
@@ -359,6 +381,8 @@ namespace Katabatic {
     record->add ( getSlot           ( "_gmetalv"         , _gmetalv          ) );
     record->add ( getSlot           ( "_gcontact"        , _gcontact         ) );
     record->add ( getSlot           ( "_saturateRatio"   , _saturateRatio    ) );
+    record->add ( getSlot           ( "_loadThreads"     , _loadThreads      ) );
+    record->add ( getSlot           ( "_gcellSnapshots"  , _gcellSnapshots   ) );
     record->add ( DbU::getValueSlot ( "_globalThreshold" , &_globalThreshold ) );
     record->add ( getSlot           ( "_allowedDepth"    , _allowedDepth     ) );
     record->add ( getSlot           ( "_hEdgeCapacity"   , _hEdgeCapacity    ) );
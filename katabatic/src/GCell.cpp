@@ -326,9 +326,13 @@ namespace Katabatic {
     , _feedthroughs      (new float [_depth])
     , _fragmentations    (new float [_depth])
     , _globalsCount      (new float [_depth])
+    , _passCounts        (new unsigned int [_depth])
+    , _localLengths      (new DbU::Unit [_depth])
+    , _localFeedthroughs (new float [_depth])
+    , _localGlobals      (new float [_depth])
   //, _blockedAxis       (this)
   //, _saturateDensities (new float [_depth])
-    , _flags             (GCellInvalidated)
+    , _flags             (GCellInvalidated|GCellFragmentsInvalidated)
     , _key               (this,1)
   {
     for ( size_t i=0 ; i<_depth ; i++ ) {
@@ -337,6 +341,10 @@ namespace Katabatic {
       _feedthroughs     [i] = 0.0;
       _fragmentations   [i] = 0.0;
       _globalsCount     [i] = 0.0;
+      _passCounts       [i] = 0;
+      _localLengths     [i] = 0;
+      _localFeedthroughs[i] = 0.0;
+      _localGlobals     [i] = 0.0;
     //_saturateDensities[i] = 0.0;
 
       if ( Session::getRoutingGauge()->getLayerGauge(i)->getType() == Constant::PinOnly )
@@ -384,6 +392,10 @@ namespace Katabatic {
     delete [] _feedthroughs;
     delete [] _fragmentations;
     delete [] _globalsCount;
+    delete [] _passCounts;
+    delete [] _localLengths;
+    delete [] _localFeedthroughs;
+    delete [] _localGlobals;
   //delete [] _saturateDensities;
 
     _allocateds--;
@@ -637,7 +649,10 @@ namespace Katabatic {
     if ( depth >= _depth ) return;
 
     _blockages[depth] += length;
-    _flags |= GCellInvalidated;
+    if (isValid()) {
+      _computeDensity( depth );
+      _updateSaturated();
+    }
 
     // if ( _blockages[depth] >= 8.0 ) {
     //   cinfo << Warning("%s is under power ring.",getString(this).c_str()) << endl;
@@ -674,6 +689,7 @@ namespace Katabatic {
     if (found) {
       ltrace(200) << "remove " << ac << " from " << this << endl;
       _contacts.pop_back();
+      invalidateCt();
     } else {
       cerr << Bug("%p:%s do not belong to %s."
                  ,ac->base(),getString(ac).c_str(),_getString().c_str()) << endl;
@@ -689,6 +705,20 @@ namespace Katabatic {
   }
 
 
+  void  GCell::addHSegment ( AutoSegment* segment )
+  {
+    _hsegments.push_back( segment );
+    _updatePassThrough( segment->getDepth(), 1 );
+  }
+
+
+  void  GCell::addVSegment ( AutoSegment* segment )
+  {
+    _vsegments.push_back( segment );
+    _updatePassThrough( segment->getDepth(), 1 );
+  }
+
+
   void  GCell::removeHSegment ( AutoSegment* segment )
   {
     size_t end   = _hsegments.size();
@@ -713,6 +743,7 @@ namespace Katabatic {
                  ,getString(segment).c_str()) << endl;
 
     _hsegments.erase ( _hsegments.begin() + end, _hsegments.end() );
+    _updatePassThrough( segment->getDepth(), -1 );
   }
 
 
@@ -740,6 +771,77 @@ namespace Katabatic {
                  ,getString(segment).c_str()) << endl;
 
     _vsegments.erase ( _vsegments.begin() + end, _vsegments.end() );
+    _updatePassThrough( segment->getDepth(), -1 );
+  }
+
+
+  void  GCell::changeSegmentDepth ( AutoSegment* segment, unsigned int from, unsigned int to )
+  {
+    const vector<AutoSegment*>& segments = (segment->isHorizontal()) ? _hsegments : _vsegments;
+    if (find(segments.begin(),segments.end(),segment) == segments.end()) return;
+
+    _updatePassThrough( from, -1 );
+    _updatePassThrough( to  ,  1 );
+  }
+
+
+  void  GCell::_updatePassThrough ( unsigned int depth, int delta )
+  {
+    if (depth >= _depth) return;
+
+    if ( (delta < 0) and (_passCounts[depth] < (unsigned int)-delta) ) {
+      cerr << Bug( "GCell::_updatePassThrough(): Pass through count underflow on depth %u of %s."
+                 , depth
+                 , _getString().c_str() ) << endl;
+      _passCounts[depth] = 0;
+    } else
+      _passCounts[depth] += delta;
+    _flags |= GCellUnsorted|GCellFragmentsInvalidated;
+
+  // An invalidated GCell will be fully recomputed on the next query.
+    if (isValid()) {
+      _computeDensity( depth );
+      _updateSaturated();
+    }
+  }
+
+
+  void  GCell::_computeDensity ( unsigned int depth )
+  {
+    DbU::Unit side     = 0;
+    float     capacity = 0.0;
+
+    switch ( Session::getDirection(depth) ) {
+      case KbHorizontal: side = _box.getWidth (); capacity = getHCapacity(); break;
+      case KbVertical:   side = _box.getHeight(); capacity = getVCapacity(); break;
+      default: return;
+    }
+
+    DbU::Unit length = _localLengths[depth] + _passCounts[depth]*side + _blockages[depth];
+
+    _densities   [depth] = ((float)length) / ( capacity * (float)side );
+    _feedthroughs[depth] = _localFeedthroughs[depth] + (float)_passCounts[depth]
+                         + (float)(_blockages[depth] / side);
+    _globalsCount[depth] = _localGlobals[depth] + (float)_passCounts[depth];
+  }
+
+
+  void  GCell::_updateSaturated ()
+  {
+    _flags &= ~GCellSaturated;
+    for ( size_t i=0 ; i<_depth ; i++ ) {
+      if (_densities[i] >= 1.0) _flags |= GCellSaturated;
+    }
+  }
+
+
+  void  GCell::_sortSegments ()
+  {
+    if (not (_flags & GCellUnsorted)) return;
+
+    sort ( _hsegments.begin(), _hsegments.end(), AutoSegment::CompareByDepthLength() );
+    sort ( _vsegments.begin(), _vsegments.end(), AutoSegment::CompareByDepthLength() );
+    _flags &= ~GCellUnsorted;
   }
 
 
@@ -755,32 +857,65 @@ namespace Katabatic {
   {
     if (isValid()) return (isSaturated()) ? 1 : 0;
 
-    _flags &= ~GCellSaturated;
+  // Only the wiring starting or ending in the GCell (reached through the
+  // contacts) is recomputed here. The "pass through" segments & blockages
+  // are kept up to date incrementally by _updatePassThrough() and
+  // addBlockage(), and the fragmentation is computed only when queried.
+    float                        ccapacity = getHCapacity() * getVCapacity() * 4; 
+    DbU::Unit                    uLengths  [ _depth ];
+    AutoSegment::DepthLengthSet  processeds;
 
-    for ( size_t i=0 ; i<_vsegments.size() ; i++ ) {
-      if ( _vsegments[i] == NULL )
-        cerr << "NULL Autosegment at index " << i << endl;
+    for ( size_t i=0 ; i<_depth ; i++ ) {
+      _localLengths     [i] = 0;
+      _localFeedthroughs[i] = 0.0;
+      _localGlobals     [i] = 0.0;
     }
 
-    sort ( _hsegments.begin(), _hsegments.end(), AutoSegment::CompareByDepthLength() );
-    sort ( _vsegments.begin(), _vsegments.end(), AutoSegment::CompareByDepthLength() );
+  // Compute wirelength associated to contacts (in DbU::Unit converted to float).
+    vector<AutoContact*>::iterator  it = _contacts.begin();
+    vector<AutoContact*>::iterator end = _contacts.end  ();
+    for ( ; it != end ; it++ ) {
+      for ( size_t i=0 ; i<_depth ; i++ ) uLengths[i] = 0;
+      (*it)->getLengths ( uLengths, processeds );
+      for ( size_t i=0 ; i<_depth ; i++ ) _localLengths[i] += uLengths[i];
+    }
+
+  // Compute the number of non pass-through tracks.
+    AutoSegment::DepthLengthSet::iterator isegment = processeds.begin();
+    for ( ; isegment != processeds.end(); ++isegment ) {
+      size_t depth = Session::getRoutingGauge()->getLayerDepth( (*isegment)->getLayer() );
+      if (depth >= _depth) continue;
+
+      _localFeedthroughs[depth] += ((*isegment)->isGlobal()) ? 0.50 : 0.33;
+      if ( (*isegment)->isGlobal() ) _localGlobals[depth] += 1.0;
+    }
+
+    for ( size_t i=0 ; i<_depth ; i++ ) _computeDensity( i );
+    _updateSaturated();
+
+    _cDensity  = ( (float)_contacts.size() ) / ccapacity;
+    _flags    &= ~GCellInvalidated;
+    _flags    |=  GCellFragmentsInvalidated;
+
+  //ltrace(190) << "updateDensity: " << this << endl;
+
+    checkDensity();
+
+    return isSaturated() ? 1 : 0 ;
+  }
 
-    float                    hcapacity    = getHCapacity ();
-    float                    vcapacity    = getVCapacity ();
-    float                    ccapacity    = hcapacity * vcapacity * 4; 
-    DbU::Unit                hpenalty     = 0 /*_box.getWidth () / 3*/;
-    DbU::Unit                vpenalty     = 0 /*_box.getHeight() / 3*/;
-    DbU::Unit                uLengths1    [ _depth ];
-    DbU::Unit                uLengths2    [ _depth ];
-    float                    localCounts  [ _depth ];
-    vector<UsedFragments>    ufragments   ( _depth );
+
+  void  GCell::_updateFragments ()
+  {
+    float                        hcapacity  = getHCapacity ();
+    float                        vcapacity  = getVCapacity ();
+    DbU::Unit                    uLengths   [ _depth ];
+    vector<UsedFragments>        ufragments ( _depth );
+    AutoSegment::DepthLengthSet  processeds;
 
     for ( size_t i=0 ; i<_depth ; i++ ) {
-      ufragments[i].setPitch ( Session::getPitch(i) );
-      _feedthroughs[i] = 0.0;
-      uLengths2    [i] = 0;
-      localCounts  [i] = 0.0;
-      _globalsCount[i] = 0.0;
+      ufragments[i].setPitch   ( Session::getPitch(i) );
+      ufragments[i].incGlobals ( _passCounts[i] );
 
       switch ( Session::getDirection(i) ) {
         case KbHorizontal:
@@ -794,127 +929,33 @@ namespace Katabatic {
       }
     }
 
-  // Compute wirelength associated to contacts (in DbU::Unit converted to float).
-    AutoSegment::DepthLengthSet  processeds;
     vector<AutoContact*>::iterator  it = _contacts.begin();
     vector<AutoContact*>::iterator end = _contacts.end  ();
     for ( ; it != end ; it++ ) {
-      for ( size_t i=0 ; i<_depth ; i++ ) uLengths1[i] = 0;
-      (*it)->getLengths ( uLengths1, processeds );
-      for ( size_t i=0 ; i<_depth ; i++ ) {
-        switch ( Session::getDirection(i) ) {
-          case KbHorizontal: uLengths2[i] += uLengths1[i]+hpenalty; break;
-          case KbVertical:   uLengths2[i] += uLengths1[i]+vpenalty; break;
-        }
-      }
-    }
-
-  // Add the "pass through" horizontal segments.
-    if ( _hsegments.size() ) {
-      const Layer* layer = _hsegments[0]->getLayer();
-      size_t       depth = Session::getRoutingGauge()->getLayerDepth(layer);
-      size_t       count = 0;
-      for ( size_t i=0 ; i<_hsegments.size() ; i++ ) {
-        _globalsCount[depth] += 1.0;
-        ufragments[depth].incGlobals();
-
-        if ( layer != _hsegments[i]->getLayer() ) {
-          uLengths2[depth] += count * _box.getWidth();
-
-          count = 0;
-          layer = _hsegments[i]->getLayer();
-          depth = Session::getRoutingGauge()->getLayerDepth(layer);
-        }
-        count++;
-        _feedthroughs[depth] += 1.0;
-      }
-      if ( count ) {
-        uLengths2[depth] += count * _box.getWidth();
-      }
+      for ( size_t i=0 ; i<_depth ; i++ ) uLengths[i] = 0;
+      (*it)->getLengths ( uLengths, processeds );
     }
 
-  // Add the "pass through" vertical segments.
-    if ( _vsegments.size() ) {
-      const Layer* layer = _vsegments[0]->getLayer();
-      size_t       depth = Session::getRoutingGauge()->getLayerDepth(layer);
-      size_t       count = 0;
-      for ( size_t i=0 ; i<_vsegments.size() ; i++ ) {
-        _globalsCount[depth] += 1.0;
-        ufragments[depth].incGlobals();
-
-        if ( layer != _vsegments[i]->getLayer() ) {
-          uLengths2[depth] += count * _box.getHeight();
-
-          count = 0;
-          layer = _vsegments[i]->getLayer();
-          depth = Session::getRoutingGauge()->getLayerDepth(layer);
-        }
-        count++;
-        _feedthroughs[depth] += 1.0;
-      }
-      if ( count ) {
-        uLengths2[depth] += count * _box.getHeight();
-      }
-    }
+    AutoSegment::DepthLengthSet::iterator isegment = processeds.begin();
+    for ( ; isegment != processeds.end(); ++isegment ) {
+      size_t depth = Session::getRoutingGauge()->getLayerDepth( (*isegment)->getLayer() );
+      if (depth >= _depth) continue;
 
-  // Add the blockages.
-    for ( size_t i=0 ; i<_depth ; i++ ) {
-      uLengths2[i] += _blockages[i];
+      ufragments[depth].merge ( (*isegment)->getAxis(), (*isegment)->getSpanU() );
     }
 
-  // Compute the number of non pass-through tracks.
-    if ( processeds.size() ) {
-      AutoSegment::DepthLengthSet::iterator isegment = processeds.begin();
-      const Layer* layer = (*isegment)->getLayer();
-      DbU::Unit    axis  = (*isegment)->getAxis();
-      size_t       depth = Session::getRoutingGauge()->getLayerDepth(layer);
-      size_t       count = 0;
-      for ( ; isegment != processeds.end(); ++isegment ) {
-        _feedthroughs[depth] += ((*isegment)->isGlobal()) ? 0.50 : 0.33;
-        localCounts  [depth] += 1.0;
-        if ( (*isegment)->isGlobal() ) _globalsCount[depth] += 1.0;
-
-        ufragments[depth].merge ( (*isegment)->getAxis(), (*isegment)->getSpanU() );
-        if ( (axis != (*isegment)->getAxis()) or (layer != (*isegment)->getLayer()) ) {
-          count = 0;
-          axis  = (*isegment)->getAxis();
-          layer = (*isegment)->getLayer();
-          depth = Session::getRoutingGauge()->getLayerDepth(layer);
-        }
-        ++count;
-      }
-    }
-
-  // Normalize: 0 < d < 1.0 (divide by H/V capacity).
     for ( size_t i=0 ; i<_depth ; i++ ) {
       switch ( Session::getDirection(i) ) {
         case KbHorizontal:
-          _densities     [i]  = ((float)uLengths2[i]) / ( hcapacity * (float)_box.getWidth() );
-          _feedthroughs  [i] += (float)(_blockages[i] / _box.getWidth());
-          _fragmentations[i]  = (float)ufragments[i].getMaxFree().getSize() / (float)_box.getWidth();
+          _fragmentations[i] = (float)ufragments[i].getMaxFree().getSize() / (float)_box.getWidth();
           break;
         case KbVertical:
-          _densities     [i]  = ((float)uLengths2[i]) / ( vcapacity * (float)_box.getHeight() );
-          _feedthroughs  [i] += (float)(_blockages[i] / _box.getHeight());
-          _fragmentations[i]  = (float)ufragments[i].getMaxFree().getSize() / (float)_box.getHeight();
+          _fragmentations[i] = (float)ufragments[i].getMaxFree().getSize() / (float)_box.getHeight();
           break;
       }
-
-      if (_densities[i] >= 1.0)
-        _flags |= GCellSaturated;
     }
 
-    _cDensity  = ( (float)_contacts.size() ) / ccapacity;
-    _flags    &= ~GCellInvalidated;
-
-  //for ( size_t i=0 ; i<_depth ; i++ ) { _densities[i] = roundfp ( _densities[i] ); }
-  //_cDensity = roundfp (_cDensity );
-
-  //ltrace(190) << "updateDensity: " << this << endl;
-
-    checkDensity();
-
-    return isSaturated() ? 1 : 0 ;
+    _flags &= ~GCellFragmentsInvalidated;
   }
 
 
@@ -1140,6 +1181,7 @@ namespace Katabatic {
     ltrace(500) << "Deter| GCell::stepDesaturate() [" << getIndex() << "] depth:" << depth << endl;
 
     updateDensity ();
+    _sortSegments ();
     moved = NULL;
 
     if ( not (flags & KbForceMove) and not isSaturated(depth) ) return false;
@@ -1187,6 +1229,7 @@ namespace Katabatic {
     ltrace(200) << "stepBalance() - " << this << endl;
 
     updateDensity ();
+    _sortSegments ();
 
   //float capacity;
     vector<AutoSegment*>::iterator isegment;
@@ -1233,6 +1276,7 @@ namespace Katabatic {
     ltrace(500) << "Deter| " << this << endl;
 
     updateDensity ();
+    _sortSegments ();
 
   //float capacity;
     vector<AutoSegment*>::iterator isegment;
@@ -1342,24 +1386,6 @@ namespace Katabatic {
   }
 
 
-  void  GCell::_xmlWrite ( ostream& o ) const
-  {
-    char line[1024];
-
-    snprintf ( line, 1024
-             , "<GCell index=\"%04i %04i\" corner=\"%06.1f %06.1f\" density=\"%3.2f,%3.2f\">"
-             , getColumn()
-             , getRow()
-             , DbU::toLambda(getX())
-             , DbU::toLambda(getY())
-             , getDensity()
-             , _cDensity
-             );
-
-    o << line;
-  }
-
-
 // -------------------------------------------------------------------
 // Class  :  "Kite::GCellDensitySet".
 
@@ -14,14 +14,34 @@
 // +-----------------------------------------------------------------+
 
 
+#include  <cstdio>
+#include  <cstring>
 #include  "hurricane/Error.h"
 #include  "hurricane/Cell.h"
+#include  "crlcore/RoutingGauge.h"
 #include  "knik/KnikEngine.h"
 #include  "katabatic/Session.h"
 #include  "katabatic/GCellGrid.h"
+#include  "katabatic/GridSnapshotFormat.h"
 #include  "katabatic/KatabaticEngine.h"
 
 
+namespace {
+
+
+  bool  writeSection ( FILE* file, const void* data, size_t size )
+  {
+    static const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    if (size and (fwrite(data,1,size,file) != size)) return false;
+    size_t pad = Katabatic::kgsAlign(size) - size;
+    return (not pad) or (fwrite(padding,1,pad,file) == pad);
+  }
+
+
+} // Anonymous namespace.
+
+
 namespace Katabatic {
 
 
@@ -201,26 +221,94 @@ namespace Katabatic {
   }
 
 
-  void  GCellGrid::_xmlWrite ( ostream& o )
+  void  GCellGrid::saveSnapshot ( const string& path, const string& stage )
   {
-    updateDensity ();
-
-    o << "<GCellGrid Cell=\"" << getCell()->getName() << "\">" << endl; 
-    o << "<!--            GRID           Lower Left Corner            Density    -->" << endl;
-    o << "<!--        column row             XMin YMin             hor  ver  con -->" << endl;
+    updateDensity();
+
+    RoutingGauge* rg       = _katabatic->getRoutingGauge();
+    size_t        depth    = rg->getDepth();
+    size_t        nbGCells = _gcells.size();
+
+    if (depth > KgsMaxDepth)
+      throw Error( "GCellGrid::saveSnapshot(): Routing gauge is too deep (%u layers, max %u)."
+                 , (unsigned int)depth, KgsMaxDepth );
+
+    KgsHeader header;
+    memset( &header, 0, sizeof(KgsHeader) );
+    memcpy( header._magic, KgsMagic, 4 );
+    header._version       = KgsVersion;
+    header._endianness    = KgsEndianness;
+    header._depth         = depth;
+    header._columns       = getColumns();
+    header._rows          = getRows();
+    header._nbGCells      = nbGCells;
+    header._saturateRatio = Session::getSaturateRatio();
+    header._hEdgeCapacity = _hEdgeCapacity;
+    header._vEdgeCapacity = _vEdgeCapacity;
+    strncpy( header._cellName, getString(getCell()->getName()).c_str(), KgsNameSize-1 );
+    strncpy( header._stage   , stage.c_str()                          , KgsNameSize-1 );
+    for ( size_t i=0 ; i<depth ; ++i )
+      strncpy( header._layers[i], getString(rg->getRoutingLayer(i)->getName()).c_str(), KgsLayerNameSize-1 );
+
+    uint64_t floats = kgsFloatStride( nbGCells ) * sizeof(float);
+    header._xGradsOffset       = kgsAlign( sizeof(KgsHeader) );
+    header._yGradsOffset       = header._xGradsOffset       + getXGrads().getSize()*sizeof(int64_t);
+    header._densitiesOffset    = header._yGradsOffset       + getYGrads().getSize()*sizeof(int64_t);
+    header._feedthroughsOffset = header._densitiesOffset    + depth*floats;
+    header._cDensitiesOffset   = header._feedthroughsOffset + depth*floats;
+    header._hCapacitiesOffset  = header._cDensitiesOffset   + floats;
+    header._vCapacitiesOffset  = header._hCapacitiesOffset  + floats;
+    header._flagsOffset        = header._vCapacitiesOffset  + floats;
+    header._size               = header._flagsOffset        + kgsAlign( nbGCells*sizeof(uint32_t) );
+
+    FILE* file = fopen( path.c_str(), "wb" );
+    if (not file)
+      throw Error( "GCellGrid::saveSnapshot(): Cannot open \"%s\" for writing.", path.c_str() );
+
+    vector<int64_t> grads;
+    vector<float>   values ( nbGCells );
+    bool            written = writeSection( file, &header, sizeof(KgsHeader) );
+
+    for ( size_t axis=0 ; written and (axis<2) ; ++axis ) {
+      const Axis& graduations = (axis) ? getYGrads() : getXGrads();
+      grads.resize( graduations.getSize() );
+      for ( size_t i=0 ; i<grads.size() ; ++i ) grads[i] = graduations[i];
+      written = writeSection( file, grads.data(), grads.size()*sizeof(int64_t) );
+    }
 
-    unsigned int  row = 0;
-    forEach ( GCell*, gcell, getGCells() ) {
-      if ( gcell->getRow() > row ) {
-        o << endl;
-        o << "<!--        column row             XMin YMin             hor  ver  con -->" << endl;
-        row = gcell->getRow();
+    for ( size_t i=0 ; written and (i<depth) ; ++i ) {
+      for ( size_t j=0 ; j<nbGCells ; ++j ) values[j] = _gcells[j]->getWDensity( i, NoUpdate );
+      written = writeSection( file, values.data(), nbGCells*sizeof(float) );
+    }
+    for ( size_t i=0 ; written and (i<depth) ; ++i ) {
+      for ( size_t j=0 ; j<nbGCells ; ++j ) values[j] = _gcells[j]->getFeedthroughs( i );
+      written = writeSection( file, values.data(), nbGCells*sizeof(float) );
+    }
+    if (written) {
+      for ( size_t j=0 ; j<nbGCells ; ++j ) values[j] = _gcells[j]->getCDensity( NoUpdate );
+      written = writeSection( file, values.data(), nbGCells*sizeof(float) );
+    }
+    if (written) {
+      for ( size_t j=0 ; j<nbGCells ; ++j ) values[j] = _gcells[j]->getHCapacity();
+      written = writeSection( file, values.data(), nbGCells*sizeof(float) );
+    }
+    if (written) {
+      for ( size_t j=0 ; j<nbGCells ; ++j ) values[j] = _gcells[j]->getVCapacity();
+      written = writeSection( file, values.data(), nbGCells*sizeof(float) );
+    }
+    if (written) {
+      vector<uint32_t> flags ( nbGCells, 0 );
+      for ( size_t j=0 ; j<nbGCells ; ++j ) {
+        if (_gcells[j]->isSaturated()) flags[j] |= KgsSaturated;
+        for ( size_t i=0 ; i<depth ; ++i )
+          if (_gcells[j]->getWDensity(i,NoUpdate) > header._saturateRatio) flags[j] |= (1 << i);
       }
-
-      o << "  "; gcell->_xmlWrite ( o ); o << endl;
+      written = writeSection( file, flags.data(), nbGCells*sizeof(uint32_t) );
     }
+    fclose( file );
 
-    o << "</GCellGrid>" << endl;
+    if (not written)
+      throw Error( "GCellGrid::saveSnapshot(): Error while writing \"%s\".", path.c_str() );
   }
 
 
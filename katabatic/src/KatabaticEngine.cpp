@@ -15,7 +15,6 @@
 
 
 #include <iostream>
-#include <fstream>
 #include "hurricane/DebugSession.h"
 #include "hurricane/Bug.h"
 #include "hurricane/Error.h"
@@ -81,6 +80,23 @@ namespace {
 #endif
 
 
+// Store object at slot id of a look-up table starting at id base. The
+// table is grown on either side, so it only spans the ids of the
+// components wrapped by the engine.
+
+  template<typename Object>
+  void  linkInLut ( vector<Object*>& lut, unsigned int& base, unsigned int id, Object* object )
+  {
+    if (lut.empty()) base = id;
+    if (id < base) {
+      lut.insert( lut.begin(), base-id, NULL );
+      base = id;
+    }
+    if (id-base >= lut.size()) lut.resize( id-base+1, NULL );
+    lut[ id-base ] = object;
+  }
+
+
 } // End of anonymous namespace.
 
 
@@ -157,6 +173,8 @@ namespace Katabatic {
     , _chipTools         (cell)
     , _autoSegmentLut    ()
     , _autoContactLut    ()
+    , _autoSegmentBase   (0)
+    , _autoContactBase   (0)
     , _netRoutingStates  ()
   {
     addMeasure<size_t>( cell, "Gates"
@@ -259,8 +277,9 @@ namespace Katabatic {
       size_t sameLayerDoglegs = 0;
       AutoSegmentLut::const_iterator isegment = _autoSegmentLut.begin();
       for ( ; isegment != _autoSegmentLut.end() ; ++isegment ) {
-        if ((*isegment).second->isFixed()) ++fixedSegments;
-        if ((*isegment).second->reduceDoglegLayer()) ++sameLayerDoglegs;
+        if (not (*isegment)) continue;
+        if ((*isegment)->isFixed()) ++fixedSegments;
+        if ((*isegment)->reduceDoglegLayer()) ++sameLayerDoglegs;
       }
 
       cmess1 << "  o  Driving Hurricane data-base." << endl;
@@ -296,19 +315,11 @@ namespace Katabatic {
   }
 
 
-  AutoSegment* KatabaticEngine::_lookup ( Segment* segment ) const
-  {
-    AutoSegmentLut::const_iterator it = _autoSegmentLut.find( segment );
-    if (it == _autoSegmentLut.end()) return NULL;
-
-    return (*it).second;
-  }
-
-
   void  KatabaticEngine::_link ( AutoSegment* autoSegment )
   {
     if (_state > EngineActive) return;
-    _autoSegmentLut[ autoSegment->base() ] = autoSegment;
+
+    linkInLut( _autoSegmentLut, _autoSegmentBase, autoSegment->base()->getId(), autoSegment );
   }
 
 
@@ -316,26 +327,17 @@ namespace Katabatic {
   {
     if (_state > EngineDriving) return;
 
-    AutoSegmentLut::iterator it = _autoSegmentLut.find( autoSegment->base() );
-    if (it != _autoSegmentLut.end())
-      _autoSegmentLut.erase( it );
-  }
-
-
-  AutoContact* KatabaticEngine::_lookup ( Contact* contact ) const
-  {
-    AutoContactLut::const_iterator it = _autoContactLut.find( contact );
-    if (it == _autoContactLut.end()) {
-      return NULL;
-    }
-    return (*it).second;
+    unsigned int id = autoSegment->base()->getId();
+    if ( (id >= _autoSegmentBase) and (id-_autoSegmentBase < _autoSegmentLut.size()) )
+      _autoSegmentLut[ id-_autoSegmentBase ] = NULL;
   }
 
 
   void  KatabaticEngine::_link ( AutoContact* autoContact )
   {
     if (_state > EngineActive) return;
-    _autoContactLut [ autoContact->base() ] = autoContact;
+
+    linkInLut( _autoContactLut, _autoContactBase, autoContact->base()->getId(), autoContact );
   }
 
 
@@ -343,27 +345,33 @@ namespace Katabatic {
   {
     if ( _state > EngineActive ) return;
 
-    AutoContactLut::iterator it = _autoContactLut.find( autoContact->base() );
-    if (it != _autoContactLut.end())
-      _autoContactLut.erase( it );
+    unsigned int id = autoContact->base()->getId();
+    if ( (id >= _autoContactBase) and (id-_autoContactBase < _autoContactLut.size()) )
+      _autoContactLut[ id-_autoContactBase ] = NULL;
   }
 
 
-  void  KatabaticEngine::xmlWriteGCellGrid ( const string& fileName )
+  void  KatabaticEngine::saveGCellGrid ( const string& path, const string& stage )
   {
-    ofstream  file (fileName.c_str());
+    if (not _gcellGrid)
+      throw Error( "KatabaticEngine::saveGCellGrid(): GCellGrid is not allocated yet." );
 
-    xmlWriteGCellGrid( file );
-    file.close ();
+    _gcellGrid->saveSnapshot( path, stage );
   }
 
 
-  void  KatabaticEngine::xmlWriteGCellGrid ( ostream& o )
+  void  KatabaticEngine::_snapshotGCellGrid ( const string& stage )
   {
-    if (_gcellGrid)
-      _gcellGrid->_xmlWrite( o );
-    else
-      cerr << Error("Cannot dump GCellGrid: not allocated yet.") << endl;
+    if (not getGCellSnapshots() or not _gcellGrid) return;
+
+    string path = getString(_cell->getName()) + "." + stage + ".kgs";
+    try {
+      saveGCellGrid( path, stage );
+      cmess2 << Dots::asString("     - GCellGrid snapshot",path) << endl;
+    }
+    catch ( Error& e ) {
+      cerr << Warning( "KatabaticEngine::_snapshotGCellGrid(): %s", e.getReason().c_str() ) << endl;
+    }
   }
 
 
@@ -408,7 +416,7 @@ namespace Katabatic {
     AutoSegmentLut::const_iterator  it = _autoSegmentLut.begin();
     AutoSegmentLut::const_iterator end = _autoSegmentLut.end  ();
     for ( ; it != end ; it++ )
-      coherency = it->second->_check() and coherency;
+      if (*it) coherency = (*it)->_check() and coherency;
 
     vector<GCell*>::const_iterator  itGCell = _gcellGrid->getGCellVector()->begin();
     vector<GCell*>::const_iterator endGCell = _gcellGrid->getGCellVector()->end();
@@ -439,8 +447,9 @@ namespace Katabatic {
     AutoSegmentLut::iterator  it = _autoSegmentLut.begin();
     AutoSegmentLut::iterator end = _autoSegmentLut.end  ();
     for ( ; it != end ; it++ ) {
+      if (not (*it)) continue;
       expandeds++;
-      it->second->destroy();
+      (*it)->destroy();
     }
     if (_state == EngineDriving)
       cerr << "     - Expandeds     := " << expandeds << endl;
@@ -456,7 +465,7 @@ namespace Katabatic {
     AutoContactLut::iterator  it = _autoContactLut.begin();
     AutoContactLut::iterator end = _autoContactLut.end  ();
     for ( ; it != end ; it++ )
-      it->second->destroy();
+      if (*it) (*it)->destroy();
 
     _autoContactLut.clear();
   }
@@ -0,0 +1,273 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |        K a t a b a t i c  -  Routing Toolbox                    |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :   "./KgsDump.cpp"                                |
+// +-----------------------------------------------------------------+
+//
+// Standalone reader of the binary GCellGrid snapshots (.kgs). Do not
+// link against the database, so it can be used on any machine.
+//
+// Usage:  kgsdump [--csv <depth>|--csv all] <file.kgs>
+//
+// Without option, prints the header and, for each depth, the min/avg/max
+// density and the number of saturated GCells. With --csv, prints one
+// line per GCell: column,row,xmin,ymin,xmax,ymax,depth,density,feedthroughs.
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <iostream>
+#include "katabatic/GridSnapshotFormat.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Katabatic;
+
+
+  class Snapshot {
+    public:
+      bool             load        ( const char* path );
+      void             printHeader () const;
+      void             printStats  () const;
+      bool             printCsv    ( int depth ) const;
+    private:
+      inline  float    _density    ( size_t depth, size_t index ) const;
+      inline  float    _feedthrough( size_t depth, size_t index ) const;
+              bool     _fits       ( uint64_t offset, uint64_t count, size_t size ) const;
+      template<typename T>
+      inline  const T* _section    ( uint64_t offset ) const;
+    private:
+      vector<char>  _data;
+      KgsHeader     _header;
+  };
+
+
+  template<typename T>
+  inline const T* Snapshot::_section ( uint64_t offset ) const
+  { return reinterpret_cast<const T*>( &_data[offset] ); }
+
+  inline float  Snapshot::_density ( size_t depth, size_t index ) const
+  { return _section<float>(_header._densitiesOffset)[ depth*kgsFloatStride(_header._nbGCells) + index ]; }
+
+  inline float  Snapshot::_feedthrough ( size_t depth, size_t index ) const
+  { return _section<float>(_header._feedthroughsOffset)[ depth*kgsFloatStride(_header._nbGCells) + index ]; }
+
+
+// The section of count elements of size bytes at offset lies inside the
+// file, and is aligned for them.
+
+  bool  Snapshot::_fits ( uint64_t offset, uint64_t count, size_t size ) const
+  {
+    return (offset % size == 0)
+       and (offset <= _data.size())
+       and (count  <= (_data.size() - offset) / size);
+  }
+
+
+  bool  Snapshot::load ( const char* path )
+  {
+    FILE* fd = fopen( path, "rb" );
+    if (not fd) {
+      cerr << "[ERROR] Cannot open <" << path << ">." << endl;
+      return false;
+    }
+
+    fseek( fd, 0, SEEK_END );
+    long size = ftell( fd );
+    fseek( fd, 0, SEEK_SET );
+
+    if (size < (long)sizeof(KgsHeader)) {
+      cerr << "[ERROR] <" << path << "> is too small to be a GCellGrid snapshot." << endl;
+      fclose( fd );
+      return false;
+    }
+
+    _data.resize( size );
+    size_t bytes = fread( &_data[0], 1, size, fd );
+    fclose( fd );
+
+    if (bytes != (size_t)size) {
+      cerr << "[ERROR] Short read on <" << path << ">." << endl;
+      return false;
+    }
+
+    memcpy( &_header, &_data[0], sizeof(KgsHeader) );
+
+    if (memcmp(_header._magic,KgsMagic,sizeof(KgsMagic))) {
+      cerr << "[ERROR] <" << path << "> is not a GCellGrid snapshot (bad magic)." << endl;
+      return false;
+    }
+    if (_header._endianness != KgsEndianness) {
+      cerr << "[ERROR] <" << path << "> has been written on a machine of different endianness." << endl;
+      return false;
+    }
+    if (_header._version != KgsVersion) {
+      cerr << "[ERROR] <" << path << "> has format version " << _header._version
+           << ", expected " << KgsVersion << "." << endl;
+      return false;
+    }
+    uint64_t nbGCells = _header._nbGCells;
+    uint64_t stride   = kgsFloatStride( nbGCells );   // Padded per-depth arrays.
+    if ( (_header._size != (uint64_t)size)
+       or (_header._depth > KgsMaxDepth)
+       or (nbGCells != (uint64_t)_header._columns * _header._rows)
+       or (nbGCells > (uint64_t)size)      // Bounds depth*stride below.
+       or not _fits( _header._xGradsOffset      , (uint64_t)_header._columns+1, sizeof(int64_t ) )
+       or not _fits( _header._yGradsOffset      , (uint64_t)_header._rows   +1, sizeof(int64_t ) )
+       or not _fits( _header._densitiesOffset   , _header._depth*stride       , sizeof(float   ) )
+       or not _fits( _header._feedthroughsOffset, _header._depth*stride       , sizeof(float   ) )
+       or not _fits( _header._cDensitiesOffset  , nbGCells                    , sizeof(float   ) )
+       or not _fits( _header._hCapacitiesOffset , nbGCells                    , sizeof(float   ) )
+       or not _fits( _header._vCapacitiesOffset , nbGCells                    , sizeof(float   ) )
+       or not _fits( _header._flagsOffset       , nbGCells                    , sizeof(uint32_t) ) ) {
+      cerr << "[ERROR] <" << path << "> is truncated or corrupted." << endl;
+      return false;
+    }
+
+    _header._cellName[KgsNameSize-1] = '\0';
+    _header._stage   [KgsNameSize-1] = '\0';
+    for ( size_t depth=0 ; depth<KgsMaxDepth ; ++depth )
+      _header._layers[depth][KgsLayerNameSize-1] = '\0';
+
+    return true;
+  }
+
+
+  void  Snapshot::printHeader () const
+  {
+    cout << "Cell:            " << _header._cellName << "\n"
+         << "Stage:           " << _header._stage    << "\n"
+         << "Grid:            " << _header._columns  << "x" << _header._rows
+                                << " (" << _header._nbGCells << " GCells)\n"
+         << "Saturate ratio:  " << _header._saturateRatio << "\n"
+         << "Edge capacities: H:" << _header._hEdgeCapacity
+                                  << " V:" << _header._vEdgeCapacity << "\n"
+         << "Depth:           " << _header._depth << endl;
+  }
+
+
+  void  Snapshot::printStats () const
+  {
+    const uint32_t* flags = _section<uint32_t>( _header._flagsOffset );
+
+    size_t saturateds = 0;
+    for ( size_t i=0 ; i<_header._nbGCells ; ++i )
+      if (flags[i] & KgsSaturated) ++saturateds;
+
+    cout << "Saturated GCells: " << saturateds << "\n" << endl;
+    cout << "  Depth  Layer            Min      Avg      Max      Saturateds" << endl;
+
+    for ( size_t depth=0 ; depth<_header._depth ; ++depth ) {
+      float  minimum   = 0.0;
+      float  maximum   = 0.0;
+      double sum       = 0.0;
+      size_t saturated = 0;
+
+      for ( size_t i=0 ; i<_header._nbGCells ; ++i ) {
+        float density = _density( depth, i );
+        if ((i == 0) or (density < minimum)) minimum = density;
+        if ((i == 0) or (density > maximum)) maximum = density;
+        sum += density;
+        if (flags[i] & (1 << depth)) ++saturated;
+      }
+
+      printf( "  %5zu  %-15s %8.3f %8.3f %8.3f %10zu\n"
+            , depth
+            , _header._layers[depth]
+            , minimum
+            , (_header._nbGCells) ? sum/_header._nbGCells : 0.0
+            , maximum
+            , saturated
+            );
+    }
+  }
+
+
+  bool  Snapshot::printCsv ( int depth ) const
+  {
+    if (depth >= (int)_header._depth) {
+      cerr << "[ERROR] Depth " << depth << " out of range [0:" << _header._depth << "[." << endl;
+      return false;
+    }
+
+    const int64_t* xGrads = _section<int64_t>( _header._xGradsOffset );
+    const int64_t* yGrads = _section<int64_t>( _header._yGradsOffset );
+
+    size_t depthMin = (depth < 0) ? 0              : depth;
+    size_t depthMax = (depth < 0) ? _header._depth : depth+1;
+
+    cout << "column,row,xmin,ymin,xmax,ymax,depth,density,feedthroughs" << "\n";
+    for ( size_t d=depthMin ; d<depthMax ; ++d ) {
+      for ( size_t row=0 ; row<_header._rows ; ++row ) {
+        for ( size_t column=0 ; column<_header._columns ; ++column ) {
+          size_t index = column + row*_header._columns;
+          printf( "%zu,%zu,%lld,%lld,%lld,%lld,%zu,%g,%g\n"
+                , column
+                , row
+                , (long long)xGrads[column  ]
+                , (long long)yGrads[row     ]
+                , (long long)xGrads[column+1]
+                , (long long)yGrads[row   +1]
+                , d
+                , _density    ( d, index )
+                , _feedthrough( d, index )
+                );
+        }
+      }
+    }
+    return true;
+  }
+
+
+  void  usage ( const char* program )
+  {
+    cerr << "Usage: " << program << " [--csv <depth>|--csv all] <file.kgs>" << endl;
+  }
+
+
+}  // Anonymous namespace.
+
+
+int  main ( int argc, char* argv[] )
+{
+  const char* path  = NULL;
+  bool        csv   = false;
+  int         depth = -1;
+
+  for ( int iarg=1 ; iarg<argc ; ++iarg ) {
+    if (not strcmp(argv[iarg],"--csv")) {
+      if (++iarg >= argc) { usage( argv[0] ); return 1; }
+      csv = true;
+      if (strcmp(argv[iarg],"all")) depth = atoi( argv[iarg] );
+      continue;
+    }
+    if (path) { usage( argv[0] ); return 1; }
+    path = argv[iarg];
+  }
+  if (not path) { usage( argv[0] ); return 1; }
+
+  Snapshot snapshot;
+  if (not snapshot.load(path)) return 2;
+
+  if (csv) {
+    if (not snapshot.printCsv(depth)) return 1;
+  } else {
+    snapshot.printHeader();
+    snapshot.printStats ();
+  }
+  return 0;
+}
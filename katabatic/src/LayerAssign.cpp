@@ -117,8 +117,15 @@ namespace Katabatic {
         }
 
         global++;
-        if ((*isegment)->getLayer() == Session::getRoutingLayer(1)) (*isegment)->setLayer( Session::getRoutingLayer(3) );
-        if ((*isegment)->getLayer() == Session::getRoutingLayer(2)) (*isegment)->setLayer( Session::getRoutingLayer(4) );
+        const Layer* layer = NULL;
+        if ((*isegment)->getLayer() == Session::getRoutingLayer(1)) layer = Session::getRoutingLayer(3);
+        if ((*isegment)->getLayer() == Session::getRoutingLayer(2)) layer = Session::getRoutingLayer(4);
+        if (layer) {
+        // Through the AutoSegment, so the GCells densities follow.
+          AutoSegment* autoSegment = Session::lookup( *isegment );
+          if (autoSegment) autoSegment->setLayer( layer );
+          else             (*isegment)->setLayer( layer );
+        }
       }
     }
 
@@ -430,8 +437,9 @@ namespace Katabatic {
 
     AutoSegmentLut::iterator ilut = _autoSegmentLut.begin();
     for ( ; ilut!=_autoSegmentLut.end() ; ++ilut ) {
-      AutoSegment* segment = (*ilut).second;
+      AutoSegment* segment = (*ilut);
 
+      if (not segment) continue;
       if (segment->isLocal() or segment->isFixed()) continue;
       if (not segment->isCanonical()) continue;
 
@@ -456,6 +464,7 @@ namespace Katabatic {
       Session::revalidate();
     }
 
+    _snapshotGCellGrid( "balance" );
     Session::close();
   }
 
@@ -472,10 +481,15 @@ namespace Katabatic {
     startMeasures();
     Session::open( this );
 
-    if (Session::getAllowedDepth() >= 3) {
+    if (getFlags(EngineKnikLayerAssign)) {
+    // Layers already assigned by the global router (Knik), moving the
+    // segments here would undo it.
+      cmess1 << "  o  Assign Layer (kept from global routing)." << endl;
+    } else if (Session::getAllowedDepth() >= 3) {
       switch ( method ) {
         case EngineLayerAssignByLength: _layerAssignByLength( total, global, globalNets ); break;
         case EngineLayerAssignByTrunk:  _layerAssignByTrunk ( total, global, globalNets ); break;
+        case EngineLayerAssignByDP:     _layerAssignByDP    ( total, global, globalNets ); break;
         case EngineNoNetLayerAssign:    break;
         default:
           stopMeasures();
@@ -489,6 +503,7 @@ namespace Katabatic {
   
       globalNets.clear();
       Session::revalidate();
+      _snapshotGCellGrid( "assign" );
   
       if (getConfiguration()->getAllowedDepth() > 2) {
       //for ( int i=0 ; i < 3 ; i++ ) {
@@ -502,6 +517,7 @@ namespace Katabatic {
       //  if (not _gcellGrid->updateDensity()) break;
       //}
         Session::revalidate();
+        _snapshotGCellGrid( "desaturate" );
       }
   
 #if defined(CHECK_DATABASE)
@@ -0,0 +1,445 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |        K a t a b a t i c  -  Routing Toolbox                    |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :       "./LayerAssignDP.cpp"                      |
+// +-----------------------------------------------------------------+
+
+
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include "hurricane/Warning.h"
+#include "hurricane/DebugSession.h"
+#include "hurricane/Net.h"
+#include "hurricane/Layer.h"
+#include "hurricane/Cell.h"
+#include "crlcore/RoutingGauge.h"
+#include "katabatic/AutoContact.h"
+#include "katabatic/AutoSegment.h"
+#include "katabatic/GCellGrid.h"
+#include "katabatic/KatabaticEngine.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+  using namespace Katabatic;
+
+
+// Hard-coded weights of the cost function. The congestion cost of a
+// candidate layer is the sum, over the GCells crossed, of the density
+// it would reach, plus OverflowWeight per track above the saturation
+// ratio. Each via layer crossed between two connected wires costs
+// ViaCost. Each negociation pass multiplies the overflow weight.
+
+  const float         ViaCost          = 1.0;
+  const float         OverflowWeight   = 4.0;
+  const float         NegociateFactor  = 4.0;
+  const unsigned int  NegociatePasses  = 3;
+  const size_t        BatchSize        = 1024;
+
+
+// -------------------------------------------------------------------
+// Class  :  "DpNet".
+//
+// Layer assignment of one net by dynamic programming over the tree of
+// its global aligned sets (one variable per canonical AutoSegment).
+// measure() and plan() only read the Katabatic data-base and can be run
+// concurrently on different nets, apply() must be run serially.
+
+  class DpNet {
+    public:
+                            DpNet          ( Net* );
+      inline  Net*          getNet         () const;
+      inline  float         getCriticality () const;
+      inline  size_t        getGroupsCount () const;
+              void          measure        ();
+              void          plan           ( float overflowWeight );
+              size_t        apply          ();
+    private:
+      struct Group {
+          AutoSegment*          _canonical;
+          unsigned int          _depth;
+          bool                  _horizontal;
+          vector<GCell*>        _gcells;
+          vector<unsigned int>  _fixedDepths;
+          vector<size_t>        _neighbors;
+          vector<unsigned int>  _candidates;
+          vector<float>         _costs;
+          vector<size_t>        _choices;
+          size_t                _parent;
+          size_t                _assigned;
+      };
+    private:
+              void          _collect       ();
+              float         _getCongestion ( const Group&, unsigned int depth, float overflowWeight ) const;
+    private:
+      Net*                                 _net;
+      float                                _criticality;
+      bool                                 _collected;
+      vector<Group>                        _groups;
+      vector< pair<AutoSegment*,size_t> >  _moves;
+      exception_ptr                        _exception;
+  };
+
+
+  inline Net*    DpNet::getNet         () const { return _net; }
+  inline float   DpNet::getCriticality () const { return _criticality; }
+  inline size_t  DpNet::getGroupsCount () const { return _groups.size(); }
+
+
+  DpNet::DpNet ( Net* net )
+    : _net        (net)
+    , _criticality(0.0)
+    , _collected  (false)
+    , _groups     ()
+    , _moves      ()
+    , _exception  ()
+  { }
+
+
+  void  DpNet::_collect ()
+  {
+    _groups.clear();
+    _collected = true;
+
+    unsigned int              allowedDepth = Session::getConfiguration()->getAllowedDepth();
+    map<AutoSegment*,size_t>  groupOf;
+    vector<AutoSegment*>      canonicals;
+
+    forEach ( Segment*, isegment, _net->getSegments() ) {
+      AutoSegment* segment = Session::lookup( *isegment );
+      if (not segment or not segment->isCanonical()) continue;
+      if (segment->isLocal() or segment->isFixed()) continue;
+      if (not segment->canMoveUp(1.0,KbPropagate|KbAllowTerminal|KbNoCheckLayer)) continue;
+
+      canonicals.push_back( segment );
+    }
+    sort( canonicals.begin(), canonicals.end(), AutoSegment::CompareId() );
+
+    vector< vector<AutoSegment*> > members ( canonicals.size() );
+    for ( size_t i=0 ; i<canonicals.size() ; ++i ) {
+      Group group;
+      group._canonical  = canonicals[i];
+      group._depth      = Session::getRoutingGauge()->getLayerDepth( canonicals[i]->getLayer() );
+      group._horizontal = canonicals[i]->isHorizontal();
+      group._parent     = i;
+      group._assigned   = 0;
+
+      for ( unsigned int depth=group._depth ; depth<=allowedDepth ; ++depth ) {
+        if (Session::getDirection(depth) == Session::getDirection(group._depth))
+          group._candidates.push_back( depth );
+      }
+
+      members[i].push_back( canonicals[i] );
+      forEach ( AutoSegment*, isegment, canonicals[i]->getAligneds(KbNoCheckLayer) )
+        members[i].push_back( *isegment );
+
+      vector<GCell*> gcells;
+      for ( size_t j=0 ; j<members[i].size() ; ++j ) {
+        groupOf[ members[i][j] ] = i;
+        members[i][j]->getGCells( gcells );
+        group._gcells.insert( group._gcells.end(), gcells.begin(), gcells.end() );
+      }
+      sort( group._gcells.begin(), group._gcells.end(), GCell::CompareByIndex() );
+      group._gcells.erase( unique(group._gcells.begin(),group._gcells.end()), group._gcells.end() );
+
+      _groups.push_back( group );
+    }
+
+  // Connections: other groups become edges of the tree, global or
+  // terminal wires stay where they are and only add a via cost. Local
+  // wires follow the group (changeDepth() with KbWithNeighbors).
+    for ( size_t i=0 ; i<_groups.size() ; ++i ) {
+      for ( size_t j=0 ; j<members[i].size() ; ++j ) {
+        AutoSegment* member = members[i][j];
+
+        for ( size_t end=0 ; end<2 ; ++end ) {
+          AutoContact* contact = (end) ? member->getAutoTarget() : member->getAutoSource();
+          if (not contact) continue;
+          if (contact->isTerminal()) _groups[i]._fixedDepths.push_back( 0 );
+
+          AutoSegments neighbors = (end) ? member->getCachedOnTargetContact(KbDirectionMask)
+                                         : member->getCachedOnSourceContact(KbDirectionMask);
+          forEach ( AutoSegment*, isegment, neighbors ) {
+            if (*isegment == member) continue;
+
+            map<AutoSegment*,size_t>::iterator igroup = groupOf.find( *isegment );
+            if (igroup != groupOf.end()) {
+              if (igroup->second != i) _groups[i]._neighbors.push_back( igroup->second );
+              continue;
+            }
+            if (isegment->isGlobal() or isegment->isTerminal())
+              _groups[i]._fixedDepths.push_back
+                ( Session::getRoutingGauge()->getLayerDepth(isegment->getLayer()) );
+          }
+        }
+      }
+
+      vector<size_t>& neighbors = _groups[i]._neighbors;
+      sort( neighbors.begin(), neighbors.end() );
+      neighbors.erase( unique(neighbors.begin(),neighbors.end()), neighbors.end() );
+    }
+  }
+
+
+  float  DpNet::_getCongestion ( const Group& group, unsigned int depth, float overflowWeight ) const
+  {
+    float saturateRatio = Session::getSaturateRatio();
+    float cost          = 0.0;
+
+    for ( size_t i=0 ; i<group._gcells.size() ; ++i ) {
+      GCell* gcell     = group._gcells[i];
+      float  capacity  = (group._horizontal) ? gcell->getHCapacity() : gcell->getVCapacity();
+      float  occupancy = gcell->getFeedthroughs( depth ) + ((depth == group._depth) ? 0.0 : 1.0);
+      float  limit     = capacity * saturateRatio;
+
+      cost += occupancy / capacity;
+      if (occupancy > limit) cost += overflowWeight * (occupancy - limit);
+    }
+
+    return cost;
+  }
+
+
+  void  DpNet::measure ()
+  {
+    try {
+      _collect();
+
+      _criticality = 0.0;
+      for ( size_t i=0 ; i<_groups.size() ; ++i ) {
+        for ( size_t j=0 ; j<_groups[i]._gcells.size() ; ++j ) {
+          float overflow = _groups[i]._gcells[j]->getWDensity( _groups[i]._depth )
+                         - Session::getSaturateRatio();
+          if (overflow > 0.0) _criticality += overflow;
+        }
+      }
+    }
+    catch ( ... ) {
+      _exception = current_exception();
+    }
+  }
+
+
+  void  DpNet::plan ( float overflowWeight )
+  {
+    _moves.clear();
+
+    try {
+      if (not _collected) _collect();
+      if (_groups.empty()) return;
+
+    // Breadth first ordering of the forest, cycles (if any) are cut.
+      vector<size_t> order;
+      vector<bool>   visiteds ( _groups.size(), false );
+      for ( size_t root=0 ; root<_groups.size() ; ++root ) {
+        if (visiteds[root]) continue;
+        visiteds[root] = true;
+        _groups[root]._parent = root;
+
+        size_t head = order.size();
+        order.push_back( root );
+        for ( size_t i=head ; i<order.size() ; ++i ) {
+          Group& group = _groups[ order[i] ];
+          for ( size_t j=0 ; j<group._neighbors.size() ; ++j ) {
+            size_t neighbor = group._neighbors[j];
+            if (visiteds[neighbor]) continue;
+            visiteds[neighbor] = true;
+            _groups[neighbor]._parent = order[i];
+            order.push_back( neighbor );
+          }
+        }
+      }
+
+    // Unary costs: congestion and vias towards the wires that won't move.
+      for ( size_t i=0 ; i<_groups.size() ; ++i ) {
+        Group& group = _groups[i];
+        group._costs.resize( group._candidates.size() );
+        for ( size_t j=0 ; j<group._candidates.size() ; ++j ) {
+          unsigned int depth = group._candidates[j];
+          float        cost  = _getCongestion( group, depth, overflowWeight );
+
+          for ( size_t k=0 ; k<group._fixedDepths.size() ; ++k )
+            cost += ViaCost * (float)abs( (int)depth - (int)group._fixedDepths[k] );
+
+          group._costs[j] = cost;
+        }
+      }
+
+    // Bottom-up: fold each subtree cost into its parent, remembering the
+    // best child candidate for every parent candidate.
+      for ( size_t i=order.size() ; i>1 ; --i ) {
+        Group& child = _groups[ order[i-1] ];
+        if (child._parent == order[i-1]) continue;
+
+        Group& parent = _groups[ child._parent ];
+        child._choices.assign( parent._candidates.size(), 0 );
+
+        for ( size_t j=0 ; j<parent._candidates.size() ; ++j ) {
+          float best = numeric_limits<float>::max();
+          for ( size_t k=0 ; k<child._candidates.size() ; ++k ) {
+            float cost = child._costs[k]
+                       + ViaCost * (float)abs( (int)parent._candidates[j] - (int)child._candidates[k] );
+            if (cost < best) { best = cost; child._choices[j] = k; }
+          }
+          parent._costs[j] += best;
+        }
+      }
+
+    // Top-down: pick the best candidate at each root, then follow choices.
+      for ( size_t i=0 ; i<order.size() ; ++i ) {
+        Group& group = _groups[ order[i] ];
+        if (group._parent == order[i]) {
+          group._assigned = min_element( group._costs.begin(), group._costs.end() ) - group._costs.begin();
+        } else
+          group._assigned = group._choices[ _groups[group._parent]._assigned ];
+
+        unsigned int depth = group._candidates[ group._assigned ];
+        if (depth != group._depth) _moves.push_back( make_pair(group._canonical,depth) );
+      }
+    }
+    catch ( ... ) {
+      _exception = current_exception();
+    }
+  }
+
+
+  size_t  DpNet::apply ()
+  {
+    if (_exception) rethrow_exception( _exception );
+
+    DebugSession::open( _net, 90 );
+    for ( size_t i=0 ; i<_moves.size() ; ++i ) {
+      ltrace(99) << "DP move to depth " << _moves[i].second << ": " << _moves[i].first << endl;
+      _moves[i].first->changeDepth( _moves[i].second, KbPropagate|KbWithNeighbors );
+    }
+    DebugSession::close();
+
+    size_t moveds = _moves.size();
+    _moves.clear();
+    _collected = false;
+    return moveds;
+  }
+
+
+  struct DpNetCompare {
+      inline bool  operator() ( const DpNet& lhs, const DpNet& rhs ) const
+      {
+        if (lhs.getCriticality() != rhs.getCriticality()) return lhs.getCriticality() > rhs.getCriticality();
+        return lhs.getNet()->getId() < rhs.getNet()->getId();
+      }
+  };
+
+
+  template< typename Action >
+  void  runDpNets ( vector<DpNet>& dpNets, size_t begin, size_t end, unsigned int threads, Action action )
+  {
+  // Traces are not thread-safe, keep them readable.
+    if (inltrace(500)) threads = 1;
+
+    std::atomic<size_t> next ( begin );
+    auto worker = [&dpNets,&next,end,action] () {
+      for ( size_t i=next++ ; i<end ; i=next++ ) action( dpNets[i] );
+    };
+
+    if ( (threads > 1) and (end-begin > 1) ) {
+      vector<std::thread> workers;
+      for ( unsigned int i=0 ; i<threads ; ++i ) workers.push_back( std::thread(worker) );
+      for ( size_t i=0 ; i<workers.size() ; ++i ) workers[i].join();
+    } else
+      worker();
+  }
+
+
+} // Anonymous namespace.
+
+
+
+
+namespace Katabatic {
+
+  using Hurricane::ForEachIterator;
+
+
+  void  KatabaticEngine::_layerAssignByDP ( unsigned long& total, unsigned long& global, set<Net*>& globalNets )
+  {
+    cmess1 << "  o  Assign Layer (tree dynamic programming)." << endl;
+
+    unsigned int threads = getLoadThreads();
+    if (not threads) threads = std::thread::hardware_concurrency();
+
+    vector<DpNet> dpNets;
+    forEach ( Net*, inet, getCell()->getNets() ) {
+      if (NetRoutingExtension::get(*inet)->isAutomaticGlobalRoute())
+        dpNets.push_back( DpNet(*inet) );
+    }
+
+  // The parallel stages only read densities, have them all up to date.
+    _gcellGrid->updateDensity();
+
+    runDpNets( dpNets, 0, dpNets.size(), threads, [] ( DpNet& dpNet ) { dpNet.measure(); } );
+    stable_sort( dpNets.begin(), dpNets.end(), DpNetCompare() );
+
+    size_t moveds = 0;
+    for ( size_t ibatch=0 ; ibatch<dpNets.size() ; ibatch+=BatchSize ) {
+      size_t iend = std::min( ibatch+BatchSize, dpNets.size() );
+
+      runDpNets( dpNets, ibatch, iend, threads, [] ( DpNet& dpNet ) { dpNet.plan(OverflowWeight); } );
+
+      for ( size_t i=ibatch ; i<iend ; ++i ) {
+        total += dpNets[i].getGroupsCount();
+        size_t netMoveds = dpNets[i].apply();
+        if (netMoveds) globalNets.insert( dpNets[i].getNet() );
+        moveds += netMoveds;
+      }
+
+      Session::revalidate();
+      _gcellGrid->updateDensity();
+    }
+    global += moveds;
+
+    cmess2 << Dots::asSizet("     - Moved aligned sets",moveds) << endl;
+
+  // Negociation: nets of a batch were planned against the same densities,
+  // replan serially the ones still crossing saturated GCells, with an
+  // increasing overflow cost.
+    float overflowWeight = OverflowWeight;
+    for ( unsigned int pass=0 ; pass<NegociatePasses ; ++pass ) {
+      overflowWeight *= NegociateFactor;
+
+      size_t passMoveds = 0;
+      for ( size_t i=0 ; i<dpNets.size() ; ++i ) {
+        dpNets[i].measure();
+        if (dpNets[i].getCriticality() <= 0.0) continue;
+
+        dpNets[i].plan( overflowWeight );
+        size_t netMoveds = dpNets[i].apply();
+        if (netMoveds) {
+          globalNets.insert( dpNets[i].getNet() );
+          Session::revalidate();
+        }
+        passMoveds += netMoveds;
+      }
+
+      cmess2 << Dots::asSizet("     - Negociation pass "+getString(pass+1),passMoveds) << endl;
+      global += passMoveds;
+      if (not passMoveds) break;
+    }
+  }
+
+
+}  // Katabatic namespace.
@@ -16,6 +16,9 @@
 
 #include <cstdlib>
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <exception>
 #include "hurricane/Bug.h"
 #include "hurricane/Error.h"
 #include "hurricane/Warning.h"
@@ -595,39 +598,6 @@ namespace {
   }
 
 
-  // ---------------------------------------------------------------
-  // Class  :  "ForkStack".
-
-  class ForkStack {
-    public:
-      inline void         push       ( Hook* from, AutoContact* contact );
-      inline void         pop        ();
-      inline Hook*        getFrom    () const;
-      inline AutoContact* getContact () const;
-    private:
-      struct Element {
-                 Hook*         _from;
-                 AutoContact*  _contact;
-          inline               Element ( Hook* from, AutoContact* contact );
-      };
-    private:
-      list<Element>  _stack;
-  };
-
-
-  inline              ForkStack::Element::Element ( Hook* from, AutoContact* contact ) : _from(from), _contact(contact) {}
-  inline void         ForkStack::pop              () { if (not _stack.empty()) _stack.pop_back(); }
-  inline Hook*        ForkStack::getFrom          ()  const { return _stack.empty() ? NULL : _stack.back()._from; }
-  inline AutoContact* ForkStack::getContact       ()  const { return _stack.empty() ? NULL : _stack.back()._contact; }
-
-
-  inline void  ForkStack::push ( Hook* from, AutoContact* contact )
-  {
-    ltrace(80) << "    Stacking " << from << " + " << contact << endl;
-    _stack.push_back( Element(from,contact) );
-  }
-
-
   // ---------------------------------------------------------------
   // Class  :  "GGellTopology".
 
@@ -637,9 +607,14 @@ namespace {
       static void          init              ( unsigned int degree );
       static void          fixSegments       ();
                            GCellTopology     ( GCellGrid*, Hook* fromHook, AutoContact* sourceContact=NULL );
-             void          construct         ( ForkStack& forks );
+             void          construct         ();
+             bool          isStraightLine    () const;
       inline unsigned int  getStateG         () const;
       inline GCell*        getGCell          () const;
+      inline AutoContact*  getSouthWestContact () const;
+      inline AutoContact*  getNorthEastContact () const;
+             void          getForks          ( bool isStart, vector< pair<Hook*,bool> >& ) const;
+      inline void          setSourceContact  ( AutoContact* );
       static void          doRp_AutoContacts ( GCell*, Component*, AutoContact*& source, AutoContact*& target, unsigned int flags );
       static AutoContact*  doRp_Access       ( GCell*, Component*, unsigned int  flags );
       static AutoContact*  doRp_AccessPad    ( Component*, unsigned int flags );
@@ -775,6 +750,9 @@ namespace {
 
   inline unsigned int  GCellTopology::getStateG () const { return _connexity.fields.globals; }
   inline GCell*        GCellTopology::getGCell  () const { return _gcell; }
+  inline AutoContact*  GCellTopology::getSouthWestContact () const { return _southWestContact; }
+  inline AutoContact*  GCellTopology::getNorthEastContact () const { return _northEastContact; }
+  inline void          GCellTopology::setSourceContact    ( AutoContact* contact ) { _sourceContact = contact; }
 
 
   vector<AutoSegment*>  GCellTopology::_toFixSegments;
@@ -905,7 +883,7 @@ namespace {
   }
 
 
-  void  GCellTopology::construct ( ForkStack& forks )
+  void  GCellTopology::construct ()
   {
     ltrace(99) << "GCellTopology::construct() [" << _connexity.connexity << "] in " << _gcell << endl;
     ltracein(99);
@@ -913,8 +891,6 @@ namespace {
     _southWestContact = NULL;
     _northEastContact = NULL;
 
-    bool straightLine = false;
-
     switch ( _connexity.connexity ) {
       case Conn_1G_1Pad:
       case Conn_2G_1Pad:
@@ -961,10 +937,7 @@ namespace {
       case Conn_3G_1M3:     _do_xG_xM3    (); break;
       case Conn_2G_1M1_1M2: _do_xG_1M1_1M2(); break;
       case Conn_2G:
-        if ( (_east and _west) or (_north and _south) ) {
-          straightLine = true;
-          break;
-        }
+        if (isStraightLine()) break;
       case Conn_3G:
       case Conn_4G:
         _do_xG();
@@ -985,77 +958,71 @@ namespace {
         _do_xG();
     }
 
-    if (straightLine) {
+    if (isStraightLine()) {
     // This a global router problem.
       cerr << Bug( "Unmanaged configuration: straight line in %s,\n"
                    "      The global routing seems to be defective."
                  , _net->_getString().c_str()
                  ) << endl;
+      ltraceout(99);
       return;
-    } else {
-      if (_sourceContact) {
-        AutoContact* targetContact
-          = ( getSegmentHookType(_fromHook) & (NorthBound|EastBound) )
-            ? _northEastContact : _southWestContact ;
-        AutoSegment* globalSegment = AutoSegment::create( _sourceContact
-                                                        , targetContact
-                                                        , static_cast<Segment*>( _fromHook->getComponent() )
-                                                        );
-        globalSegment->setFlags( (_degree == 2) ? SegBipoint : 0 );
-        
-        ltrace(99) << "Create global segment: " << globalSegment << endl;
+    }
+
+    if (_sourceContact) {
+      AutoContact* targetContact
+        = ( getSegmentHookType(_fromHook) & (NorthBound|EastBound) )
+          ? _northEastContact : _southWestContact ;
+      AutoSegment* globalSegment = AutoSegment::create( _sourceContact
+                                                      , targetContact
+                                                      , static_cast<Segment*>( _fromHook->getComponent() )
+                                                      );
+      globalSegment->setFlags( (_degree == 2) ? SegBipoint : 0 );
+      
+      ltrace(99) << "Create global segment: " << globalSegment << endl;
 
 #if THIS_IS_DEPRECATED
-        if ( globalSegment->isHorizontal()
-           and (  (Session::getRoutingGauge()->getLayerDepth(_sourceContact->getLayer()->getBottom()) > 1)
-               or (Session::getRoutingGauge()->getLayerDepth(targetContact ->getLayer()->getBottom()) > 1)) ) {
-          globalSegment->setLayer ( Session::getRoutingLayer(3) );
-          ltrace(99) << "Source:" << _sourceContact << endl;
-          ltrace(99) << "Target:" << targetContact << endl;
-          ltrace(99) << "Moving up global:" << globalSegment << endl;
-        }
+      if ( globalSegment->isHorizontal()
+         and (  (Session::getRoutingGauge()->getLayerDepth(_sourceContact->getLayer()->getBottom()) > 1)
+             or (Session::getRoutingGauge()->getLayerDepth(targetContact ->getLayer()->getBottom()) > 1)) ) {
+        globalSegment->setLayer ( Session::getRoutingLayer(3) );
+        ltrace(99) << "Source:" << _sourceContact << endl;
+        ltrace(99) << "Target:" << targetContact << endl;
+        ltrace(99) << "Moving up global:" << globalSegment << endl;
+      }
 #endif
-      // HARDCODED VALUE.
-        if ( (_topology & Global_Fixed) and (globalSegment->getLength() < 2*Session::getSliceHeight()) )
-          _toFixSegments.push_back( globalSegment );
-        
-        if (_connexity.fields.globals < 2) {
-          ltraceout(99);
-          return;
-        }
-      } else
-        _fromHook = NULL;
-    }
-
-    if ( _east and (_fromHook != _east) ) {
-      Hook* toHook = getSegmentOppositeHook( _east );
-      ltrace(99) << "Pushing East (to)   " << getString(toHook) << endl;
-      ltrace(99) << "Pushing East (from) " << _northEastContact << endl;
-      forks.push( toHook, _northEastContact );
-    }
-    if ( _west and (_fromHook != _west) ) {
-      Hook* toHook = getSegmentOppositeHook( _west );
-      ltrace(99) << "Pushing West (to)   " << getString(toHook) << endl;
-      ltrace(99) << "Pushing West (from) " << _southWestContact << endl;
-      forks.push( toHook, _southWestContact );
-    }
-    if ( _north and (_fromHook != _north) ) {
-      Hook* toHook = getSegmentOppositeHook( _north );
-      ltrace(99) << "Pushing North (to)   " << getString(toHook) << endl;
-      ltrace(99) << "Pushing North (from) " << _northEastContact << endl;
-      forks.push( toHook, _northEastContact );
-    }
-    if ( _south and (_fromHook != _south) ) {
-      Hook* toHook = getSegmentOppositeHook( _south );
-      ltrace(99) << "Pushing South (to)   " << getString(toHook) << endl;
-      ltrace(99) << "Pushing South (from) " << _southWestContact << endl;
-      forks.push( toHook, _southWestContact );
+    // HARDCODED VALUE.
+      if ( (_topology & Global_Fixed) and (globalSegment->getLength() < 2*Session::getSliceHeight()) )
+        _toFixSegments.push_back( globalSegment );
     }
 
     ltraceout(99);
   }
 
 
+  bool  GCellTopology::isStraightLine () const
+  {
+    if (_connexity.connexity != Conn_2G) return false;
+    return (_east and _west) or (_north and _south);
+  }
+
+
+  void  GCellTopology::getForks ( bool isStart, vector< pair<Hook*,bool> >& forks ) const
+  {
+  // Global segments to follow from this GCell, in the order the walk
+  // stacks them. The boolean tells if the segment is to be connected to
+  // the north-east contact (true) or to the south-west one (false).
+    if (isStraightLine()) return;
+    if (not isStart and (_connexity.fields.globals < 2)) return;
+
+    Hook* fromHook = (isStart) ? NULL : _fromHook;
+
+    if (_east  and (fromHook != _east )) forks.push_back( make_pair(getSegmentOppositeHook(_east ),true ) );
+    if (_west  and (fromHook != _west )) forks.push_back( make_pair(getSegmentOppositeHook(_west ),false) );
+    if (_north and (fromHook != _north)) forks.push_back( make_pair(getSegmentOppositeHook(_north),true ) );
+    if (_south and (fromHook != _south)) forks.push_back( make_pair(getSegmentOppositeHook(_south),false) );
+  }
+
+
   void  GCellTopology::doRp_AutoContacts ( GCell*        gcell
                                          , Component*    rp
                                          , AutoContact*& source
@@ -1975,6 +1942,244 @@ namespace {
   }
 
 
+  // ---------------------------------------------------------------
+  // Class  :  "NetTopology".
+  //
+  // The loading of one Net, split in two steps so the first one can be
+  // run by a pool of threads over a batch of Nets:
+  //   1. analyse(): read only on the global routing. Find the starting
+  //      GCell, then follow the global routing tree and make the
+  //      GCellTopology of each crossed GCell, in the very same order as
+  //      the former recursive walk.
+  //   2. build(): create the AutoContacts & AutoSegments. As neither the
+  //      Hurricane database nor the Session are thread-safe, it is done
+  //      by one thread, in Net order, so the result is deterministic.
+
+  class NetTopology {
+    public:
+      enum State { Unloaded=0, NoRoutingPad, LessThanTwo, Unconnected, SingleGCell, Tree };
+    public:
+                   NetTopology ( Net* );
+             void  analyse     ( GCellGrid* );
+             void  build       ( KatabaticEngine* );
+      inline Net*  getNet      () const;
+    private:
+      static const size_t  NoParent = (size_t)-1;
+      struct Fork {
+        inline Fork ( Hook*, size_t parent, bool northEast );
+        Hook*   _hook;
+        size_t  _parent;
+        bool    _northEast;
+      };
+      struct Node {
+        inline Node ( const GCellTopology&, size_t parent, bool northEast );
+        GCellTopology  _topology;
+        size_t         _parent;
+        bool           _northEast;
+      };
+    private:
+      Net*                _net;
+      State               _state;
+      size_t              _degree;
+      size_t              _unconnecteds;
+      vector<Node>        _nodes;
+      std::exception_ptr  _error;
+  };
+
+
+  inline Net* NetTopology::getNet () const { return _net; }
+
+  inline NetTopology::Fork::Fork ( Hook* hook, size_t parent, bool northEast )
+    : _hook(hook), _parent(parent), _northEast(northEast)
+  { }
+
+  inline NetTopology::Node::Node ( const GCellTopology& topology, size_t parent, bool northEast )
+    : _topology(topology), _parent(parent), _northEast(northEast)
+  { }
+
+
+  NetTopology::NetTopology ( Net* net )
+    : _net         (net)
+    , _state       (Unloaded)
+    , _degree      (0)
+    , _unconnecteds(0)
+    , _nodes       ()
+    , _error       ()
+  { }
+
+
+  void  NetTopology::analyse ( GCellGrid* gcellGrid )
+  {
+    ltrace(99) << "NetTopology::analyse() " << _net << endl;
+    ltracein(99);
+
+    try {
+      RoutingPads routingPads = _net->getRoutingPads();
+      _degree = routingPads.getSize();
+
+      if (_degree == 0) { _state = NoRoutingPad; ltraceout(99); return; }
+      if (_degree <  2) { _state = LessThanTwo;  ltraceout(99); return; }
+
+      Hook*  startHook   = NULL;
+      GCell* lowestGCell = NULL;
+      size_t connecteds  = 0;
+
+      ltrace(99) << "Start RoutingPad Ring" << endl;
+      forEach ( RoutingPad*, startRp, routingPads ) {
+        bool segmentFound = false;
+
+        forEach ( Hook*, ihook, startRp->getBodyHook()->getHooks() ) {
+          ltrace(99) << "Component " << ihook->getComponent() << endl;
+          Segment* segment = dynamic_cast<Segment*>( ihook->getComponent() );
+
+          if (segment) {
+            ++connecteds;
+            segmentFound = true;
+
+            GCellTopology  gcellConf ( gcellGrid, *ihook, NULL );
+            if (gcellConf.getStateG() == 1) {
+              if ( (lowestGCell == NULL) or (lowestGCell->getIndex() > gcellConf.getGCell()->getIndex()) ) {
+                ltrace(99) << "Starting from GCell " << gcellConf.getGCell() << endl;
+                lowestGCell = gcellConf.getGCell();
+                startHook   = *ihook;
+              }
+              break;
+            }
+          }
+        }
+
+        _unconnecteds += (segmentFound) ? 0 : 1;
+        if ( (_unconnecteds > 10) and (connecteds == 0) ) {
+          _state = Unconnected;
+          ltraceout(99);
+          return;
+        }
+      // Uncomment the next line to disable the lowest GCell search.
+      // (takes first GCell with exactly one global).
+      //if (startHook) break;
+      }
+
+      if (startHook == NULL) { _state = SingleGCell; ltraceout(99); return; }
+
+      _state = Tree;
+
+      vector<Fork>                forks;
+      vector< pair<Hook*,bool> >  nexts;
+
+      forks.push_back( Fork(startHook,NoParent,false) );
+      while ( not forks.empty() ) {
+        Fork fork = forks.back();
+        forks.pop_back();
+
+        ltrace(99) << "Popping (from) " << fork._hook << endl;
+        _nodes.push_back( Node( GCellTopology(gcellGrid,fork._hook,NULL), fork._parent, fork._northEast ) );
+
+        nexts.clear();
+        _nodes.back()._topology.getForks( (fork._parent == NoParent), nexts );
+        for ( size_t i=0 ; i<nexts.size() ; ++i )
+          forks.push_back( Fork(nexts[i].first,_nodes.size()-1,nexts[i].second) );
+      }
+    }
+    catch ( ... ) {
+    // Rethrown by build(), once the GCells walked so far are built.
+      _error = std::current_exception();
+    }
+
+    ltraceout(99);
+  }
+
+
+  void  NetTopology::build ( KatabaticEngine* ktbt )
+  {
+    ltrace(100) << "NetTopology::build() " << _net << endl;
+    ltracein(99);
+
+    switch ( _state ) {
+      case NoRoutingPad:
+        cmess2 << Warning("Net \"%s\" do not have any RoutingPad (ignored)."
+                         ,getString(_net->getName()).c_str()) << endl;
+        break;
+      case Unconnected:
+        cerr << Warning("More than 10 unconnected RoutingPads (%u) on %s, missing global routing?"
+                       ,_unconnecteds, getString(_net->getName()).c_str() ) << endl;
+
+        NetRoutingExtension::create( _net )->setFlags  ( NetRoutingState::Excluded );
+        NetRoutingExtension::create( _net )->unsetFlags( NetRoutingState::AutomaticGlobalRoute );
+        break;
+      case SingleGCell:
+        lookupClear();
+        GCellTopology::init( _degree );
+        singleGCell( ktbt, _net );
+        break;
+      case Tree:
+        lookupClear();
+        GCellTopology::init( _degree );
+
+        for ( size_t i=0 ; i<_nodes.size() ; ++i ) {
+          Node& node = _nodes[i];
+          if (node._parent != NoParent) {
+            const GCellTopology& parent = _nodes[node._parent]._topology;
+            node._topology.setSourceContact( (node._northEast) ? parent.getNorthEastContact()
+                                                               : parent.getSouthWestContact() );
+          }
+          node._topology.construct();
+        }
+        if (_error) break;
+
+        lookupClear();
+        Session::revalidate();
+        Session::revalidate();
+        GCellTopology::fixSegments();
+        break;
+      case LessThanTwo:
+      case Unloaded:
+        break;
+    }
+
+    vector<Node>().swap( _nodes );
+    ltraceout(99);
+
+    if (_error) std::rethrow_exception( _error );
+  }
+
+
+  void  analyseTopologies ( GCellGrid* gcellGrid, vector<NetTopology>& topologies, unsigned int threads )
+  {
+  // Traces are not thread-safe, keep them readable.
+    if (inltrace(99)) threads = 1;
+
+  // DebugSession is a singleton: traced nets are analysed afterwards,
+  // serially and inside their own session, like the build pass.
+    vector<size_t> traceds;
+    vector<size_t> untraceds;
+    for ( size_t i=0 ; i<topologies.size() ; ++i ) {
+      if ( (threads == 1) or DebugSession::isTraced(topologies[i].getNet()) )
+        traceds.push_back( i );
+      else
+        untraceds.push_back( i );
+    }
+
+    std::atomic<size_t> next ( 0 );
+    auto worker = [gcellGrid,&topologies,&untraceds,&next] () {
+      for ( size_t i=next++ ; i<untraceds.size() ; i=next++ )
+        topologies[ untraceds[i] ].analyse( gcellGrid );
+    };
+
+    if (untraceds.size() > 1) {
+      vector<std::thread> workers;
+      for ( unsigned int i=0 ; i<threads ; ++i ) workers.push_back( std::thread(worker) );
+      for ( size_t i=0 ; i<workers.size() ; ++i ) workers[i].join();
+    } else
+      worker();
+
+    for ( size_t i=0 ; i<traceds.size() ; ++i ) {
+      DebugSession::open( topologies[ traceds[i] ].getNet(), 80 );
+      topologies[ traceds[i] ].analyse( gcellGrid );
+      DebugSession::close();
+    }
+  }
+
+
 } // Anonymous namespace.
 
 
@@ -1999,17 +2204,38 @@ namespace Katabatic {
     cmess1 << "  o  Loading Nets global routing from Knik." << endl;
     cmess1 << Dots::asDouble("     - Saturation",getMeasure<double>(getCell(),"Sat.")->getData()) << endl;
 
+    unsigned int threads = getLoadThreads();
+    if (not threads) threads = std::thread::hardware_concurrency();
+    if (not threads) threads = 1;
+    cmess2 << Dots::asUInt("     - Topology threads",threads) << endl;
+
     startMeasures();
     Session::open( this );
 
+    vector<Net*> nets;
     forEach ( Net*, inet, getCell()->getNets() ) {
-      if (NetRoutingExtension::isAutomaticGlobalRoute(*inet)) {
-        DebugSession::open( *inet, 80 );
-        _loadNetGlobalRouting( *inet );
+      if (NetRoutingExtension::isAutomaticGlobalRoute(*inet))
+        nets.push_back( *inet );
+    }
+
+  // Nets are processed by batches to bound the memory used by the
+  // pending topologies.
+    const size_t batchSize = 4096;
+
+    for ( size_t ibatch=0 ; ibatch<nets.size() ; ibatch+=batchSize ) {
+      vector<NetTopology> topologies;
+      for ( size_t inet=ibatch ; (inet<ibatch+batchSize) and (inet<nets.size()) ; ++inet )
+        topologies.push_back( NetTopology(nets[inet]) );
+
+      analyseTopologies( getGCellGrid(), topologies, threads );
+
+      for ( size_t i=0 ; i<topologies.size() ; ++i ) {
+        DebugSession::open( topologies[i].getNet(), 80 );
+        topologies[i].build( this );
         Session::revalidate();
         DebugSession::close();
-      } 
-    } // forEach(Net*)
+      }
+    }
 
 #if defined(CHECK_DATABASE)
     _check ( "after Katabatic loading" );
@@ -2031,112 +2257,12 @@ namespace Katabatic {
     ltrace(100) << "Katabatic::_loadNetGlobalRouting( " << net << " )" << endl;
     ltracein(99);
 
-    ForkStack    forks;
-    Hook*        sourceHook    = NULL;
-    AutoContact* sourceContact = NULL;
-
-    lookupClear();
-
-    RoutingPads routingPads = net->getRoutingPads();
-    size_t      degree      = routingPads.getSize();
-
-    if (degree == 0) {
-        cmess2 << Warning("Net \"%s\" do not have any RoutingPad (ignored)."
-                         ,getString(net->getName()).c_str()) << endl;
-      ltraceout(99);
-      return;
-    }
-    if (degree < 2) {
-#if 0
-      if ( !getDemoMode() )
-        cmess2 << Warning("Net \"%s\" have less than 2 plugs/pins (ignored)."
-                         ,getString(net->getName()).c_str()) << endl;
-#endif
-      ltraceout(99);
-      return;
-    }
-
-    ltracein(99);
-    Hook*  startHook    = NULL;
-    GCell* lowestGCell  = NULL;
-    size_t unconnecteds = 0;
-    size_t connecteds   = 0;
-
-    GCellTopology::init( degree );
-
-    ltrace(99) << "Start RoutingPad Ring" << endl;
-    forEach ( RoutingPad*, startRp, routingPads ) {
-      bool segmentFound = false;
-
-      forEach ( Hook*, ihook, startRp->getBodyHook()->getHooks() ) {
-        ltrace(99) << "Component " << ihook->getComponent() << endl;
-        Segment* segment = dynamic_cast<Segment*>( ihook->getComponent() );
-
-        if (segment) {
-          ++connecteds;
-          segmentFound = true;
-
-          GCellTopology  gcellConf ( getGCellGrid(), *ihook, NULL );
-          if (gcellConf.getStateG() == 1) {
-            if ( (lowestGCell == NULL) or (lowestGCell->getIndex() > gcellConf.getGCell()->getIndex()) ) {
-              ltrace(99) << "Starting from GCell " << gcellConf.getGCell() << endl;
-              lowestGCell = gcellConf.getGCell();
-              startHook   = *ihook;
-            }
-            break;
-          }
-        }
-      }
-
-      unconnecteds += (segmentFound) ? 0 : 1;
-      if ( (unconnecteds > 10) and (connecteds == 0) ) {
-        cerr << Warning("More than 10 unconnected RoutingPads (%u) on %s, missing global routing?"
-                       ,unconnecteds, getString(net->getName()).c_str() ) << endl;
-
-        NetRoutingExtension::create( net )->setFlags  ( NetRoutingState::Excluded );
-        NetRoutingExtension::create( net )->unsetFlags( NetRoutingState::AutomaticGlobalRoute );
-        ltraceout(99);
-        return;
-      }
-    // Uncomment the next line to disable the lowest GCell search.
-    // (takes first GCell with exactly one global).
-    //if (startHook) break;
-    }
-    ltraceout(99);
-
-    if (startHook == NULL) { singleGCell( this, net ); ltraceout(99); return; }
-
-    GCellTopology  startGCellConf ( getGCellGrid(), startHook, NULL );
-    startGCellConf.construct( forks );
-
-    sourceHook    = forks.getFrom   ();
-    sourceContact = forks.getContact();
-    forks.pop();
-
-    while ( sourceHook ) {
-      GCellTopology  gcellConf ( getGCellGrid(), sourceHook, sourceContact );
-      gcellConf.construct( forks );
-
-      sourceHook    = forks.getFrom();
-      sourceContact = forks.getContact();
-      forks.pop();
-
-      ltrace(99) << "Popping (from) " << sourceHook << endl;
-      ltrace(99) << "Popping (to)   " << sourceContact << endl;
-    }
-
-    lookupClear();
-    Session::revalidate();
-    
-#if THIS_IS_DISABLED
-    set<AutoSegment*>::iterator iover = overconstraineds.begin();
-    for ( ; iover != overconstraineds.end() ; ++iover ) {
-      (*iover)->makeDogLeg( (*iover)->getAutoSource()->getGCell(), true );
-    }
-#endif
+    DebugSession::open( net, 80 );
+    NetTopology topology ( net );
+    topology.analyse( getGCellGrid() );
+    topology.build  ( this );
+    DebugSession::close();
 
-    Session::revalidate();
-    GCellTopology::fixSegments();
     ltraceout(99);
   }
 
@@ -72,6 +72,7 @@ extern "C" {
     LoadObjectConstant(dictionnary,EngineLayerAssignByLength,"EngineLayerAssignByLength");
     LoadObjectConstant(dictionnary,EngineLayerAssignByTrunk ,"EngineLayerAssignByTrunk" );
     LoadObjectConstant(dictionnary,EngineNoNetLayerAssign   ,"EngineNoNetLayerAssign"   );
+    LoadObjectConstant(dictionnary,EngineLayerAssignByDP    ,"EngineLayerAssignByDP"    );
   }
 
   
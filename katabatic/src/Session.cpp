@@ -67,7 +67,8 @@ namespace Katabatic {
 // -------------------------------------------------------------------
 // Class  :  "Katabatic::Session".
 
-  Session*  Session::_session = NULL;
+  Session*      Session::_session = NULL;
+  unsigned int  Session::_epoch   = 0;
 
 
   Session* Session::get ( const char* message )
@@ -128,6 +129,20 @@ namespace Katabatic {
   }
 
 
+  unsigned int  Session::_nextEpoch ()
+  {
+  // Epoch stamps replace a per call set of explored segments. On wrap
+  // around, clear the stale stamps so none is mistaken for the new one.
+    if (++_epoch == 0) {
+      const AutoSegmentLut& lut = _katabatic->_getAutoSegmentLut();
+      for ( size_t i=0 ; i<lut.size() ; ++i )
+        if (lut[i]) lut[i]->setEpoch( 0 );
+      ++_epoch;
+    }
+    return _epoch;
+  }
+
+
   void  Session::_canonize ()
   {
     ltrace(110) << "Katabatic::Session::_canonize()" << endl;
@@ -139,7 +154,7 @@ namespace Katabatic {
       return;
     }
 
-    set<Segment*>        exploredSegments;
+    unsigned int         epoch = _nextEpoch();
     vector<AutoSegment*> aligneds;
 
   // Should no longer be necessary to ensure determinism.
@@ -149,16 +164,17 @@ namespace Katabatic {
       AutoSegment* seedSegment = _segmentInvalidateds[i];
       AutoSegment* canonical   = seedSegment;
 
-      if (exploredSegments.find(seedSegment->base()) == exploredSegments.end()) {
+      if (seedSegment->getEpoch() != epoch) {
         ltrace(110) << "New chunk from: " << seedSegment << endl;
         aligneds.push_back( seedSegment );
+        seedSegment->setEpoch( epoch );
 
         bool isWeakGlobal = seedSegment->isGlobal();
         if (not seedSegment->isNotAligned()) {
           forEach ( AutoSegment*, aligned, seedSegment->getAligneds() ) {
             ltrace(110) << "Aligned: " << *aligned << endl;
             aligneds.push_back ( *aligned );
-            exploredSegments.insert ( aligned->base() );
+            aligned->setEpoch( epoch );
 
             isWeakGlobal = isWeakGlobal or aligned->isGlobal();
             if (AutoSegment::CompareId()( *aligned, canonical ))
@@ -201,6 +217,17 @@ namespace Katabatic {
   }
 
 
+  void  Session::_alignCanonicals ()
+  {
+    for ( size_t i=0 ; i<_segmentInvalidateds.size() ; ++i ) {
+      if (_segmentInvalidateds[i]->isCanonical()) {
+        if (_segmentInvalidateds[i]->isUnsetAxis()) _segmentInvalidateds[i]->toOptimalAxis();
+        else                                        _segmentInvalidateds[i]->toConstraintAxis();
+      }
+    }
+  }
+
+
   void  Session::_revalidateTopology ()
   {
     ltrace(110) << "Katabatic::Session::_revalidateTopology()" << endl;
@@ -215,14 +242,8 @@ namespace Katabatic {
       _katabatic->_computeNetOptimals  ( *inet );
       _katabatic->_computeNetTerminals ( *inet );
     }
-    _canonize ();
-
-    for ( size_t i=0 ; i<_segmentInvalidateds.size() ; ++i ) {
-      if (_segmentInvalidateds[i]->isCanonical()) {
-        if (_segmentInvalidateds[i]->isUnsetAxis()) _segmentInvalidateds[i]->toOptimalAxis();
-        else                                        _segmentInvalidateds[i]->toConstraintAxis();
-      }
-    }
+    _canonize       ();
+    _alignCanonicals();
     
     _netRevalidateds.clear();
     _netRevalidateds.swap( _netInvalidateds );
@@ -231,37 +252,47 @@ namespace Katabatic {
   }
 
 
-  size_t  Session::_revalidate ()
+  size_t  Session::_revalidateContacts ()
   {
-    ltrace(110) << "Katabatic::Session::revalidate()" << endl;
-    ltracein(110);
-
-    ltrace(110) << "_segmentInvalidateds.size(): " << _segmentInvalidateds.size() << endl;
-    ltrace(110) << "_autoContacts.size(): " << _autoContacts.size() << endl;
+    ltrace(110) << "AutoContacts Revalidate (after _revalidateTopology())." << endl;
 
+  // Updates may queue more contacts, do not cache the size.
     size_t count = 0;
+    for ( ; count < _autoContacts.size() ; ++count )
+      _autoContacts[count]->updateGeometry();
+    _autoContacts.clear();
 
-    if (not _netInvalidateds.empty()) _revalidateTopology();
+    return count;
+  }
 
-    ltrace(110) << "AutoContacts Revalidate (after _revalidateTopology())." << endl;
-    for ( size_t i=0 ; i < _autoContacts.size() ; i++, count++ )
-      _autoContacts[i]->updateGeometry();
-    _autoContacts.clear();
 
+  size_t  Session::_revalidateSegments ()
+  {
     ltrace(110) << "AutoSegments Revalidate (after AutoContact::updateGeometry())." << endl;
     ltrace(110) << "_segmentInvalidateds.size(): " << _segmentInvalidateds.size() << endl;
 
+    size_t count = 0;
+
     _segmentRevalidateds.clear();
-    for ( size_t i=0 ; i < _segmentInvalidateds.size() ; ++i, ++count ) {
-      _segmentInvalidateds[i]->revalidate();
+    _segmentRevalidateds.reserve( _segmentInvalidateds.size() );
+    for ( ; count < _segmentInvalidateds.size() ; ++count ) {
+      _segmentInvalidateds[count]->revalidate();
       if ( not _destroyedSegments.empty()
-         and (_destroyedSegments.find(_segmentInvalidateds[i]) != _destroyedSegments.end()) )
+         and (_destroyedSegments.find(_segmentInvalidateds[count]) != _destroyedSegments.end()) )
         continue;
 
-      _segmentRevalidateds.push_back( _segmentInvalidateds[i] );
+      _segmentRevalidateds.push_back( _segmentInvalidateds[count] );
     }
     _segmentInvalidateds.clear();
 
+    return count;
+  }
+
+
+  void  Session::_destroyRequesteds ()
+  {
+    if (_destroyedSegments.empty()) return;
+
     ltrace(110) << "AutoSegments/AutoContacts queued deletion." << endl;
     unsigned int flags = _katabatic->getFlags( EngineDestroyMask );
     _katabatic->setFlags( EngineDestroyMask );
@@ -275,6 +306,26 @@ namespace Katabatic {
     }
     _katabatic->setFlags( flags );
     set<AutoSegment*>().swap( _destroyedSegments );
+  }
+
+
+  size_t  Session::_revalidate ()
+  {
+    ltrace(110) << "Katabatic::Session::revalidate()" << endl;
+    ltracein(110);
+
+    ltrace(110) << "_segmentInvalidateds.size(): " << _segmentInvalidateds.size() << endl;
+    ltrace(110) << "_autoContacts.size(): " << _autoContacts.size() << endl;
+
+  // Phases: topology (canonize & constraint axis), contacts geometry,
+  // segments geometry, then the queued deletions.
+    size_t count = 0;
+
+    if (not _netInvalidateds.empty()) _revalidateTopology();
+
+    count += _revalidateContacts();
+    count += _revalidateSegments();
+    _destroyRequesteds();
 
     ltraceout(110);
 
@@ -50,7 +50,7 @@ namespace Katabatic {
   class AutoContact;
 
 
-  typedef  std::map<Contact*,AutoContact*>  AutoContactLut;
+  typedef  std::vector<AutoContact*>  AutoContactLut;   // Indexed by Contact::getId() - base.
 
 
 // -------------------------------------------------------------------
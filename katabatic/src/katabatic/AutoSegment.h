@@ -153,7 +153,7 @@ namespace Katabatic {
       inline  DbU::Unit           getTargetX                 () const;
       inline  DbU::Unit           getTargetY                 () const;
       inline  void                invert                     ();
-      inline  void                setLayer                   ( const Layer* );
+              void                setLayer                   ( const Layer* );
     // Predicates.                                           
       inline  bool                isHorizontal               () const;
       inline  bool                isVertical                 () const;
@@ -205,6 +205,7 @@ namespace Katabatic {
       inline  T*                  getObserver                ();
       inline  unsigned long       getId                      () const;
       inline  unsigned int        getFlags                   () const;
+      inline  unsigned int        getEpoch                   () const;
       virtual unsigned int        getDirection               () const = 0;
       inline  GCell*              getGCell                   () const;
       virtual size_t              getGCells                  ( vector<GCell*>& ) const = 0;
@@ -243,6 +244,7 @@ namespace Katabatic {
       inline  void                removeObserver             ( BaseObserver* );
       inline  void                unsetFlags                 ( unsigned int );
       inline  void                setFlags                   ( unsigned int );
+      inline  void                setEpoch                   ( unsigned int );
               void                setFlagsOnAligneds         ( unsigned int );
       inline  void                incReduceds                ();
       inline  void                decReduceds                ();
@@ -325,6 +327,7 @@ namespace Katabatic {
              unsigned int         _optimalMin : 8;
              unsigned int         _optimalMax : 8;
              unsigned int         _reduceds   : 2;
+             unsigned int         _epoch;
              DbU::Unit            _sourcePosition;
              DbU::Unit            _targetPosition;
              Interval             _userConstraints;
@@ -468,10 +471,11 @@ namespace Katabatic {
   inline  void            AutoSegment::unsetFlags           ( unsigned int flags ) { _flags &= ~flags; }
                                                             
   inline  unsigned int    AutoSegment::getFlags             () const { return _flags; }
+  inline  unsigned int    AutoSegment::getEpoch             () const { return _epoch; }
+  inline  void            AutoSegment::setEpoch             ( unsigned int epoch ) { _epoch = epoch; }
   inline  unsigned int    AutoSegment::_getFlags            () const { return _flags; }
   inline  void            AutoSegment::incReduceds          () { if (_reduceds<3) ++_reduceds; }
   inline  void            AutoSegment::decReduceds          () { if (_reduceds>0) --_reduceds; }
-  inline  void            AutoSegment::setLayer             ( const Layer* layer ) { base()->setLayer(layer); _depth=Session::getLayerDepth(layer); }
   inline  void            AutoSegment::setOptimalMin        ( DbU::Unit min ) { _optimalMin = (unsigned int)DbU::getLambda(min-getOrigin()); }
   inline  void            AutoSegment::setOptimalMax        ( DbU::Unit max ) { _optimalMax = (unsigned int)DbU::getLambda(max-getOrigin()); }
 //inline  void            AutoSegment::mergeUserConstraints ( const Interval& constraints ) { _userConstraints.intersection(constraints); }
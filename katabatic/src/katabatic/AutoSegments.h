@@ -73,7 +73,7 @@ namespace Katabatic {
   typedef GenericCollection<AutoSegment*>     AutoSegments;
   typedef GenericLocator<AutoSegment*>        AutoSegmentLocator;
   typedef GenericFilter<AutoSegment*>         AutoSegmentFilter;
-  typedef map<Segment*,AutoSegment*>          AutoSegmentLut;
+  typedef vector<AutoSegment*>                AutoSegmentLut;   // Indexed by Segment::getId() - base.
 
 
 // -------------------------------------------------------------------
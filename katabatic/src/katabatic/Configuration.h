@@ -83,12 +83,16 @@ namespace Katabatic {
       virtual unsigned int       getDirection       ( const Layer* ) const = 0;
       virtual float              getSaturateRatio   () const = 0;
       virtual size_t             getSaturateRp      () const = 0;
+      virtual unsigned int       getLoadThreads     () const = 0;
+      virtual bool               getGCellSnapshots  () const = 0;
       virtual DbU::Unit          getGlobalThreshold () const = 0;
       virtual size_t             getHEdgeCapacity   () const = 0;
       virtual size_t             getVEdgeCapacity   () const = 0;
       virtual void               setAllowedDepth    ( size_t ) = 0;
       virtual void               setSaturateRatio   ( float ) = 0;
       virtual void               setSaturateRp      ( size_t ) = 0;
+      virtual void               setLoadThreads     ( unsigned int ) = 0;
+      virtual void               setGCellSnapshots  ( bool ) = 0;
       virtual void               setGlobalThreshold ( DbU::Unit ) = 0;
       virtual void               print              ( Cell* ) const = 0;
       virtual Record*            _getRecord         () const = 0;
@@ -140,12 +144,16 @@ namespace Katabatic {
       virtual unsigned int           getDirection          ( const Layer* ) const;
       virtual float                  getSaturateRatio      () const;
       virtual size_t                 getSaturateRp         () const;
+      virtual unsigned int           getLoadThreads        () const;
+      virtual bool                   getGCellSnapshots     () const;
       virtual DbU::Unit              getGlobalThreshold    () const;
       virtual size_t                 getHEdgeCapacity      () const;
       virtual size_t                 getVEdgeCapacity      () const;
       virtual void                   setAllowedDepth       ( size_t );
       virtual void                   setSaturateRatio      ( float );
       virtual void                   setSaturateRp         ( size_t );
+      virtual void                   setLoadThreads        ( unsigned int );
+      virtual void                   setGCellSnapshots     ( bool );
       virtual void                   setGlobalThreshold    ( DbU::Unit );
       virtual void                   print                 ( Cell* ) const;
       virtual Record*                _getRecord            () const;
@@ -161,6 +169,8 @@ namespace Katabatic {
       std::vector<DbU::Unit>  _extensionCaps;
       float                   _saturateRatio;
       size_t                  _saturateRp;
+      unsigned int            _loadThreads;
+      bool                    _gcellSnapshots;
       DbU::Unit               _globalThreshold;
       size_t                  _allowedDepth;
       size_t                  _hEdgeCapacity;
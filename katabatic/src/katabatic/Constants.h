@@ -63,6 +63,7 @@ namespace Katabatic {
                        , EngineDestroyBaseContact  = 0x00000004
                        , EngineDestroyBaseSegment  = 0x00000008
                        , EngineDestroyMask         = EngineDestroyBaseContact|EngineDestroyBaseSegment
+                       , EngineKnikLayerAssign     = 0x00000010
                        };
 
   enum EngineAlgorithm { EngineLoadGrByNet         = 0x00000001
@@ -70,6 +71,7 @@ namespace Katabatic {
                        , EngineLayerAssignByLength = 0x00000004
                        , EngineLayerAssignByTrunk  = 0x00000008
                        , EngineNoNetLayerAssign    = 0x00000010
+                       , EngineLayerAssignByDP     = 0x00000020
                        };
 
 
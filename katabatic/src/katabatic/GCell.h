@@ -65,9 +65,11 @@ namespace Katabatic {
 // -------------------------------------------------------------------
 // Class  :  "Katabatic::GCell".
 
-  enum GCellFlag { GCellInvalidated = 0x00000001
-                 , GCellSaturated   = 0x00000002
-                 , GCellUnderIoPad  = 0x00000004
+  enum GCellFlag { GCellInvalidated          = 0x00000001
+                 , GCellSaturated            = 0x00000002
+                 , GCellUnderIoPad           = 0x00000004
+                 , GCellUnsorted             = 0x00000008
+                 , GCellFragmentsInvalidated = 0x00000010
                  };
 
  
@@ -163,12 +165,13 @@ namespace Katabatic {
               bool                        checkEdgeSaturation ( size_t hreserved, size_t vreserved) const;
     // Modifiers.                         
               void                        addBlockage         ( unsigned int depth, DbU::Unit );
-      inline  void                        addHSegment         ( AutoSegment* );
-      inline  void                        addVSegment         ( AutoSegment* );
+              void                        addHSegment         ( AutoSegment* );
+              void                        addVSegment         ( AutoSegment* );
       inline  void                        addContact          ( AutoContact* );
               void                        removeVSegment      ( AutoSegment* );
               void                        removeHSegment      ( AutoSegment* );
               void                        removeContact       ( AutoContact* );
+              void                        changeSegmentDepth  ( AutoSegment*, unsigned int from, unsigned int to );
               void                        updateContacts      ();
               size_t                      updateDensity       ();
       inline  void                        updateKey           ( unsigned int depth );
@@ -187,8 +190,13 @@ namespace Katabatic {
               Record*                     _getRecord          () const;
               string                      _getString          () const;
       inline  string                      _getTypeName        () const;
-              void                        _xmlWrite           ( ostream& o ) const;
 
+    private:
+              void                        _updatePassThrough  ( unsigned int depth, int delta );
+              void                        _computeDensity     ( unsigned int depth );
+              void                        _updateSaturated    ();
+              void                        _updateFragments    ();
+              void                        _sortSegments       ();
     private:
     // Static Attributes.
       static  const Name            _goName;
@@ -209,6 +217,10 @@ namespace Katabatic {
               float*                _feedthroughs;
               float*                _fragmentations;
               float*                _globalsCount;
+              unsigned int*         _passCounts;
+              DbU::Unit*            _localLengths;
+              float*                _localFeedthroughs;
+              float*                _localGlobals;
               unsigned int          _flags;
               Key                   _key;
 
@@ -249,7 +261,7 @@ namespace Katabatic {
   inline  const vector<AutoSegment*>& GCell::getHSegments () const { return _hsegments; }
   inline  const vector<AutoContact*>& GCell::getContacts  () const { return _contacts; }
   inline  string                      GCell::_getTypeName () const { return _TName("GCell"); }
-  inline  void                        GCell::invalidateCt () { _flags |= GCellInvalidated; }
+  inline  void                        GCell::invalidateCt () { _flags |= GCellInvalidated|GCellFragmentsInvalidated; }
   inline  void                        GCell::setUnderIoPad() { _flags |= GCellUnderIoPad; }
   inline  const GCell::Key&           GCell::getKey       () const { return _key; }
   inline  void                        GCell::updateKey    ( unsigned int depth ) { _key.update(depth); }
@@ -267,7 +279,7 @@ namespace Katabatic {
   { if (not isValid() and not(flags & NoUpdate)) const_cast<GCell*>(this)->updateDensity(); return _densities[depth]; }
 
   inline  float  GCell::getFragmentation ( unsigned int depth ) const
-  { if (not isValid()) const_cast<GCell*>(this)->updateDensity(); return _fragmentations[depth]; }
+  { if (_flags & GCellFragmentsInvalidated) const_cast<GCell*>(this)->_updateFragments(); return _fragmentations[depth]; }
 
   inline  float  GCell::getFeedthroughs ( unsigned int depth ) const
   { if (not isValid()) const_cast<GCell*>(this)->updateDensity(); return _feedthroughs[depth]; }
@@ -278,12 +290,6 @@ namespace Katabatic {
   inline  DbU::Unit  GCell::getBlockage ( unsigned int depth ) const
   { return (depth<_depth) ? _blockages[depth] : 0; }
 
-  inline  void  GCell::addVSegment ( AutoSegment* segment )
-  { invalidateCt(); _vsegments.push_back(segment); }
-
-  inline  void  GCell::addHSegment ( AutoSegment* segment )
-  { invalidateCt(); _hsegments.push_back(segment); }
-
   inline  void  GCell::addContact ( AutoContact* contact )
   { invalidateCt(); _contacts.push_back(contact); }
 
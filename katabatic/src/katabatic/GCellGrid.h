@@ -62,7 +62,7 @@ namespace Katabatic {
               size_t           updateDensity       ();
               void             updateContacts      ( unsigned int flags=KbOpenSession );
       inline  void             setDensityMode      ( unsigned int );
-              void             _xmlWrite           ( ostream& );
+              void             saveSnapshot        ( const string& path, const string& stage );
       virtual Record*          _getRecord          () const;
       virtual string           _getString          () const;
       virtual string           _getTypeName        () const;
@@ -0,0 +1,99 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |        K a t a b a t i c  -  Routing Toolbox                    |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :   "./katabatic/GridSnapshotFormat.h"             |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KATABATIC_GRID_SNAPSHOT_FORMAT_H
+#define  KATABATIC_GRID_SNAPSHOT_FORMAT_H
+
+#include <stdint.h>
+
+
+namespace Katabatic {
+
+
+// -------------------------------------------------------------------
+// Binary GCellGrid snapshot (.kgs).
+//
+// Written by GCellGrid::saveSnapshot(), read by the standalone kgsdump
+// tool. The layout is columnar so one map (say, the densities of one
+// depth) is a single contiguous array. Every section starts on an
+// 8 bytes boundary, in the native byte order:
+//
+//   [KgsHeader]
+//   [int64  x graduations x (columns+1)]
+//   [int64  y graduations x (rows+1)]
+//   [float  densities     x stride  ] x depth
+//   [float  feedthroughs  x stride  ] x depth
+//   [float  cDensity      x nbGCells]
+//   [float  hCapacity     x nbGCells]
+//   [float  vCapacity     x nbGCells]
+//   [uint32 flags         x nbGCells]
+//
+// Each per-depth array is padded to 8 bytes too, so the densities of
+// depth d start at float d*stride, with stride = kgsFloatStride(nbGCells)
+// (nbGCells rounded up to an even count).
+//
+// GCells are stored in the grid index order (column + row*columns).
+// Coordinates are in DbU. In flags, bit <depth> tells if the GCell is
+// saturated at that depth and KgsSaturated if it is saturated at all.
+
+
+  const char      KgsMagic[4]       = { 'K', 'G', 'S', 'S' };
+  const uint32_t  KgsVersion        = 1;
+  const uint32_t  KgsEndianness     = 0x01020304;
+  const uint32_t  KgsMaxDepth       = 16;
+  const uint32_t  KgsNameSize       = 64;
+  const uint32_t  KgsLayerNameSize  = 16;
+  const uint32_t  KgsSaturated      = 0x80000000;
+
+
+  struct KgsHeader {
+    char      _magic[4];
+    uint32_t  _version;
+    uint32_t  _endianness;
+    uint32_t  _depth;            // Number of routing layers.
+    uint32_t  _columns;
+    uint32_t  _rows;
+    uint64_t  _nbGCells;
+    float     _saturateRatio;
+    uint32_t  _hEdgeCapacity;    // Of the GCellGrid, in tracks.
+    uint32_t  _vEdgeCapacity;
+    uint32_t  _reserved;
+    uint64_t  _xGradsOffset;
+    uint64_t  _yGradsOffset;
+    uint64_t  _densitiesOffset;
+    uint64_t  _feedthroughsOffset;
+    uint64_t  _cDensitiesOffset;
+    uint64_t  _hCapacitiesOffset;
+    uint64_t  _vCapacitiesOffset;
+    uint64_t  _flagsOffset;
+    uint64_t  _size;             // Of the whole file.
+    char      _cellName[KgsNameSize];
+    char      _stage   [KgsNameSize];
+    char      _layers  [KgsMaxDepth][KgsLayerNameSize];
+  };
+
+
+  inline uint64_t  kgsAlign ( uint64_t size )
+  { return (size + 7) & ~(uint64_t)7; }
+
+
+  inline uint64_t  kgsFloatStride ( uint64_t nbGCells )
+  { return kgsAlign( nbGCells*sizeof(float) ) / sizeof(float); }
+
+
+}  // Katabatic namespace.
+
+#endif  // KATABATIC_GRID_SNAPSHOT_FORMAT_H
@@ -27,6 +27,7 @@
 #include  "hurricane/Torus.h"
 #include  "hurricane/Layer.h"
 #include  "hurricane/Net.h"
+#include  "hurricane/Segment.h"
 #include  "hurricane/NetRoutingProperty.h"
 
 namespace Hurricane {
@@ -122,11 +123,12 @@ namespace Katabatic {
       inline  DbU::Unit               getGlobalThreshold        () const;
       inline  float                   getSaturateRatio          () const;
       inline  size_t                  getSaturateRp             () const;
+      inline  unsigned int            getLoadThreads            () const;
+      inline  bool                    getGCellSnapshots         () const;
       inline  DbU::Unit               getExtensionCap           () const;
       inline  const ChipTools&        getChipTools              () const;
       inline  const NetRoutingStates& getNetRoutingStates       () const;
-              void                    xmlWriteGCellGrid         ( ostream& );
-              void                    xmlWriteGCellGrid         ( const string& );
+              void                    saveGCellGrid             ( const string& path, const string& stage="" );
     // Modifiers.                                               
       inline  void                    setState                  ( EngineState state );
       inline  void                    setFlags                  ( unsigned int );
@@ -134,6 +136,8 @@ namespace Katabatic {
       inline  void                    setGlobalThreshold        ( DbU::Unit );
       inline  void                    setSaturateRatio          ( float );
       inline  void                    setSaturateRp             ( size_t );
+      inline  void                    setLoadThreads            ( unsigned int );
+      inline  void                    setGCellSnapshots         ( bool );
               void                    startMeasures             ();
               void                    stopMeasures              ();
               void                    printMeasures             ( const string& ) const;
@@ -165,8 +169,8 @@ namespace Katabatic {
               void                    _link                     ( AutoSegment* );
               void                    _unlink                   ( AutoContact* );
               void                    _unlink                   ( AutoSegment* );
-              AutoContact*            _lookup                   ( Contact* ) const;
-              AutoSegment*            _lookup                   ( Segment* ) const;
+      inline  AutoContact*            _lookup                   ( Contact* ) const;
+      inline  AutoSegment*            _lookup                   ( Segment* ) const;
               void                    _destroyAutoSegments      ();
               void                    _destroyAutoContacts      ();
               void                    _loadGrByNet              ();
@@ -178,6 +182,8 @@ namespace Katabatic {
               void                    _layerAssignByLength      ( Net*, unsigned long& total, unsigned long& global, set<Net*>& );
               void                    _layerAssignByTrunk       ( unsigned long& total, unsigned long& global, set<Net*>& );
               void                    _layerAssignByTrunk       ( Net*, set<Net*>&, unsigned long& total, unsigned long& global );
+              void                    _layerAssignByDP          ( unsigned long& total, unsigned long& global, set<Net*>& );
+              void                    _snapshotGCellGrid        ( const string& stage );
               void                    _saveNet                  ( Net* );
               void                    _print                    () const;
               void                    _print                    ( Net* ) const;
@@ -199,6 +205,8 @@ namespace Katabatic {
               ChipTools         _chipTools;
               AutoSegmentLut    _autoSegmentLut;
               AutoContactLut    _autoContactLut;
+              unsigned int      _autoSegmentBase;
+              unsigned int      _autoContactBase;
               NetRoutingStates  _netRoutingStates;
 
     protected:
@@ -226,6 +234,8 @@ namespace Katabatic {
   inline void                           KatabaticEngine::unsetFlags                ( unsigned int flags ) { _flags &= ~flags; }
   inline void                           KatabaticEngine::setSaturateRatio          ( float ratio ) { _configuration->setSaturateRatio(ratio); }
   inline void                           KatabaticEngine::setSaturateRp             ( size_t threshold ) { _configuration->setSaturateRp(threshold); }
+  inline void                           KatabaticEngine::setLoadThreads            ( unsigned int threads ) { _configuration->setLoadThreads(threads); }
+  inline void                           KatabaticEngine::setGCellSnapshots         ( bool state ) { _configuration->setGCellSnapshots(state); }
   inline void                           KatabaticEngine::setGlobalThreshold        ( DbU::Unit threshold ) { _configuration->setGlobalThreshold(threshold); }
   inline unsigned int                   KatabaticEngine::getFlags                  ( unsigned int mask ) const { return _flags & mask; }
   inline EngineState                    KatabaticEngine::getState                  () const { return _state; }
@@ -238,6 +248,8 @@ namespace Katabatic {
   inline DbU::Unit                      KatabaticEngine::getGlobalThreshold        () const { return _configuration->getGlobalThreshold(); }
   inline float                          KatabaticEngine::getSaturateRatio          () const { return _configuration->getSaturateRatio(); }
   inline size_t                         KatabaticEngine::getSaturateRp             () const { return _configuration->getSaturateRp(); }
+  inline unsigned int                   KatabaticEngine::getLoadThreads            () const { return _configuration->getLoadThreads(); }
+  inline bool                           KatabaticEngine::getGCellSnapshots         () const { return _configuration->getGCellSnapshots(); }
   inline const AutoContactLut&          KatabaticEngine::_getAutoContactLut        () const { return _autoContactLut; }
   inline const AutoSegmentLut&          KatabaticEngine::_getAutoSegmentLut        () const { return _autoSegmentLut; }
   inline void                           KatabaticEngine::setState                  ( EngineState state ) { _state = state; }
@@ -246,6 +258,28 @@ namespace Katabatic {
   inline const NetRoutingStates&        KatabaticEngine::getNetRoutingStates       () const { return _netRoutingStates; }
 
 
+// The look-up tables are indexed by the Hurricane Entity identifier of
+// the base component, minus the lowest one linked (the base). As ids are
+// allocated in sequence, a table spans the ids created from the first to
+// the last component wrapped, not the whole DataBase. Components created
+// meanwhile by other tools leave holes (NULL slots).
+
+  inline AutoSegment* KatabaticEngine::_lookup ( Segment* segment ) const
+  {
+    if (not segment or (segment->getId() < _autoSegmentBase)) return NULL;
+    unsigned int index = segment->getId() - _autoSegmentBase;
+    return (index < _autoSegmentLut.size()) ? _autoSegmentLut[ index ] : NULL;
+  }
+
+
+  inline AutoContact* KatabaticEngine::_lookup ( Contact* contact ) const
+  {
+    if (not contact or (contact->getId() < _autoContactBase)) return NULL;
+    unsigned int index = contact->getId() - _autoContactBase;
+    return (index < _autoContactLut.size()) ? _autoContactLut[ index ] : NULL;
+  }
+
+
 // -------------------------------------------------------------------
 // Global Variables.
 
@@ -140,8 +140,13 @@ namespace Katabatic {
              inline void                        _invalidate           ( AutoContact* );
              inline void                        _invalidate           ( AutoSegment* );
              inline void                        _destroyRequest       ( AutoSegment* );
+                    unsigned int                _nextEpoch            ();
                     void                        _canonize             ();
+                    void                        _alignCanonicals      ();
                     void                        _revalidateTopology   ();
+                    size_t                      _revalidateContacts   ();
+                    size_t                      _revalidateSegments   ();
+                    void                        _destroyRequesteds    ();
                     size_t                      _revalidate           ();
                     DbU::Unit                   _getPitch             ( size_t depth, unsigned int flags ) const;
                     Record*                     _getRecord            () const;
@@ -150,6 +155,7 @@ namespace Katabatic {
                                    
     protected:                     
       static Session*              _session;
+      static unsigned int          _epoch;
              KatabaticEngine*      _katabatic;
              Technology*           _technology;
              CellGauge*            _cellGauge;
@@ -15,7 +15,10 @@
 
 
 #include <map>
-#include <list>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include "hurricane/DebugSession.h"
 #include "hurricane/Error.h"
 #include "hurricane/Warning.h"
@@ -31,7 +34,7 @@
 #include "hurricane/Instance.h"
 #include "hurricane/Plug.h"
 #include "hurricane/Path.h"
-#include "hurricane/Query.h"
+#include "hurricane/Cell.h"
 #include "crlcore/AllianceFramework.h"
 #include "katabatic/GCell.h"
 #include "katabatic/GCellGrid.h"
@@ -66,9 +69,8 @@ namespace {
   using Hurricane::Instance;
   using Hurricane::Plug;
   using Hurricane::Path;
-  using Hurricane::Query;
-  using Hurricane::Go;
-  using Hurricane::Rubber;
+  using Hurricane::Cell;
+  using Hurricane::Component;
   using Hurricane::Layer;
   using Hurricane::BasicLayer;
   using Hurricane::RegularLayer;
@@ -451,6 +453,17 @@ namespace {
 
 // -------------------------------------------------------------------
 // Class  :  "::PowerRailsPlanes".
+//
+// Power rails elements are first accumulated as flat RailShapes (box
+// already in the top cell coordinates and root net resolved). They
+// are then merged in two passes:
+//   1. In parallel, per vertical strip (tile) of the top cell, shapes
+//      of the same rail (plane, net, direction, axis, width) are sorted
+//      and their overlapping spans fused.
+//   2. Serially, the fused spans of all the tiles are fused again to
+//      join the rails crossing tiles boundaries.
+// Only geometrical data is touched by the threads, the Hurricane
+// database (components & Tracks creation) is updated afterwards.
 
   class PowerRailsPlanes {
     public:
@@ -466,29 +479,14 @@ namespace {
           inline RoutingPlane* getRoutingPlane   () const;
           inline unsigned int  getDirection      () const;
           inline Net*          getNet            () const;
-                 void          merge             ( DbU::Unit source, DbU::Unit target );
+          inline void          addChunk          ( const Interval& );
                  void          doLayout          ( const Layer* );
                  string        _getString        () const;
         private:
-          Rails*         _rails;
-          DbU::Unit      _axis;
-          DbU::Unit      _width;
-          list<Interval> _chunks;
-      };
-
-    private:
-      class RailCompare {
-        public:
-          bool operator() ( const Rail* lhs, const Rail* rhs );
-      };
-
-      class RailMatch : public unary_function<Rail*,bool> {
-        public:
-          inline      RailMatch  ( DbU::Unit axis, DbU::Unit width );
-          inline bool operator() ( const Rail* );
-        private:
-          DbU::Unit  _axis;
-          DbU::Unit  _width;
+          Rails*            _rails;
+          DbU::Unit         _axis;
+          DbU::Unit         _width;
+          vector<Interval>  _chunks;
       };
 
     public:
@@ -500,7 +498,7 @@ namespace {
           inline RoutingPlane* getRoutingPlane   ();
           inline unsigned int  getDirection      () const;
           inline Net*          getNet            () const;
-                 void          merge             ( const Box& );
+                 Rail*         addRail           ( DbU::Unit axis, DbU::Unit width );
                  void          doLayout          ( const Layer* );
         private:
           Plane*         _plane;
@@ -520,7 +518,8 @@ namespace {
           inline RoutingPlane* getRoutingPlane   ();
           inline unsigned int  getDirection      () const;
           inline unsigned int  getPowerDirection () const;
-                 void          merge             ( const Box&, Net* );
+                 unsigned int  getRailDirection  ( const Net* ) const;
+                 Rails*        getRails          ( Net*, unsigned int direction );
                  void          doLayout          ();
         private:
           const Layer*         _layer;
@@ -530,25 +529,45 @@ namespace {
           unsigned int         _powerDirection;
       };
 
+    public:
+      class RailShape {
+        public:
+                        RailShape  ( Plane*, Net*, const Box& );
+        public:
+          Plane*        _plane;
+          Net*          _net;
+          unsigned int  _direction;
+          DbU::Unit     _axis;
+          DbU::Unit     _width;
+          Interval      _span;
+      };
+
+    private:
+      class RailShapeCompare {
+        public:
+          bool operator() ( const RailShape& lhs, const RailShape& rhs ) const;
+      };
+
     public:
       typedef  map<const BasicLayer*,Plane*,BasicLayer::CompareByMask>  PlanesMap;
+      typedef  vector<RailShape>                                         RailShapes;
     public:
                     PowerRailsPlanes       ( KiteEngine* );
                    ~PowerRailsPlanes       ();
       inline Net*   getRootNet             ( Net*, Path );
       inline bool   isCoreClockNetRouted   ( const Net* ) const;
+      inline size_t getShapesCount         () const;
              bool   hasPlane               ( const BasicLayer* );
-             bool   setActivePlane         ( const BasicLayer* );
-      inline Plane* getActivePlane         () const;
-      inline Plane* getActiveBlockagePlane () const;
-             void   merge                  ( const Box&, Net* );
+             void   addShape               ( const BasicLayer*, const Box&, Net* );
+             void   mergeShapes            ( unsigned int threads );
              void   doLayout               ();
+      static bool   isSameRail             ( const RailShape&, const RailShape& );
+      static void   fuseShapes             ( RailShapes& );
     private:
       KiteEngine*     _kite;
       GlobalNetTable  _globalNets;
       PlanesMap       _planes;
-      Plane*          _activePlane;
-      Plane*          _activeBlockagePlane;
+      RailShapes      _shapes;
   };
 
 
@@ -571,63 +590,7 @@ namespace {
   inline RoutingPlane*            PowerRailsPlanes::Rail::getRoutingPlane  () const { return _rails->getRoutingPlane(); }
   inline unsigned int             PowerRailsPlanes::Rail::getDirection     () const { return _rails->getDirection(); }
   inline Net*                     PowerRailsPlanes::Rail::getNet           () const { return _rails->getNet(); }
-
-
-  void  PowerRailsPlanes::Rail::merge ( DbU::Unit source, DbU::Unit target )
-  {
-    Interval chunkToMerge ( source, target );
-    ltrace(300) << "    Rail::merge() "
-                << ((getDirection()==KbHorizontal) ? "Horizontal" : "Vertical")
-                << " " << chunkToMerge << endl;
-    ltrace(300) << "    | " << _getString() << endl;
-
-    list<Interval>::iterator imerge = _chunks.end();
-    list<Interval>::iterator ichunk = _chunks.begin();
-
-    while ( ichunk != _chunks.end() ) {
-      if (imerge == _chunks.end()) {
-        if (chunkToMerge.getVMax() < (*ichunk).getVMin()) {
-          ltrace(300) << "    | Insert before " << *ichunk << endl;
-          imerge = _chunks.insert( ichunk, chunkToMerge );
-          break;
-        }
-
-        if (chunkToMerge.intersect(*ichunk)) {
-          ltrace(300) << "    | Merge with " << *ichunk << endl;
-          imerge = ichunk;
-          (*imerge).merge( chunkToMerge );
-        }
-      } else {
-        if (chunkToMerge.getVMax() >= (*ichunk).getVMin()) {
-          (*imerge).merge( *ichunk );
-          ltrace(300) << "    | Absorb (erase) " << *ichunk << endl;
-          ichunk = _chunks.erase( ichunk );
-          continue;
-        } else
-          break;
-      }
-
-      // if (chunkToMerge.intersect(*ichunk)) {
-      //   if (imerge == _chunks.end()) {
-      //     ltrace(300) << "    | Merge with " << *ichunk << endl;
-      //     imerge = ichunk;
-      //     (*imerge).merge( chunkToMerge );
-      //   } else {
-      //     (*imerge).merge( *ichunk );
-      //     ltrace(300) << "    | Absorb (erase) " << *ichunk << endl;
-      //     ichunk = _chunks.erase( ichunk );
-      //     continue;
-      //   }
-      // }
-      ++ichunk;
-    }
-
-    if (imerge == _chunks.end()) {
-      _chunks.insert( ichunk, chunkToMerge );
-      ltrace(300) << "    | Insert at end " << DbU::getValueString(_axis) << " " << chunkToMerge << endl;
-      ltrace(300) << "    | " << _getString() << endl;
-    }
-  }
+  inline void                     PowerRailsPlanes::Rail::addChunk         ( const Interval& chunk ) { _chunks.push_back(chunk); }
 
 
   void  PowerRailsPlanes::Rail::doLayout ( const Layer* layer )
@@ -662,11 +625,9 @@ namespace {
     // }
 
     if ( getDirection() == KbHorizontal ) {
-      list<Interval>::iterator ichunk     = _chunks.begin();
-      list<Interval>::iterator ichunknext = ichunk;
-      ++ichunknext;
-
-      for ( ; ichunk != _chunks.end() ; ++ichunk, ++ichunknext ) {
+      vector<Interval>::iterator ichunk = _chunks.begin();
+      for ( ; ichunk != _chunks.end() ; ++ichunk ) {
+        vector<Interval>::iterator ichunknext = ichunk + 1;
 
         if (ichunknext != _chunks.end()) {
           if ((*ichunk).intersect(*ichunknext))
@@ -706,7 +667,7 @@ namespace {
         }
       }
     } else {
-      list<Interval>::iterator ichunk = _chunks.begin();
+      vector<Interval>::iterator ichunk = _chunks.begin();
       for ( ; ichunk != _chunks.end() ; ichunk++ ) {
         ltrace(300) << "  chunk: [" << DbU::getValueString((*ichunk).getVMin())
                     << ":" << DbU::getValueString((*ichunk).getVMax()) << "]" << endl;
@@ -748,7 +709,7 @@ namespace {
     os << "<Rail " << ((getDirection()==KbHorizontal) ? "Horizontal" : "Vertical")
        << " @"  << DbU::getValueString(_axis)  << " "
        << " w:" << DbU::getValueString(_width) << " ";
-    list<Interval>::const_iterator ichunk = _chunks.begin();
+    vector<Interval>::const_iterator ichunk = _chunks.begin();
     for ( ; ichunk != _chunks.end() ; ++ichunk ) {
       if (ichunk != _chunks.begin()) os << " ";
       os << "[" << DbU::getValueString((*ichunk).getVMin())
@@ -759,23 +720,6 @@ namespace {
   }
 
 
-  inline bool  PowerRailsPlanes::RailCompare::operator() ( const Rail* lhs, const Rail* rhs )
-  {
-    if ( lhs->getAxis () < rhs->getAxis () ) return true;
-    if ( lhs->getWidth() < rhs->getWidth() ) return true;
-    return false;
-  }
-
-
-  inline  PowerRailsPlanes::RailMatch::RailMatch ( DbU::Unit axis, DbU::Unit width )
-    : _axis(axis)
-    , _width(width)
-  { }
-
-
-  inline bool  PowerRailsPlanes::RailMatch::operator() ( const Rail* rail )
-  { return (rail->getAxis() == _axis) and (rail->getWidth() == _width); }
-
 
   PowerRailsPlanes::Rails::Rails ( PowerRailsPlanes::Plane* plane , unsigned int direction , Net* net )
     : _plane         (plane)
@@ -805,37 +749,12 @@ namespace {
   inline Net*                     PowerRailsPlanes::Rails::getNet            () const { return _net; }
 
 
-  void   PowerRailsPlanes::Rails::merge ( const Box& bb )
+  PowerRailsPlanes::Rail* PowerRailsPlanes::Rails::addRail ( DbU::Unit axis, DbU::Unit width )
   {
-    DbU::Unit  axis;
-    DbU::Unit  width;
-    DbU::Unit  sourceU;
-    DbU::Unit  targetU;
-
-    if (getDirection() == KbHorizontal) {
-      axis    = bb.getYCenter();
-      width   = bb.getHeight();
-      sourceU = bb.getXMin();
-      targetU = bb.getXMax();
-    } else {
-      axis    = bb.getXCenter();
-      width   = bb.getWidth();
-      sourceU = bb.getYMin();
-      targetU = bb.getYMax();
-    }
-
-    vector<Rail*>::iterator irail = find_if ( _rails.begin(), _rails.end(), RailMatch(axis,width) );
-
-    Rail* rail = NULL;
-    if ( irail == _rails.end() ) {
-      rail = new Rail(this,axis,width);
-      _rails.push_back ( rail );
-      stable_sort ( _rails.begin(), _rails.end(), RailCompare() );
-    } else {
-      rail = *irail;
-    }
-
-    rail->merge ( sourceU, targetU );
+  // Called in (axis,width) increasing order by mergeShapes().
+    Rail* rail = new Rail( this, axis, width );
+    _rails.push_back( rail );
+    return rail;
   }
 
 
@@ -883,36 +802,23 @@ namespace {
   inline unsigned int  PowerRailsPlanes::Plane::getPowerDirection () const { return _powerDirection; }
 
 
-  void  PowerRailsPlanes::Plane::merge ( const Box& bb, Net* net )
+  unsigned int  PowerRailsPlanes::Plane::getRailDirection ( const Net* net ) const
   {
-    Rails* rails = NULL;
-
-    ltrace(300) << "    Plane::merge() " << net->getName() << " " << bb << endl;
-
-    unsigned int direction = getDirection();
     if ( (net->getType() == Net::Type::POWER) or (net->getType() == Net::Type::GROUND) )
-      direction = getPowerDirection();
+      return getPowerDirection();
+    return getDirection();
+  }
 
-    if (direction == KbHorizontal) {
-      RailsMap::iterator irails = _horizontalRails.find(net);
-      if ( irails == _horizontalRails.end() ) {
-        rails = new Rails(this,KbHorizontal,net);
-        _horizontalRails.insert ( make_pair(net,rails) );
-      } else
-        rails = (*irails).second;
 
-      rails->merge ( bb );
-    } else {
-      RailsMap::iterator irails = _verticalRails.find(net);
-      if ( irails == _verticalRails.end() ) {
-        rails = new Rails(this,KbVertical,net);
-        _verticalRails.insert ( make_pair(net,rails) );
-      } else
-        rails = (*irails).second;
-
-      ltrace(300) << "    Vertical Merging" << endl; 
-      rails->merge ( bb );
-    }
+  PowerRailsPlanes::Rails* PowerRailsPlanes::Plane::getRails ( Net* net, unsigned int direction )
+  {
+    RailsMap&          railsMap = (direction == KbHorizontal) ? _horizontalRails : _verticalRails;
+    RailsMap::iterator irails   = railsMap.find(net);
+    if (irails != railsMap.end()) return (*irails).second;
+
+    Rails* rails = new Rails( this, direction, net );
+    railsMap.insert( make_pair(net,rails) );
+    return rails;
   }
 
 
@@ -931,12 +837,42 @@ namespace {
   }
 
 
+  PowerRailsPlanes::RailShape::RailShape ( Plane* plane, Net* net, const Box& bb )
+    : _plane    (plane)
+    , _net      (net)
+    , _direction(plane->getRailDirection(net))
+    , _axis     (0)
+    , _width    (0)
+    , _span     ()
+  {
+    if (_direction == KbHorizontal) {
+      _axis  = bb.getYCenter();
+      _width = bb.getHeight();
+      _span  = Interval( bb.getXMin(), bb.getXMax() );
+    } else {
+      _axis  = bb.getXCenter();
+      _width = bb.getWidth();
+      _span  = Interval( bb.getYMin(), bb.getYMax() );
+    }
+  }
+
+
+  bool  PowerRailsPlanes::RailShapeCompare::operator() ( const RailShape& lhs, const RailShape& rhs ) const
+  {
+    if (lhs._plane != rhs._plane) return lhs._plane < rhs._plane;
+    if (lhs._direction != rhs._direction) return lhs._direction < rhs._direction;
+    if (lhs._net != rhs._net) return lhs._net->getId() < rhs._net->getId();
+    if (lhs._axis  != rhs._axis ) return lhs._axis  < rhs._axis;
+    if (lhs._width != rhs._width) return lhs._width < rhs._width;
+    return lhs._span.getVMin() < rhs._span.getVMin();
+  }
+
+
   PowerRailsPlanes::PowerRailsPlanes ( KiteEngine* kite )
     : _kite               (kite)
     , _globalNets         (kite)
     , _planes             ()
-    , _activePlane        (NULL)
-    , _activeBlockagePlane(NULL)
+    , _shapes             ()
   {
     _globalNets.setBlockage( kite->getBlockageNet() );
 
@@ -984,49 +920,120 @@ namespace {
   { return _globalNets.isCoreClockNetRouted(net); }
 
 
+  inline size_t  PowerRailsPlanes::getShapesCount () const
+  { return _shapes.size(); }
+
+
   bool  PowerRailsPlanes::hasPlane ( const BasicLayer* layer )
   { return (_planes.find(layer) != _planes.end()); }
 
 
-  bool  PowerRailsPlanes::setActivePlane ( const BasicLayer* layer )
+  void  PowerRailsPlanes::addShape ( const BasicLayer* layer, const Box& bb, Net* net )
   {
     PlanesMap::iterator iplane = _planes.find(layer);
-    if (iplane == _planes.end()) return false;
-
-    _activePlane         = iplane->second;
-    _activeBlockagePlane = NULL;
-    if (layer->getMaterial() != BasicLayer::Material::blockage) {
-      BasicLayer* blockageLayer = layer->getBlockageLayer();
-      PlanesMap::iterator ibplane = _planes.find(blockageLayer);
-      if (ibplane != _planes.end())
-        _activeBlockagePlane = ibplane->second;
+    if (iplane == _planes.end()) return;
+
+    Net* topGlobalNet = _globalNets.getRootNet( net, Path() );
+    if (topGlobalNet == NULL) {
+      ltrace(300) << "Not a global net: " << net << endl;
+      return;
     }
-    return true;
+
+    Plane* plane = iplane->second;
+    if ( (topGlobalNet == _globalNets.getBlockage())
+       and (layer->getMaterial() != BasicLayer::Material::blockage) ) {
+      PlanesMap::iterator ibplane = _planes.find(layer->getBlockageLayer());
+      if (ibplane != _planes.end()) plane = ibplane->second;
+    }
+
+    ltrace(300) << "    addShape() " << topGlobalNet->getName() << " " << bb << endl;
+    _shapes.push_back( RailShape(plane,topGlobalNet,bb) );
   }
 
 
-  inline PowerRailsPlanes::Plane* PowerRailsPlanes::getActivePlane () const
-  { return _activePlane; }
+  bool  PowerRailsPlanes::isSameRail ( const RailShape& lhs, const RailShape& rhs )
+  {
+    return (lhs._plane     == rhs._plane    )
+       and (lhs._direction == rhs._direction)
+       and (lhs._net       == rhs._net      )
+       and (lhs._axis      == rhs._axis     )
+       and (lhs._width     == rhs._width    );
+  }
 
 
-  inline PowerRailsPlanes::Plane* PowerRailsPlanes::getActiveBlockagePlane () const
-  { return _activeBlockagePlane; }
+  void  PowerRailsPlanes::fuseShapes ( RailShapes& shapes )
+  {
+  // Sort, then fuse overlapping (or abutting) spans of a same rail, in place.
+    if (shapes.empty()) return;
+    sort( shapes.begin(), shapes.end(), RailShapeCompare() );
+
+    size_t last = 0;
+    for ( size_t i=1 ; i<shapes.size() ; ++i ) {
+      if (   isSameRail(shapes[last],shapes[i])
+         and (shapes[i]._span.getVMin() <= shapes[last]._span.getVMax()) ) {
+        shapes[last]._span.merge( shapes[i]._span );
+        continue;
+      }
+      if (++last != i) shapes[last] = shapes[i];
+    }
+    shapes.erase( shapes.begin()+last+1, shapes.end() );
+  }
 
 
-  void  PowerRailsPlanes::merge ( const Box& bb, Net* net )
+  void  PowerRailsPlanes::mergeShapes ( unsigned int threads )
   {
-    if (not _activePlane) return;
+    if (_shapes.empty()) return;
 
-    Net* topGlobalNet = _globalNets.getRootNet( net, Path() );
-    if (topGlobalNet == NULL) {
-      ltrace(300) << "Not a global net: " << net << endl;
-      return;
+    if (not threads) threads = std::thread::hardware_concurrency();
+    if (not threads) threads = 1;
+
+  // Vertical strips of the top cell, a few per thread to balance the load.
+    const Box&        area     = _kite->getCell()->getBoundingBox();
+    size_t            nbTiles  = (threads > 1) ? 4*threads : 1;
+    DbU::Unit         tileSize = area.getWidth() / nbTiles + 1;
+    vector<RailShapes> tiles   ( nbTiles );
+
+    for ( size_t i=0 ; i<_shapes.size() ; ++i ) {
+      const RailShape& shape = _shapes[i];
+      DbU::Unit        x     = (shape._direction == KbHorizontal) ? shape._span.getCenter() : shape._axis;
+      long             itile = (x - area.getXMin()) / tileSize;
+
+      tiles[ std::min( std::max(itile,0L), (long)nbTiles-1 ) ].push_back( shape );
+    }
+    size_t shapesCount = _shapes.size();
+    RailShapes().swap( _shapes );
+
+    std::atomic<size_t> next ( 0 );
+    auto worker = [&tiles,&next] () {
+      for ( size_t itile=next++ ; itile<tiles.size() ; itile=next++ )
+        fuseShapes( tiles[itile] );
+    };
+
+    if (threads > 1) {
+      vector<std::thread> workers;
+      for ( unsigned int i=0 ; i<threads ; ++i ) workers.push_back( std::thread(worker) );
+      for ( size_t i=0 ; i<workers.size() ; ++i ) workers[i].join();
+    } else
+      worker();
+
+  // Cross-tiles pass: rails spanning over several strips.
+    RailShapes fuseds;
+    for ( size_t itile=0 ; itile<tiles.size() ; ++itile ) {
+      fuseds.insert( fuseds.end(), tiles[itile].begin(), tiles[itile].end() );
+      RailShapes().swap( tiles[itile] );
+    }
+    fuseShapes( fuseds );
+
+    Rail* rail = NULL;
+    for ( size_t i=0 ; i<fuseds.size() ; ++i ) {
+      if (not i or not isSameRail(fuseds[i-1],fuseds[i]))
+        rail = fuseds[i]._plane->getRails( fuseds[i]._net, fuseds[i]._direction )
+                               ->addRail ( fuseds[i]._axis, fuseds[i]._width );
+      rail->addChunk( fuseds[i]._span );
     }
 
-    if ( (topGlobalNet == _globalNets.getBlockage()) and (_activeBlockagePlane != NULL) )
-      _activeBlockagePlane->merge( bb, topGlobalNet );
-    else
-      _activePlane->merge( bb, topGlobalNet );
+    cmess1 << "     - " << shapesCount << " shapes merged into "
+           << fuseds.size() << " chunks (" << threads << " threads)." << endl;
   }
 
 
@@ -1040,190 +1047,235 @@ namespace {
 
 
 // -------------------------------------------------------------------
-// Class  :  "::QueryPowerRails".
-
-  class QueryPowerRails : public Query {
+// Class  :  "::PowerRailsCollector".
+//
+// Walks the instances hierarchy of the top cell to collect the power
+// rails elements. The candidate components of each master cell (those
+// of a power rail layer which may belong to a global net) are computed
+// once and kept in a cache ("kite.powerRailsCache"), so the many
+// occurrences of a same standard cell only cost a transformation and,
+// for clocks, the resolution of the root net along the path.
+
+  class PowerRailsCollector {
     public:
-                            QueryPowerRails     ( KiteEngine* );
-      virtual bool          hasGoCallback       () const;
-      virtual void          setBasicLayer       ( const BasicLayer* );
-      virtual bool          hasBasicLayer       ( const BasicLayer* );
-      virtual void          goCallback          ( Go*     );
-      virtual void          rubberCallback      ( Rubber* );
-      virtual void          extensionGoCallback ( Go*     );
-      virtual void          masterCellCallback  ();
-              void          addToPowerRail      ( const Go*              go
-                                                , const BasicLayer*      basicLayer
-                                                , const Box&             area
-                                                , const Transformation&  transformation
-                                                );
-              void          ringAddToPowerRails ();
-      virtual void          doQuery             ();
-      inline  void          doLayout            ();
-      inline  unsigned int  getGoMatchCount     () const;
+      class Entry {
+        public:
+          inline            Entry ( const Component*, const BasicLayer*, const Box&, Net* rootNet, unsigned int ring );
+        public:
+          const Component*  _component;
+          const BasicLayer* _layer;
+          Box               _bb;        // In the master cell coordinates.
+          Net*              _rootNet;   // NULL when path dependent (clocks).
+          unsigned int      _ring;      // Depth (2 or 3) for a corona ring segment, 0 otherwise.
+      };
+      typedef  vector<Entry>        Entries;
+      typedef  map<Cell*,Entries*>  EntriesCache;
+    public:
+                             PowerRailsCollector ( KiteEngine* );
+                            ~PowerRailsCollector ();
+             void            collect             ();
+             void            ringAddToPowerRails ();
+             void            doLayout            ( unsigned int threads );
+      inline unsigned int    getGoMatchCount     () const;
     private:
-      AllianceFramework*      _framework;
-      KiteEngine*             _kite;
-      RoutingGauge*           _routingGauge;
-      const ChipTools&        _chipTools;
-      PowerRailsPlanes        _powerRailsPlanes;
-      bool                    _isBlockagePlane;
-      vector<const Segment*>  _hRingSegments;
-      vector<const Segment*>  _vRingSegments;
-      unsigned int            _goMatchCount;
+             bool            _isRailLayer        ( const BasicLayer* );
+             const Entries&  _getEntries         ( Cell* );
+             void            _buildEntries       ( Cell*, Entries& );
+             void            _collect            ( Cell*, const Transformation&, const Path& );
+    private:
+      AllianceFramework*        _framework;
+      KiteEngine*               _kite;
+      RoutingGauge*             _routingGauge;
+      const ChipTools&          _chipTools;
+      PowerRailsPlanes          _powerRailsPlanes;
+      map<const BasicLayer*,bool,BasicLayer::CompareByMask>
+                                _railLayers;
+      bool                      _useCache;
+      EntriesCache              _cache;
+      Entries                   _uncached;
+      vector<const Segment*>    _hRingSegments;
+      vector<const Segment*>    _vRingSegments;
+      unsigned int              _goMatchCount;
+      size_t                    _occurrences;
   };
 
 
-  QueryPowerRails::QueryPowerRails ( KiteEngine* kite )
-    : Query            ()
-    , _framework       (AllianceFramework::get())
+  inline PowerRailsCollector::Entry::Entry ( const Component*  component
+                                           , const BasicLayer* layer
+                                           , const Box&        bb
+                                           , Net*              rootNet
+                                           , unsigned int      ring )
+    : _component(component)
+    , _layer    (layer)
+    , _bb       (bb)
+    , _rootNet  (rootNet)
+    , _ring     (ring)
+  { }
+
+
+  PowerRailsCollector::PowerRailsCollector ( KiteEngine* kite )
+    : _framework       (AllianceFramework::get())
     , _kite            (kite)
     , _routingGauge    (kite->getConfiguration()->getRoutingGauge())
     , _chipTools       (kite->getChipTools())
     , _powerRailsPlanes(kite)
-    , _isBlockagePlane (false)
+    , _railLayers      ()
+    , _useCache        (kite->getKiteConfiguration()->usePowerRailsCache())
+    , _cache           ()
+    , _uncached        ()
     , _hRingSegments   ()
     , _vRingSegments   ()
     , _goMatchCount    (0)
+    , _occurrences     (0)
   {
-    setCell       ( kite->getCell() );
-    setArea       ( kite->getCell()->getBoundingBox() );
-    setBasicLayer ( NULL );
-    setFilter     ( Query::DoTerminalCells|Query::DoComponents );
-
     cmess1 << "  o  Building power rails." << endl;
   }
 
 
-  inline  unsigned int  QueryPowerRails::getGoMatchCount () const
-  { return _goMatchCount; }
-
-
-  inline  void  QueryPowerRails::doLayout ()
-  { return _powerRailsPlanes.doLayout(); }
+  PowerRailsCollector::~PowerRailsCollector ()
+  {
+    for ( EntriesCache::iterator ientries=_cache.begin() ; ientries!=_cache.end() ; ++ientries )
+      delete ientries->second;
+  }
 
 
-  bool  QueryPowerRails::hasBasicLayer ( const BasicLayer* basicLayer )
-  { return _powerRailsPlanes.hasPlane ( basicLayer ); }
+  inline  unsigned int  PowerRailsCollector::getGoMatchCount () const
+  { return _goMatchCount; }
 
 
-  void  QueryPowerRails::setBasicLayer ( const BasicLayer* basicLayer )
+  bool  PowerRailsCollector::_isRailLayer ( const BasicLayer* layer )
   {
-    _isBlockagePlane = (basicLayer) and (basicLayer->getMaterial() == BasicLayer::Material::blockage);
-    _powerRailsPlanes.setActivePlane ( basicLayer );
-    Query::setBasicLayer ( basicLayer );
+    auto ilayer = _railLayers.find( layer );
+    if (ilayer != _railLayers.end()) return ilayer->second;
+
+    bool isRail = (   (layer->getMaterial() == BasicLayer::Material::metal)
+                  or  (layer->getMaterial() == BasicLayer::Material::blockage) )
+              and not _kite->getConfiguration()->isGMetal(layer)
+              and     _powerRailsPlanes.hasPlane(layer);
+    _railLayers.insert( make_pair(layer,isRail) );
+    return isRail;
   }
 
 
-  void  QueryPowerRails::doQuery ()
+  void  PowerRailsCollector::_buildEntries ( Cell* cell, Entries& entries )
   {
-    PowerRailsPlanes::Plane* activePlane = _powerRailsPlanes.getActivePlane();
+    entries.clear();
 
-    if (not activePlane) return;
+    bool isPad = _framework->isPad( cell );
 
-    cmess1 << "     - PowerRails in " << activePlane->getLayer()->getName() << " ..." << endl;
-    Query::doQuery();
-  }
+    for ( Component* component : cell->getComponents() ) {
+      const Segment* segment = dynamic_cast<const Segment*>(component);
+      if ( not segment and not dynamic_cast<const Contact*>(component) ) continue;
 
+      if (    isPad
+         and ( (_routingGauge->getLayerDepth(component->getLayer()) < 2)
+             or (component->getLayer()->getBasicLayers().getFirst()->getMaterial() != BasicLayer::Material::blockage) ) )
+        continue;
 
-  void  QueryPowerRails::masterCellCallback ()
-  { }
+      for ( BasicLayer* basicLayer : component->getLayer()->getBasicLayers() ) {
+        if (not _isRailLayer(basicLayer)) continue;
+
+      // Apart from clocks, the root net do not depends on the instance path.
+        Net* rootNet = _kite->getBlockageNet();
+        if (basicLayer->getMaterial() != BasicLayer::Material::blockage) {
+          if (component->getNet()->getType() == Net::Type::CLOCK)
+            rootNet = NULL;
+          else {
+            rootNet = _powerRailsPlanes.getRootNet( component->getNet(), Path() );
+            if (not rootNet) continue;
+          }
+        }
 
+        Box          bb   = component->getBoundingBox( basicLayer );
+        unsigned int ring = 0;
+
+        if (segment and _chipTools.isChip()) {
+          unsigned int depth = _routingGauge->getLayerDepth( segment->getLayer() );
+          if (   ((depth == 2) or (depth == 3))
+             and (segment->getWidth () == _chipTools.getPadPowerWidth())
+             and (segment->getLength() >  _chipTools.getPadWidth())
+             and (_chipTools.getCorona().contains(bb)) )
+            ring = depth;
+        }
 
-  bool  QueryPowerRails::hasGoCallback () const
-  { return true; }
+        entries.push_back( Entry(component,basicLayer,bb,rootNet,ring) );
+      }
+    }
+  }
 
 
-  void  QueryPowerRails::goCallback ( Go* go )
+  const PowerRailsCollector::Entries& PowerRailsCollector::_getEntries ( Cell* cell )
   {
-  //ltrace(80) << "QueryPowerRails::goCallback() " << go->getId() << ":" << go
-  //           << " " << getPath().getName() << endl;
-    addToPowerRail ( go, getBasicLayer(), getArea(), getTransformation() );
+    if (not _useCache) {
+      _buildEntries( cell, _uncached );
+      return _uncached;
+    }
+
+    EntriesCache::iterator ientries = _cache.find( cell );
+    if (ientries != _cache.end()) return *(ientries->second);
+
+    Entries* entries = new Entries();
+    _buildEntries( cell, *entries );
+    _cache.insert( make_pair(cell,entries) );
+    return *entries;
   }
 
 
-  void  QueryPowerRails::addToPowerRail ( const Go*              go
-                                        , const BasicLayer*      basicLayer
-                                        , const Box&             area
-                                        , const Transformation&  transformation
-                                        )
+  void  PowerRailsCollector::_collect ( Cell* cell, const Transformation& transformation, const Path& path )
   {
-    const Component* component = dynamic_cast<const Component*>(go);
-    if ( component ) {
-      if (    _framework->isPad(getMasterCell())
-         and ( (_routingGauge->getLayerDepth(component->getLayer()) < 2)
-             or (component->getLayer()->getBasicLayers().getFirst()->getMaterial() != BasicLayer::Material::blockage) ) )
-        return;
+    ++_occurrences;
 
-      Net* rootNet = _kite->getBlockageNet();
-      if (not _isBlockagePlane) {
-        rootNet = _powerRailsPlanes.getRootNet(component->getNet(),getPath());
-      }
+    const Entries& entries = _getEntries( cell );
+    for ( size_t i=0 ; i<entries.size() ; ++i ) {
+      const Entry& entry   = entries[i];
+      Net*         rootNet = entry._rootNet;
 
-#if 0
-      Net* rootNet = NULL;
-      if ( not _isBlockagePlane )
-        rootNet = _powerRailsPlanes.getRootNet(component->getNet(),getPath());
-      else {
-        rootNet = _kite->getBlockageNet();
+      if (not rootNet) {
+        rootNet = _powerRailsPlanes.getRootNet( entry._component->getNet(), path );
+        if (not rootNet) {
+          ltrace(300) << "  rootNet is NULL, not taken into account." << endl;
+          continue;
+        }
       }
-#endif
 
-      if ( rootNet == NULL ) {
-        ltrace(300) << "  rootNet is NULL, not taken into account." << endl;
-        return;
+      _goMatchCount++;
+      ltrace(300) << "  Merging PowerRail element: " << entry._component << " " << entry._layer << endl;
+
+      switch ( entry._ring ) {
+        case 2: _vRingSegments.push_back( static_cast<const Segment*>(entry._component) ); continue; // M3 V.
+        case 3: _hRingSegments.push_back( static_cast<const Segment*>(entry._component) ); continue; // M4 H.
       }
 
-      ltrace(300) << "  rootNet " << rootNet << " (" << rootNet->isClock() << ") "
-                  << go->getCell() << " (" << go->getCell()->isTerminal() << ")" << endl;
+      Box bb = entry._bb;
+      transformation.applyOn( bb );
+      _powerRailsPlanes.addShape( entry._layer, bb, rootNet );
+    }
 
-      const Segment* segment = dynamic_cast<const Segment*>(component);
-      if ( segment != NULL ) {
-        _goMatchCount++;
-        ltrace(300) << "  Merging PowerRail element: " << segment << endl;
-
-        Box bb = segment->getBoundingBox ( basicLayer );
-
-        unsigned int depth = _routingGauge->getLayerDepth ( segment->getLayer() );
-
-        if (    _chipTools.isChip()
-           and ((depth == 2) or (depth == 3))
-           and (segment->getWidth () == _chipTools.getPadPowerWidth())
-           and (segment->getLength() >  _chipTools.getPadWidth())
-           and (_kite->getChipTools().getCorona().contains(bb)) ) {
-          switch ( depth ) {
-            case 2: _vRingSegments.push_back ( segment ); break; // M3 V.
-            case 3: _hRingSegments.push_back ( segment ); break; // M4 H.
-          }
-          return;
-        }
+  // Same transformation & path building as Hurricane::QueryStack.
+    for ( Instance* instance : cell->getInstances() ) {
+      Transformation childTransformation = instance->getTransformation();
+      transformation.applyOn( childTransformation );
 
-        transformation.applyOn ( bb );
+      _collect( instance->getMasterCell()
+              , childTransformation
+              , Path( Path(path,cell->getShuntedPath()), instance ) );
+    }
+  }
 
-        _powerRailsPlanes.merge ( bb, rootNet );
-      } else {
-        const Contact* contact = dynamic_cast<const Contact*>(component);
-        if ( contact != NULL ) {
-          _goMatchCount++;
 
-          Box bb = contact->getBoundingBox ( basicLayer );
-          transformation.applyOn ( bb );
+  void  PowerRailsCollector::collect ()
+  {
+    _collect( _kite->getCell(), Transformation(), Path() );
 
-          ltrace(300) << "  Merging PowerRail element: " << contact << " bb:" << bb
-                      << " " << basicLayer << endl;
-          
-          _powerRailsPlanes.merge ( bb, rootNet );
-        }
-      }
-    }
+    cmess1 << "     - " << _occurrences << " cells walked, "
+           << ((_useCache) ? _cache.size() : _occurrences) << " queried." << endl;
   }
 
 
-  void  QueryPowerRails::ringAddToPowerRails ()
+  void  PowerRailsCollector::ringAddToPowerRails ()
   {
     if ( not _hRingSegments.empty() ) {
       const RegularLayer* layer = dynamic_cast<const RegularLayer*>(_routingGauge->getRoutingLayer(3));
-      setBasicLayer ( layer->getBasicLayer() );
 
       DbU::Unit   xmin = DbU::Max;
       DbU::Unit   xmax = DbU::Min;
@@ -1236,14 +1288,14 @@ namespace {
       }
 
       for ( size_t i=0 ; i<_hRingSegments.size() ; ++i ) {
-        _powerRailsPlanes.merge ( Box(xmin,boxes[i].getYMin(),xmax,boxes[i].getYMax())
-                                , _powerRailsPlanes.getRootNet(_hRingSegments[i]->getNet(),Path()) );
+        _powerRailsPlanes.addShape ( layer->getBasicLayer()
+                                   , Box(xmin,boxes[i].getYMin(),xmax,boxes[i].getYMax())
+                                   , _powerRailsPlanes.getRootNet(_hRingSegments[i]->getNet(),Path()) );
       }
     }
 
     if ( not _vRingSegments.empty() ) {
       const RegularLayer* layer = dynamic_cast<const RegularLayer*>(_routingGauge->getRoutingLayer(2));
-      setBasicLayer ( layer->getBasicLayer() );
 
       DbU::Unit   ymin = DbU::Max;
       DbU::Unit   ymax = DbU::Min;
@@ -1256,19 +1308,19 @@ namespace {
       }
 
       for ( size_t i=0 ; i<_vRingSegments.size() ; ++i ) {
-        _powerRailsPlanes.merge ( Box(boxes[i].getXMin(),ymin,boxes[i].getXMax(),ymax)
-                                , _powerRailsPlanes.getRootNet(_vRingSegments[i]->getNet(),Path()) );
+        _powerRailsPlanes.addShape ( layer->getBasicLayer()
+                                   , Box(boxes[i].getXMin(),ymin,boxes[i].getXMax(),ymax)
+                                   , _powerRailsPlanes.getRootNet(_vRingSegments[i]->getNet(),Path()) );
       }
     }
   }
 
 
-  void  QueryPowerRails::rubberCallback ( Rubber* )
-  { }
-
-
-  void  QueryPowerRails::extensionGoCallback ( Go* )
-  { }
+  void  PowerRailsCollector::doLayout ( unsigned int threads )
+  {
+    _powerRailsPlanes.mergeShapes( threads );
+    _powerRailsPlanes.doLayout();
+  }
 
 
 } // End of anonymous namespace.
@@ -1297,22 +1349,11 @@ namespace Kite {
       state->setFlags( NetRoutingState::Fixed );
     }
 
-    QueryPowerRails query ( this );
-    Technology*     technology = DataBase::getDB()->getTechnology();
-
-    for( BasicLayer* layer : technology->getBasicLayers() ) {
-      if (   (layer->getMaterial() != BasicLayer::Material::metal)
-         and (layer->getMaterial() != BasicLayer::Material::blockage) )
-        continue;
-      if (_configuration->isGMetal(layer)) continue;
-      if (not query.hasBasicLayer(layer)) continue;
-
-      query.setBasicLayer( layer );
-      query.doQuery      ();
-    }
-    query.ringAddToPowerRails();
-    query.doLayout();
-    cmess1 << "     - " << query.getGoMatchCount() << " power rails elements found." << endl;
+    PowerRailsCollector collector ( this );
+    collector.collect();
+    collector.ringAddToPowerRails();
+    collector.doLayout( _configuration->getPowerRailsThreads() );
+    cmess1 << "     - " << collector.getGoMatchCount() << " power rails elements found." << endl;
 
     vector<GCell*>& gcells = *(getGCellGrid()->getGCellVector());
     for ( auto gcell : gcells ) {
@@ -96,6 +96,7 @@ namespace Kite {
       if (net->getType() == Net::Type::POWER ) continue;
       if (net->getType() == Net::Type::GROUND) continue;
     // Don't skip the clock.
+      if (isEco() and (_ecoNets.find(net) == _ecoNets.end()) and _freezeEcoNet(net)) continue;
 
       vector<Segment*>  segments;
       vector<Contact*>  contacts;
@@ -193,6 +194,104 @@ namespace Kite {
   }
 
 
+  bool  KiteEngine::_freezeEcoNet ( Net* net )
+  {
+  // ECO mode: an already routed net that is not to be re-routed becomes
+  // fixed. Knik & Katabatic ignore it and it's wires are put in the Tracks
+  // as TrackFixedSegments, like the power rails. It's contacts are blocked
+  // by stub wires on both the layers they connect.
+    if (net->isDeepNet()) return false;
+
+    vector<Segment*> segments;
+    vector<Contact*> contacts;
+    for( Component* component : net->getComponents() ) {
+      if (dynamic_cast<Pin*>(component)) continue;
+
+      const RegularLayer* layer = dynamic_cast<const RegularLayer*>(component->getLayer());
+      if (layer and (layer->getBasicLayer()->getMaterial() == BasicLayer::Material::blockage))
+        continue;
+
+      if (dynamic_cast<Horizontal*>(component) or dynamic_cast<Vertical*>(component)) {
+        segments.push_back( static_cast<Segment*>(component) );
+        continue;
+      }
+      Contact* contact = dynamic_cast<Contact*>(component);
+      if (contact) contacts.push_back( contact );
+    }
+    if (segments.empty() and contacts.empty()) return false;
+
+    NetRoutingState* state = getRoutingState( net, Katabatic::KbCreate );
+    _ecoFrozens.insert( make_pair(net,state->getFlags()) );
+    state->unsetFlags( NetRoutingState::AutomaticGlobalRoute|NetRoutingState::ManualGlobalRoute );
+    state->setFlags  ( NetRoutingState::Fixed );
+
+    for ( Segment* segment : segments ) {
+      RoutingPlane* plane = getRoutingPlaneByLayer( segment->getLayer() );
+      if (not plane) continue;
+
+      DbU::Unit axis    = (dynamic_cast<Horizontal*>(segment)) ? segment->getY() : segment->getX();
+      DbU::Unit axisMin = axis - segment->getWidth()/2;
+      DbU::Unit axisMax = axis + segment->getWidth()/2;
+
+      Track* track = plane->getTrackByPosition( axisMin, Constant::Superior );
+      for ( ; track and (track->getAxis() <= axisMax) ; track = track->getNextTrack() )
+        TrackFixedSegment::create( track, segment );
+    }
+
+    for ( Contact* contact : contacts ) {
+      Box          bb        = contact->getBoundingBox();
+      const Layer* layers[2] = { contact->getLayer()->getBottom(), contact->getLayer()->getTop() };
+
+      for ( size_t i=0 ; i<2 ; ++i ) {
+        if ( not layers[i] or ((i == 1) and (layers[1] == layers[0])) ) continue;
+
+        RoutingPlane* plane = getRoutingPlaneByLayer( layers[i] );
+        if (not plane) continue;
+
+        DbU::Unit wireWidth = plane->getLayerGauge()->getWireWidth();
+
+        if (plane->getDirection() == KbHorizontal) {
+          Track* track = plane->getTrackByPosition( bb.getYMin()-wireWidth/2, Constant::Superior );
+          for ( ; track and (track->getAxis() <= bb.getYMax()+wireWidth/2) ; track = track->getNextTrack() ) {
+            Segment* stub = Horizontal::create( net, layers[i], track->getAxis(), wireWidth, bb.getXMin(), bb.getXMax() );
+            _ecoStubs.push_back( stub );
+            TrackFixedSegment::create( track, stub );
+          }
+        } else {
+          Track* track = plane->getTrackByPosition( bb.getXMin()-wireWidth/2, Constant::Superior );
+          for ( ; track and (track->getAxis() <= bb.getXMax()+wireWidth/2) ; track = track->getNextTrack() ) {
+            Segment* stub = Vertical::create( net, layers[i], track->getAxis(), wireWidth, bb.getYMin(), bb.getYMax() );
+            _ecoStubs.push_back( stub );
+            TrackFixedSegment::create( track, stub );
+          }
+        }
+      }
+    }
+
+    ltrace(200) << "ECO frozen: " << net << " (" << segments.size() << " segments, "
+                << contacts.size() << " contacts)." << endl;
+    return true;
+  }
+
+
+  void  KiteEngine::_thawEcoNets ()
+  {
+    map<Net*,unsigned int>::iterator ifrozen = _ecoFrozens.begin();
+    for ( ; ifrozen != _ecoFrozens.end() ; ++ifrozen ) {
+      NetRoutingState* state = NetRoutingExtension::get( ifrozen->first );
+      if (not state) continue;
+
+      state->unsetFlags( state->getFlags() );
+      state->setFlags  ( ifrozen->second );
+    }
+    _ecoFrozens.clear();
+
+  // The contacts stubs were only there to block the Tracks.
+    for ( Segment* stub : _ecoStubs ) stub->destroy();
+    _ecoStubs.clear();
+  }
+
+
   void  KiteEngine::setFixedPreRouted ()
   {
     for ( size_t depth=0 ; depth<_routingPlanes.size() ; ++depth ) {
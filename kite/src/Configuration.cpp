@@ -47,6 +47,12 @@ namespace Kite {
     , _ripupLimits         ()
     , _ripupCost           (Cfg::getParamInt("kite.ripupCost"           ,      3)->asInt())
     , _eventsLimit         (Cfg::getParamInt("kite.eventsLimit"         ,4000000)->asInt())
+    , _snapshotPeriod      (Cfg::getParamInt("kite.snapshotPeriod"      ,      0)->asInt())
+    , _snapshotPath        (Cfg::getParamString("kite.snapshotPath"     ,     "")->asString())
+    , _telemetrySampling   (Cfg::getParamInt("kite.telemetrySampling"   ,      0)->asInt())
+    , _progressInterval    (Cfg::getParamInt("kite.progressInterval"    ,    250)->asInt())
+    , _powerRailsThreads   (Cfg::getParamInt("kite.powerRailsThreads"   ,      0)->asInt())
+    , _powerRailsCache     (Cfg::getParamBool("kite.powerRailsCache"    ,   true)->asBool())
     , _flags               (0)
   {
     _ripupLimits[StrapRipupLimit]      = Cfg::getParamInt("kite.strapRipupLimit"      ,16)->asInt();
@@ -84,6 +90,13 @@ namespace Kite {
     , _ripupLimits         ()
     , _ripupCost           (other._ripupCost)
     , _eventsLimit         (other._eventsLimit)
+    , _snapshotPeriod      (other._snapshotPeriod)
+    , _snapshotPath        (other._snapshotPath)
+    , _telemetrySampling   (other._telemetrySampling)
+    , _progressInterval    (other._progressInterval)
+    , _powerRailsThreads   (other._powerRailsThreads)
+    , _powerRailsCache     (other._powerRailsCache)
+    , _flags               (other._flags)
   {
     if ( _base == NULL ) _base = other._base->clone();
 
@@ -213,6 +226,14 @@ namespace Kite {
   { return _base->getVEdgeCapacity(); }
 
 
+  unsigned int  Configuration::getLoadThreads () const
+  { return _base->getLoadThreads(); }
+
+
+  bool  Configuration::getGCellSnapshots () const
+  { return _base->getGCellSnapshots(); }
+
+
   void  Configuration::setAllowedDepth ( size_t allowedDepth )
   { _base->setAllowedDepth(allowedDepth); }
 
@@ -229,6 +250,14 @@ namespace Kite {
   { _base->setGlobalThreshold(threshold); }
 
 
+  void  Configuration::setLoadThreads ( unsigned int threads )
+  { _base->setLoadThreads(threads); }
+
+
+  void  Configuration::setGCellSnapshots ( bool state )
+  { _base->setGCellSnapshots(state); }
+
+
   void  Configuration::setRipupLimit ( unsigned int type, unsigned int limit )
   {
     if ( type >= RipupLimitsTableSize ) {
@@ -282,6 +311,10 @@ namespace Kite {
     cout << Dots::asUInt ("     - Ripup limit, locals"                ,_ripupLimits[LocalRipupLimit]) << endl;
     cout << Dots::asUInt ("     - Ripup limit, globals"               ,_ripupLimits[GlobalRipupLimit]) << endl;
     cout << Dots::asUInt ("     - Ripup limit, long globals"          ,_ripupLimits[LongGlobalRipupLimit]) << endl;
+    cout << Dots::asULong("     - Snapshot period (events)"           ,_snapshotPeriod) << endl;
+    cout << Dots::asULong("     - Telemetry sampling (events)"        ,_telemetrySampling) << endl;
+    cout << Dots::asUInt ("     - Power rails threads (0:all cores)"  ,_powerRailsThreads) << endl;
+    cout << Dots::asBool ("     - Power rails master cell cache"      ,_powerRailsCache) << endl;
 
     _base->print ( cell );
   }
@@ -310,6 +343,12 @@ namespace Kite {
       record->add ( getSlot("_vTracksReservedLocal" ,_vTracksReservedLocal ) );
       record->add ( getSlot("_ripupCost"            ,_ripupCost            ) );
       record->add ( getSlot("_eventsLimit"          ,_eventsLimit          ) );
+      record->add ( getSlot("_snapshotPeriod"       ,_snapshotPeriod       ) );
+      record->add ( getSlot("_snapshotPath"         ,_snapshotPath         ) );
+      record->add ( getSlot("_telemetrySampling"    ,_telemetrySampling    ) );
+      record->add ( getSlot("_progressInterval"     ,_progressInterval     ) );
+      record->add ( getSlot("_powerRailsThreads"    ,_powerRailsThreads    ) );
+      record->add ( getSlot("_powerRailsCache"      ,_powerRailsCache      ) );
 
       record->add ( getSlot("_ripupLimits[StrapRipupLimit]"     ,_ripupLimits[StrapRipupLimit]     ) );
       record->add ( getSlot("_ripupLimits[LocalRipupLimit]"     ,_ripupLimits[LocalRipupLimit]     ) );
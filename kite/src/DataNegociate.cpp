@@ -45,6 +45,13 @@ namespace Kite {
 // Class  :  "DataNegociate".
 
 
+  ObjectPool<DataNegociate>  DataNegociate::_pool ( 4096 );
+
+  ObjectPool<DataNegociate>& DataNegociate::getPool         () { return _pool; }
+  void*                      DataNegociate::operator new    ( size_t size ) { return _pool.allocate(size); }
+  void                       DataNegociate::operator delete ( void* data, size_t size ) { _pool.release(data,size); }
+
+
   DataNegociate::DataNegociate ( TrackElement* trackSegment )
     : _trackSegment     (trackSegment)
     , _childSegment     (NULL)
@@ -308,12 +308,12 @@ namespace Kite {
                       );
     _viewer->addToMenu( "placeAndRoute.stepByStep.loadGlobalRouting"
                       , "Kite - &Load Global Routing"
-                      , "Load a solution for the global routing (.kgr)"
+                      , "Load a solution for the global routing (.kgb)"
                       , std::bind(&GraphicKiteEngine::_loadGlobalSolution,this)
                       );
     _viewer->addToMenu( "placeAndRoute.stepByStep.saveGlobalRouting"
                       , "Kite - &Save Global Routing"
-                      , "Save a global router solution (.kgr)"
+                      , "Save a global router solution (.kgb)"
                       , std::bind(&GraphicKiteEngine::_saveGlobalSolution,this)
                       );
     _viewer->addToMenu( "placeAndRoute.stepByStep.detailedRoute"
@@ -31,6 +31,7 @@
 #include "hurricane/Plug.h"
 #include "hurricane/Cell.h"
 #include "hurricane/Instance.h"
+#include "hurricane/RoutingPad.h"
 #include "hurricane/Vertical.h"
 #include "hurricane/Horizontal.h"
 #include "hurricane/viewer/Script.h"
@@ -77,12 +78,14 @@ namespace Kite {
   using Hurricane::Warning;
   using Hurricane::Breakpoint;
   using Hurricane::Box;
+  using Hurricane::RoutingPad;
   using Hurricane::Torus;
   using Hurricane::Layer;
   using Hurricane::Horizontal;
   using Hurricane::Vertical;
   using Hurricane::NetRoutingExtension;
   using Hurricane::Cell;
+  using Hurricane::Plug;
   using CRL::System;
   using CRL::addMeasure;
   using CRL::Measures;
@@ -98,6 +101,38 @@ namespace Kite {
     "    Cell %s do not have any KiteEngine (or not yet created).\n";
 
 
+  namespace {
+
+
+  void  wipeoutNetRouting ( Net* net )
+  {
+  // First pass: destroy the contacts
+    std::vector<Contact*> contacts;
+    for ( Component* component : net->getComponents() ) {
+      Contact* contact = dynamic_cast<Contact*>(component);
+      if (contact and not contact->getAnchorHook()->isAttached())
+        contacts.push_back( contact );
+    }
+    for ( Contact* contact : contacts )
+      contact->destroy();
+
+  // Second pass: destroy unconnected segments added by Knik as blockages
+    std::vector<Component*> segments;
+    for ( Component* component : net->getComponents() ) {
+      Horizontal* horizontal = dynamic_cast<Horizontal*>(component);
+      if (horizontal) segments.push_back( horizontal );
+
+      Vertical* vertical = dynamic_cast<Vertical*>(component);
+      if (vertical) segments.push_back( vertical );
+    }
+    for ( Component* segment : segments )
+      segment->destroy();
+  }
+
+
+  }  // Anonymous namespace.
+
+
 // -------------------------------------------------------------------
 // Class  :  "Kite::KiteEngine".
 
@@ -120,8 +155,14 @@ namespace Kite {
     , _configuration   (new Configuration(getKatabaticConfiguration()))
     , _routingPlanes   ()
     , _negociateWindow (NULL)
+    , _negociatePrepared(false)
     , _minimumWL       (0.0)
     , _toolSuccess     (false)
+    , _eco             (false)
+    , _ecoNets         ()
+    , _ecoFrozens      ()
+    , _ecoStubs        ()
+    , _ecoWindow       ()
   { }
 
 
@@ -195,9 +236,15 @@ namespace Kite {
 
     _gutKite();
     KatabaticEngine::_preDestroy();
+    _thawEcoNets();
 
     cmess2 << "     - RoutingEvents := " << RoutingEvent::getAllocateds() << endl;
 
+  // Give back the pools memory in bulk, if no more object uses it.
+    RoutingEvent ::getPool().trim();
+    TrackSegment ::getPool().trim();
+    DataNegociate::getPool().trim();
+
     if (not ToolEngine::inDestroyAll()) {
       KnikEngine* attachedKnik = KnikEngine::get( getCell() );
 
@@ -224,31 +271,79 @@ namespace Kite {
 
     for ( Net* net : cell->getNets() ) {
       if (NetRoutingExtension::isManualGlobalRoute(net)) continue;
+      wipeoutNetRouting( net );
+    }
 
-    // First pass: destroy the contacts
-      std::vector<Contact*> contacts;
-      for ( Component* component : net->getComponents() ) {
-        Contact* contact = dynamic_cast<Contact*>(component);
-        if (contact and not contact->getAnchorHook()->isAttached())
-          contacts.push_back( contact );
-      }
-      for ( Contact* contact : contacts )
-        contact->destroy();
+    UpdateSession::close();
+  }
 
-    // Second pass: destroy unconnected segments added by Knik as blockages
-      std::vector<Component*> segments;
-      for ( Component* component : net->getComponents() ) {
-        Horizontal* horizontal = dynamic_cast<Horizontal*>(component);
-        if (horizontal) segments.push_back( horizontal );
 
-        Vertical* vertical = dynamic_cast<Vertical*>(component);
-        if (vertical) segments.push_back( vertical );
+  KiteEngine* KiteEngine::createEco ( Cell*                    cell
+                                    , const vector<Net*>&      nets
+                                    , const vector<Instance*>& instances
+                                    , const Box&               window )
+  {
+    if ( (KiteEngine::get(cell) != NULL) or (KatabaticEngine::get(cell) != NULL) )
+      throw Error( "KiteEngine::createEco(): KiteEngine still active on %s"
+                 , getString(cell->getName()).c_str() );
+
+    KiteEngine* kite = new KiteEngine ( cell );
+    kite->_eco       = true;
+    kite->_ecoWindow = window;
+
+  // The candidate nets: the modified ones and all the ones connected
+  // to a modified (moved or swapped) instance.
+    NetSet candidates;
+    for ( Net* net : nets ) {
+      if (net and (net->getCell() == cell)) candidates.insert( net );
+    }
+    for ( Instance* instance : instances ) {
+      if (not instance or (instance->getCell() != cell)) continue;
+      for ( Plug* plug : instance->getConnectedPlugs() )
+        candidates.insert( plug->getNet() );
+      if (window.isEmpty()) kite->_ecoWindow.merge( instance->getAbutmentBox() );
+    }
+
+  // When no window is given, it is the area of the changed instances
+  // and nets. Only the nets with a terminal in the window are re-routed,
+  // and the window is grown to reach all their terminals.
+    map<Net*,Box> terminalBoxes;
+    for ( Net* net : candidates ) {
+      Box terminalBox;
+      for ( RoutingPad* rp : net->getRoutingPads() ) terminalBox.merge( rp->getBoundingBox() );
+      terminalBoxes.insert( make_pair(net,terminalBox) );
+
+      if (window.isEmpty() and (find(nets.begin(),nets.end(),net) != nets.end()))
+        kite->_ecoWindow.merge( terminalBox );
+    }
+    for ( auto iterminal : terminalBoxes ) {
+      if (   not window.isEmpty()
+         and not iterminal.second.isEmpty()
+         and not iterminal.second.intersect(window) ) {
+        cmess2 << "     - <" << iterminal.first->getName() << "> is outside the ECO window, kept." << endl;
+        continue;
       }
-      for ( Component* segment : segments )
-        segment->destroy();
+      kite->_ecoNets.insert( iterminal.first );
+      kite->_ecoWindow.merge( iterminal.second );
     }
 
+    cmess1 << "  o  ECO on <" << cell->getName() << ">, "
+           << kite->_ecoNets.size() << " nets to re-route in " << kite->_ecoWindow << "." << endl;
+
+    UpdateSession::open();
+    for ( Net* net : kite->_ecoNets ) {
+      if (net->isSupply() or net->isGlobal()) continue;
+      if (NetRoutingExtension::isManualGlobalRoute(net)) continue;
+      wipeoutNetRouting( net );
+    }
     UpdateSession::close();
+
+    kite->_postCreate();
+    kite->_initDataBase();
+
+    cmess1 << "     - " << kite->_ecoFrozens.size() << " routed nets kept as fixed." << endl;
+
+    return kite;
   }
 
 
@@ -581,6 +676,37 @@ namespace Kite {
   }
 
 
+  void  KiteEngine::_closeEcoWindow ()
+  {
+  // ECO mode: the global routing edges that are not fully inside the
+  // window get no capacity, so Knik keeps the re-routed nets in it.
+    if (_ecoWindow.isEmpty()) return;
+
+    Katabatic::GCellGrid* grid   = getGCellGrid();
+    size_t                closed = 0;
+
+    for ( unsigned int row=0 ; row<grid->getRows() ; ++row ) {
+      for ( unsigned int column=0 ; column<grid->getColumns() ; ++column ) {
+        Katabatic::GCell* gcell  = grid->getGCell( grid->getIndex(column,row) );
+        bool              inside = gcell->getBoundingBox().intersect( _ecoWindow );
+        Katabatic::GCell* right  = gcell->getRight();
+        Katabatic::GCell* up     = gcell->getUp();
+
+        if ( right and (not inside or not right->getBoundingBox().intersect(_ecoWindow)) ) {
+          _knik->updateEdgeCapacity( column, row, right->getColumn(), right->getRow(), 0 );
+          ++closed;
+        }
+        if ( up and (not inside or not up->getBoundingBox().intersect(_ecoWindow)) ) {
+          _knik->updateEdgeCapacity( column, row, up->getColumn(), up->getRow(), 0 );
+          ++closed;
+        }
+      }
+    }
+
+    cmess2 << "     - ECO window " << _ecoWindow << ", " << closed << " global edges closed." << endl;
+  }
+
+
   void  KiteEngine::runGlobalRouter ( unsigned int mode )
   {
     if (getState() >= Katabatic::EngineGlobalLoaded)
@@ -592,6 +718,7 @@ namespace Kite {
       _knik->loadSolution();
     } else {
       annotateGlobalGraph();
+      if (isEco()) _closeEcoWindow();
       map<Name,Net*>  preRouteds;
       for ( auto istate : getNetRoutingStates() ) {
         if (istate.second->isMixedPreRoute())
@@ -599,6 +726,10 @@ namespace Kite {
       }
       _knik->run( preRouteds );
     }
+    if (mode & KtLayerAssignGlobal) {
+      _knik->layerAssign();
+      setFlags( Katabatic::EngineKnikLayerAssign );
+    }
 
     setState( Katabatic::EngineGlobalLoaded );
 
@@ -616,16 +747,49 @@ namespace Kite {
   }
 
 
+  string  KiteEngine::getSnapshotPath () const
+  {
+    if (not _configuration->getSnapshotPath().empty()) return _configuration->getSnapshotPath();
+    return getString(getCell()->getName()) + ".ksnap";
+  }
+
+
+  void  KiteEngine::resumeNegociate ( unsigned int flags )
+  { runNegociate( flags|KtResumeSnapshot ); }
+
+
   void  KiteEngine::runNegociate ( unsigned int flags )
   {
-    if (_negociateWindow) return;
+  // A window left by _prepareNegociate() (sweeps) is reused as is.
+    if (_negociateWindow and not _negociatePrepared) return;
 
     startMeasures();
-    Session::open( this );
+    if (not _negociateWindow) _prepareNegociate();
+
+    unsigned int overlaps = _negociate( flags );
+    _toolSuccess = _toolSuccess and (overlaps == 0);
+  }
+
 
+  void  KiteEngine::_prepareNegociate ()
+  {
+  // The part of the negociation which do not depends on its parameters.
+    Session::open( this );
     _negociateWindow = NegociateWindow::create( this );
     _negociateWindow->setGCells( *(getGCellGrid()->getGCellVector()) );
     _computeCagedConstraints();
+    Session::close();
+
+    _negociatePrepared = true;
+  }
+
+
+  unsigned int  KiteEngine::_negociate ( unsigned int flags )
+  {
+    _negociatePrepared = false;
+
+    Session::open( this );
+    if (flags & KtResumeSnapshot) _negociateWindow->loadSnapshot( getSnapshotPath() );
     _negociateWindow->run( flags );
     _negociateWindow->destroy();
     _negociateWindow = NULL;
@@ -656,33 +820,34 @@ namespace Kite {
     _check( overlaps );
     Session::close();
 
-    _toolSuccess = _toolSuccess and (overlaps == 0);
+    return overlaps;
   }
 
 
-  void  KiteEngine::printCompletion () const
+  void  KiteEngine::_computeCompletion ( size_t&                 routeds
+                                       , vector<TrackElement*>&  unrouteds
+                                       , unsigned long long&     totalWireLength
+                                       , unsigned long long&     routedWireLength ) const
   {
-    size_t                 routeds          = 0;
-    unsigned long long     totalWireLength  = 0;
-    unsigned long long     routedWireLength = 0;
-    vector<TrackElement*>  unrouteds;
-    vector<TrackElement*>  reduceds;
-    ostringstream          result;
+    routeds          = 0;
+    totalWireLength  = 0;
+    routedWireLength = 0;
+    unrouteds.clear();
 
     AutoSegmentLut::const_iterator ilut = _getAutoSegmentLut().begin();
     for ( ; ilut != _getAutoSegmentLut().end() ; ilut++ ) {
-      TrackElement* segment = _lookup( ilut->second );
+      if (not (*ilut)) continue;
+      TrackElement* segment = _lookup( *ilut );
       if (segment == NULL) continue;
 
       unsigned long long wl = (unsigned long long)DbU::toLambda( segment->getLength() );
       if (wl > 100000) {
         cerr << Error("KiteEngine::printCompletion(): Suspiciously long wire: %llu for %p:%s"
-                     ,wl,ilut->first,getString(segment).c_str()) << endl;
+                     ,wl,(*ilut)->base(),getString(segment).c_str()) << endl;
         continue;
       }
 
       if (segment->isFixed() or segment->isBlockage()) continue;
-      if (segment->isReduced()) reduceds.push_back( segment );
 
       totalWireLength += wl;
       if ( (segment->getTrack() != NULL) or (segment->isReduced()) ) {
@@ -693,6 +858,18 @@ namespace Kite {
 
       unrouteds.push_back( segment );
     }
+  }
+
+
+  void  KiteEngine::printCompletion () const
+  {
+    size_t                 routeds          = 0;
+    unsigned long long     totalWireLength  = 0;
+    unsigned long long     routedWireLength = 0;
+    vector<TrackElement*>  unrouteds;
+    ostringstream          result;
+
+    _computeCompletion( routeds, unrouteds, totalWireLength, routedWireLength );
 
     float segmentRatio    = (float)(routeds)          / (float)(routeds+unrouteds.size()) * 100.0;
     float wireLengthRatio = (float)(routedWireLength) / (float)(totalWireLength)   * 100.0;
@@ -706,13 +883,6 @@ namespace Kite {
       }
     }
 
-    // if (not reduceds.empty()) {
-    //   cerr << "  o  Reduced segments:" << endl;
-    //   for ( size_t i=0; i<reduceds.size() ; ++i ) {
-    //     cerr << "   " << dec << setw(4) << (i+1) << "| " << reduceds[i] << endl;
-    //   }
-    // }
-
     result << setprecision(4) << segmentRatio
            << "% [" << routeds << "+" << unrouteds.size() << "]";
     cmess1 << Dots::asString( "     - Track Segment Completion Ratio", result.str() ) << endl;
@@ -846,6 +1016,13 @@ namespace Kite {
     if (getState() < Katabatic::EngineGutted) {
       Session::open( this );
 
+    // Window prepared for a sweep but never negociated.
+      if (_negociateWindow) {
+        _negociateWindow->destroy();
+        _negociateWindow   = NULL;
+        _negociatePrepared = false;
+      }
+
       size_t maxDepth = getRoutingGauge()->getDepth();
       for ( size_t depth=0 ; depth < maxDepth ; depth++ ) {
         _routingPlanes[depth]->destroy();
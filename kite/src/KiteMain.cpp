@@ -67,9 +67,11 @@ int main ( int argc, char *argv[] )
     bool          coreDump;
     bool          logMode;
     bool          loadGlobal;
+    bool          layerGlobal;
     bool          dumpMeasures;
     bool          saveGlobal;
     bool          destroyDatabase;
+    unsigned int  sweepJobs;
 
     bopts::options_description options ("Command line arguments & options");
     options.add_options()
@@ -92,15 +94,22 @@ int main ( int argc, char *argv[] )
       ( "core-dump,D"    , bopts::bool_switch(&coreDump)->default_value(false)
                          , "Enable core dumping.")
       ( "load-global,g"  , bopts::bool_switch(&loadGlobal)->default_value(false)
-                         , "Do *not* run the global router (Knik), reuse previous routing (.kgr).")
+                         , "Do *not* run the global router (Knik), reuse previous routing (.kgb).")
       ( "save-global"    , bopts::bool_switch(&saveGlobal)->default_value(false)
                          , "Save the global routing solution.")
+      ( "layer-global"   , bopts::bool_switch(&layerGlobal)->default_value(false)
+                         , "Assign the global routing to the real routing layers (3D).")
       ( "dump-measures,M", bopts::bool_switch(&dumpMeasures)->default_value(false)
                          , "Dump statistical measurements on the disk.")
       ( "cell,c"         , bopts::value<string>()
                          , "The name of the cell to load, without extension." )
       ( "save-design,s"  , bopts::value<string>()
                          , "Save the routed design under the given name.")
+      ( "sweep"          , bopts::value<string>()
+                         , "Negociate once per configuration of the given sweep file, "
+                           "then route with the best one." )
+      ( "sweep-jobs"     , bopts::value<unsigned int>(&sweepJobs)->default_value(1)
+                         , "Number of sweep configurations run in parallel (0: one per core)." )
       ( "destroy-db"     , bopts::bool_switch(&destroyDatabase)->default_value(false)
                          , "Perform a complete deletion of the database (may be buggy).");
 
@@ -144,6 +153,7 @@ int main ( int argc, char *argv[] )
 
     unsigned int globalFlags = (loadGlobal) ? Kite::KtLoadGlobalRouting
                                             : Kite::KtBuildGlobalRouting;
+    if (layerGlobal) globalFlags |= Kite::KtLayerAssignGlobal;
 
     KiteEngine* kite = KiteEngine::create( cell );
     if (showConf) kite->printConfiguration();
@@ -154,6 +164,8 @@ int main ( int argc, char *argv[] )
     kite->loadGlobalRouting   ( Katabatic::EngineLoadGrByNet );
     kite->balanceGlobalDensity();
     kite->layerAssign         ( Katabatic::EngineNoNetLayerAssign );
+    if (arguments.count("sweep"))
+      kite->runSweep( arguments["sweep"].as<string>(), sweepJobs );
     kite->runNegociate        ();
     kiteSuccess = kite->getToolSuccess();
     kite->finalizeLayout   ();
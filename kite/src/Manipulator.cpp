@@ -25,6 +25,7 @@
 #include "kite/SegmentFsm.h"
 #include "kite/Manipulator.h"
 #include "kite/KiteEngine.h"
+#include "kite/Telemetry.h"
 
 
 namespace {
@@ -157,6 +158,8 @@ namespace Kite {
 
   bool  Manipulator::ripupPerpandiculars ( unsigned int flags )
   {
+    Telemetry::Timer timer ( Telemetry::RipupPerpandiculars );
+
     ltrace(200) << "Manipulator::ripupPerpandiculars() - " << flags << endl;
 
     bool          success                  = true;
@@ -1201,6 +1204,8 @@ namespace Kite {
 
   bool  Manipulator::minimize ()
   {
+    Telemetry::Timer timer ( Telemetry::Minimize );
+
     ltrace(200) << "Manipulator::minimize() " << _segment << endl; 
 
     if (_segment->isFixed()) return false;
@@ -1389,6 +1394,8 @@ namespace Kite {
 
   void  Manipulator::repackPerpandiculars ()
   {
+    Telemetry::Timer timer ( Telemetry::RepackPerpandiculars );
+
     ltrace(200) << "Manipulator::repackPerpandiculars()" << endl;
 
     const vector<TrackElement*>& perpandiculars = _event->getPerpandiculars();
@@ -0,0 +1,256 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :       Jean-Paul.Chaput@asim.lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./NegociateSnapshot.cpp"                       |
+// +-----------------------------------------------------------------+
+
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "hurricane/Net.h"
+#include "hurricane/Segment.h"
+#include "hurricane/Cell.h"
+#include "crlcore/Utilities.h"
+#include "katabatic/AutoSegment.h"
+#include "kite/DataNegociate.h"
+#include "kite/TrackElement.h"
+#include "kite/Track.h"
+#include "kite/RoutingPlane.h"
+#include "kite/RoutingEvent.h"
+#include "kite/NegociateWindow.h"
+#include "kite/Session.h"
+#include "kite/KiteEngine.h"
+
+
+namespace Kite {
+
+  using std::map;
+  using std::string;
+  using std::vector;
+  using std::endl;
+  using std::cerr;
+  using Hurricane::tab;
+  using Hurricane::inltrace;
+  using Hurricane::ltracein;
+  using Hurricane::ltraceout;
+  using Hurricane::Error;
+  using Hurricane::Warning;
+  using Hurricane::Net;
+  using Hurricane::Segment;
+  using Katabatic::AutoSegment;
+
+
+// -------------------------------------------------------------------
+// Class  :  "NegociateWindow" (snapshots).
+
+
+  void  NegociateWindow::_snapshotCheck ()
+  {
+    unsigned long period = _kite->getSnapshotPeriod();
+    if (not period) return;
+
+  // Only the negociation stage can be resumed, the repair one relies on
+  // the whole events history. The last negociation snapshot is kept.
+    if (RoutingEvent::getStage() != RoutingEvent::Negociate) return;
+
+  // The last snapshot is taken when the events limit stops the negociation.
+    if (isInterrupted() or not (RoutingEvent::getProcesseds() % period))
+      saveSnapshot( _kite->getSnapshotPath() );
+  }
+
+
+  bool  NegociateWindow::saveSnapshot ( const string& path )
+  {
+    vector<KsnSegment> records;
+
+    Katabatic::Session* ktbtSession = Session::base();
+    for ( Net* net : getCell()->getNets() ) {
+      for ( Segment* segment : net->getComponents().getSubSet<Segment*>() ) {
+        AutoSegment* autoSegment = ktbtSession->lookup( segment );
+        if (not autoSegment or not autoSegment->isCanonical()) continue;
+
+        TrackElement* trackSegment = Session::lookup( segment );
+        if (not trackSegment or trackSegment->isFixed() or trackSegment->isBlockage()) continue;
+
+        DataNegociate* data = trackSegment->getDataNegociate();
+        if (not data) continue;
+
+        KsnSegment record;
+        memset( &record, 0, sizeof(KsnSegment) );
+        record._id         = trackSegment->getId();
+        record._sourceU    = trackSegment->getSourceU();
+        record._targetU    = trackSegment->getTargetU();
+        record._axis       = trackSegment->getAxis();
+        record._depth      = _kite->getRoutingPlaneByLayer(trackSegment->getLayer())->getDepth();
+        record._flags      = (trackSegment->getTrack()) ? KsnPlaced : 0;
+        record._state      = data->getState();
+        record._stateCount = data->getStateCount();
+        record._ripupCount = data->getRipupCount();
+        records.push_back( record );
+      }
+    }
+
+    KsnHeader header;
+    memset( &header, 0, sizeof(KsnHeader) );
+    memcpy( header._magic, KsnMagic, 4 );
+    header._version    = KsnVersion;
+    header._endianness = KsnEndianness;
+    header._stage      = RoutingEvent::getStage();
+    header._processeds = RoutingEvent::getProcesseds();
+    header._nbSegments = records.size();
+    strncpy( header._cellName, getString(getCell()->getName()).c_str(), KsnCellNameSize-1 );
+
+  // Write aside then rename, so a crash while writing keeps the previous one.
+    string tmpPath  = path + ".tmp";
+    FILE*  saveFile = fopen( tmpPath.c_str(), "wb" );
+    if (not saveFile) {
+      cerr << Warning( "NegociateWindow::saveSnapshot(): Cannot open \"%s\" for writing.", tmpPath.c_str() ) << endl;
+      return false;
+    }
+
+    bool written = (fwrite(&header,sizeof(KsnHeader),1,saveFile) == 1);
+    if (written and not records.empty())
+      written = (fwrite(&records[0],sizeof(KsnSegment),records.size(),saveFile) == records.size());
+    written = (fclose(saveFile) == 0) and written;
+
+    if (not written or (rename(tmpPath.c_str(),path.c_str()) != 0)) {
+      cerr << Warning( "NegociateWindow::saveSnapshot(): Error while writing \"%s\".", path.c_str() ) << endl;
+      remove( tmpPath.c_str() );
+      return false;
+    }
+
+    cmess2 << "        <snapshot:" << RoutingEvent::getProcesseds()
+           << " segments:" << records.size() << " \"" << path << "\">" << endl;
+    return true;
+  }
+
+
+  bool  NegociateWindow::loadSnapshot ( const string& path )
+  {
+    _snapshot.clear();
+
+    FILE* file = fopen( path.c_str(), "rb" );
+    if (not file)
+      throw Error( "NegociateWindow::loadSnapshot(): Can't open/read file: %s.", path.c_str() );
+
+    KsnHeader header;
+    bool      valid = (fread(&header,sizeof(KsnHeader),1,file) == 1);
+
+    if (not valid or (memcmp(header._magic,KsnMagic,4) != 0)) {
+      fclose( file );
+      throw Error( "NegociateWindow::loadSnapshot(): \"%s\" is not a Kite snapshot.", path.c_str() );
+    }
+    if ( (header._version != KsnVersion) or (header._endianness != KsnEndianness) ) {
+      fclose( file );
+      throw Error( "NegociateWindow::loadSnapshot(): \"%s\" has an unsupported version or byte order."
+                 , path.c_str() );
+    }
+
+    if (header._stage != RoutingEvent::Negociate) {
+      fclose( file );
+      throw Error( "NegociateWindow::loadSnapshot(): \"%s\" was not taken during the negociation stage."
+                 , path.c_str() );
+    }
+
+    header._cellName[KsnCellNameSize-1] = '\0';
+    if (getString(getCell()->getName()) != header._cellName) {
+      fclose( file );
+      throw Error( "NegociateWindow::loadSnapshot(): \"%s\" was taken on Cell <%s>, not <%s>."
+                 , path.c_str(), header._cellName, getString(getCell()->getName()).c_str() );
+    }
+
+    _snapshot.resize( header._nbSegments );
+    if (header._nbSegments)
+      valid = (fread(&_snapshot[0],sizeof(KsnSegment),_snapshot.size(),file) == _snapshot.size());
+    fclose( file );
+
+    if (not valid) {
+      _snapshot.clear();
+      throw Error( "NegociateWindow::loadSnapshot(): \"%s\" is truncated.", path.c_str() );
+    }
+
+    cmess1 << "  o  Loaded negociation snapshot \"" << path << "\"." << endl;
+    cmess1 << Dots::asSizet("     - Taken at event"  ,header._processeds) << endl;
+    cmess1 << Dots::asSizet("     - Segments"        ,_snapshot.size()) << endl;
+    return true;
+  }
+
+
+  void  NegociateWindow::_restoreSnapshot ()
+  {
+    ltrace(150) << "NegociateWindow::_restoreSnapshot()" << endl;
+    ltracein(149);
+
+    map<unsigned long,TrackElement*> lut;
+    for ( size_t i=0 ; i<_segments.size() ; ++i ) lut[ _segments[i]->getId() ] = _segments[i];
+
+    size_t placeds  = 0;
+    size_t restored = 0;
+    size_t skippeds = 0;
+
+    for ( size_t i=0 ; i<_snapshot.size() ; ++i ) {
+      const KsnSegment& record = _snapshot[i];
+
+      map<unsigned long,TrackElement*>::iterator ilut = lut.find( record._id );
+      if (ilut == lut.end()) { ++skippeds; continue; }
+
+      TrackElement* segment = ilut->second;
+      RoutingPlane* plane   = _kite->getRoutingPlaneByLayer( segment->getLayer() );
+
+    // A different span means a different topology (doglegs): ignore it.
+      if ( (segment->getSourceU() != record._sourceU)
+         or (segment->getTargetU() != record._targetU)
+         or (plane->getDepth() != record._depth) ) {
+        ltrace(149) << "Mismatch, skipped: " << segment << endl;
+        ++skippeds;
+        continue;
+      }
+
+      DataNegociate* data = segment->getDataNegociate();
+      if (data) {
+        data->setState     ( record._state, KtResetCount );
+        data->setStateCount( record._stateCount );
+        data->setRipupCount( record._ripupCount );
+      }
+      ++restored;
+
+      if ( data and (record._flags & KsnPlaced) and not segment->getTrack() ) {
+        Track* track = plane->getTrackByPosition( record._axis );
+        if (not track or (track->getAxis() != record._axis)) continue;
+
+      // The segment must have an event to be ripped up later: give it an
+      // already processed one, kept by the serial pass history.
+        RoutingEvent* event = RoutingEvent::create( segment );
+        event->setAxisHint( record._axis );
+        event->setProcessed();
+        _eventHistory.push( event );
+
+        Session::addInsertEvent( segment, track );
+        ++placeds;
+      }
+    }
+    Session::revalidate();
+    _snapshot.clear();
+
+    cmess1 << "  o  Restoring negociation snapshot." << endl;
+    cmess1 << Dots::asSizet("     - Restored segments",restored) << endl;
+    cmess1 << Dots::asSizet("     - Placed in Tracks" ,placeds) << endl;
+    cmess1 << Dots::asSizet("     - Unmatched (skip)" ,skippeds) << endl;
+
+    ltraceout(149);
+  }
+
+
+}  // Kite namespace.
@@ -0,0 +1,384 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :       Jean-Paul.Chaput@asim.lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./NegociateSweep.cpp"                          |
+// +-----------------------------------------------------------------+
+
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "hurricane/Cell.h"
+#include "crlcore/Utilities.h"
+#include "kite/RoutingEvent.h"
+#include "kite/Sweep.h"
+#include "kite/KiteEngine.h"
+
+
+namespace {
+
+  using namespace std;
+  using Kite::SweepResult;
+  using Kite::SweepPoint;
+
+
+  const char* getStatusName ( int status )
+  {
+    switch ( status ) {
+      case SweepResult::Ok:     return "ok";
+      case SweepResult::Failed: return "failed";
+    }
+    return "crashed";
+  }
+
+
+// Best is the most complete routing, then the shortest. Runtime is not
+// a criterion so the choice do not depends on the machine load.
+  bool  isBetter ( const SweepResult& lhs, const SweepResult& rhs )
+  {
+    if (lhs._status != rhs._status) return lhs._status < rhs._status;
+    if (lhs._unrouteds          != rhs._unrouteds         ) return lhs._unrouteds          < rhs._unrouteds;
+    if (lhs._overlaps           != rhs._overlaps          ) return lhs._overlaps           < rhs._overlaps;
+    if (lhs._unroutedWireLength != rhs._unroutedWireLength) return lhs._unroutedWireLength < rhs._unroutedWireLength;
+    return lhs._wireLength < rhs._wireLength;
+  }
+
+
+} // Anonymous namespace.
+
+
+namespace Kite {
+
+  using std::cout;
+  using std::cerr;
+  using std::endl;
+  using std::setw;
+  using std::left;
+  using std::right;
+  using std::fixed;
+  using std::setprecision;
+  using std::ifstream;
+  using std::ofstream;
+  using std::istringstream;
+  using std::ostringstream;
+  using std::map;
+  using Hurricane::Error;
+  using Hurricane::Warning;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::SweepPoint".
+
+
+  SweepPoint::SweepPoint ( const string& name, const Configuration* configuration )
+    : _name        (name)
+    , _eventsLimit (configuration->getEventsLimit())
+    , _ripupCost   (configuration->getRipupCost())
+  {
+    for ( size_t type=0 ; type<Configuration::RipupLimitsTableSize ; ++type )
+      _ripupLimits[type] = configuration->getRipupLimit( type );
+
+    memset( &_result, 0, sizeof(SweepResult) );
+    _result._status = SweepResult::Crashed;
+  }
+
+
+  void  SweepPoint::set ( const string& parameter, unsigned long value )
+  {
+    if      (parameter == "eventsLimit"         ) _eventsLimit  = value;
+    else if (parameter == "ripupCost"           ) _ripupCost    = value;
+    else if (parameter == "strapRipupLimit"     ) _ripupLimits[Configuration::StrapRipupLimit     ] = value;
+    else if (parameter == "localRipupLimit"     ) _ripupLimits[Configuration::LocalRipupLimit     ] = value;
+    else if (parameter == "globalRipupLimit"    ) _ripupLimits[Configuration::GlobalRipupLimit    ] = value;
+    else if (parameter == "longGlobalRipupLimit") _ripupLimits[Configuration::LongGlobalRipupLimit] = value;
+    else
+      throw Error( "SweepPoint::set(): Unknown parameter \"%s\" in configuration \"%s\"."
+                 , parameter.c_str(), _name.c_str() );
+  }
+
+
+  void  SweepPoint::apply ( Configuration* configuration ) const
+  {
+    configuration->setEventsLimit  ( _eventsLimit );
+    configuration->setRipupCost    ( _ripupCost );
+    for ( size_t type=0 ; type<Configuration::RipupLimitsTableSize ; ++type )
+      configuration->setRipupLimit( type, _ripupLimits[type] );
+  }
+
+
+  vector<SweepPoint>  SweepPoint::load ( const string& path, const Configuration* configuration )
+  {
+    ifstream file ( path.c_str() );
+    if (not file.good())
+      throw Error( "SweepPoint::load(): Can't open/read file: %s.", path.c_str() );
+
+    vector<SweepPoint> points;
+    string             line;
+    size_t             lineNo = 0;
+
+    while ( getline(file,line) ) {
+      ++lineNo;
+      size_t comment = line.find( '#' );
+      if (comment != string::npos) line.erase( comment );
+
+      istringstream tokens ( line );
+      string        name;
+      if (not (tokens >> name)) continue;
+
+      points.push_back( SweepPoint(name,configuration) );
+
+      string setting;
+      while ( tokens >> setting ) {
+        size_t equal = setting.find( '=' );
+        char*  end   = NULL;
+        unsigned long value = (equal != string::npos) ? strtoul( setting.c_str()+equal+1, &end, 10 ) : 0;
+
+        if ( (equal == string::npos) or (equal == 0) or (end == setting.c_str()+equal+1) or *end )
+          throw Error( "SweepPoint::load(): Bad setting \"%s\" in %s:%u (expected <parameter>=<value>)."
+                     , setting.c_str(), path.c_str(), lineNo );
+
+        points.back().set( setting.substr(0,equal), value );
+      }
+    }
+
+    return points;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::KiteEngine" (sweeps).
+
+
+  size_t  KiteEngine::runSweep ( const string& path, unsigned int jobs )
+  {
+    vector<SweepPoint> points = SweepPoint::load( path, _configuration );
+    return runSweep( points, jobs );
+  }
+
+
+  size_t  KiteEngine::runSweep ( vector<SweepPoint>& points, unsigned int jobs, unsigned int flags )
+  {
+    if (points.empty()) return SweepPoint::NoBest;
+    if (_negociateWindow and not _negociatePrepared)
+      throw Error( "KiteEngine::runSweep(): Cannot be called while negociating." );
+
+    if (not jobs) jobs = sysconf( _SC_NPROCESSORS_ONLN );
+    if (not jobs) jobs = 1;
+
+    cmess1 << "  o  Negociation sweep." << endl;
+    cmess1 << Dots::asSizet("     - Configurations",points.size()) << endl;
+    cmess1 << Dots::asUInt ("     - Jobs"          ,jobs) << endl;
+
+  // Done once, shared copy-on-write by all the forked negociations.
+    if (not _negociateWindow) _prepareNegociate();
+
+    map<pid_t,size_t> runnings;
+    map<pid_t,int>    pipes;
+    size_t            next = 0;
+
+    while ( (next < points.size()) or not runnings.empty() ) {
+      while ( (next < points.size()) and (runnings.size() < jobs) ) {
+        int fds[2];
+        if (pipe(fds) < 0)
+          throw Error( "KiteEngine::runSweep(): Unable to create pipe (%s).", strerror(errno) );
+
+        cout.flush();
+        cerr.flush();
+
+        pid_t pid = fork();
+        if (pid < 0)
+          throw Error( "KiteEngine::runSweep(): Unable to fork (%s).", strerror(errno) );
+
+        if (pid == 0) {
+          close( fds[0] );
+
+          SweepResult result;
+          memset( &result, 0, sizeof(SweepResult) );
+          result._status = SweepResult::Failed;
+
+          try {
+            if (jobs > 1) mstream::disable( mstream::Verbose1|mstream::Verbose2 );
+            cmess1 << "  o  Sweep configuration \"" << points[next].getName() << "\"." << endl;
+
+          // Files would be shared by all the children: no snapshot nor telemetry.
+            points[next].apply( _configuration );
+            _configuration->setSnapshotPeriod   ( 0 );
+            _configuration->setTelemetrySampling( 0 );
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            startMeasures();
+            result._overlaps = _negociate( flags );
+            result._seconds  = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+            result._events   = RoutingEvent::getProcesseds();
+
+            size_t                 routeds          = 0;
+            unsigned long long     totalWireLength  = 0;
+            unsigned long long     routedWireLength = 0;
+            vector<TrackElement*>  unrouteds;
+            _computeCompletion( routeds, unrouteds, totalWireLength, routedWireLength );
+
+            result._routeds            = routeds;
+            result._unrouteds          = unrouteds.size();
+            result._wireLength         = totalWireLength;
+            result._unroutedWireLength = totalWireLength - routedWireLength;
+            result._status             = SweepResult::Ok;
+
+            struct rusage usage;
+            if (getrusage(RUSAGE_SELF,&usage) == 0)
+              result._peakRss = usage.ru_maxrss;
+          }
+          catch ( Error& e ) {
+            cerr << e.what() << endl;
+          }
+          catch ( ... ) {
+            cerr << "[ERROR] Abnormal termination of sweep \"" << points[next].getName() << "\"." << endl;
+          }
+          cout.flush();
+          cerr.flush();
+
+          ssize_t written = write( fds[1], &result, sizeof(SweepResult) );
+          close( fds[1] );
+          _exit( (written == (ssize_t)sizeof(SweepResult)) ? 0 : 1 );
+        }
+
+        close( fds[1] );
+        runnings[pid] = next++;
+        pipes   [pid] = fds[0];
+      }
+
+    // Only wait for our own children (the caller may have others): a
+    // child pipe becomes readable when it sends its result or dies.
+      vector<pollfd> fds;
+      vector<pid_t>  pids;
+      for ( map<pid_t,int>::iterator ipipe=pipes.begin() ; ipipe!=pipes.end() ; ++ipipe ) {
+        pollfd entry;
+        entry.fd      = ipipe->second;
+        entry.events  = POLLIN;
+        entry.revents = 0;
+        fds .push_back( entry );
+        pids.push_back( ipipe->first );
+      }
+      if (poll(&fds[0],fds.size(),-1) < 0) {
+        if (errno == EINTR) continue;
+        throw Error( "KiteEngine::runSweep(): poll() failed (%s).", strerror(errno) );
+      }
+
+      size_t ready = 0;
+      while ( (ready < fds.size()) and not fds[ready].revents ) ++ready;
+      if (ready == fds.size()) continue;
+
+      pid_t                       pid      = pids[ready];
+      map<pid_t,size_t>::iterator irunning = runnings.find( pid );
+
+    // The result is small enough to be written at once, then the child exits.
+      SweepResult& result   = points[irunning->second].getResult();
+      int          fd       = fds[ready].fd;
+      size_t       received = 0;
+      char*        buffer   = (char*)&result;
+      while ( received < sizeof(SweepResult) ) {
+        ssize_t count = read( fd, buffer+received, sizeof(SweepResult)-received );
+        if (count < 0 and errno == EINTR) continue;
+        if (count <= 0) break;
+        received += count;
+      }
+      close( fd );
+
+      int status = 0;
+      while ( waitpid(pid,&status,0) < 0 ) {
+        if (errno != EINTR)
+          throw Error( "KiteEngine::runSweep(): waitpid() failed (%s).", strerror(errno) );
+      }
+
+      if ( (received != sizeof(SweepResult)) or not WIFEXITED(status) or WEXITSTATUS(status) ) {
+        memset( &result, 0, sizeof(SweepResult) );
+        result._status = SweepResult::Crashed;
+      }
+
+      runnings.erase( irunning );
+      pipes   .erase( pid );
+    }
+
+  // Report, always in the order of the configurations.
+    size_t best = 0;
+    for ( size_t i=1 ; i<points.size() ; ++i ) {
+      if (isBetter(points[i].getResult(),points[best].getResult())) best = i;
+    }
+
+    string   csvPath = getString(getCell()->getName()) + ".ksweep.csv";
+    ofstream csv     ( csvPath.c_str() );
+    csv << "name,status,events,routeds,unrouteds,overlaps,wireLength,unroutedWireLength,seconds,peakRss" << endl;
+
+    cmess1 << "  o  Sweep results." << endl;
+    cmess1 << "     " << left  << setw(20) << "Configuration"
+                      << right << setw( 8) << "Status"
+                               << setw(10) << "Events"
+                               << setw(10) << "Unrouted"
+                               << setw( 9) << "Overlap"
+                               << setw(12) << "DWL(l)"
+                               << setw(10) << "fWL(l)"
+                               << setw(10) << "Time(s)"
+                               << setw(10) << "RSS(Mb)" << endl;
+
+    for ( size_t i=0 ; i<points.size() ; ++i ) {
+      const SweepResult& result = points[i].getResult();
+
+      cmess1 << "   " << ((i == best) ? "* " : "  ")
+             << left  << setw(20) << points[i].getName()
+             << right << setw( 8) << getStatusName(result._status)
+                      << setw(10) << result._events
+                      << setw(10) << result._unrouteds
+                      << setw( 9) << result._overlaps
+                      << setw(12) << result._wireLength
+                      << setw(10) << result._unroutedWireLength
+                      << setw(10) << fixed << setprecision(2) << result._seconds
+                      << setw(10) << (result._peakRss >> 10) << endl;
+
+      csv << points[i].getName()
+          << "," << getStatusName(result._status)
+          << "," << result._events
+          << "," << result._routeds
+          << "," << result._unrouteds
+          << "," << result._overlaps
+          << "," << result._wireLength
+          << "," << result._unroutedWireLength
+          << "," << result._seconds
+          << "," << result._peakRss << endl;
+    }
+    csv.close();
+    cmess1 << Dots::asIdentifier("     - Results",csvPath) << endl;
+
+    if (points[best].getResult()._status != SweepResult::Ok) {
+      cerr << Warning( "KiteEngine::runSweep(): No configuration completed." ) << endl;
+      return SweepPoint::NoBest;
+    }
+
+  // A following runNegociate() reuses the prepared window with the best one.
+    points[best].apply( _configuration );
+    cmess1 << Dots::asIdentifier("     - Best configuration",points[best].getName()) << endl;
+    return best;
+  }
+
+
+}  // Kite namespace.
@@ -39,6 +39,7 @@
 #include "kite/RoutingEventHistory.h"
 #include "kite/RoutingEventLoop.h"
 #include "kite/NegociateWindow.h"
+#include "kite/Telemetry.h"
 #include "kite/KiteEngine.h"
 
 
@@ -171,6 +172,8 @@ namespace Kite {
     , _eventQueue  ()
     , _eventHistory()
     , _eventLoop   (10,50)
+    , _statistics  ()
+    , _snapshot    ()
   { }
 
 
@@ -201,10 +204,11 @@ namespace Kite {
     Session::revalidate();
 
     TrackElement*            segment;
-    AutoSegmentLut           lut = Session::getKiteEngine()->_getAutoSegmentLut();
-    AutoSegmentLut::iterator it  = lut.begin ();
+    const AutoSegmentLut&          lut = Session::getKiteEngine()->_getAutoSegmentLut();
+    AutoSegmentLut::const_iterator it  = lut.begin ();
     for ( ; it != lut.end() ; it++ ) {
-      segment = Session::lookup( it->second );
+      if (not (*it)) continue;
+      segment = Session::lookup( *it );
       if (segment) segment->getDataNegociate()->update();
     }
 
@@ -383,9 +387,11 @@ namespace Kite {
 
     cmess1 << "     o  Negociation Stage." << endl;
 
-    unsigned long limit = _kite->getEventsLimit();
+    unsigned long    limit    = _kite->getEventsLimit();
+    ProgressReporter progress ( _kite->getProgressInterval() );
 
-    _eventHistory.clear();
+  // The history is not cleared here: it may already hold the events of
+  // the segments restored from a snapshot.
     _eventQueue.load( _segments );
     cmess2 << "        <queue:" <<  right << setw(8) << setfill('0') << _eventQueue.size() << ">" << endl;
     if (inltrace(500)) _eventQueue.dump();
@@ -396,13 +402,15 @@ namespace Kite {
       RoutingEvent* event = _eventQueue.pop();
 
       if (tty::enabled()) {
-        cmess2 << "        <event:" << tty::bold << right << setw(8) << setfill('0')
-               << RoutingEvent::getProcesseds() << tty::reset
-               << " remains:" << right << setw(8) << setfill('0')
-               << _eventQueue.size()
-               << setfill(' ') << tty::reset << ">" << tty::cr;
-        cmess2.flush ();
-      } else {
+        if (cmess2.enabled() and progress.ready()) {
+          cmess2 << "        <event:" << tty::bold << right << setw(8) << setfill('0')
+                 << RoutingEvent::getProcesseds() << tty::reset
+                 << " remains:" << right << setw(8) << setfill('0')
+                 << _eventQueue.size()
+                 << setfill(' ') << tty::reset << ">" << tty::cr;
+          cmess2.flush ();
+        }
+      } else if (cmess2.enabled()) {
         cmess2 << "        <event:" << right << setw(8) << setfill('0')
                << RoutingEvent::getProcesseds() << setfill(' ') << " "
                << event->getEventLevel() << ":" << event->getPriority() << "> "
@@ -415,6 +423,8 @@ namespace Kite {
 
       count++;
       if (RoutingEvent::getProcesseds() >= limit) setInterrupt( true );
+      _snapshotCheck();
+      Telemetry::sample( RoutingEvent::getProcesseds(), _eventQueue.size(), _eventHistory.size() );
     }
     if (count and cmess2.enabled() and tty::enabled()) cmess1 << endl;
 
@@ -426,7 +436,7 @@ namespace Kite {
     for ( size_t i=0 ; (i<_eventHistory.size()) and not isInterrupted() ; i++ ) {
       RoutingEvent* event = _eventHistory.getNth(i);
 
-      if (not event->isCloned() and event->isUnimplemented()) {
+      if (event and not event->isCloned() and event->isUnimplemented()) {
         event->reschedule( _eventQueue, 0 );
       }
     }
@@ -440,13 +450,15 @@ namespace Kite {
       RoutingEvent* event = _eventQueue.pop();
 
       if (tty::enabled()) {
-        cmess2 << "        <repair.event:" << tty::bold << setw(8) << setfill('0')
-               << RoutingEvent::getProcesseds() << tty::reset
-               << " remains:" << right << setw(8) << setfill('0')
-               << _eventQueue.size() << ">"
-               << setfill(' ') << tty::reset << tty::cr;
-        cmess2.flush();
-      } else {
+        if (cmess2.enabled() and progress.ready()) {
+          cmess2 << "        <repair.event:" << tty::bold << setw(8) << setfill('0')
+                 << RoutingEvent::getProcesseds() << tty::reset
+                 << " remains:" << right << setw(8) << setfill('0')
+                 << _eventQueue.size() << ">"
+                 << setfill(' ') << tty::reset << tty::cr;
+          cmess2.flush();
+        }
+      } else if (cmess2.enabled()) {
         cmess2 << "        <repair.event:" << setw(8) << setfill('0')
                << RoutingEvent::getProcesseds() << setfill(' ') << " "
                << event->getEventLevel() << ":" << event->getPriority() << "> "
@@ -459,6 +471,8 @@ namespace Kite {
 
       count++;
       if (RoutingEvent::getProcesseds() >= limit ) setInterrupt( true );
+      _snapshotCheck();
+      Telemetry::sample( RoutingEvent::getProcesseds(), _eventQueue.size(), _eventHistory.size() );
     }
 
     if (count and cmess2.enabled() and tty::enabled()) cmess1 << endl;
@@ -488,6 +502,7 @@ namespace Kite {
 
     TrackElement::setOverlapCostCB( NegociateOverlapCost );
     RoutingEvent::resetProcesseds();
+    Telemetry::open( getString(getCell()->getName()), _kite->getTelemetrySampling() );
 
     for ( size_t igcell=0 ; igcell<_gcells.size() ; ++igcell ) {
       _createRouting( _gcells[igcell] );
@@ -499,6 +514,8 @@ namespace Kite {
       Session::revalidate();
     }
 
+    if (not _snapshot.empty()) _restoreSnapshot();
+
     _kite->setMinimumWL( computeWirelength() );
 
 #if defined(CHECK_DATABASE)
@@ -509,6 +526,7 @@ namespace Kite {
     _flags |= flags;
     _negociate();
     printStatistics();
+    Telemetry::close();
 
     if (flags & KtPreRoutedStage) {
       _kite->setFixedPreRouted();
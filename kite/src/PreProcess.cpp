@@ -355,7 +355,8 @@ namespace Kite {
     TrackElement*                  segment  = NULL;
     AutoSegmentLut::const_iterator isegment = _getAutoSegmentLut().begin();
     for ( ; isegment != _getAutoSegmentLut().end() ; isegment++ ) {
-      segment = _lookup( isegment->second );
+      if (not (*isegment)) continue;
+      segment = _lookup( *isegment );
       if (not segment or not segment->isFixed()) continue;
 
       DebugSession::open( segment->getNet() );
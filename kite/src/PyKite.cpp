@@ -92,6 +92,7 @@ extern "C" {
 
     LoadObjectConstant( dictionnary, KtBuildGlobalRouting, "KtBuildGlobalRouting" );
     LoadObjectConstant( dictionnary, KtLoadGlobalRouting , "KtLoadGlobalRouting"  );
+    LoadObjectConstant( dictionnary, KtLayerAssignGlobal , "KtLayerAssignGlobal"  );
   }
 
   
@@ -15,11 +15,16 @@
 
 
 #include "hurricane/isobar/PyCell.h"
+#include "hurricane/isobar/PyNet.h"
+#include "hurricane/isobar/PyInstance.h"
+#include "hurricane/isobar/PyBox.h"
 #include "hurricane/viewer/PyCellViewer.h"
 #include "hurricane/viewer/ExceptionWidget.h"
 #include "hurricane/Cell.h"
+#include "kite/Sweep.h"
 #include "kite/PyKiteEngine.h"
 #include <functional>
+#include <QCoreApplication>
 
 # undef   ACCESS_OBJECT
 # undef   ACCESS_CLASS
@@ -48,6 +53,13 @@ namespace  Kite {
   using Isobar::ParseTwoArg;
   using Isobar::PyCell;
   using Isobar::PyCell_Link;
+  using Isobar::PyTypeCell;
+  using Isobar::PyNet;
+  using Isobar::PyTypeNet;
+  using Isobar::PyInstance;
+  using Isobar::PyTypeInstance;
+  using Isobar::PyBox;
+  using Isobar::PyTypeBox;
   using Isobar::PyCellViewer;
   using Isobar::PyTypeCellViewer;
   using CRL::PyToolEngine;
@@ -142,6 +154,60 @@ extern "C" {
   }
 
 
+  static PyObject* PyKiteEngine_createEco ( PyObject*, PyObject* args )
+  {
+    trace << "PyKiteEngine_createEco()" << endl;
+
+    KiteEngine* kite = NULL;
+    
+    HTRY
+    PyObject* arg0   = NULL;
+    PyObject* pyNets = NULL;
+    PyObject* pyInst = NULL;
+    PyObject* pyBox  = NULL;
+
+    if (not PyArg_ParseTuple(args,"OOO|O:Kite.createEco", &arg0, &pyNets, &pyInst, &pyBox)) {
+      PyErr_SetString(ConstructorError, "Kite.createEco(): Invalid number/bad type of parameter.");
+      return NULL;
+    }
+    if (   not IsPyCell(arg0)
+       or  not PyList_Check(pyNets)
+       or  not PyList_Check(pyInst)
+       or (pyBox and not IsPyBox(pyBox)) ) {
+      PyErr_SetString(ConstructorError, "Kite.createEco(): Expects (Cell, list of Net, list of Instance [, Box]).");
+      return NULL;
+    }
+
+    vector<Net*> nets;
+    for ( Py_ssize_t i=0 ; i<PyList_Size(pyNets) ; ++i ) {
+      PyObject* pyNet = PyList_GetItem( pyNets, i );
+      if (not IsPyNet(pyNet)) {
+        PyErr_SetString(ConstructorError, "Kite.createEco(): Second argument must be a list of Net.");
+        return NULL;
+      }
+      nets.push_back( PYNET_O(pyNet) );
+    }
+
+    vector<Instance*> instances;
+    for ( Py_ssize_t i=0 ; i<PyList_Size(pyInst) ; ++i ) {
+      PyObject* pyInstance = PyList_GetItem( pyInst, i );
+      if (not IsPyInstance(pyInstance)) {
+        PyErr_SetString(ConstructorError, "Kite.createEco(): Third argument must be a list of Instance.");
+        return NULL;
+      }
+      instances.push_back( PYINSTANCE_O(pyInstance) );
+    }
+
+    Cell* cell = PYCELL_O(arg0);
+    kite = KiteEngine::createEco( cell, nets, instances, (pyBox) ? *PYBOX_O(pyBox) : Box() );
+    if (cmess1.enabled())
+      kite->getKiteConfiguration()->print(cell);
+    HCATCH
+
+    return PyKiteEngine_Link(kite);
+  }
+
+
   static PyObject* PyKiteEngine_setViewer ( PyKiteEngine* self, PyObject* args )
   {
     trace << "PyKiteEngine_setViewer ()" << endl;
@@ -308,6 +374,49 @@ extern "C" {
   }
 
 
+  static PyObject* PyKiteEngine_resumeNegociate ( PyKiteEngine* self )
+  {
+    trace << "PyKiteEngine_resumeNegociate()" << endl;
+    HTRY
+    METHOD_HEAD("KiteEngine.resumeNegociate()")
+    if (kite->getViewer()) {
+      if (ExceptionWidget::catchAllWrapper( std::bind(&KiteEngine::resumeNegociate,kite,0) )) {
+        PyErr_SetString( HurricaneError, "KiteEngine::resumeNegociate() has thrown an exception (C++)." );
+        return NULL;
+      }
+    } else {
+      kite->resumeNegociate();
+    }
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  static PyObject* PyKiteEngine_runSweep ( PyKiteEngine* self, PyObject* args )
+  {
+    trace << "PyKiteEngine_runSweep()" << endl;
+
+    size_t best = 0;
+    HTRY
+    METHOD_HEAD("KiteEngine.runSweep()")
+    char*        path = NULL;
+    unsigned int jobs = 1;
+    if (not PyArg_ParseTuple(args,"s|I:KiteEngine.runSweep", &path, &jobs)) {
+      PyErr_SetString(ConstructorError, "KiteEngine.runSweep(): Invalid number/bad type of parameter.");
+      return NULL;
+    }
+  // The sweep forks: the children would share the GUI connection.
+    if (kite->getViewer() or QCoreApplication::instance()) {
+      PyErr_SetString(HurricaneError, "KiteEngine.runSweep(): Cannot fork while a viewer/GUI is active.");
+      return NULL;
+    }
+    best = kite->runSweep( path, jobs );
+    HCATCH
+    if (best == SweepPoint::NoBest) Py_RETURN_NONE;
+    return PyInt_FromLong( best );
+  }
+
+
   // Standart Accessors (Attributes).
   DirectVoidToolMethod(KiteEngine,kite,printConfiguration)
   DirectVoidToolMethod(KiteEngine,kite,saveGlobalSolution)
@@ -326,6 +435,8 @@ extern "C" {
                                , "Returns the Kite engine attached to the Cell, None if there isnt't." }
     , { "create"               , (PyCFunction)PyKiteEngine_create               , METH_VARARGS|METH_STATIC
                                , "Create a Kite engine on this cell." }
+    , { "createEco"            , (PyCFunction)PyKiteEngine_createEco            , METH_VARARGS|METH_STATIC
+                               , "Create a Kite engine to re-route only some nets of an already routed cell (ECO)." }
     , { "setViewer"            , (PyCFunction)PyKiteEngine_setViewer            , METH_VARARGS
                                , "Associate a Viewer to this KiteEngine." }
     , { "printConfiguration"   , (PyCFunction)PyKiteEngine_printConfiguration   , METH_NOARGS
@@ -344,6 +455,10 @@ extern "C" {
                                , "Run the negociation stage for pre-routed of the detailed router." }
     , { "runNegociate"         , (PyCFunction)PyKiteEngine_runNegociate         , METH_NOARGS
                                , "Run the negociation stage of the detailed router." }
+    , { "resumeNegociate"      , (PyCFunction)PyKiteEngine_resumeNegociate      , METH_NOARGS
+                               , "Run the negociation stage, restarting from the last snapshot." }
+    , { "runSweep"             , (PyCFunction)PyKiteEngine_runSweep             , METH_VARARGS
+                               , "Run the negociation once per configuration of a sweep file, returns the best index (None if none completed)." }
     , { "finalizeLayout"       , (PyCFunction)PyKiteEngine_finalizeLayout       , METH_NOARGS
                                , "Revert to a pure Hurricane database, remove router's additionnal data structures." }
     , { "dumpMeasures"         , (PyCFunction)PyKiteEngine_dumpMeasures         , METH_NOARGS
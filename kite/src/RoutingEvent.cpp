@@ -147,6 +147,7 @@ namespace Kite {
   size_t        RoutingEvent::_allocateds = 0;
   size_t        RoutingEvent::_processeds = 0;
   size_t        RoutingEvent::_cloneds    = 0;
+  ObjectPool<RoutingEvent>  RoutingEvent::_pool ( 4096 );
 
 
   unsigned int  RoutingEvent::getStage        () { return _stage; }
@@ -155,6 +156,10 @@ namespace Kite {
   size_t        RoutingEvent::getCloneds      () { return _cloneds; }
   void          RoutingEvent::setStage        ( unsigned int stage ) { _stage = stage; }
   void          RoutingEvent::resetProcesseds () { _processeds = 0; }
+  ObjectPool<RoutingEvent>&
+                RoutingEvent::getPool         () { return _pool; }
+  void*         RoutingEvent::operator new    ( size_t size ) { return _pool.allocate(size); }
+  void          RoutingEvent::operator delete ( void* event, size_t size ) { _pool.release(event,size); }
 
 
   RoutingEvent::RoutingEvent ( TrackElement* segment, unsigned int mode )
@@ -180,6 +185,8 @@ namespace Kite {
     , _eventLevel          (0)
     , _priority            (0.0)
     , _key                 (this)
+    , _queueIndex          (NotQueued)
+    , _queueStamp          (0)
   {
     if (_idCounter == std::numeric_limits<unsigned int>::max()) {
       throw Error( "RoutingEvent::RoutingEvent(): Identifier counter has reached it's limit (%d bits)."
@@ -226,6 +233,7 @@ namespace Kite {
     clone->_cloned     = false;
     clone->_disabled   = false;
     clone->_eventLevel = 0;
+    clone->_queueIndex = NotQueued;
 
     ltrace(200) << "RoutingEvent::clone() " << clone
                 << " (from: " << ")" <<  endl;
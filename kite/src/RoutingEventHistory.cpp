@@ -15,6 +15,7 @@
 
 
 #include <iomanip>
+#include <algorithm>
 #include "hurricane/Error.h"
 #include "kite/RoutingEvent.h"
 #include "kite/RoutingEventHistory.h"
@@ -26,6 +27,8 @@ namespace Kite {
   using std::setw;
   using std::setfill;
   using std::endl;
+  using std::sort;
+  using std::unique;
   using Hurricane::Error;
 
 
@@ -33,8 +36,31 @@ namespace Kite {
 // Class  :  "RoutingEventHistory".
 
 
+  TrackElement* RoutingEventHistory::Entry::getSegment () const
+  { return (_event) ? _event->getSegment() : _segment; }
+
+
+  DbU::Unit  RoutingEventHistory::Entry::getAxisHistory () const
+  { return (_event) ? _event->getAxisHistory() : _axisHistory; }
+
+
+  unsigned int  RoutingEventHistory::Entry::getId () const
+  { return (_event) ? _event->getId() : _id; }
+
+
+  string  RoutingEventHistory::Entry::_getString () const
+  {
+    if (_event) return getString(_event);
+    return "<Finalized id:" + getString(_id)
+         + " @"             + DbU::getValueString(_axisHistory)
+         + " "              + getString(_segment) + ">";
+  }
+
+
   RoutingEventHistory::RoutingEventHistory ()
-    : _events    ()
+    : _events     ()
+    , _finalizeds (0)
+    , _nextCompact(CompactMinSize)
   { }
 
 
@@ -44,14 +70,28 @@ namespace Kite {
 
   RoutingEvent* RoutingEventHistory::getNth ( size_t index ) const
   {
-    if ( index < size() ) return _events[index];
+    if ( index < size() ) return _events[index].getEvent();
     return NULL;
   }
 
 
   RoutingEvent* RoutingEventHistory::getRNth ( size_t index ) const
   {
-    if ( index < size() ) return _events[size()-index-1];
+    if ( index < size() ) return _events[size()-index-1].getEvent();
+    return NULL;
+  }
+
+
+  const RoutingEventHistory::Entry* RoutingEventHistory::getNthEntry ( size_t index ) const
+  {
+    if ( index < size() ) return &_events[index];
+    return NULL;
+  }
+
+
+  const RoutingEventHistory::Entry* RoutingEventHistory::getRNthEntry ( size_t index ) const
+  {
+    if ( index < size() ) return &_events[size()-index-1];
     return NULL;
   }
 
@@ -64,21 +104,64 @@ namespace Kite {
     size_t stop = (_events.size() > depth) ? (_events.size()-depth-1) : 0;
     size_t i    =  _events.size()-1;
     do {
-      o << "     - [" << setfill('0') << setw(3) << i << "]: " << _events[i] << endl;
+      o << "     - [" << setfill('0') << setw(3) << i << "]: " << _events[i]._getString() << endl;
       o << setfill(' ');
     } while ( i && (i-- >= stop) );
   }
 
 
   void  RoutingEventHistory::push ( RoutingEvent* event )
-  { _events.push_back(event); }
+  {
+    _events.push_back( Entry(event) );
+    if (_events.size() >= _nextCompact) compact();
+  }
+
+
+  void  RoutingEventHistory::compact ()
+  {
+  // An event is finalized when it has been superseded by a clone, that is
+  // no longer queued nor the active event of it's segment. It is replaced
+  // by it's id, segment and axis history. As the same event may have been
+  // pushed more than once, it is destroyed only after all it's entries
+  // have been finalized. The period doubles, so it is amortized O(1).
+    vector<RoutingEvent*> finalizeds;
+
+    for ( size_t i=0 ; i < _events.size() ; i++ ) {
+      RoutingEvent* event = _events[i]._event;
+      if (not event or not event->isCloned() or event->isQueued()) continue;
+      if (event->getSegment()->getDataNegociate()->getRoutingEvent() == event) continue;
+
+      _events[i]._segment     = event->getSegment();
+      _events[i]._axisHistory = event->getAxisHistory();
+      _events[i]._id          = event->getId();
+      _events[i]._event       = NULL;
+      finalizeds.push_back( event );
+      ++_finalizeds;
+    }
+
+    sort( finalizeds.begin(), finalizeds.end() );
+    finalizeds.erase( unique(finalizeds.begin(),finalizeds.end()), finalizeds.end() );
+    for ( size_t i=0 ; i < finalizeds.size() ; i++ )
+      finalizeds[i]->destroy();
+
+    _nextCompact = std::max( CompactMinSize, 2*_events.size() );
+  }
 
 
   void  RoutingEventHistory::clear ()
   {
+    vector<RoutingEvent*> events;
     for ( size_t i=0 ; i < _events.size() ; i++ )
-      _events[i]->destroy();
+      if (_events[i]._event) events.push_back( _events[i]._event );
+
+    sort( events.begin(), events.end() );
+    events.erase( unique(events.begin(),events.end()), events.end() );
+    for ( size_t i=0 ; i < events.size() ; i++ )
+      events[i]->destroy();
+
     _events.clear ();
+    _finalizeds  = 0;
+    _nextCompact = CompactMinSize;
   }
 
 
@@ -87,6 +170,7 @@ namespace Kite {
     string s = "<" + _getTypeName();
 
     s += ":" + getString(size());
+    s += " (" + getString(_finalizeds) + " finalizeds)";
     s += ">";
 
     return s;
@@ -96,7 +180,8 @@ namespace Kite {
   Record* RoutingEventHistory::_getRecord () const
   {
     Record* record = new Record ( getString(this) );
-    record->add ( getSlot ( "_events", &_events ) );
+    record->add ( getSlot ( "_size"      , size()       ) );
+    record->add ( getSlot ( "_finalizeds", &_finalizeds ) );
                                      
     return record;
   }
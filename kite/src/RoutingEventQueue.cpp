@@ -31,9 +31,7 @@ namespace Kite {
   using std::endl;
   using std::setw;
   using std::max;
-  using std::make_heap;
-  using std::push_heap;
-  using std::pop_heap;
+  using std::sort;
 
   using Hurricane::tab;
   using Hurricane::inltrace;
@@ -51,6 +49,7 @@ namespace Kite {
     : _topEventLevel (0)
     , _pushRequests  ()
     , _events        ()
+    , _stamp         (0)
   { }
 
 
@@ -58,8 +57,79 @@ namespace Kite {
   { clear (); }
 
 
+  void  RoutingEventQueue::_siftUp ( size_t index )
+  {
+    RoutingEvent* event = _events[index];
+
+    while ( index > 0 ) {
+      size_t parent = (index-1) / Arity;
+      if (not _isAbove(event,_events[parent])) break;
+
+      _place( _events[parent], index );
+      index = parent;
+    }
+    _place( event, index );
+  }
+
+
+  void  RoutingEventQueue::_siftDown ( size_t index )
+  {
+    RoutingEvent* event = _events[index];
+    size_t        size  = _events.size();
+
+    while ( true ) {
+      size_t first = index*Arity + 1;
+      if (first >= size) break;
+
+      size_t last = std::min( first+Arity, size );
+      size_t best = first;
+      for ( size_t child=first+1 ; child<last ; ++child ) {
+        if (_isAbove(_events[child],_events[best])) best = child;
+      }
+      if (not _isAbove(_events[best],event)) break;
+
+      _place( _events[best], index );
+      index = best;
+    }
+    _place( event, index );
+  }
+
+
+  void  RoutingEventQueue::_heapify ()
+  {
+    for ( size_t i=0 ; i<_events.size() ; ++i ) _events[i]->_queueIndex = i;
+    if (_events.size() < 2) return;
+
+    for ( size_t i=(_events.size()-2)/Arity + 1 ; i > 0 ; --i )
+      _siftDown( i-1 );
+  }
+
+
+  void  RoutingEventQueue::_remove ( RoutingEvent* event )
+  {
+    size_t index = event->_queueIndex;
+    if ( (index >= _events.size()) or (_events[index] != event) ) {
+      cerr << Bug( "RoutingEventQueue::_remove(): %p:%s is not in the queue."
+                 , event, getString(event).c_str() ) << endl;
+      return;
+    }
+
+    RoutingEvent* last = _events.back();
+    _events.pop_back();
+    event->_queueIndex = RoutingEvent::NotQueued;
+
+    if (last == event) return;
+
+    _place( last, index );
+    _siftUp( index );
+    if (last->_queueIndex == index) _siftDown( index );
+  }
+
+
   void  RoutingEventQueue::load ( const vector<TrackElement*>& segments )
   {
+    size_t before = _events.size();
+
     for ( size_t i=0 ; i<segments.size() ; i++ ) {
       if (segments[i]->getDataNegociate()->getRoutingEvent()) {
         cinfo << "[INFO] Already have a RoutingEvent - " << segments[i] << endl;
@@ -71,7 +141,14 @@ namespace Kite {
       }
       RoutingEvent* event = RoutingEvent::create(segments[i]);
       event->updateKey();
-      _events.insert( event );
+      event->_queueStamp = _stamp++;
+      _events.push_back( event );
+    }
+
+  // Bulk loading: build the heap in linear time.
+    if (before == 0) _heapify();
+    else {
+      for ( size_t i=before ; i<_events.size() ; ++i ) _siftUp( i );
     }
   }
 
@@ -100,14 +177,29 @@ namespace Kite {
 
     RoutingEventSet::iterator ipushEvent = _pushRequests.begin();
     for ( ; ipushEvent != _pushRequests.end() ; ipushEvent++ ) {
-      (*ipushEvent)->updateKey();
+      RoutingEvent* event = *ipushEvent;
 
-      _topEventLevel = max( _topEventLevel, (*ipushEvent)->getEventLevel() );
-      _events.insert( (*ipushEvent) );
+      if (event->isQueued()) {
+        cerr << Bug( "RoutingEventQueue::commit(): %p:%s is already queued."
+                   , event, getString(event).c_str() ) << endl;
+        continue;
+      }
 
-      ltrace(200) << "| " << (*ipushEvent) << endl;
+      event->updateKey();
+      event->_queueStamp = _stamp++;
+      _topEventLevel = max( _topEventLevel, event->getEventLevel() );
+      _events.push_back( event );
+
+      ltrace(200) << "| " << event << endl;
     }
     _pushRequests.clear();
+
+  // Many insertions at once (i.e. the repair stage): rebuild the heap.
+    if (_events.size()-before > before) _heapify();
+    else {
+      for ( size_t i=before ; i<_events.size() ; ++i ) _siftUp( i );
+    }
+
 #if defined(CHECK_ROUTINGEVENT_QUEUE)
     _keyCheck();
 #endif
@@ -123,27 +215,21 @@ namespace Kite {
 
   RoutingEvent* RoutingEventQueue::pop ()
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::iterator ievent;
-    RoutingEvent* event = NULL;
-
 #if defined(CHECK_ROUTINGEVENT_QUEUE)
     _keyCheck ();
 #endif
 
-    if (not _events.empty()) {
-      size_t beforeSize = _events.size();
+    if (_events.empty()) return NULL;
 
-      ievent = _events.end();
-      ievent--;
-      event  = (*ievent);
-      _events.erase( ievent );
+    RoutingEvent* event = _events[0];
+    RoutingEvent* last  = _events.back();
 
-      size_t afterSize = _events.size();
+    _events.pop_back();
+    event->_queueIndex = RoutingEvent::NotQueued;
 
-      if (afterSize+1 != beforeSize) {
-        cerr << Bug( "RoutingEventQueue::pop(): more than one event popped: %d."
-                   , (beforeSize-afterSize) ) << endl;
-      }
+    if (not _events.empty()) {
+      _place( last, 0 );
+      _siftDown( 0 );
     }
 
     return event;
@@ -156,18 +242,7 @@ namespace Kite {
     _keyCheck ();
 #endif
 
-    multiset<RoutingEvent*,RoutingEvent::Compare>::iterator ievent = _events.find(event);
-    size_t count = _events.count(event);
-    if (count > 1) {
-      cerr << Bug("RoutingEventQueue::repush(): %d events matches key %p.",count,event) << endl;
-#if defined(CHECK_ROUTINGEVENT_QUEUE)
-      _keyCheck ();
-#endif
-    }
-
-    if (ievent != _events.end()) {
-      _events.erase( ievent );
-    }
+    if (event->isQueued()) _remove( event );
     push ( event );
   }
 
@@ -195,12 +270,20 @@ namespace Kite {
   }
 
 
+  void  RoutingEventQueue::_getSorteds ( vector<RoutingEvent*>& events ) const
+  {
+    events = _events;
+    sort( events.begin(), events.end(), RoutingEvent::Compare() );
+  }
+
+
   void  RoutingEventQueue::prepareRepair ()
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ++ievent ) {
-      (*ievent)->getSegment()->base()->toOptimalAxis();
-    }
+    vector<RoutingEvent*> events;
+    _getSorteds( events );
+
+    for ( size_t i=0 ; i<events.size() ; ++i )
+      events[i]->getSegment()->base()->toOptimalAxis();
   }
 
 
@@ -210,47 +293,50 @@ namespace Kite {
       cerr << Bug("RoutingEvent queue is not empty, %d events remains."
                  ,_events.size()) << endl;
     }
+    for ( size_t i=0 ; i<_events.size() ; ++i )
+      _events[i]->_queueIndex = RoutingEvent::NotQueued;
     _events.clear();
+    _stamp = 0;
   }
 
 
   void  RoutingEventQueue::dump () const
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ievent++ ) {
+    vector<RoutingEvent*> events;
+    _getSorteds( events );
+
+    for ( size_t i=0 ; i<events.size() ; ++i ) {
       cerr << "Deter| Queue:"
-           <<         (*ievent)->getEventLevel()
-           << ","  << setw(6) << (*ievent)->getPriority()
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getLength())
-           << " "             << (*ievent)->getSegment()->isHorizontal()
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getAxis())
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getSourceU())
-           << ": " << (*ievent)->getSegment() << endl;
+           <<         events[i]->getEventLevel()
+           << ","  << setw(6) << events[i]->getPriority()
+           << " "  << setw(6) << DbU::getValueString(events[i]->getSegment()->getLength())
+           << " "             << events[i]->getSegment()->isHorizontal()
+           << " "  << setw(6) << DbU::getValueString(events[i]->getSegment()->getAxis())
+           << " "  << setw(6) << DbU::getValueString(events[i]->getSegment()->getSourceU())
+           << ": " << events[i]->getSegment() << endl;
     }
   }
 
 
   void  RoutingEventQueue::_keyCheck () const
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ievent++ ) {
-      multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ieventByKey
-        = _events.find ( *ievent );
-      
-      if ( ieventByKey != ievent ) {
-        if ( ieventByKey == _events.end() ) {
-          cerr << Bug("Key mismatch in RoutingEvent Queue:\n"
-                      "      %p:%s wasn't found by key."
-                     ,*ievent,getString(*ievent).c_str()
-                     ) << endl;
-        } else {
-          cerr << Bug("Key mismatch in RoutingEvent Queue:\n"
-                      "      %p:%s has same key of\n"
-                      "      %p:%s"
-                     ,*ievent,getString(*ievent).c_str()
-                     ,*ieventByKey,getString(*ieventByKey).c_str()
-                     ) << endl;
-        }
+    for ( size_t i=0 ; i<_events.size() ; ++i ) {
+      if (_events[i]->_queueIndex != i) {
+        cerr << Bug("Slot mismatch in RoutingEvent Queue:\n"
+                    "      %p:%s is at %d but believe to be at %d."
+                   ,_events[i],getString(_events[i]).c_str(),i,_events[i]->_queueIndex
+                   ) << endl;
+      }
+      if (i == 0) continue;
+
+      size_t parent = (i-1) / Arity;
+      if (_isAbove(_events[i],_events[parent])) {
+        cerr << Bug("Key mismatch in RoutingEvent Queue:\n"
+                    "      %p:%s is above it's parent\n"
+                    "      %p:%s"
+                   ,_events[i],getString(_events[i]).c_str()
+                   ,_events[parent],getString(_events[parent]).c_str()
+                   ) << endl;
       }
     }
   }
@@ -27,6 +27,7 @@
 #include "kite/Manipulator.h"
 #include "kite/SegmentFsm.h"
 #include "kite/KiteEngine.h"
+#include "kite/Telemetry.h"
 
 
 namespace {
@@ -206,14 +207,14 @@ namespace {
   class RipupHistory {
     public:
                              RipupHistory       ( RoutingEvent* );
-      inline bool            isDislodger        ( RoutingEvent* ) const;
+      inline bool            isDislodger        ( const RoutingEventHistory::Entry* ) const;
       inline size_t          size               () const;
       inline size_t          getDislodgersCount () const;
              void            addAxis            ( DbU::Unit );
              void            addAxis            ( RoutingEvent* );
              bool            hasAxis            ( DbU::Unit ) const;
              UnionIntervals* getUnionIntervals  ( DbU::Unit );
-             void            addDislodger       ( RoutingEvent* );
+             void            addDislodger       ( const RoutingEventHistory::Entry* );
              void            addDislodger       ( TrackElement* );
              void            print              ( ostream& );
     private:
@@ -246,7 +247,7 @@ namespace {
       size_t   begin    = Track::npos;
       size_t   end      = Track::npos;
       Interval interval = _masterEvent->getSegment()->getCanonicalInterval();
-      track->getOverlapBounds( interval, begin, end );
+      track->getIntersectBounds( interval, begin, end );
 
       if (begin != Track::npos) {
         for ( ; begin < end ; ++begin ) {
@@ -261,7 +262,7 @@ namespace {
   }
 
 
-  inline bool    RipupHistory::isDislodger        ( RoutingEvent* event ) const { return hasAxis(event->getSegment()->getAxis()); }
+  inline bool    RipupHistory::isDislodger        ( const RoutingEventHistory::Entry* entry ) const { return hasAxis(entry->getSegment()->getAxis()); }
   inline size_t  RipupHistory::size               () const { return _dislodgers.size(); }
   inline size_t  RipupHistory::getDislodgersCount () const { return _dislodgersCount; }
 
@@ -290,15 +291,15 @@ namespace {
   }
 
 
-  void  RipupHistory::addDislodger ( RoutingEvent* event )
+  void  RipupHistory::addDislodger ( const RoutingEventHistory::Entry* entry )
   {
-    if (event->getSegment() == _masterEvent->getSegment()) return;
-    if (event->getSegment()->getLayer() != _masterEvent->getSegment()->getLayer()) return;
+    if (entry->getSegment() == _masterEvent->getSegment()) return;
+    if (entry->getSegment()->getLayer() != _masterEvent->getSegment()->getLayer()) return;
 
-    UnionIntervals* intervals = getUnionIntervals( event->getAxisHistory() );
+    UnionIntervals* intervals = getUnionIntervals( entry->getAxisHistory() );
     if (not intervals) return;
 
-    Interval canonical = event->getSegment()->getCanonicalInterval();
+    Interval canonical = entry->getSegment()->getCanonicalInterval();
     intervals->addInterval( canonical );
 
     ++_dislodgersCount;
@@ -380,6 +381,8 @@ namespace Kite {
     DataNegociate* data = _segment->getDataNegociate();
     if (data == NULL) { DebugSession::close(); return true; }
 
+    Telemetry::addAction( _type );
+
     if (_type & ResetRipup) data->resetRipupCount();
 
     if (_type & ToState) {
@@ -387,7 +390,10 @@ namespace Kite {
       data->setRipupCount( Session::getKiteEngine()->getRipupLimit(_segment) );
     }
 
-    if (_segment->getTrack()) Session::addRemoveEvent( _segment );
+    if (_segment->getTrack()) {
+      Telemetry::addRipup( _segment->getNet() );
+      Session::addRemoveEvent( _segment );
+    }
 
     RoutingEvent* event = data->getRoutingEvent();
     if (event == NULL) {
@@ -615,6 +621,8 @@ namespace Kite {
 
   bool  SegmentFsm::insertInTrack ( size_t i )
   {
+    Telemetry::Timer timer ( Telemetry::InsertInTrack );
+
     ltrace(200) << "SegmentFsm::insertInTrack() istate:" << _event->getInsertState()
                 << " track:" << i << endl;
 
@@ -636,9 +644,10 @@ namespace Kite {
 
   bool  SegmentFsm::conflictSolveByHistory ()
   {
+    Telemetry::Timer timer ( Telemetry::ConflictByHistory );
+
     bool          success = false;
     RipupHistory  ripupHistory ( _event );
-    RoutingEvent* event;
     TrackElement* segment = _event->getSegment();
 
     ltrace(200) << "SegmentFsm::conflictSolveByHistory()" << endl;
@@ -646,10 +655,10 @@ namespace Kite {
     size_t maxDepth   = min( getHistory().size(), (size_t)300 );
     size_t depth      = 0;
     while ( (ripupHistory.getDislodgersCount() < 3) and (depth < maxDepth) ) {
-      event = getHistory().getRNth(depth++);
-      if (not event) continue;
-      if ( (event->getSegment() != segment) and ripupHistory.isDislodger(event) )
-        ripupHistory.addDislodger( event );
+      const RoutingEventHistory::Entry* entry = getHistory().getRNthEntry(depth++);
+      if (not entry) continue;
+      if ( (entry->getSegment() != segment) and ripupHistory.isDislodger(entry) )
+        ripupHistory.addDislodger( entry );
     }
 
   //ripupHistory.print ( cout );
@@ -721,6 +730,8 @@ namespace Kite {
 
   bool  SegmentFsm::conflictSolveByPlaceds ()
   {
+    Telemetry::Timer timer ( Telemetry::ConflictByPlaceds );
+
     bool                  success    = false;
     Interval              constraints;
     vector<Cs1Candidate>  candidates;
@@ -863,6 +874,8 @@ namespace Kite {
 
   bool  SegmentFsm::solveTerminalVsGlobal ()
   {
+    Telemetry::Timer timer ( Telemetry::TerminalVsGlobal );
+
     TrackElement* segment = getEvent()->getSegment();
     ltrace(200) << "SegmentFsm::solveTerminalVsGlobal: " << " " << segment << endl;
 
@@ -896,6 +909,8 @@ namespace Kite {
 
   bool  SegmentFsm::solveFullBlockages ()
   {
+    Telemetry::Timer timer ( Telemetry::FullBlockages );
+
     bool          success = false;
     TrackElement* segment = getEvent()->getSegment();
 
@@ -943,6 +958,8 @@ namespace Kite {
 
   bool  SegmentFsm::desaturate ()
   {
+    Telemetry::Timer timer ( Telemetry::Desaturate );
+
     ltrace(200) << "SegmentFsm::desaturate()" << endl;
     ltracein(200);
 
@@ -1210,6 +1227,8 @@ namespace Kite {
 
   bool  SegmentFsm::slackenTopology ( unsigned int flags )
   {
+    Telemetry::Timer timer ( Telemetry::SlackenTopology );
+
     bool           success     = false;
     TrackElement*  segment     = getEvent()->getSegment();
     DataNegociate* data        = segment->getDataNegociate ();
@@ -22,6 +22,7 @@
 #include "kite/Track.h"
 #include "kite/TrackElement.h"
 #include "kite/KiteEngine.h"
+#include "kite/Telemetry.h"
 
 
 namespace {
@@ -179,7 +180,11 @@ namespace Kite {
       }
     }
     
-    size_t count = Katabatic::Session::_revalidate();
+    size_t count = 0;
+    {
+      Telemetry::Timer timer ( Telemetry::KatabaticRevalidate );
+      count = Katabatic::Session::_revalidate();
+    }
 
     Interval                    span;
     const vector<AutoSegment*>& revalidateds     = getRevalidateds();
@@ -279,7 +284,7 @@ namespace Kite {
   void  Session::_addInsertEvent ( TrackMarker* marker, Track* track )
   {
     _insertEvents.push_back( Event(marker,track) );
-    _addSortEvent( track, true );
+    _addSortEvent( track, false );
   }
 
 
@@ -299,7 +304,7 @@ namespace Kite {
     }
 
     _insertEvents.push_back( Event(segment,track) );
-    _addSortEvent( track, true );
+    _addSortEvent( track, false );
   }
 
 
@@ -313,7 +318,7 @@ namespace Kite {
 
     ltrace(200) << "Ripup: @" << DbU::getValueString(segment->getAxis()) << " " << segment << endl;
     _removeEvents.push_back( Event(segment,segment->getTrack()) );
-    _addSortEvent( segment->getTrack(), true );
+    _addSortEvent( segment->getTrack(), false );
   }
 
 
@@ -0,0 +1,196 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :       Jean-Paul.Chaput@asim.lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./Telemetry.cpp"                               |
+// +-----------------------------------------------------------------+
+
+
+#include <vector>
+#include <algorithm>
+#include "hurricane/Warning.h"
+#include "hurricane/Net.h"
+#include "crlcore/Utilities.h"
+#include "kite/Telemetry.h"
+
+
+namespace {
+
+  using namespace std;
+  using Hurricane::Net;
+
+
+  string  actionTypeName ( unsigned int type )
+  {
+    static const char* names[] = { "Self"        , "Other"      , "Perpandicular", "Insert"
+                                 , "Ripup"       , "RipedByLocal", "ResetRipup"  , "ToRipupLimit"
+                                 , "MoveToAxis"  , "AxisHint"   , "PackingMode"  , "ToState"
+                                 , "EventLevel1" , "EventLevel2", "EventLevel3"  , "EventLevel4"
+                                 , "EventLevel5" };
+    string name;
+    for ( size_t bit=0 ; bit<sizeof(names)/sizeof(char*) ; ++bit ) {
+      if (not (type & (1<<bit))) continue;
+      if (not name.empty()) name += "|";
+      name += names[bit];
+    }
+    return (name.empty()) ? "None" : name;
+  }
+
+
+  double  toSeconds ( Kite::Telemetry::Clock::duration duration )
+  { return std::chrono::duration<double>(duration).count(); }
+
+
+  struct NetRipupsCompare {
+      inline bool  operator() ( const pair<Net*,size_t>& lhs, const pair<Net*,size_t>& rhs ) const
+      {
+        if (lhs.second != rhs.second) return lhs.second > rhs.second;
+        return lhs.first->getId() < rhs.first->getId();
+      }
+  };
+
+
+} // Anonymous namespace.
+
+
+namespace Kite {
+
+  using std::cerr;
+  using std::endl;
+  using std::vector;
+  using std::pair;
+  using Hurricane::Warning;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::Telemetry".
+
+
+  bool                      Telemetry::_enabled   = false;
+  unsigned long             Telemetry::_sampling  = 0;
+  string                    Telemetry::_cellName;
+  FILE*                     Telemetry::_trace     = NULL;
+  Telemetry::Clock::time_point
+                            Telemetry::_start;
+  size_t                    Telemetry::_inserts   = 0;
+  size_t                    Telemetry::_removes   = 0;
+  size_t                    Telemetry::_ripups    = 0;
+  map<unsigned int,size_t>  Telemetry::_actions;
+  map<Net*,size_t>          Telemetry::_netRipups;
+  Telemetry::Clock::duration
+                            Telemetry::_times [TimingsSize];
+  size_t                    Telemetry::_calls [TimingsSize];
+
+
+  const char* Telemetry::getTimingName ( Timing timing )
+  {
+    switch ( timing ) {
+      case InsertInTrack:        return "insertInTrack";
+      case ConflictByHistory:    return "conflictSolveByHistory";
+      case ConflictByPlaceds:    return "conflictSolveByPlaceds";
+      case TerminalVsGlobal:     return "solveTerminalVsGlobal";
+      case FullBlockages:        return "solveFullBlockages";
+      case Desaturate:           return "desaturate";
+      case SlackenTopology:      return "slackenTopology";
+      case RipupPerpandiculars:  return "ripupPerpandiculars";
+      case Minimize:             return "minimize";
+      case RepackPerpandiculars: return "repackPerpandiculars";
+      case KatabaticRevalidate:  return "Katabatic::Session::revalidate";
+      case TimingsSize:          break;
+    }
+    return "Unknown";
+  }
+
+
+  void  Telemetry::open ( const string& cellName, unsigned long sampling )
+  {
+    if (_enabled) close();
+    if (not sampling) return;
+
+    _enabled   = true;
+    _sampling  = sampling;
+    _cellName  = cellName;
+    _start     = Clock::now();
+    _inserts   = 0;
+    _removes   = 0;
+    _ripups    = 0;
+    _actions  .clear();
+    _netRipups.clear();
+    for ( size_t i=0 ; i<TimingsSize ; ++i ) {
+      _times[i] = Clock::duration::zero();
+      _calls[i] = 0;
+    }
+
+    string tracePath = _cellName + ".ktrace.csv";
+    _trace = fopen( tracePath.c_str(), "w" );
+    if (not _trace) {
+      cerr << Warning( "Telemetry::open(): Cannot open \"%s\" for writing, no trace.", tracePath.c_str() ) << endl;
+      return;
+    }
+    fprintf( _trace, "events,queue,history,inserts,removes,ripups,seconds\n" );
+  }
+
+
+  void  Telemetry::_sample ( size_t processeds, size_t queueSize, size_t historySize )
+  {
+    if (not _trace) return;
+    fprintf( _trace, "%zu,%zu,%zu,%zu,%zu,%zu,%.6f\n"
+           , processeds, queueSize, historySize, _inserts, _removes, _ripups
+           , toSeconds(Clock::now() - _start) );
+  }
+
+
+  void  Telemetry::close ()
+  {
+    if (not _enabled) return;
+    _enabled = false;
+
+    if (_trace) { fclose( _trace ); _trace = NULL; }
+
+    string statsPath = _cellName + ".kstats.csv";
+    FILE*  stats     = fopen( statsPath.c_str(), "w" );
+    if (not stats) {
+      cerr << Warning( "Telemetry::close(): Cannot open \"%s\" for writing.", statsPath.c_str() ) << endl;
+      return;
+    }
+
+    fprintf( stats, "kind,name,count,seconds\n" );
+    fprintf( stats, "track,insert,%zu,\n", _inserts );
+    fprintf( stats, "track,remove,%zu,\n", _removes );
+
+    for ( map<unsigned int,size_t>::iterator iaction=_actions.begin() ; iaction!=_actions.end() ; ++iaction )
+      fprintf( stats, "action,%s,%zu,\n", actionTypeName(iaction->first).c_str(), iaction->second );
+
+    for ( size_t i=0 ; i<TimingsSize ; ++i )
+      fprintf( stats, "timing,%s,%zu,%.6f\n", getTimingName((Timing)i), _calls[i], toSeconds(_times[i]) );
+
+    vector< pair<Net*,size_t> > netRipups ( _netRipups.begin(), _netRipups.end() );
+    sort( netRipups.begin(), netRipups.end(), NetRipupsCompare() );
+    for ( size_t i=0 ; i<netRipups.size() ; ++i )
+      fprintf( stats, "ripup,%s,%zu,\n", getString(netRipups[i].first->getName()).c_str(), netRipups[i].second );
+
+    fclose( stats );
+
+    cmess1 << "  o  Telemetry." << endl;
+    cmess1 << Dots::asSizet     ("     - Track inserts"        ,_inserts) << endl;
+    cmess1 << Dots::asSizet     ("     - Track removes"        ,_removes) << endl;
+    cmess1 << Dots::asSizet     ("     - Ripups"               ,_ripups) << endl;
+    if (not netRipups.empty())
+      cmess1 << Dots::asIdentifier("     - Most ripped up Net"
+                                  ,getString(netRipups[0].first->getName())+" ("+getString(netRipups[0].second)+")") << endl;
+    cmess1 << Dots::asIdentifier("     - Trace & statistics" ,_cellName+".k{trace,stats}.csv") << endl;
+
+    _actions  .clear();
+    _netRipups.clear();
+  }
+
+
+}  // Kite namespace.
@@ -26,6 +26,7 @@
 #include "kite/Track.h"
 #include "kite/TrackMarker.h"
 #include "kite/DataNegociate.h"
+#include "kite/Telemetry.h"
 
 
 namespace {
@@ -50,6 +51,9 @@ namespace {
 namespace Kite {
 
   using std::lower_bound;
+  using std::upper_bound;
+  using std::inplace_merge;
+  using std::is_sorted;
   using std::remove_if;
   using std::sort;
   using Hurricane::dbo_ptr;
@@ -77,7 +81,11 @@ namespace Kite {
     , _min          (routingPlane->getTrackMin())
     , _max          (routingPlane->getTrackMax())
     , _segments     ()
+    , _sourceUs     ()
+    , _maxTargets   ()
+    , _sortedSize   (0)
     , _markers      ()
+    , _sortedMarkers(0)
     , _localAssigned(false)
     , _segmentsValid(false)
     , _markersValid (false)
@@ -226,9 +234,10 @@ namespace Kite {
       return;
     }
 
-    vector<TrackElement*>::const_iterator  lowerBound
-      = lower_bound( _segments.begin(), _segments.end(), position, SourceCompare() );
-    begin = lowerBound - _segments.begin();
+    if (_isPacked())
+      begin = lower_bound( _sourceUs.begin(), _sourceUs.end(), position ) - _sourceUs.begin();
+    else
+      begin = lower_bound( _segments.begin(), _segments.end(), position, SourceCompare() ) - _segments.begin();
 
   // This is suspicious.
   // I guess this has been written for the case of overlapping segments from the same
@@ -278,6 +287,25 @@ namespace Kite {
   }
 
 
+  void  Track::getIntersectBounds ( Interval interval, size_t& begin, size_t& end ) const
+  {
+  // Smallest [begin:end[ range holding all the segments intersecting interval.
+  // As _maxTargets is non-decreasing, the first candidate is found by a binary
+  // search even when a long segment overlaps the following ones.
+    begin = end = npos;
+    if (not _sortedSize or interval.isEmpty()) return;
+
+    vector<DbU::Unit>::const_iterator ifirst
+      = lower_bound( _maxTargets.begin(), _maxTargets.begin()+_sortedSize, interval.getVMin() );
+    if (ifirst == _maxTargets.begin()+_sortedSize) return;
+
+    begin = ifirst - _maxTargets.begin();
+    end   = upper_bound( _sourceUs.begin()+begin, _sourceUs.begin()+_sortedSize, interval.getVMax() )
+          - _sourceUs.begin();
+    if (begin >= end) begin = end = npos;
+  }
+
+
   TrackCost  Track::getOverlapCost ( Interval     interval
                                    , Net*         net
                                    , size_t       begin
@@ -334,7 +362,9 @@ namespace Kite {
     size_t begin;
     size_t end;
 
-    getOverlapBounds( interval, begin, end );
+  // Once sorted, only the segments really intersecting are visited.
+    if (_isPacked()) getIntersectBounds( interval, begin, end );
+    else             getOverlapBounds  ( interval, begin, end );
 
     return getOverlapCost( interval, net, begin, end, flags );
   }
@@ -465,7 +495,7 @@ namespace Kite {
 
     segment->setAxis ( getAxis() );
     _segments.push_back ( segment );
-    _segmentsValid = false;
+    Telemetry::addInserts( 1 );
 
     segment->setTrack ( this );
   }
@@ -628,12 +658,31 @@ namespace Kite {
     ltrace(148) << "Track::doRemoval() - " << this << endl;
     ltracein(148);
 
-    size_t  size = _segments.size();
+    size_t  size           = _segments.size();
+    size_t  firstRemoved   = size;
+    size_t  sortedRemoveds = 0;
 
-    vector<TrackElement*>::iterator  beginRemove
-      = remove_if( _segments.begin(), _segments.end(), isDetachedSegment() );
+    for ( size_t i=0 ; i<size ; ++i ) {
+      if (_segments[i]->getTrack()) continue;
+      if (firstRemoved == size) firstRemoved = i;
+      if (i < _sortedSize) ++sortedRemoveds;
+    }
 
-    _segments.erase( beginRemove, _segments.end() );
+    if (firstRemoved < size) {
+      vector<TrackElement*>::iterator  beginRemove
+        = remove_if( _segments.begin()+firstRemoved, _segments.end(), isDetachedSegment() );
+
+      _segments.erase( beginRemove, _segments.end() );
+      Telemetry::addRemoves( size - _segments.size() );
+
+    // Removal keeps the order, only the indexes after the first hole changes.
+      _sortedSize -= sortedRemoveds;
+      if (firstRemoved < _sortedSize) _reindex( firstRemoved );
+      else {
+        _sourceUs  .resize( _sortedSize );
+        _maxTargets.resize( _sortedSize );
+      }
+    }
 
     ltrace(148) << "After doRemoval " << this << endl;
     ltraceout(148);
@@ -642,21 +691,54 @@ namespace Kite {
   }
 
 
+  void  Track::_reindex ( size_t from )
+  {
+    _sourceUs  .resize( _sortedSize );
+    _maxTargets.resize( _sortedSize );
+
+    for ( size_t i=from ; i < _sortedSize ; i++ ) {
+      DbU::Unit targetU = _segments[i]->getTargetU();
+
+      _segments[i]->setIndex( i );
+      _sourceUs[i]   = _segments[i]->getSourceU();
+      _maxTargets[i] = (i and (_maxTargets[i-1] > targetU)) ? _maxTargets[i-1] : targetU;
+    }
+  }
+
+
   void  Track::doReorder ()
   {
     ltrace(200) << "Track::doReorder() " << this << endl;
 
-    if (not _segmentsValid ) {
-      std::sort ( _segments.begin(), _segments.end(), SegmentCompare() );
-      for ( size_t i=0 ; i < _segments.size() ; i++ ) {
-        _segments[i]->setIndex ( i );
-      }
+    if (not _segmentsValid) {
+    // Segments extensions have changed: full sort, usually on an almost
+    // sorted vector.
+      if (not is_sorted( _segments.begin(), _segments.end(), SegmentCompare() ))
+        std::sort( _segments.begin(), _segments.end(), SegmentCompare() );
+      _sortedSize = _segments.size();
+      _reindex( 0 );
       _segmentsValid = true;
+    } else if (_sortedSize < _segments.size()) {
+    // Only insertions: sort the pending ones and merge them.
+      vector<TrackElement*>::iterator imiddle = _segments.begin() + _sortedSize;
+
+      std::sort( imiddle, _segments.end(), SegmentCompare() );
+      size_t first = upper_bound( _segments.begin(), imiddle, *imiddle, SegmentCompare() )
+                   - _segments.begin();
+      inplace_merge( _segments.begin(), imiddle, _segments.end(), SegmentCompare() );
+
+      _sortedSize = _segments.size();
+      _reindex( first );
     }
 
     if (not _markersValid ) {
-      std::sort ( _markers.begin(), _markers.end(), TrackMarker::Compare() );
-      _markersValid = true;
+    // Markers are never moved: only sort the new ones and merge them.
+      vector<TrackMarker*>::iterator imiddle = _markers.begin() + _sortedMarkers;
+
+      std::sort( imiddle, _markers.end(), TrackMarker::Compare() );
+      inplace_merge( _markers.begin(), imiddle, _markers.end(), TrackMarker::Compare() );
+      _sortedMarkers = _markers.size();
+      _markersValid  = true;
     }
   }
 
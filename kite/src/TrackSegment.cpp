@@ -59,6 +59,13 @@ namespace Kite {
   { return _allocateds; }
 
 
+  ObjectPool<TrackSegment>  TrackSegment::_pool ( 4096 );
+
+  ObjectPool<TrackSegment>& TrackSegment::getPool         () { return _pool; }
+  void*                     TrackSegment::operator new    ( size_t size ) { return _pool.allocate(size); }
+  void                      TrackSegment::operator delete ( void* segment, size_t size ) { _pool.release(segment,size); }
+
+
   TrackSegment::TrackSegment ( AutoSegment* segment, Track* track )
     : TrackElement  (track)
     , _base         (segment)
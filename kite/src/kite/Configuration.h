@@ -85,22 +85,37 @@ namespace Kite {
       virtual DbU::Unit                  getGlobalThreshold      () const;
       virtual size_t                     getHEdgeCapacity        () const;
       virtual size_t                     getVEdgeCapacity        () const;
+      virtual unsigned int               getLoadThreads          () const;
+      virtual bool                       getGCellSnapshots       () const;
       virtual void                       setAllowedDepth         ( size_t );
       virtual void                       setSaturateRatio        ( float );
       virtual void                       setSaturateRp           ( size_t );
       virtual void                       setGlobalThreshold      ( DbU::Unit );
+      virtual void                       setLoadThreads          ( unsigned int );
+      virtual void                       setGCellSnapshots       ( bool );
       virtual void                       print                   ( Cell* ) const;
     // Methods.                                                  
       inline  Katabatic::Configuration*  base                    ();
       inline  PostEventCb_t&             getPostEventCb          ();
       inline  unsigned long              getEventsLimit          () const;
       inline  unsigned int               getRipupCost            () const;
+      inline  unsigned long              getSnapshotPeriod       () const;
+      inline  const string&              getSnapshotPath         () const;
+      inline  unsigned long              getTelemetrySampling    () const;
+      inline  unsigned int               getProgressInterval     () const;
+      inline  unsigned int               getPowerRailsThreads    () const;
+      inline  bool                       usePowerRailsCache      () const;
               unsigned int               getRipupLimit           ( unsigned int type ) const;
       inline  size_t                     getHTracksReservedLocal () const;
       inline  size_t                     getVTracksReservedLocal () const;
       inline  void                       setEventsLimit          ( unsigned long );
       inline  void                       setRipupCost            ( unsigned int );
-              void                       setRipupLimit           ( unsigned int limit, unsigned int type );
+      inline  void                       setSnapshotPeriod       ( unsigned long );
+      inline  void                       setSnapshotPath         ( const string& );
+      inline  void                       setTelemetrySampling    ( unsigned long );
+      inline  void                       setPowerRailsThreads    ( unsigned int );
+      inline  void                       setPowerRailsCache      ( bool );
+              void                       setRipupLimit           ( unsigned int type, unsigned int limit );
       inline  void                       setPostEventCb          ( PostEventCb_t );
               void                       setHTracksReservedLocal ( size_t );
               void                       setVTracksReservedLocal ( size_t );
@@ -118,6 +133,12 @@ namespace Kite {
              unsigned int                _ripupLimits         [RipupLimitsTableSize];
              unsigned int                _ripupCost;
              unsigned long               _eventsLimit;
+             unsigned long               _snapshotPeriod;
+             string                      _snapshotPath;
+             unsigned long               _telemetrySampling;
+             unsigned int                _progressInterval;
+             unsigned int                _powerRailsThreads;
+             bool                        _powerRailsCache;
              unsigned int                _flags;
     private:
                      Configuration ( const Configuration& other, Katabatic::Configuration* base=NULL );
@@ -130,9 +151,20 @@ namespace Kite {
   inline Configuration::PostEventCb_t& Configuration::getPostEventCb          () { return _postEventCb; }
   inline unsigned long                 Configuration::getEventsLimit          () const { return _eventsLimit; }
   inline unsigned int                  Configuration::getRipupCost            () const { return _ripupCost; }
+  inline unsigned long                 Configuration::getSnapshotPeriod       () const { return _snapshotPeriod; }
+  inline const string&                 Configuration::getSnapshotPath         () const { return _snapshotPath; }
+  inline unsigned long                 Configuration::getTelemetrySampling    () const { return _telemetrySampling; }
+  inline unsigned int                  Configuration::getProgressInterval     () const { return _progressInterval; }
+  inline unsigned int                  Configuration::getPowerRailsThreads    () const { return _powerRailsThreads; }
+  inline bool                          Configuration::usePowerRailsCache      () const { return _powerRailsCache; }
   inline size_t                        Configuration::getHTracksReservedLocal () const { return _hTracksReservedLocal; }
   inline size_t                        Configuration::getVTracksReservedLocal () const { return _vTracksReservedLocal; }
   inline void                          Configuration::setRipupCost            ( unsigned int cost ) { _ripupCost = cost; }
+  inline void                          Configuration::setSnapshotPeriod       ( unsigned long period ) { _snapshotPeriod = period; }
+  inline void                          Configuration::setSnapshotPath         ( const string& path ) { _snapshotPath = path; }
+  inline void                          Configuration::setTelemetrySampling    ( unsigned long sampling ) { _telemetrySampling = sampling; }
+  inline void                          Configuration::setPowerRailsThreads    ( unsigned int threads ) { _powerRailsThreads = threads; }
+  inline void                          Configuration::setPowerRailsCache      ( bool state ) { _powerRailsCache = state; }
   inline void                          Configuration::setPostEventCb          ( PostEventCb_t cb ) { _postEventCb = cb; }
   inline void                          Configuration::setEventsLimit          ( unsigned long limit ) { _eventsLimit = limit; }
   inline bool                          Configuration::useClockTree            () const { return _flags & UseClockTree; }
@@ -48,6 +48,8 @@ namespace Kite {
                      , KtLoadingStage       = 0x00000800
                      , KtSlowMotion         = 0x00001000
                      , KtPreRoutedStage     = 0x00002000
+                     , KtLayerAssignGlobal  = 0x00004000
+                     , KtResumeSnapshot     = 0x00008000
                      , };
 
 } // Kite namespace.
@@ -24,6 +24,7 @@ namespace Hurricane {
   class Record;
 }
 
+#include  "kite/ObjectPool.h"
 #include  "kite/TrackElement.h"
 namespace Katabatic {
   class AutoSegment;
@@ -64,6 +65,9 @@ namespace Kite {
     public:
                                           DataNegociate         ( TrackElement* );
                                          ~DataNegociate         ();
+      static ObjectPool<DataNegociate>&   getPool               ();
+      static void*                        operator new          ( size_t );
+      static void                         operator delete       ( void*, size_t );
       inline bool                         hasRoutingEvent       () const;
       inline RoutingEvent*                getRoutingEvent       () const;
       inline TrackElement*                getTrackSegment       () const;
@@ -83,6 +87,7 @@ namespace Kite {
       inline void                         setState              ( unsigned int, unsigned int flags=0 );
       inline void                         setRoutingEvent       ( RoutingEvent* );
       inline void                         setChildSegment       ( TrackElement* );
+      inline void                         setStateCount         ( unsigned int );
       inline void                         setRipupCount         ( unsigned int );
       inline void                         incRipupCount         ();
       inline void                         decRipupCount         ();
@@ -95,6 +100,7 @@ namespace Kite {
       inline string                       _getTypeName          () const;
     protected:
     // Attributes.
+      static ObjectPool<DataNegociate>  _pool;
       TrackElement*         _trackSegment;
       TrackElement*         _childSegment;
       RoutingEvent*         _routingEvent;
@@ -132,6 +138,7 @@ namespace Kite {
   inline void                         DataNegociate::resetStateCount      () { _stateCount=0; }
   inline void                         DataNegociate::setRoutingEvent      ( RoutingEvent* event ) { _routingEvent = event; }
   inline void                         DataNegociate::setChildSegment      ( TrackElement* child ) { _childSegment = child; }
+  inline void                         DataNegociate::setStateCount        ( unsigned int count ) { _stateCount = count; }
   inline void                         DataNegociate::setRipupCount        ( unsigned int count ) { _ripupCount = count; }
   inline void                         DataNegociate::incRipupCount        () { _ripupCount++; }
   inline void                         DataNegociate::decRipupCount        () { if (_ripupCount) _ripupCount--; }
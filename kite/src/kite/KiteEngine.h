@@ -18,12 +18,15 @@
 #define  KITE_KITE_ENGINE_H
 
 #include <iostream>
+#include <map>
 
 #include "hurricane/Name.h"
+#include "hurricane/Box.h"
 namespace Hurricane {
   class Layer;
   class Net;
   class Cell;
+  class Instance;
   class CellViewer;
 }
 
@@ -41,10 +44,13 @@ namespace Knik {
 
 namespace Kite {
 
+  using std::map;
   using Hurricane::Name;
+  using Hurricane::Box;
   using Hurricane::Layer;
   using Hurricane::Net;
   using Hurricane::Cell;
+  using Hurricane::Instance;
   using Hurricane::CellViewer;
   using CRL::RoutingGauge;
   using Katabatic::KatabaticEngine;
@@ -52,6 +58,7 @@ namespace Kite {
   class Track;
   class RoutingPlane;
   class NegociateWindow;
+  class SweepPoint;
 
 
 // -------------------------------------------------------------------
@@ -64,8 +71,15 @@ namespace Kite {
       static  KiteEngine*             create                     ( Cell* );
       static  KiteEngine*             get                        ( const Cell* );
       static  void                    wipeoutRouting             ( Cell* );
+      static  KiteEngine*             createEco                  ( Cell*
+                                                                 , const vector<Net*>&
+                                                                 , const vector<Instance*>&
+                                                                 , const Box& window=Box() );
     public:                                                      
       inline  bool                    useClockTree               () const;
+      inline  bool                    isEco                      () const;
+      inline  const NetSet&           getEcoNets                 () const;
+      inline  const Box&              getEcoWindow               () const;
       inline  CellViewer*             getViewer                  () const;
       inline  KatabaticEngine*        base                       ();
       inline  Configuration*          getKiteConfiguration       ();
@@ -76,6 +90,10 @@ namespace Kite {
       inline  unsigned int            getRipupLimit              ( unsigned int type ) const;
               unsigned int            getRipupLimit              ( const TrackElement* ) const;
       inline  unsigned int            getRipupCost               () const;
+      inline  unsigned long           getSnapshotPeriod          () const;
+              string                  getSnapshotPath            () const;
+      inline  unsigned long           getTelemetrySampling       () const;
+      inline  unsigned int            getProgressInterval        () const;
       inline  size_t                  getHTracksReservedLocal    () const;
       inline  size_t                  getVTracksReservedLocal    () const;
       virtual const Name&             getName                    () const;
@@ -96,6 +114,9 @@ namespace Kite {
       inline  void                    setMinimumWL               ( double );
       inline  void                    setRipupLimit              ( unsigned int type, unsigned int );
       inline  void                    setRipupCost               ( unsigned int );
+      inline  void                    setSnapshotPeriod          ( unsigned long );
+      inline  void                    setSnapshotPath            ( const string& );
+      inline  void                    setTelemetrySampling       ( unsigned long );
       inline  void                    setHTracksReservedLocal    ( size_t );
       inline  void                    setVTracksReservedLocal    ( size_t );
               void                    buildPowerRails            ();
@@ -109,12 +130,24 @@ namespace Kite {
               void                    annotateGlobalGraph        ();
               void                    setFixedPreRouted          ();
               void                    runNegociate               ( unsigned int flags=KtNoFlags );
+              void                    resumeNegociate            ( unsigned int flags=KtNoFlags );
+              size_t                  runSweep                   ( vector<SweepPoint>&, unsigned int jobs=1, unsigned int flags=KtNoFlags );
+              size_t                  runSweep                   ( const string& path, unsigned int jobs=1 );
               void                    runGlobalRouter            ( unsigned int mode );
       virtual void                    loadGlobalRouting          ( unsigned int method );
       virtual void                    finalizeLayout             ();
               void                    _runKiteInit               ();
               void                    _gutKite                   ();
+              bool                    _freezeEcoNet              ( Net* );
+              void                    _thawEcoNets               ();
+              void                    _closeEcoWindow            ();
               void                    _computeCagedConstraints   ();
+              void                    _prepareNegociate          ();
+              unsigned int            _negociate                 ( unsigned int flags );
+              void                    _computeCompletion         ( size_t&                 routeds
+                                                                 , vector<TrackElement*>&  unrouteds
+                                                                 , unsigned long long&     totalWireLength
+                                                                 , unsigned long long&     routedWireLength ) const;
               TrackElement*           _lookup                    ( Segment* ) const;
       inline  TrackElement*           _lookup                    ( AutoSegment* ) const;
               bool                    _check                     ( unsigned int& overlap, const char* message=NULL ) const;
@@ -133,8 +166,14 @@ namespace Kite {
              Configuration*           _configuration;
              vector<RoutingPlane*>    _routingPlanes;
              NegociateWindow*         _negociateWindow;
+             bool                     _negociatePrepared;
              double                   _minimumWL;
              mutable bool             _toolSuccess;
+             bool                     _eco;
+             NetSet                   _ecoNets;      // Nets to re-route.
+             map<Net*,unsigned int>   _ecoFrozens;   // Nets kept as is, with their original state.
+             vector<Segment*>         _ecoStubs;     // Wires blocking the frozen nets contacts.
+             Box                      _ecoWindow;    // Area where the ECO nets are re-routed.
 
     protected:
     // Constructors & Destructors.
@@ -151,6 +190,9 @@ namespace Kite {
 
 // Inline Functions.
   inline  bool                          KiteEngine::useClockTree            () const { return _configuration->useClockTree(); }
+  inline  bool                          KiteEngine::isEco                   () const { return _eco; }
+  inline  const KiteEngine::NetSet&     KiteEngine::getEcoNets              () const { return _ecoNets; }
+  inline  const Box&                    KiteEngine::getEcoWindow            () const { return _ecoWindow; }
   inline  CellViewer*                   KiteEngine::getViewer               () const { return _viewer; }
   inline  KatabaticEngine*              KiteEngine::base                    () { return static_cast<KatabaticEngine*>(this); }
   inline  Configuration*                KiteEngine::getKiteConfiguration    () { return _configuration; }
@@ -159,6 +201,9 @@ namespace Kite {
   inline  bool                          KiteEngine::getToolSuccess          () const { return _toolSuccess; }
   inline  unsigned long                 KiteEngine::getEventsLimit          () const { return _configuration->getEventsLimit(); }
   inline  unsigned int                  KiteEngine::getRipupCost            () const { return _configuration->getRipupCost(); }
+  inline  unsigned long                 KiteEngine::getSnapshotPeriod       () const { return _configuration->getSnapshotPeriod(); }
+  inline  unsigned long                 KiteEngine::getTelemetrySampling    () const { return _configuration->getTelemetrySampling(); }
+  inline  unsigned int                  KiteEngine::getProgressInterval     () const { return _configuration->getProgressInterval(); }
   inline  size_t                        KiteEngine::getHTracksReservedLocal () const { return _configuration->getHTracksReservedLocal(); }
   inline  size_t                        KiteEngine::getVTracksReservedLocal () const { return _configuration->getVTracksReservedLocal(); }
   inline  unsigned int                  KiteEngine::getRipupLimit           ( unsigned int type ) const { return _configuration->getRipupLimit(type); }
@@ -166,8 +211,11 @@ namespace Kite {
   inline  size_t                        KiteEngine::getRoutingPlanesSize    () const { return _routingPlanes.size(); }
   inline  void                          KiteEngine::setViewer               ( CellViewer* viewer ) { _viewer=viewer; }
   inline  void                          KiteEngine::setEventLimit           ( unsigned long limit ) { _configuration->setEventsLimit(limit); }
-  inline  void                          KiteEngine::setRipupLimit           ( unsigned int type, unsigned int limit ) { _configuration->setRipupLimit(limit,type); }
+  inline  void                          KiteEngine::setRipupLimit           ( unsigned int type, unsigned int limit ) { _configuration->setRipupLimit(type,limit); }
   inline  void                          KiteEngine::setRipupCost            ( unsigned int cost ) { _configuration->setRipupCost(cost); }
+  inline  void                          KiteEngine::setSnapshotPeriod       ( unsigned long period ) { _configuration->setSnapshotPeriod(period); }
+  inline  void                          KiteEngine::setSnapshotPath         ( const string& path ) { _configuration->setSnapshotPath(path); }
+  inline  void                          KiteEngine::setTelemetrySampling    ( unsigned long sampling ) { _configuration->setTelemetrySampling(sampling); }
   inline  void                          KiteEngine::setHTracksReservedLocal ( size_t reserved ) { _configuration->setHTracksReservedLocal(reserved); }
   inline  void                          KiteEngine::setVTracksReservedLocal ( size_t reserved ) { _configuration->setVTracksReservedLocal(reserved); }
   inline  void                          KiteEngine::setMinimumWL            ( double minimum ) { _minimumWL = minimum; }
@@ -29,6 +29,7 @@ namespace Hurricane {
 #include "kite/RoutingEventQueue.h"
 #include "kite/RoutingEventHistory.h"
 #include "kite/RoutingEventLoop.h"
+#include "kite/SnapshotFormat.h"
 
 
 namespace Kite {
@@ -115,7 +116,11 @@ namespace Kite {
       inline void                          rescheduleEvent    ( RoutingEvent*, unsigned int level );
              void                          run                ( unsigned int flags );
              void                          printStatistics    () const;
+             bool                          saveSnapshot       ( const std::string& path );
+             bool                          loadSnapshot       ( const std::string& path );
              void                          _createRouting     ( Katabatic::GCell* );
+             void                          _snapshotCheck     ();
+             void                          _restoreSnapshot   ();
              size_t                        _negociate         ();
              Hurricane::Record*            _getRecord         () const;
              std::string                   _getString         () const;
@@ -132,6 +137,7 @@ namespace Kite {
       RoutingEventHistory         _eventHistory;
       RoutingEventLoop            _eventLoop;
       Statistics                  _statistics;
+      std::vector<KsnSegment>     _snapshot;
 
     // Constructors.
     protected:
@@ -149,6 +155,7 @@ namespace Kite {
   inline const Katabatic::GCellVector& NegociateWindow::getGCells       () const { return _gcells; }
   inline RoutingEventQueue&            NegociateWindow::getEventQueue   () { return _eventQueue; }
   inline RoutingEventHistory&          NegociateWindow::getEventHistory () { return _eventHistory; }
+  inline RoutingEventLoop&             NegociateWindow::getEventLoop    () { return _eventLoop; }
   inline void                          NegociateWindow::setInterrupt    ( bool state ) { _interrupt = state; }
   inline void                          NegociateWindow::rescheduleEvent ( RoutingEvent* event, unsigned int level ) { event->reschedule(_eventQueue,level); }
   inline std::string                   NegociateWindow::_getTypeName    () const { return "NegociateWindow"; }
@@ -0,0 +1,136 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :       Jean-Paul.Chaput@asim.lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./kite/ObjectPool.h"                           |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KITE_OBJECT_POOL_H
+#define  KITE_OBJECT_POOL_H
+
+#include <new>
+#include <vector>
+#include <type_traits>
+
+
+namespace Kite {
+
+  using std::vector;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::ObjectPool".
+//
+// Fixed size allocator for the many small objects of the negociation
+// (RoutingEvent, TrackSegment, DataNegociate). Memory is obtained by
+// chunks and released objects are recycled through a free list. The
+// chunks are only given back to the system by trim(), when no object
+// remains in use (at the end of a KiteEngine).
+
+  template<typename T>
+  class ObjectPool {
+    public:
+      inline          ObjectPool  ( size_t chunkSize=1024 );
+      inline         ~ObjectPool  ();
+      inline void*    allocate    ( size_t size );
+      inline void     release     ( void*, size_t size );
+      inline size_t   getInUse    () const;
+      inline size_t   getReserved () const;
+      inline bool     trim        ();
+    private:
+      union Slot {
+        Slot*                                                    _next;
+        typename std::aligned_storage<sizeof(T),alignof(T)>::type _storage;
+      };
+    private:
+      size_t         _chunkSize;
+      vector<Slot*>  _chunks;
+      Slot*          _freeList;
+      size_t         _inUse;
+    private:
+                     ObjectPool   ( const ObjectPool& );
+      ObjectPool&    operator=    ( const ObjectPool& );
+  };
+
+
+  template<typename T>
+  inline ObjectPool<T>::ObjectPool ( size_t chunkSize )
+    : _chunkSize(chunkSize)
+    , _chunks   ()
+    , _freeList (NULL)
+    , _inUse    (0)
+  { }
+
+
+  template<typename T>
+  inline ObjectPool<T>::~ObjectPool ()
+  { trim(); }
+
+
+  template<typename T>
+  inline void* ObjectPool<T>::allocate ( size_t size )
+  {
+  // Derived classes are bigger, let them go to the default allocator.
+    if (size != sizeof(T)) return ::operator new(size);
+
+    if (not _freeList) {
+      Slot* chunk = static_cast<Slot*>( ::operator new(sizeof(Slot)*_chunkSize) );
+      _chunks.push_back( chunk );
+
+      for ( size_t i=0 ; i+1<_chunkSize ; ++i ) chunk[i]._next = &chunk[i+1];
+      chunk[_chunkSize-1]._next = NULL;
+      _freeList = chunk;
+    }
+
+    Slot* slot = _freeList;
+    _freeList = slot->_next;
+    ++_inUse;
+
+    return slot;
+  }
+
+
+  template<typename T>
+  inline void  ObjectPool<T>::release ( void* object, size_t size )
+  {
+    if (not object) return;
+    if (size != sizeof(T)) { ::operator delete(object); return; }
+
+    Slot* slot = static_cast<Slot*>( object );
+    slot->_next = _freeList;
+    _freeList   = slot;
+    --_inUse;
+  }
+
+
+  template<typename T>
+  inline bool  ObjectPool<T>::trim ()
+  {
+    if (_inUse) return false;
+
+    for ( size_t i=0 ; i<_chunks.size() ; ++i ) ::operator delete(_chunks[i]);
+    _chunks.clear();
+    _freeList = NULL;
+    return true;
+  }
+
+
+  template<typename T>
+  inline size_t  ObjectPool<T>::getInUse () const { return _inUse; }
+
+  template<typename T>
+  inline size_t  ObjectPool<T>::getReserved () const { return _chunks.size()*_chunkSize; }
+
+
+}  // Kite namespace.
+
+#endif  // KITE_OBJECT_POOL_H
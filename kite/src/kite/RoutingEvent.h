@@ -27,6 +27,7 @@ namespace Hurricane {
   class Net;
 }
 
+#include "kite/ObjectPool.h"
 #include "kite/TrackCost.h"
 #include "kite/TrackElement.h"
 #include "kite/DataNegociate.h"
@@ -90,9 +91,11 @@ namespace Kite {
           inline bool  operator() ( const RoutingEvent* lhs, const RoutingEvent* rhs ) const;
       };
     friend class Compare;
+    friend class RoutingEventQueue;
 
     public:
       enum Mode { Negociate=1, Pack=2, Repair=3 };
+      static const size_t  NotQueued = (size_t)-1;
 
     public:
       static  unsigned int                 getStage              ();
@@ -101,6 +104,9 @@ namespace Kite {
       static  size_t                       getCloneds            ();
       static  void                         resetProcesseds       ();
       static  void                         setStage              ( unsigned int );
+      static  ObjectPool<RoutingEvent>&    getPool               ();
+      static  void*                        operator new          ( size_t );
+      static  void                         operator delete       ( void*, size_t );
     public:                                                      
       static  RoutingEvent*                create                ( TrackElement*, unsigned int mode=Negociate );
               RoutingEvent*                clone                 () const;
@@ -115,6 +121,7 @@ namespace Kite {
       inline  bool                         isRipedByLocal        () const;
       inline  bool                         isOverConstrained     () const;
       inline  unsigned int                 getId                 () const;
+      inline  bool                         isQueued              () const;
       inline  bool                         getMode               () const;
       inline  bool                         canMinimize           () const;
               unsigned int                 getState              () const;
@@ -170,6 +177,7 @@ namespace Kite {
       static size_t         _allocateds;
       static size_t         _processeds;
       static size_t         _cloneds;
+      static ObjectPool<RoutingEvent>  _pool;
       mutable bool          _cloned;
       bool                  _processed;
       bool                  _disabled;
@@ -194,6 +202,8 @@ namespace Kite {
       float                 _priority;
     //vector<TrackElement*> _perpandiculars;
       Key                   _key;
+      size_t                _queueIndex;      // Slot in the RoutingEventQueue heap.
+      size_t                _queueStamp;      // Insertion order, for equal keys.
   };
 
 
@@ -205,6 +215,7 @@ namespace Kite {
   inline bool                          RoutingEvent::isRipedByLocal          () const { return _ripedByLocal; }
   inline bool                          RoutingEvent::isOverConstrained       () const { return _overConstrained; }
   inline unsigned int                  RoutingEvent::getId                   () const { return _id; }
+  inline bool                          RoutingEvent::isQueued                () const { return _queueIndex != NotQueued; }
   inline bool                          RoutingEvent::getMode                 () const { return _mode; }
   inline bool                          RoutingEvent::canMinimize             () const { return !_minimized; }
   inline const RoutingEvent::Key&      RoutingEvent::getKey                  () const { return _key; }
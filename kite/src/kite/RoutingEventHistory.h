@@ -19,14 +19,17 @@
 
 #include <iostream>
 #include <vector>
+#include "hurricane/DbU.h"
 
 
 namespace Kite {
 
   using std::vector;
   using std::ostream;
+  using Hurricane::DbU;
 
   class RoutingEvent;
+  class TrackElement;
 
 
 // -------------------------------------------------------------------
@@ -34,6 +37,28 @@ namespace Kite {
  
   class RoutingEventHistory {
 
+    public:
+    // Sub-Class: Entry.
+    // Once an event has been superseded by it's clone, only what the
+    // history lookups needs is kept, and the RoutingEvent is released.
+      class Entry {
+        public:
+          inline                Entry          ( RoutingEvent* );
+          inline RoutingEvent*  getEvent       () const;
+                 TrackElement*  getSegment     () const;
+                 DbU::Unit      getAxisHistory () const;
+                 unsigned int   getId          () const;
+                 string         _getString     () const;
+        private:
+          friend class RoutingEventHistory;
+                 RoutingEvent*  _event;
+                 TrackElement*  _segment;
+                 DbU::Unit      _axisHistory;
+                 unsigned int   _id;
+      };
+
+    public:
+      static  const size_t  CompactMinSize = 4096;
     public:
                             RoutingEventHistory ();
                            ~RoutingEventHistory ();
@@ -41,7 +66,11 @@ namespace Kite {
       inline  size_t        size                () const;
               RoutingEvent* getNth              ( size_t ) const;
               RoutingEvent* getRNth             ( size_t ) const;
+              const Entry*  getNthEntry         ( size_t ) const;
+              const Entry*  getRNthEntry        ( size_t ) const;
+      inline  size_t        getFinalizeds       () const;
               void          push                ( RoutingEvent* );
+              void          compact             ();
               void          clear               ();
               void          dump                ( ostream&, size_t depth=10 ) const;
               Record*       _getRecord          () const;
@@ -50,7 +79,9 @@ namespace Kite {
 
     protected:
     // Attributes.
-      vector<RoutingEvent*>  _events;
+      vector<Entry>  _events;
+      size_t         _finalizeds;
+      size_t         _nextCompact;
 
     private:
       RoutingEventHistory& operator=           ( const RoutingEventHistory& );
@@ -60,7 +91,14 @@ namespace Kite {
 
 
 // Inline Functions.
+  inline RoutingEventHistory::Entry::Entry ( RoutingEvent* event )
+    : _event(event), _segment(NULL), _axisHistory(0), _id(0)
+  { }
+
+  inline RoutingEvent* RoutingEventHistory::Entry::getEvent () const { return _event; }
+
   inline bool    RoutingEventHistory::empty        () const { return _events.empty(); }
+  inline size_t  RoutingEventHistory::getFinalizeds() const { return _finalizeds; }
   inline size_t  RoutingEventHistory::size         () const { return _events.size(); }
   inline string  RoutingEventHistory::_getTypeName () const { return "RoutingEventHistory"; }
 
@@ -17,29 +17,34 @@
 #ifndef  KITE_ROUTING_EVENT_QUEUE_H
 #define  KITE_ROUTING_EVENT_QUEUE_H
 
-#include <set>
 #include <vector>
 #include "kite/RoutingEvent.h"
 
 
 namespace Kite {
 
-  using std::set;
-  using std::multiset;
   using std::vector;
 
 
 // -------------------------------------------------------------------
 // Class  :  "RoutingEventQueue".
+//
+// Addressable d-ary max-heap of RoutingEvents. Each queued event knows
+// its slot, so it can be removed (repush) in O(log n) without a search.
+// The pop order is the one of RoutingEvent::Compare, events of equal
+// keys being popped in reverse order of insertion.
 
   class RoutingEventQueue {
 
+    public:
+      enum { Arity = 4 };
     public:
                             RoutingEventQueue  ();
                            ~RoutingEventQueue  ();
       inline  bool          empty              () const;
       inline  size_t        size               () const;
       inline  unsigned int  getTopEventLevel   () const;
+      inline  RoutingEvent* peek               () const;
               RoutingEvent* pop                ();
               void          load               ( const vector<TrackElement*>& );
               void          add                ( TrackElement*, unsigned int level );
@@ -55,11 +60,21 @@ namespace Kite {
               string        _getString         () const;
       inline  string        _getTypeName       () const;
 
+    protected:
+      inline  bool          _isAbove           ( const RoutingEvent*, const RoutingEvent* ) const;
+      inline  void          _place             ( RoutingEvent*, size_t index );
+              void          _remove            ( RoutingEvent* );
+              void          _siftUp            ( size_t index );
+              void          _siftDown          ( size_t index );
+              void          _heapify           ();
+              void          _getSorteds        ( vector<RoutingEvent*>& ) const;
+
     protected:
     // Attributes.
-      unsigned int                                   _topEventLevel;
-      RoutingEventSet                                _pushRequests;
-      multiset<RoutingEvent*,RoutingEvent::Compare>  _events;
+      unsigned int           _topEventLevel;
+      RoutingEventSet        _pushRequests;
+      vector<RoutingEvent*>  _events;
+      size_t                 _stamp;
 
     private:
               RoutingEventQueue& operator=         ( const RoutingEventQueue& );
@@ -72,10 +87,27 @@ namespace Kite {
   inline bool          RoutingEventQueue::empty            () const { return _events.empty(); }
   inline size_t        RoutingEventQueue::size             () const { return _events.size(); }
   inline unsigned int  RoutingEventQueue::getTopEventLevel () const { return _topEventLevel; }
+  inline RoutingEvent* RoutingEventQueue::peek             () const { return (_events.empty()) ? NULL : _events[0]; }
   inline string        RoutingEventQueue::_getTypeName     () const { return "EventQueue"; }
   inline void          RoutingEventQueue::push             ( RoutingEvent* event ) { _pushRequests.insert( event ); }
 
 
+  inline bool  RoutingEventQueue::_isAbove ( const RoutingEvent* lhs, const RoutingEvent* rhs ) const
+  {
+    RoutingEvent::Compare compare;
+    if (compare(rhs,lhs)) return true;
+    if (compare(lhs,rhs)) return false;
+    return lhs->_queueStamp > rhs->_queueStamp;
+  }
+
+
+  inline void  RoutingEventQueue::_place ( RoutingEvent* event, size_t index )
+  {
+    _events[index]     = event;
+    event->_queueIndex = index;
+  }
+
+
 }  // Kite namespace.
 
 
@@ -0,0 +1,74 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :       Jean-Paul.Chaput@asim.lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./kite/SnapshotFormat.h"                       |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KITE_SNAPSHOT_FORMAT_H
+#define  KITE_SNAPSHOT_FORMAT_H
+
+#include <stdint.h>
+
+
+namespace Kite {
+
+
+// -------------------------------------------------------------------
+// Binary negociation snapshot (.ksnap).
+//
+// Written by NegociateWindow every "kite.snapshotPeriod" events, and
+// when the events limit is reached. Records are multiples of 8 bytes
+// in the native byte order:
+//
+//   [KsnHeader] [KsnSegment x nbSegments]
+//
+// One KsnSegment per (canonical, non fixed) TrackSegment, identified
+// by its AutoSegment id. Segments created by doglegs after the loading
+// of the global routing cannot be matched on reload and are ignored.
+
+
+  const char      KsnMagic[4]     = { 'K', 'S', 'N', 'P' };
+  const uint32_t  KsnVersion      = 1;
+  const uint32_t  KsnEndianness   = 0x01020304;
+  const uint32_t  KsnCellNameSize = 64;
+  const uint32_t  KsnPlaced       = 0x0001;
+
+
+  struct KsnHeader {
+    char      _magic[4];
+    uint32_t  _version;
+    uint32_t  _endianness;
+    uint32_t  _stage;            // RoutingEvent stage (Negociate, Repair...).
+    uint64_t  _processeds;       // Events processed when written.
+    uint64_t  _nbSegments;
+    char      _cellName[KsnCellNameSize];
+  };
+
+
+  struct KsnSegment {
+    uint64_t  _id;               // AutoSegment id.
+    int64_t   _sourceU;          // Canonical span, used to check the match.
+    int64_t   _targetU;
+    int64_t   _axis;
+    uint32_t  _depth;            // Routing layer depth.
+    uint32_t  _flags;            // KsnPlaced if in a Track.
+    uint32_t  _state;            // DataNegociate.
+    uint32_t  _stateCount;
+    uint32_t  _ripupCount;
+    uint32_t  _reserved;
+  };
+
+
+}  // Kite namespace.
+
+#endif  // KITE_SNAPSHOT_FORMAT_H
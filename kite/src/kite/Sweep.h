@@ -0,0 +1,93 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :       Jean-Paul.Chaput@asim.lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./kite/Sweep.h"                                |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KITE_SWEEP_H
+#define  KITE_SWEEP_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "kite/Configuration.h"
+
+
+namespace Kite {
+
+  using std::string;
+  using std::vector;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::SweepResult".
+//
+// Quality of results of one sweep configuration. Plain data, sent back
+// through a pipe by the child process which did the negociation.
+
+  struct SweepResult {
+    enum Status { Ok=0, Failed=1, Crashed=2 };
+
+    int32_t   _status;
+    uint32_t  _overlaps;
+    uint64_t  _events;
+    uint64_t  _routeds;
+    uint64_t  _unrouteds;
+    uint64_t  _wireLength;          // In lambdas.
+    uint64_t  _unroutedWireLength;
+    double    _seconds;             // Negociation wall time.
+    int64_t   _peakRss;             // In kilobytes.
+  };
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::SweepPoint".
+//
+// One configuration of a sweep: the negociation parameters to override,
+// starting from the current Configuration, and the result of the run.
+// A sweep file holds one configuration per line:
+//
+//   <name> [<parameter>=<value> ...]
+//
+// where <parameter> is one of the "kite." Configuration parameters
+// listed in SweepPoint::set(). Blank lines and '#' comments are skipped.
+
+  class SweepPoint {
+    public:
+      static const size_t         NoBest = (size_t)-1;
+    public:
+      static  vector<SweepPoint>  load      ( const string& path, const Configuration* );
+    public:
+                                  SweepPoint ( const string& name, const Configuration* );
+              void                set        ( const string& parameter, unsigned long value );
+              void                apply      ( Configuration* ) const;
+      inline  const string&       getName    () const;
+      inline  const SweepResult&  getResult  () const;
+      inline  SweepResult&        getResult  ();
+    private:
+      string         _name;
+      unsigned long  _eventsLimit;
+      unsigned int   _ripupCost;
+      unsigned int   _ripupLimits [Configuration::RipupLimitsTableSize];
+      SweepResult    _result;
+  };
+
+
+  inline const string&       SweepPoint::getName   () const { return _name; }
+  inline const SweepResult&  SweepPoint::getResult () const { return _result; }
+  inline SweepResult&        SweepPoint::getResult () { return _result; }
+
+
+}  // Kite namespace.
+
+#endif  // KITE_SWEEP_H
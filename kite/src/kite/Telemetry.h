@@ -0,0 +1,165 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2015-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :       Jean-Paul.Chaput@asim.lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./kite/Telemetry.h"                            |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KITE_TELEMETRY_H
+#define  KITE_TELEMETRY_H
+
+#include <cstdio>
+#include <string>
+#include <map>
+#include <chrono>
+
+namespace Hurricane {
+  class Net;
+}
+
+
+namespace Kite {
+
+  using std::string;
+  using std::map;
+  using Hurricane::Net;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::Telemetry".
+//
+// Counters of the negociation, enabled by "kite.telemetrySampling"
+// (number of events between two samples, zero disables everything).
+// When disabled, each probe costs one test of a static boolean.
+//
+// Two CSV files are written, next to the design:
+//   <cell>.ktrace.csv  One line per sample: events, queue & history
+//                      sizes, Track inserts/removes, ripups, time.
+//   <cell>.kstats.csv  Final totals: SegmentAction types, time spent
+//                      per strategy (and Katabatic revalidation), and
+//                      the nets with the most ripups.
+
+  class Telemetry {
+    public:
+      enum Timing { InsertInTrack        = 0
+                  , ConflictByHistory
+                  , ConflictByPlaceds
+                  , TerminalVsGlobal
+                  , FullBlockages
+                  , Desaturate
+                  , SlackenTopology
+                  , RipupPerpandiculars
+                  , Minimize
+                  , RepackPerpandiculars
+                  , KatabaticRevalidate
+                  , TimingsSize
+                  };
+      typedef std::chrono::steady_clock  Clock;
+    public:
+      class Timer {
+        public:
+          inline  Timer  ( Timing );
+          inline ~Timer  ();
+        private:
+          Timing             _timing;
+          bool               _enabled;
+          Clock::time_point  _start;
+      };
+    public:
+      static  void          open          ( const string& cellName, unsigned long sampling );
+      static  void          close         ();
+      static  const char*   getTimingName ( Timing );
+      inline static bool    enabled       ();
+      inline static void    addAction     ( unsigned int type );
+      inline static void    addRipup      ( Net* );
+      inline static void    addInserts    ( size_t );
+      inline static void    addRemoves    ( size_t );
+      inline static void    addTime       ( Timing, Clock::duration );
+      inline static void    sample        ( size_t processeds, size_t queueSize, size_t historySize );
+    private:
+      static  void          _sample       ( size_t processeds, size_t queueSize, size_t historySize );
+    private:
+      static bool                        _enabled;
+      static unsigned long               _sampling;
+      static string                      _cellName;
+      static FILE*                       _trace;
+      static Clock::time_point           _start;
+      static size_t                      _inserts;
+      static size_t                      _removes;
+      static size_t                      _ripups;
+      static map<unsigned int,size_t>    _actions;
+      static map<Net*,size_t>            _netRipups;
+      static Clock::duration             _times [TimingsSize];
+      static size_t                      _calls [TimingsSize];
+  };
+
+
+  inline bool  Telemetry::enabled    () { return _enabled; }
+  inline void  Telemetry::addAction  ( unsigned int type ) { if (_enabled) ++_actions[type]; }
+  inline void  Telemetry::addInserts ( size_t count ) { if (_enabled) _inserts += count; }
+  inline void  Telemetry::addRemoves ( size_t count ) { if (_enabled) _removes += count; }
+
+  inline void  Telemetry::addRipup ( Net* net )
+  { if (_enabled) { ++_ripups; ++_netRipups[net]; } }
+
+  inline void  Telemetry::addTime ( Timing timing, Clock::duration duration )
+  { _times[timing] += duration; ++_calls[timing]; }
+
+  inline void  Telemetry::sample ( size_t processeds, size_t queueSize, size_t historySize )
+  { if (_enabled and not (processeds % _sampling)) _sample( processeds, queueSize, historySize ); }
+
+
+  inline Telemetry::Timer::Timer ( Timing timing )
+    : _timing (timing)
+    , _enabled(Telemetry::enabled())
+    , _start  ()
+  { if (_enabled) _start = Clock::now(); }
+
+
+  inline Telemetry::Timer::~Timer ()
+  { if (_enabled) Telemetry::addTime( _timing, Clock::now() - _start ); }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Kite::ProgressReporter".
+//
+// Tells when the progress line is to be refreshed, at most once every
+// "kite.progressInterval" milliseconds, instead of once per event.
+
+  class ProgressReporter {
+    public:
+      inline       ProgressReporter ( unsigned int milliseconds );
+      inline bool  ready            ();
+    private:
+      Telemetry::Clock::duration    _interval;
+      Telemetry::Clock::time_point  _last;
+  };
+
+
+  inline ProgressReporter::ProgressReporter ( unsigned int milliseconds )
+    : _interval(std::chrono::milliseconds(milliseconds))
+    , _last    ()
+  { }
+
+
+  inline bool  ProgressReporter::ready ()
+  {
+    Telemetry::Clock::time_point now = Telemetry::Clock::now();
+    if (now - _last < _interval) return false;
+    _last = now;
+    return true;
+  }
+
+
+}  // Kite namespace.
+
+#endif  // KITE_TELEMETRY_H
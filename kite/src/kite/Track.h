@@ -95,6 +95,7 @@ namespace Kite {
               Interval       expandFreeInterval  ( size_t& begin, size_t& end, unsigned int state, Net* ) const;
               void           getBeginIndex       ( DbU::Unit position, size_t& begin, unsigned int& state ) const;
               void           getOverlapBounds    ( Interval, size_t& begin, size_t& end ) const;
+              void           getIntersectBounds  ( Interval, size_t& begin, size_t& end ) const;
               TrackCost      getOverlapCost      ( Interval, Net*, size_t begin, size_t end, unsigned int flags ) const;
               TrackCost      getOverlapCost      ( Interval, Net*, unsigned int flags ) const;
               TrackCost      getOverlapCost      ( TrackElement*, unsigned int flags ) const;
@@ -121,7 +122,11 @@ namespace Kite {
       DbU::Unit              _min;
       DbU::Unit              _max;
       vector<TrackElement*>  _segments;
+      vector<DbU::Unit>      _sourceUs;      // Packed segments sources, for the binary searches.
+      vector<DbU::Unit>      _maxTargets;    // Running maximum of the segments target.
+      size_t                 _sortedSize;    // Sorted prefix of _segments (pending inserts after).
       vector<TrackMarker*>   _markers;
+      size_t                 _sortedMarkers; // Sorted prefix of _markers.
       bool                   _localAssigned;
       bool                   _segmentsValid;
       bool                   _markersValid;
@@ -139,6 +144,8 @@ namespace Kite {
     // Protected functions.
       inline  unsigned int  setMinimalFlags ( unsigned int& state, unsigned int flags ) const;
       inline  unsigned int  setMaximalFlags ( unsigned int& state, unsigned int flags ) const;
+              void          _reindex        ( size_t from );
+      inline  bool          _isPacked       () const;
 
     protected:
     // Sub-Classes.
@@ -195,6 +202,9 @@ namespace Kite {
   inline size_t        Track::getSize          () const { return _segments.size(); }
   inline void          Track::setLocalAssigned ( bool state ) { _localAssigned=state; }
 
+  inline bool  Track::_isPacked () const
+  { return _segmentsValid and (_sortedSize == _segments.size()); }
+
   inline unsigned int  Track::setMinimalFlags ( unsigned int& state, unsigned int flags ) const
   {
     state &=         ~BeginMask;
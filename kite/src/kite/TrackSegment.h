@@ -19,6 +19,7 @@
 
 #include <set>
 #include <functional>
+#include "kite/ObjectPool.h"
 #include "kite/TrackElement.h"
 
 
@@ -53,6 +54,9 @@ namespace Kite {
     public:
       static  TrackElement*         create                 ( AutoSegment*, Track*, bool& created );
       static  size_t                getAllocateds          ();
+      static  ObjectPool<TrackSegment>& getPool            ();
+      static  void*                 operator new           ( size_t );
+      static  void                  operator delete        ( void*, size_t );
     public:                                                
     // Wrapped AutoSegment Functions (when applicable).
       virtual AutoSegment*          base                   () const;
@@ -130,6 +134,7 @@ namespace Kite {
     protected:
     // Attributes.
       static size_t         _allocateds;
+      static ObjectPool<TrackSegment>  _pool;
              AutoSegment*   _base;
              unsigned long  _freedomDegree;
              DbU::Unit      _ppitch;
@@ -27,6 +27,8 @@
 
 #include  "hurricane/Warning.h"
 #include  "hurricane/Error.h"
+#include  <cmath>
+#include  "vlsisapd/configuration/Configuration.h"
 #include  "hurricane/Technology.h"
 #include  "hurricane/DataBase.h"
 #include  "knik/Configuration.h"
@@ -111,11 +113,31 @@ namespace Knik {
     return get()->_getGContact();
   }
 
+// Rip-up & reroute schedule (PathFinder like): at each iteration, the
+// history cost of overflowed edges is increased and the present congestion
+// cost grows, so nets are more and more pushed away from congested edges.
+
+  float Configuration::getHistoryIncrement ( unsigned int iteration ) {
+    Configuration* configuration = get();
+    return configuration->_historyIncrement * pow( configuration->_historyGrowth, (float)iteration );
+  }
+
+  float Configuration::getPresentCost ( unsigned int iteration ) {
+    Configuration* configuration = get();
+    float cost = configuration->_presentCost * pow( configuration->_presentGrowth, (float)iteration );
+    return (cost < configuration->_presentCostMax) ? cost : configuration->_presentCostMax;
+  }
+
   Configuration::Configuration(const Layer* pinMetal, const Layer* gMetalH, const Layer* gMetalV, const Layer* gContact)
     : _pinMetal(gMetalH)
     , _gMetalH(gMetalH)
     , _gMetalV(gMetalV)
     , _gContact(gContact)
+    , _historyIncrement(Cfg::getParamDouble("knik.historyIncrement",   1.5)->asDouble())
+    , _historyGrowth   (Cfg::getParamDouble("knik.historyGrowth"   ,   1.0)->asDouble())
+    , _presentCost     (Cfg::getParamDouble("knik.presentCost"     ,  19.0)->asDouble())
+    , _presentGrowth   (Cfg::getParamDouble("knik.presentGrowth"   ,   1.3)->asDouble())
+    , _presentCostMax  (Cfg::getParamDouble("knik.presentCostMax"  , 200.0)->asDouble())
   { }
 
 }  // End of Knik namespace.
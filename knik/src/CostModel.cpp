@@ -0,0 +1,161 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2006-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |        K n i k  -  G l o b a l   R o u t e r                    |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./CostModel.cpp"                               |
+// +-----------------------------------------------------------------+
+
+
+#include "knik/Configuration.h"
+#include "knik/CostModel.h"
+
+
+namespace {
+
+  // Rip-up mode: history cost weight, according to the edge saturation.
+  inline float  historicFactor ( float ratio )
+  { return (ratio < 1.0) ? ratio : exp(log(8.0)*(ratio - 1.0)); }
+
+} // Anonymous namespace.
+
+
+namespace Knik {
+
+  extern unsigned int  __congestion__;
+  extern unsigned int  __precongestion__;
+  extern float         __edge_cost__;
+  extern bool          __ripupMode__;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Knik::CostModel".
+
+
+// Above this capacity, costs are computed on the fly (and tables would
+// be too big anyway).
+  const unsigned int  TableMaxCapacity = 256;
+
+  CostModel* CostModel::_singleton = NULL;
+
+
+  CostModel* CostModel::get ()
+  {
+    if (not _singleton) _singleton = new CostModel ();
+    return _singleton;
+  }
+
+
+  unsigned int  CostModel::getMode ()
+  {
+    if (not __congestion__) return NoCongestion;
+    if (__ripupMode__)      return Ripup;
+    if (__precongestion__)  return PreCongestion;
+    return Congestion;
+  }
+
+
+  CostModel::CostModel ()
+    : _maxCapacity (0)
+    , _iteration   (0)
+    , _presentCost (0.0)
+    , _viaCost     (__edge_cost__)
+    , _offsets     ()
+    , _routingTable()
+    , _presentTable()
+    , _historyTable()
+  {
+    _offsets.push_back( 0 );
+    _offsets.push_back( 2 );
+  }
+
+
+  float  CostModel::_slowRouting ( unsigned int capacity, unsigned int occupancy2 ) const
+  {
+    float occupancy = (float)occupancy2 / (2.0 * (float)capacity);
+    return 1.0 + (9.0 / (1.0 + exp(-30.0 * (occupancy - 1.0))));
+  }
+
+
+  float  CostModel::_slowRipup ( unsigned int capacity, unsigned int occupancy, float history ) const
+  {
+    float ratio = (float)occupancy / (float)capacity;
+    return 1.0 + (_presentCost / (1.0 + exp(-60.0 * (ratio - 1.0)))) + history * historicFactor(ratio);
+  }
+
+
+  void  CostModel::build ( const vector<Edge*>& edges )
+  {
+    _maxCapacity = 0;
+    for ( size_t i=0 ; i<edges.size() ; ++i ) {
+      if (edges[i]->getCapacity() > _maxCapacity)
+        _maxCapacity = edges[i]->getCapacity();
+    }
+    if (_maxCapacity > TableMaxCapacity) _maxCapacity = TableMaxCapacity;
+
+  // Row of capacity c covers occupancies (in half units) up to 4 x c.
+    _offsets.resize( _maxCapacity+2 );
+    _offsets[0] = 0;
+    for ( unsigned int capacity=0 ; capacity<=_maxCapacity ; ++capacity )
+      _offsets[capacity+1] = _offsets[capacity] + 8*capacity + 2;
+
+    _routingTable.resize( _offsets.back() );
+    for ( unsigned int capacity=1 ; capacity<=_maxCapacity ; ++capacity ) {
+      for ( size_t occupancy2=0 ; occupancy2 < _offsets[capacity+1]-_offsets[capacity] ; ++occupancy2 )
+        _routingTable[ _offsets[capacity]+occupancy2 ] = _slowRouting( capacity, occupancy2 );
+    }
+
+    setIteration( 0 );
+  }
+
+
+  void  CostModel::setIteration ( unsigned int iteration )
+  {
+  // Also reached by reroute() without a prior build().
+    _iteration   = iteration;
+    _presentCost = Configuration::getPresentCost( iteration );
+    _viaCost     = __edge_cost__;
+    _buildRipup();
+  }
+
+
+  void  CostModel::_buildRipup ()
+  {
+    _presentTable.resize( _offsets.back()/2 );
+    _historyTable.resize( _offsets.back()/2 );
+
+    for ( unsigned int capacity=1 ; capacity<=_maxCapacity ; ++capacity ) {
+      size_t rowSize = (_offsets[capacity+1]-_offsets[capacity]) / 2;
+      size_t offset  = _offsets[capacity] / 2;
+
+      for ( size_t occupancy=0 ; occupancy < rowSize ; ++occupancy ) {
+        _presentTable[ offset+occupancy ] = _slowRipup( capacity, occupancy, 0.0 );
+        _historyTable[ offset+occupancy ] = historicFactor( (float)occupancy / (float)capacity );
+      }
+    }
+  }
+
+
+  float  CostModel::getHistoryIncrement () const
+  { return Configuration::getHistoryIncrement( _iteration ); }
+
+
+  float  CostModel::getCost ( const Edge* edge, const Edge* arrivalEdge ) const
+  {
+    switch ( getMode() ) {
+      case Congestion:    return getCost<Congestion   >( edge, arrivalEdge );
+      case PreCongestion: return getCost<PreCongestion>( edge, arrivalEdge );
+      case Ripup:         return getCost<Ripup        >( edge, arrivalEdge );
+    }
+    return getCost<NoCongestion>( edge, arrivalEdge );
+  }
+
+
+}  // Knik namespace.
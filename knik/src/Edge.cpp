@@ -7,20 +7,16 @@
 #include "knik/Edge.h"
 #include "knik/Vertex.h"
 #include "knik/Graph.h"
+#include "knik/CostModel.h"
 
 namespace Knik {
 
-extern unsigned __congestion__;
-extern unsigned __precongestion__;
-extern bool __ripupMode__;
-
-extern float __edge_cost__;
-
 const Name  Edge::_extensionName = "Knik::Edge";
 
 Edge::Edge ( Vertex* from, Vertex* to )
 // ************************************
     : Inherit (from->getCell())
+    , _id (0)
     , _from (from)
     , _nextFrom (NULL)
     , _to (to)
@@ -30,6 +26,7 @@ Edge::Edge ( Vertex* from, Vertex* to )
     , _capacity (0)
     , _realOccupancy (0)
     , _estimateOccupancy (0.0)
+    , _history (0.0)
     , _netStamp (0)
     , _segments()
 {
@@ -40,6 +37,7 @@ Edge::Edge ( Vertex* from, Vertex* to, unsigned capacity )
 // *******************************************************
     : Inherit (from->getCell())
     , _boundingBox()
+    , _id (0)
     , _from (from)
     , _nextFrom (NULL)
     , _to (to)
@@ -49,6 +47,7 @@ Edge::Edge ( Vertex* from, Vertex* to, unsigned capacity )
     , _capacity (capacity)
     , _realOccupancy (0)
     , _estimateOccupancy (0.0)
+    , _history (0.0)
     , _netStamp (0)
     , _isCongested (false)
     , _segments()
@@ -198,69 +197,10 @@ Cell* Edge::getCell() const
 float Edge::getCost ( Edge* arrivalEdge )
 // **************************************
 {
-// 20/10/2010: Check for null capacity, which may occurs after back-annotation
-// by Kite.
-  if ( _capacity == 0.0 ) return (float)(HUGE_VAL);
-
-//#ifdef __USE_CONGESTION__
-    if ( __congestion__ ) {
-        // definition de la fonction de cout :
-        // on ramene l'occupation de l'edge à un pourcentage de la capacité :
-        float edge_capacity  = (float)1.0;
-        float edge_occupancy;
-        //float h = 9.0;
-        //float k = 30.0; // environ 3*h pour etre sur d'avoir cost(0) = 1 !!
-        //now defined as edge's attributes for ripup & reroute
-
-        if ( !__ripupMode__ ) {
-            //#if defined ( __USE_STATIC_PRECONGESTION__ ) || defined ( __USE_DYNAMIC_PRECONGESTION__ )
-            if ( __precongestion__ )
-                edge_occupancy = ((float)getRealOccupancy() + getEstimateOccupancy()) / (float)_capacity;
-            //#else
-            else
-                edge_occupancy = (float)getRealOccupancy() / (float)_capacity;
-            //#endif
-            _cost = 1.0 + (9.0 / (1.0 + exp(-30.0 * (edge_occupancy - edge_capacity)))); // plutot que 1.0 on devrait avoir un getLength renvoyant la longueur de l'arete en unités normalisées (pas de grille)
-        }
-        else {
-            // dans ce mode l'estimation de congestion est utilisé comme historique de congestion
-            edge_occupancy = (float)getRealOccupancy() / (float)_capacity;
-            float historicCost;
-            if ( edge_occupancy < 1 )
-                historicCost = getEstimateOccupancy() * edge_occupancy;
-            else
-                historicCost = getEstimateOccupancy() * exp(log(8)*(edge_occupancy - edge_capacity));
-            _cost = 1.0 + (19.0 / (1.0 + exp(-60.0 * (edge_occupancy - edge_capacity)))) + historicCost;
-        }
-    }
-//#else
-    else
-        _cost = 1.0;
-//#endif
-    // Prise en compte des vias !
-    if ( arrivalEdge ) {
-        if ( arrivalEdge->isVertical() && isHorizontal() )
-            _cost += __edge_cost__;
-        if ( arrivalEdge->isHorizontal() && isVertical() )
-            _cost += __edge_cost__;
-    }
-
-    //if ( _from->getRoutingGraph()->getRipupMode() )
-    //   if ( _isCongested ) 
-    //       _cost += 1000;
-
+    _cost = CostModel::get()->getCost ( this, arrivalEdge );
     return _cost;
 }
 
-unsigned Edge::getRealOccupancy() const
-// ************************************
-{
-    // pour debug plus facile :   // Attention ce n'est plus vrai lorsque l'edge gère elle même son occupation!
-    //assert ( _realOccupancy == _fence->getOccupancy() );
-
-    return _realOccupancy;
-}
-
 Segment* Edge::getSegmentFor ( Net* net )
 // **************************************
 {
@@ -399,6 +339,7 @@ Record* Edge::_getRecord() const
     record->add ( getSlot ( "capacity" , _capacity  ) );
     record->add ( getSlot ( "occupancy", _realOccupancy ) );
     record->add ( getSlot ( "estimate occupancy", _estimateOccupancy ) );
+    record->add ( getSlot ( "history", _history ) );
     record->add ( getSlot ( "segments" , &_segments ) );
 
     return record;
@@ -31,6 +31,7 @@
 #include "knik/Edge.h"
 #include "knik/HEdge.h"
 #include "knik/VEdge.h"
+#include "knik/CostModel.h"
 #include "knik/KnikEngine.h"
 
 #include "knik/flute.h"
@@ -39,7 +40,6 @@
 #define __USE_MATRIXVERTEX__
 
 #define EPSILON 10e-4
-#define HISTORIC_INC 1.5 // define the increment of historic cost for ripup & reroute
 
 namespace Knik {
 
@@ -548,6 +548,7 @@ Vertex* Graph::createVertex ( Point position, DbU::Unit halfWidth, DbU::Unit hal
     }
     Edge* newEdge = HEdge::create ( from, to, capacity-reserved );
 
+    newEdge->setId ( _all_edges.size() );
     _all_edges.push_back ( newEdge );
 
     newEdge->setCost(1);
@@ -585,6 +586,7 @@ void Graph::createVEdge ( Vertex* from, Vertex* to, size_t reserved )
     }
     Edge* newEdge = VEdge::create ( from, to, capacity-reserved );
 
+    newEdge->setId ( _all_edges.size() );
     _all_edges.push_back ( newEdge );
 
     newEdge->setCost(1);
@@ -1118,8 +1120,21 @@ int Graph::initRouting ( Net* net )
 
 void Graph::Dijkstra()
 // *******************
+{
+  switch ( CostModel::getMode() ) {
+    case CostModel::NoCongestion:  _Dijkstra<CostModel::NoCongestion >(); break;
+    case CostModel::Congestion:    _Dijkstra<CostModel::Congestion   >(); break;
+    case CostModel::PreCongestion: _Dijkstra<CostModel::PreCongestion>(); break;
+    case CostModel::Ripup:         _Dijkstra<CostModel::Ripup        >(); break;
+  }
+}
+
+template<unsigned int mode>
+void Graph::_Dijkstra()
+// ********************
 {
 //checkEmptyPriorityQueue();
+  const CostModel* costModel = CostModel::get();
 
   countDijkstra++;
 
@@ -1204,7 +1219,7 @@ void Graph::Dijkstra()
           continue;
 
         float newDistance          = currentVertex->getDistance()
-                                   + iedge->getCost( arrivalEdgeCurrentVertex );
+                                   + costModel->getCost<mode>( *iedge, arrivalEdgeCurrentVertex );
         bool  updateOppositeVertex = false;
       // reinitialize the oppositeVertex if its netStamp is < _netStamp
         if (oppositeVertex->getNetStamp() < _netStamp) {
@@ -1521,34 +1536,47 @@ void Graph::Monotonic()
     //#endif
 }
 
-FTree* Graph::createFluteTree()
-// ****************************
-{ 
-    int  accuracy = 3;                         // accuracy for flute (by default 3)
-    int  d        = _vertexes_to_route.size(); // degre du net, ie nombre de routingPads
-    int *x = new int [d];                      // x coordinates of the vertexes
-    int *y = new int [d];                      // y coordinates of the vertexes
-    FTree* flutetree = new FTree;              // the flute Steiner Tree
+void Graph::fillFluteNet ( FluteNet& fluteNet )
+// *********************************************
+{
+    // scans _vertexes_to_route to find x,y coordinates and fill x, y and d
+    // x & y are allocated here and must be released by the caller.
+    fluteNet.deg    = _vertexes_to_route.size(); // degre du net, ie nombre de routingPads
+    fluteNet.x      = new int [fluteNet.deg];    // x coordinates of the vertexes
+    fluteNet.y      = new int [fluteNet.deg];    // y coordinates of the vertexes
+    fluteNet.tree.deg    = 0;
+    fluteNet.tree.length = 0;
+    fluteNet.tree.branch = NULL;
 
-    //cout << "Net : " << _working_net << endl;
-    // scans _working_net to find x,y coordinates and fill x, y and d
-    // parcours des _vertexes_to_route
     VertexSetIter vsit = _vertexes_to_route.begin();
     int cpt = 0;
     while ( vsit != _vertexes_to_route.end() ) {
         Point position = (*vsit)->getPosition();
-        x[cpt] = position.getX();
-        y[cpt] = position.getY();
+        fluteNet.x[cpt] = position.getX();
+        fluteNet.y[cpt] = position.getY();
         vsit++;
         cpt++;
     }
 
-    assert ( d == cpt );
+    assert ( fluteNet.deg == cpt );
+}
+
+FTree* Graph::createFluteTree()
+// ****************************
+{ 
+    int      accuracy = 3;                     // accuracy for flute (by default 3)
+    FluteNet fluteNet;
+    FTree*   flutetree = new FTree;            // the flute Steiner Tree
 
-    *flutetree = flute ( d, x, y, accuracy );
+    //cout << "Net : " << _working_net << endl;
+    fillFluteNet ( fluteNet );
+
+    *flutetree = flute ( fluteNet.deg, fluteNet.x, fluteNet.y, accuracy );
     //printtree ( flutetree );
     //plottree ( flutetree );
     //cout << endl;
+    delete [] fluteNet.x;
+    delete [] fluteNet.y;
     return flutetree;
 }
 
@@ -1560,6 +1588,15 @@ void Graph::UpdateEstimateCongestion ( bool create )
     //cerr << "Running FLUTE for net : " << _working_net << endl;
     auto_ptr<FTree> flutetree ( createFluteTree() );
 
+    applyFluteTree ( *flutetree, create );
+    freetree ( *flutetree );
+}
+
+void Graph::applyFluteTree ( const FTree& fluteTree, bool create )
+// ***************************************************************
+{
+    const FTree* flutetree = &fluteTree;
+
     //parcours des branches du FTree pour créer la congestion estimée
     for ( int i = 0 ; i < 2*flutetree->deg-2 ; i++ ) {
 //        int sourceX = flutetree->branch[i].x;
@@ -1817,6 +1854,34 @@ void Graph::updateEdgesOccupancy ( Segment* segment, bool add )
     }
 }
 
+void Graph::getSegmentEdges ( Segment* segment, EdgeVector& edges )
+// ****************************************************************
+{
+    edges.clear();
+    if ( Horizontal* horiz = dynamic_cast<Horizontal*>(segment) ) {
+        Vertex* currentVertex = _matrixVertex->getVertex ( Point ( min(horiz->getSourceX(),horiz->getTargetX()), horiz->getY() ) );
+        Vertex* targetVertex  = _matrixVertex->getVertex ( Point ( max(horiz->getSourceX(),horiz->getTargetX()), horiz->getY() ) );
+        while ( currentVertex != targetVertex ) {
+            Edge* edge = currentVertex->getHEdgeOut();
+            assert ( edge );
+            edges.push_back ( edge );
+            currentVertex = edge->getOpposite ( currentVertex );
+            assert ( currentVertex );
+        }
+    }
+    else if ( Vertical* verti = dynamic_cast<Vertical*>(segment) ) {
+        Vertex* currentVertex = _matrixVertex->getVertex ( Point ( verti->getX(), min(verti->getSourceY(),verti->getTargetY()) ) );
+        Vertex* targetVertex  = _matrixVertex->getVertex ( Point ( verti->getX(), max(verti->getSourceY(),verti->getTargetY()) ) );
+        while ( currentVertex != targetVertex ) {
+            Edge* edge = currentVertex->getVEdgeOut();
+            assert ( edge );
+            edges.push_back ( edge );
+            currentVertex = edge->getOpposite ( currentVertex );
+            assert ( currentVertex );
+        }
+    }
+}
+
 void Graph::rebuildConnexComponent ( Contact* contact, int connexID, Segment* arrivalSegment )
 // *******************************************************************************************
 {
@@ -1964,6 +2029,7 @@ unsigned Graph::analyseRouting ( set<Segment*>& segmentsToUnroute )
     unsigned wirelength = 0;
     unsigned viaWirelength = 0;
     map<Segment*, segmentStat> segmentsMap;
+    float    historyIncrement = CostModel::get()->getHistoryIncrement();
     for ( unsigned i = 0 ; i < _all_edges.size() ; i++ ) 
     {
         Edge* edge = _all_edges[i];
@@ -1973,7 +2039,7 @@ unsigned Graph::analyseRouting ( set<Segment*>& segmentsToUnroute )
             unsigned edgeOv = 2*edge->getOverflow();
             overflow += edgeOv;
             maxOv = edgeOv > maxOv ? edgeOv : maxOv;
-            edge->addSubEstimateOccupancy ( HISTORIC_INC, true ); // add historic cost for each overflowed edge
+            edge->addHistory ( historyIncrement ); // add historic cost for each overflowed edge
         }
         forEach ( Segment*, segment, edge->getSegments() ) {
             map<Segment*, segmentStat>::iterator it = segmentsMap.find(*segment);
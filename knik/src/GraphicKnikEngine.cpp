@@ -387,7 +387,7 @@ namespace Knik {
     else {
       gSaveAction = new QAction  ( tr("Knik - &Save global routing"), _viewer );
       gSaveAction->setObjectName ( "viewer.menuBar.placeAndRoute.saveSolution" );
-      gSaveAction->setStatusTip  ( tr("Save global routing (.kgr file)") );
+      gSaveAction->setStatusTip  ( tr("Save global routing (.kgb file)") );
       gSaveAction->setVisible    ( true );
       stepMenu->addAction ( gSaveAction );
 
@@ -400,7 +400,7 @@ namespace Knik {
     else {
       gLoadAction = new QAction  ( tr("Knik - &Load global routing"), _viewer );
       gLoadAction->setObjectName ( "viewer.menuBar.placeAndRoute.loadSolution" );
-      gLoadAction->setStatusTip  ( tr("Load global routing (.kgr file)") );
+      gLoadAction->setStatusTip  ( tr("Load global routing (.kgb or .kgr file)") );
       gLoadAction->setVisible    ( true );
       stepMenu->addAction ( gLoadAction );
 
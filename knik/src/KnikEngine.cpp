@@ -15,6 +15,7 @@
 
 
 #include <climits>
+#include <cstring>
 #include "hurricane/Warning.h"
 #include "hurricane/Property.h"
 #include "hurricane/NetRoutingProperty.h"
@@ -40,6 +41,9 @@
 #include "knik/RoutingGrid.h"
 #include "knik/NetExtension.h"
 #include "knik/KnikEngine.h"
+#include "knik/LayerAssign.h"
+#include "knik/CostModel.h"
+#include "knik/SolutionFormat.h"
 #include "knik/flute.h"
 
 
@@ -90,6 +94,7 @@ namespace Knik {
     , _rerouteIteration( 0 )
     , _segmentOverEdges()                              
     , _sortSegmentOv   ()
+    , _assignedSegments()
   {
     if (congestion > 1)
       throw Error ( "KnikEngine::KnikEngine(): congestion argument must be 0 (None) or 1 (Congestion) : %s."
@@ -133,7 +138,7 @@ void KnikEngine::_postCreate()
 {
     Inherit::_postCreate();
 
-    // For Flute : readLUT to be able to use POWV9.dat & POST9.dat
+    // For Flute : decode the compiled-in POWV & POST lookup tables.
     readLUT();
 
     return;
@@ -225,6 +230,7 @@ void KnikEngine::initGlobalRouting( const map<Name,Net*>& excludedNets )
 
   const unsigned int MaxDegree = 13000;
   Name obstacleNetName ("obstaclenet");
+  vector<FluteNet>   fluteNets;
 
   forEach ( Net*, inet, getCell()->getNets() ) {
     if (excludedNets.find(inet->getName()) != excludedNets.end()) {
@@ -252,8 +258,11 @@ void KnikEngine::initGlobalRouting( const map<Name,Net*>& excludedNets )
 
       _nets_to_route.push_back( record );
 //#if defined(__USE_STATIC_PRECONGESTION__) || defined(__USE_DYNAMIC_PRECONGESTION__)
-      if (__precongestion__)
-        _routingGraph->UpdateEstimateCongestion( true );
+    // Steiner trees are computed afterwards, all at once (see below).
+      if (__precongestion__) {
+        fluteNets.push_back( FluteNet() );
+        _routingGraph->fillFluteNet( fluteNets.back() );
+      }
 //#endif
     } else {
       if (netDegree > MaxDegree-1)
@@ -264,6 +273,19 @@ void KnikEngine::initGlobalRouting( const map<Name,Net*>& excludedNets )
     _routingGraph->resetVertexes();
   }
 
+  if (not fluteNets.empty()) {
+  // FLUTE is reentrant, so the trees are built in parallel. They are applied
+  // to the graph in net order, giving the same estimate as a serial build.
+    flute_batch( fluteNets.size(), &fluteNets[0], 3, 0 );
+
+    for ( size_t i=0 ; i<fluteNets.size() ; ++i ) {
+      _routingGraph->applyFluteTree( fluteNets[i].tree, true );
+      freetree( fluteNets[i].tree );
+      delete [] fluteNets[i].x;
+      delete [] fluteNets[i].y;
+    }
+  }
+
   stable_sort( _nets_to_route.begin(), _nets_to_route.end(), NetSurfacesComp() );
   NetVector::iterator new_end = unique( _nets_to_route.begin(), _nets_to_route.end() );
   _nets_to_route.erase( new_end, _nets_to_route.end() );
@@ -376,32 +398,177 @@ void KnikEngine::printTime()
 
 inline bool netId_sort(Net* net1, Net* net2) { return NetExtension::getId(net1) < NetExtension::getId(net2); }
 
-string KnikEngine::_getSolutionName() const
-// ****************************************
+string KnikEngine::_getSolutionName ( const char* extension ) const
+// ****************************************************************
 {
-  return getString(_cell->getName()) + ".kgr";
+  return getString(_cell->getName()) + extension;
 }
 
-void KnikEngine::saveSolution ( const string& fileName )
-// *****************************************************
+void KnikEngine::_getSolutionNets ( vector<Net*>& nets ) const
+// ***********************************************************
 {
     Name obstacleNetName ("obstaclenet");
 
-    string saveFileName = fileName;
-    if ( saveFileName.empty() )
-      saveFileName = _getSolutionName();
-
-    _nets_to_route.clear();
-    vector<Net*> all_nets;
+    nets.clear();
     forEach (Net*, net, _cell->getNets()) {
       if (   net->isGlobal()
          or  net->isSupply()
          or  net->isClock()
          or (net->getName() == obstacleNetName) 
          or not NetRoutingExtension::isAutomaticGlobalRoute(*net) ) continue;
-      all_nets.push_back(*net);
+      nets.push_back(*net);
+    }
+    stable_sort ( nets.begin(), nets.end(), netId_sort ); 
+}
+
+void KnikEngine::_getSolutionComponents ( Net* net, vector<Segment*>& grSegments, vector<Contact*>& viaContacts ) const
+// ******************************************************************************************************************
+{
+    const Layer* gcontact = Configuration::getGContact();
+    const Layer* gmetalh  = Configuration::getGMetalH();
+    const Layer* gmetalv  = Configuration::getGMetalV();
+
+    viaContacts.clear();
+    forEach ( Contact*, icontact, net->getContacts() ) {
+      if ( (icontact->getLayer() == gcontact) or (icontact->getLayer() == gmetalv) ) 
+        viaContacts.push_back ( *icontact );
     }
-    stable_sort ( all_nets.begin(), all_nets.end(), netId_sort ); 
+
+  // Segments moved on real routing layers by layerAssign() (or reloaded so)
+  // are part of the solution too, but not the other wires of the net.
+    grSegments.clear();
+    forEach ( Segment*, isegment, net->getSegments() ) {
+      const Layer* layer = isegment->getLayer();
+      if ( (layer == gmetalh) or (layer == gmetalv) or _isAssignedSegment(*isegment) )
+        grSegments.push_back ( *isegment );
+    }
+}
+
+void KnikEngine::_addAssignedSegment ( Segment* segment )
+// ******************************************************
+{
+    _assignedSegments.insert ( segment->getId() );
+}
+
+bool KnikEngine::_isAssignedSegment ( const Segment* segment ) const
+// *****************************************************************
+{
+    return _assignedSegments.find(segment->getId()) != _assignedSegments.end();
+}
+
+void KnikEngine::saveSolution ( const string& fileName )
+// *****************************************************
+{
+    string saveFileName = fileName;
+    if ( saveFileName.empty() )
+      saveFileName = _getSolutionName();
+    else if ( (saveFileName.size() > 4) and (saveFileName.compare(saveFileName.size()-4,4,".kgr") == 0) ) {
+      exportSolution ( saveFileName );
+      return;
+    }
+
+    _nets_to_route.clear();
+    vector<Net*> all_nets;
+    _getSolutionNets ( all_nets );
+
+    const Layer* gmetalh = Configuration::getGMetalH();
+    const Layer* gmetalv = Configuration::getGMetalV();
+
+    vector<KgbNet>     nets;
+    vector<KgbSegment> segments;
+    string             names;
+    vector<Segment*>   grSegments;
+    vector<Contact*>   viaContacts;
+
+    nets.reserve ( all_nets.size() );
+    for ( size_t i=0 ; i<all_nets.size() ; ++i ) {
+        Net* net = all_nets[i];
+        _getSolutionComponents ( net, grSegments, viaContacts );
+
+        KgbNet netRecord;
+        netRecord._firstSegment = segments.size();
+        netRecord._nbSegments   = grSegments.size() + viaContacts.size();
+        netRecord._nameOffset   = names.size();
+        netRecord._nameLength   = getString(net->getName()).size();
+        netRecord._reserved     = 0;
+        netRecord._id           = NetExtension::getId ( net );
+        nets.push_back ( netRecord );
+
+        names += getString(net->getName());
+        names += '\0';
+
+        for ( size_t j=0 ; j<grSegments.size() ; ++j ) {
+          const Layer* layer = grSegments[j]->getLayer();
+          uint32_t     z     = (dynamic_cast<Horizontal*>(grSegments[j])) ? KgbGMetalH : KgbGMetalV;
+          if ( (layer != gmetalh) and (layer != gmetalv) )
+            z = KgbGaugeDepth + _routingGauge->getLayerDepth(layer);
+
+          KgbSegment record;
+          record._xSource = grSegments[j]->getSourceX();
+          record._ySource = grSegments[j]->getSourceY();
+          record._xTarget = grSegments[j]->getTargetX();
+          record._yTarget = grSegments[j]->getTargetY();
+          record._zSource = z;
+          record._zTarget = z;
+          segments.push_back ( record );
+        }
+
+        for ( size_t j=0 ; j<viaContacts.size() ; ++j ) {
+          KgbSegment record;
+          record._xSource = record._xTarget = viaContacts[j]->getX();
+          record._ySource = record._yTarget = viaContacts[j]->getY();
+          record._zSource = KgbGMetalH;
+          record._zTarget = KgbGMetalV;
+          segments.push_back ( record );
+        }
+    }
+
+    Box       ab     = _cell->getAbutmentBox();
+    KgbHeader header;
+    memset ( &header, 0, sizeof(KgbHeader) );
+    memcpy ( header._magic, KgbMagic, 4 );
+    header._version        = KgbVersion;
+    header._endianness     = KgbEndianness;
+    header._nbNets         = nets.size();
+    header._nbSegments     = segments.size();
+    header._xSize          = (_routingGraph) ? _routingGraph->getXSize() : 0;
+    header._ySize          = (_routingGraph) ? _routingGraph->getYSize() : 0;
+    header._xMin           = ab.getXMin();
+    header._yMin           = ab.getYMin();
+    header._xMax           = ab.getXMax();
+    header._yMax           = ab.getYMax();
+    header._netsOffset     = sizeof(KgbHeader);
+    header._segmentsOffset = header._netsOffset     + nets.size()    *sizeof(KgbNet);
+    header._namesOffset    = header._segmentsOffset + segments.size()*sizeof(KgbSegment);
+    header._namesSize      = names.size();
+
+    FILE* saveFile = fopen ( saveFileName.c_str(), "wb" );
+    if ( !saveFile )
+       throw Error ("Cannot open solution file to write !");
+
+    bool written = (fwrite(&header,sizeof(KgbHeader),1,saveFile) == 1);
+    if ( written and not nets.empty() )
+      written = (fwrite(&nets[0],sizeof(KgbNet),nets.size(),saveFile) == nets.size());
+    if ( written and not segments.empty() )
+      written = (fwrite(&segments[0],sizeof(KgbSegment),segments.size(),saveFile) == segments.size());
+    if ( written and not names.empty() )
+      written = (fwrite(names.data(),1,names.size(),saveFile) == names.size());
+    fclose ( saveFile );
+
+    if ( not written )
+      throw Error ( "Error while writing solution file \"%s\".", saveFileName.c_str() );
+}
+
+void KnikEngine::exportSolution ( const string& fileName )
+// *******************************************************
+{
+    string saveFileName = fileName;
+    if ( saveFileName.empty() )
+      saveFileName = _getSolutionName(".kgr");
+
+    _nets_to_route.clear();
+    vector<Net*> all_nets;
+    _getSolutionNets ( all_nets );
 
     CRL::IoFile saveStream ( saveFileName );
     saveStream.open ("w");
@@ -409,27 +576,16 @@ void KnikEngine::saveSolution ( const string& fileName )
     if ( !saveFile )
        throw Error ("Cannot open solution file to write !");
 
-    const Layer* gcontact = Configuration::getGContact();
-    const Layer* gmetalh  = Configuration::getGMetalH();
-    const Layer* gmetalv  = Configuration::getGMetalV();
+    vector<Segment*> grSegments;
+    vector<Contact*> viaContacts;
 
     for ( size_t i=0 ; i<all_nets.size() ; ++i ) {
         Net*  net   = all_nets[i];
         long  netId = NetExtension::getId ( net );
       //assert ( netId >= 0 );
 
-        vector<Contact*> viaContacts;
-        forEach ( Contact*, icontact, net->getContacts() ) {
-          if ( (icontact->getLayer() == gcontact) or (icontact->getLayer() == gmetalv) ) 
-            viaContacts.push_back ( *icontact );
-        }
-
-        vector<Segment*> grSegments;
-        forEach ( Segment*, isegment, net->getSegments() ) {
-          if ( (isegment->getLayer() == gmetalh) or (isegment->getLayer() == gmetalv) ) {
-            grSegments.push_back ( *isegment );
-          }
-        }
+      // The text format only knows about the direction (z=1 or 2).
+        _getSolutionComponents ( net, grSegments, viaContacts );
 
         unsigned nbEntries = grSegments.size() + viaContacts.size();
         fprintf ( saveFile, "%s %ld %d\n", getString(net->getName()).c_str(), netId, nbEntries );
@@ -1072,6 +1228,36 @@ void KnikEngine::run( const map<Name,Net*>& excludedNets )
     computeSymbolicWireLength ();
 }
 
+void KnikEngine::layerAssign ()
+// ****************************
+{
+    if ( not _routingGraph )
+      throw Error ( "KnikEngine::layerAssign(): The routing graph has not been created." );
+
+    vector<Net*> all_nets;
+    _getSolutionNets ( all_nets );
+
+    cmess1 << "  o  Global Routing Layer Assignment." << endl;
+
+    Timer timer;
+    timer.start ();
+
+    UpdateSession::open();
+    LayerAssign layerAssign ( this );
+    layerAssign.run ( all_nets );
+    UpdateSession::close();
+
+    timer.stop ();
+
+    ostringstream result;
+    result <<  Timer::getStringTime(timer.getCombTime()) 
+           << ", " << Timer::getStringMemory(timer.getIncrease());
+    cmess1 << Dots::asUInt  ( "     - Assigned segments", layerAssign.getAssigneds() ) << endl;
+    cmess1 << Dots::asUInt  ( "     - Vias"             , layerAssign.getViaCount () ) << endl;
+    cmess1 << Dots::asUInt  ( "     - Overflow"         , layerAssign.getOverflow () ) << endl;
+    cmess1 << Dots::asString( "     - Done in"          , result.str() ) << endl;
+}
+
 void KnikEngine::Route( const map<Name,Net*>& excludedNets )
 // *********************************************************
 {
@@ -1082,6 +1268,8 @@ void KnikEngine::Route( const map<Name,Net*>& excludedNets )
     _timer.resetIncrease();
     _timer.start();
 
+    CostModel::get()->build ( _routingGraph->getAllEdges() );
+
     cmess1 << "  o  Global Routing." << endl;
     cmess2 << "     Iteration INIT"
            <<    "  # of nets to route:" << left  << _nets_to_route.size() << endl;
@@ -1211,6 +1399,7 @@ void KnikEngine::reroute()
 
     unsigned int size = _nets_to_route.size(); 
     __ripupMode__ = true;
+    CostModel::get()->setIteration ( _rerouteIteration );
 
     for ( unsigned i = 0 ; i < size ; ++i ) {
       Net* net = _nets_to_route[i]._net;
@@ -0,0 +1,364 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2006-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |        K n i k  -  G l o b a l   R o u t e r                    |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./LayerAssign.cpp"                             |
+// +-----------------------------------------------------------------+
+
+
+#include <climits>
+#include <cstdlib>
+#include <algorithm>
+#include <map>
+#include "hurricane/Error.h"
+#include "hurricane/Layer.h"
+#include "hurricane/Net.h"
+#include "hurricane/Horizontal.h"
+#include "hurricane/Vertical.h"
+#include "hurricane/Contact.h"
+#include "hurricane/RoutingPad.h"
+#include "crlcore/RoutingGauge.h"
+#include "crlcore/RoutingLayerGauge.h"
+#include "knik/Configuration.h"
+#include "knik/Edge.h"
+#include "knik/Graph.h"
+#include "knik/KnikEngine.h"
+#include "knik/LayerAssign.h"
+
+
+namespace {
+
+  using namespace std;
+
+
+  // Index of a segment in the net tree, with the contact through which
+  // it is reached (the "child" side) and the segments hanging from it.
+  struct TreeNode {
+    Hurricane::Segment*    _segment;
+    Hurricane::Component*  _child;
+    vector<Knik::Edge*>    _edges;
+    vector<size_t>         _children;
+  };
+
+
+} // Anonymous namespace.
+
+
+namespace Knik {
+
+  using std::map;
+  using std::make_pair;
+  using Hurricane::Error;
+  using Hurricane::Hook;
+  using Hurricane::Horizontal;
+  using Hurricane::Vertical;
+  using Hurricane::RoutingPad;
+  using CRL::RoutingGauge;
+  using CRL::RoutingLayerGauge;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Knik::LayerAssign".
+
+
+  float  LayerAssign::_viaCost      = 2.0;
+  float  LayerAssign::_overflowCost = 20.0;
+
+
+  LayerAssign::LayerAssign ( KnikEngine* knik )
+    : _knik       (knik)
+    , _hPlanes    ()
+    , _vPlanes    ()
+    , _nbPlanes   (0)
+    , _capacities ()
+    , _occupancies()
+    , _viaCount   (0)
+    , _assigneds  (0)
+  {
+    _buildPlanes();
+  }
+
+
+  LayerAssign::~LayerAssign ()
+  { }
+
+
+  size_t  LayerAssign::_getIndex ( const Edge* edge, size_t plane ) const
+  { return edge->getId()*_nbPlanes + plane; }
+
+
+  const vector<LayerAssign::Plane>& LayerAssign::_getPlanes ( Segment* segment ) const
+  { return (dynamic_cast<Horizontal*>(segment)) ? _hPlanes : _vPlanes; }
+
+
+  void  LayerAssign::_buildPlanes ()
+  {
+    RoutingGauge* rg = _knik->getRoutingGauge();
+    if (not rg)
+      throw Error( "LayerAssign::_buildPlanes(): The routing gauge has not been set." );
+
+    const vector<RoutingLayerGauge*>& layerGauges = rg->getLayerGauges();
+    for ( size_t i=0 ; i<layerGauges.size() ; ++i ) {
+      RoutingLayerGauge* layerGauge = layerGauges[i];
+      if (layerGauge->getType() != Constant::Default) continue;
+      if (layerGauge->getDepth() > _knik->getAllowedDepth()) continue;
+
+      Plane plane;
+      plane._layer     = layerGauge->getLayer();
+      plane._depth     = layerGauge->getDepth();
+      plane._wireWidth = layerGauge->getWireWidth();
+      plane._gauge     = layerGauge;
+
+      if (layerGauge->getDirection() == Constant::Horizontal) _hPlanes.push_back( plane );
+      else                                                     _vPlanes.push_back( plane );
+    }
+
+    if (_hPlanes.empty() or _vPlanes.empty())
+      throw Error( "LayerAssign::_buildPlanes(): No horizontal or no vertical routing layer below allowed depth %u."
+                 , _knik->getAllowedDepth() );
+
+    _nbPlanes = std::max( _hPlanes.size(), _vPlanes.size() );
+
+  // Split each edge capacity between the layers of it's direction, in
+  // proportion of the tracks each one has across the edge's GCell side,
+  // the remainder going to the lowest layers.
+    const Graph::EdgeVector& edges = _knik->getRoutingGraph()->getAllEdges();
+    _capacities .assign( edges.size()*_nbPlanes, 0 );
+    _occupancies.assign( edges.size()*_nbPlanes, 0 );
+
+    vector<unsigned int> tracks ( _nbPlanes, 0 );
+
+    for ( size_t iedge=0 ; iedge<edges.size() ; ++iedge ) {
+      Edge*                edge     = edges[iedge];
+      const vector<Plane>& planes   = (edge->isHorizontal()) ? _hPlanes : _vPlanes;
+      DbU::Unit            side     = edge->getWidth();
+      unsigned int         capacity = edge->getCapacity();
+      unsigned int         total    = 0;
+      unsigned int         given    = 0;
+
+      for ( size_t i=0 ; i<planes.size() ; ++i ) {
+        tracks[i] = planes[i]._gauge->getTrackNumber( 0, side );
+        if (not tracks[i]) tracks[i] = 1;
+        total += tracks[i];
+      }
+      for ( size_t i=0 ; i<planes.size() ; ++i ) {
+        unsigned int share = (capacity * tracks[i]) / total;
+        _capacities[ _getIndex(edge,i) ] = share;
+        given += share;
+      }
+      for ( size_t i=0 ; given < capacity ; ++given, i=(i+1)%planes.size() )
+        _capacities[ _getIndex(edge,i) ]++;
+    }
+  }
+
+
+  unsigned int  LayerAssign::_getPinDepth ( Component* contact ) const
+  {
+    RoutingGauge* rg    = _knik->getRoutingGauge();
+    unsigned int  depth = UINT_MAX;
+
+    forEach ( Hook*, ihook, contact->getBodyHook()->getHooks() ) {
+      RoutingPad* rp = dynamic_cast<RoutingPad*>( ihook->getComponent() );
+      if (not rp) continue;
+
+      size_t rpDepth = rg->getLayerDepth( rp->getLayer() );
+      if (rpDepth == RoutingGauge::nlayerdepth) rpDepth = 0;
+      if (rpDepth < depth) depth = rpDepth;
+    }
+    return depth;
+  }
+
+
+  float  LayerAssign::_getWireCost ( const vector<Edge*>& edges, size_t plane ) const
+  {
+    float cost = 0.0;
+    for ( size_t i=0 ; i<edges.size() ; ++i ) {
+      size_t       index       = _getIndex( edges[i], plane );
+      unsigned int occupancy   = _occupancies[index] + 1;
+      unsigned int capacity    = _capacities [index];
+
+      cost += 1.0;
+      if (occupancy > capacity) cost += _overflowCost * (occupancy - capacity);
+      else                      cost += (float)occupancy / (float)(capacity+1);
+    }
+    return cost;
+  }
+
+
+  void  LayerAssign::_commit ( Segment* segment, const vector<Edge*>& edges, size_t plane )
+  {
+    const Plane& assigned = _getPlanes(segment)[plane];
+    segment->setLayer( assigned._layer );
+    segment->setWidth( assigned._wireWidth );
+    _knik->_addAssignedSegment( segment );
+
+    for ( size_t i=0 ; i<edges.size() ; ++i )
+      _occupancies[ _getIndex(edges[i],plane) ]++;
+
+    ++_assigneds;
+  }
+
+
+  void  LayerAssign::_assignNet ( Net* net )
+  {
+    const Layer* gmetalh = Configuration::getGMetalH();
+    const Layer* gmetalv = Configuration::getGMetalV();
+
+    vector<Segment*>                  segments;
+    map< Component*, vector<size_t> > contactSegments;
+
+    forEach ( Segment*, isegment, net->getSegments() ) {
+      const Layer* layer = isegment->getLayer();
+      bool         keep  = (layer == gmetalh) or (layer == gmetalv);
+
+      const vector<Plane>& planes = _getPlanes( *isegment );
+      for ( size_t i=0 ; not keep and (i<planes.size()) ; ++i )
+        keep = (planes[i]._layer == layer);
+      if (not keep) continue;
+
+      contactSegments[ isegment->getSource() ].push_back( segments.size() );
+      contactSegments[ isegment->getTarget() ].push_back( segments.size() );
+      segments.push_back( *isegment );
+    }
+    if (segments.empty()) return;
+
+  // Build the rooted trees (the global routing of a net may be a forest
+  // when it has been partially ripped up). Nodes are stored in pre-order.
+    vector<bool>     reached ( segments.size(), false );
+    vector<TreeNode> nodes;
+    vector<size_t>   nodeOf  ( segments.size(), 0 );
+    vector< pair<Component*,vector<size_t> > > roots;
+
+    for ( size_t iseed=0 ; iseed<segments.size() ; ++iseed ) {
+      if (reached[iseed]) continue;
+
+      Component* root = segments[iseed]->getSource();
+      roots.push_back( make_pair(root,vector<size_t>()) );
+
+      vector< pair<Component*,size_t> > stack;   // (contact, parent node or SIZE_MAX).
+      stack.push_back( make_pair(root,(size_t)-1) );
+
+      while ( not stack.empty() ) {
+        Component* contact = stack.back().first;
+        size_t     parent  = stack.back().second;
+        stack.pop_back();
+
+        const vector<size_t>& hooked = contactSegments[contact];
+        for ( size_t i=0 ; i<hooked.size() ; ++i ) {
+          size_t iseg = hooked[i];
+          if (reached[iseg]) continue;
+          reached[iseg] = true;
+
+          Segment*   segment = segments[iseg];
+          Component* child   = (segment->getSource() == contact) ? segment->getTarget() : segment->getSource();
+
+          nodeOf[iseg] = nodes.size();
+          nodes.push_back( TreeNode() );
+          nodes.back()._segment = segment;
+          nodes.back()._child   = child;
+          _knik->getRoutingGraph()->getSegmentEdges( segment, nodes.back()._edges );
+
+          if (parent == (size_t)-1) roots.back().second.push_back( nodes.size()-1 );
+          else                      nodes[parent]._children.push_back( nodes.size()-1 );
+
+          stack.push_back( make_pair(child,nodes.size()-1) );
+        }
+      }
+    }
+
+  // Bottom-up dynamic programming: cost[n][k] is the best cost of the
+  // subtree under node n when it's segment is put on plane k.
+    vector< vector<float> >  cost   ( nodes.size() );
+    vector< vector<size_t> > choice ( nodes.size() );   // choice[c][k]: plane of c when parent on k.
+
+    for ( size_t inode=nodes.size() ; inode-- > 0 ; ) {
+      TreeNode&            node     = nodes[inode];
+      const vector<Plane>& planes   = _getPlanes( node._segment );
+      unsigned int         pinDepth = _getPinDepth( node._child );
+
+      cost[inode].resize( planes.size() );
+      for ( size_t k=0 ; k<planes.size() ; ++k ) {
+        float nodeCost = _getWireCost( node._edges, k );
+        if (pinDepth != UINT_MAX)
+          nodeCost += _viaCost * std::abs( (int)planes[k]._depth - (int)pinDepth );
+
+        for ( size_t ic=0 ; ic<node._children.size() ; ++ic ) {
+          size_t               ichild      = node._children[ic];
+          const vector<Plane>& childPlanes = _getPlanes( nodes[ichild]._segment );
+
+          if (choice[ichild].empty()) choice[ichild].resize( planes.size() );
+
+          float  bestCost  = 0.0;
+          size_t bestPlane = 0;
+          for ( size_t kc=0 ; kc<childPlanes.size() ; ++kc ) {
+            float childCost = cost[ichild][kc]
+                            + _viaCost * std::abs( (int)planes[k]._depth - (int)childPlanes[kc]._depth );
+            if ( (kc == 0) or (childCost < bestCost) ) { bestCost = childCost; bestPlane = kc; }
+          }
+          choice[ichild][k] = bestPlane;
+          nodeCost += bestCost;
+        }
+        cost[inode][k] = nodeCost;
+      }
+    }
+
+  // Top-down commit of the choices.
+    vector<size_t> planeOf ( nodes.size(), 0 );
+
+    for ( size_t iroot=0 ; iroot<roots.size() ; ++iroot ) {
+      unsigned int          pinDepth = _getPinDepth( roots[iroot].first );
+      const vector<size_t>& tops     = roots[iroot].second;
+
+      for ( size_t it=0 ; it<tops.size() ; ++it ) {
+        const vector<Plane>& planes    = _getPlanes( nodes[tops[it]]._segment );
+        float                bestCost  = 0.0;
+        size_t               bestPlane = 0;
+
+        for ( size_t k=0 ; k<planes.size() ; ++k ) {
+          float rootCost = cost[tops[it]][k];
+          if (pinDepth != UINT_MAX)
+            rootCost += _viaCost * std::abs( (int)planes[k]._depth - (int)pinDepth );
+          if ( (k == 0) or (rootCost < bestCost) ) { bestCost = rootCost; bestPlane = k; }
+        }
+        planeOf[tops[it]] = bestPlane;
+        if (pinDepth != UINT_MAX)
+          _viaCount += std::abs( (int)planes[bestPlane]._depth - (int)pinDepth );
+      }
+    }
+
+    for ( size_t inode=0 ; inode<nodes.size() ; ++inode ) {
+      TreeNode&            node     = nodes[inode];
+      const vector<Plane>& planes   = _getPlanes( node._segment );
+      unsigned int         depth    = planes[ planeOf[inode] ]._depth;
+      unsigned int         pinDepth = _getPinDepth( node._child );
+
+      if (pinDepth != UINT_MAX)
+        _viaCount += std::abs( (int)depth - (int)pinDepth );
+
+      for ( size_t ic=0 ; ic<node._children.size() ; ++ic ) {
+        size_t ichild = node._children[ic];
+        planeOf[ichild] = choice[ichild][ planeOf[inode] ];
+        _viaCount += std::abs( (int)depth - (int)_getPlanes(nodes[ichild]._segment)[planeOf[ichild]]._depth );
+      }
+
+      _commit( node._segment, node._edges, planeOf[inode] );
+    }
+  }
+
+
+  void  LayerAssign::run ( const vector<Net*>& nets )
+  {
+    for ( size_t i=0 ; i<nets.size() ; ++i )
+      _assignNet( nets[i] );
+  }
+
+
+}  // Knik namespace.
@@ -16,6 +16,12 @@
 
 
 #include <iostream>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "hurricane/Error.h"
 #include "hurricane/Warning.h"
 #include "hurricane/DataBase.h"
@@ -32,7 +38,10 @@
 #include "crlcore/Measures.h"
 #include "crlcore/AllianceFramework.h"
 #include "crlcore/CellGauge.h"
+#include "crlcore/RoutingGauge.h"
+#include "crlcore/RoutingLayerGauge.h"
 #include "knik/Configuration.h"
+#include "knik/SolutionFormat.h"
 #include "knik/Graph.h"
 #include "knik/KnikEngine.h"
 
@@ -48,6 +57,7 @@ namespace {
 
   using CRL::IoFile;
   using CRL::AllianceFramework;
+  using CRL::RoutingGauge;
 
   using Hurricane::ForEachIterator;
   using Hurricane::Error;
@@ -73,12 +83,19 @@ namespace {
   using Knik::Configuration;
   using Knik::KnikEngine;
   using Knik::Vertex;
+  using Knik::KgbHeader;
+  using Knik::KgbNet;
+  using Knik::KgbSegment;
 
 
   const char* LoadError      = "KnikEngine::LoadSolution(): %s.\n        (file: %s, at line: %d)";
   const char* NotManhattan   =
     "KnikEngine::LoadSolution(): Encountered a Segment neither Horizontal nor Vertical.\n"
-    "        ([%s %s] [%s %s], file: %s, at line: %d)";
+    "        ([%s %s] [%s %s], net: %s)";
+  const char* BadDepth       =
+    "KnikEngine::LoadSolution(): Segment layer depth %u is outside the routing gauge.\n"
+    "        (net: %s)";
+  const char* BadBinary      = "KnikEngine::LoadSolution(): %s.\n        (file: %s)";
   const char* BadLong        =
     "KnikEngine::LoadSolution(): Incomplete string to integer conversion for \"%s\" (%ld).\n"
     "        (file: %s, at line: %d)";
@@ -203,6 +220,160 @@ namespace {
   }
 
 
+  class SolutionBuilder {
+    public:
+                    SolutionBuilder ( KnikEngine* );
+      void          addNet          ( Net*, const KgbSegment*, size_t nbSegments );
+      void          finish          ();
+    private:
+      unsigned int  _getContactZ    ( unsigned int z, Net* ) const;
+      const Layer*  _getLayer       ( unsigned int z, bool horizontal, DbU::Unit& width, Net* ) const;
+    private:
+      KnikEngine*   _knik;
+      RoutingGauge* _routingGauge;
+      DbU::Unit     _sliceHeight;
+      const Layer*  _gmetalh;
+      const Layer*  _gmetalv;
+      GContactMap   _contactMap;
+      unsigned int  _missingGlobalRouting;
+      unsigned int  _contactCount;
+      unsigned int  _segmentCount;
+  };
+
+
+  SolutionBuilder::SolutionBuilder ( KnikEngine* knik )
+    : _knik                (knik)
+    , _routingGauge        (knik->getRoutingGauge())
+    , _sliceHeight         (AllianceFramework::get()->getCellGauge()->getSliceHeight())
+    , _gmetalh             (Configuration::getGMetalH())
+    , _gmetalv             (Configuration::getGMetalV())
+    , _contactMap          (knik,_gmetalh,_gmetalv)
+    , _missingGlobalRouting(0)
+    , _contactCount        (0)
+    , _segmentCount        (0)
+  { }
+
+
+  unsigned int  SolutionBuilder::_getContactZ ( unsigned int z, Net* net ) const
+  {
+    if (z < Knik::KgbGaugeDepth) return z;
+
+    size_t depth = z - Knik::KgbGaugeDepth;
+    if ( (not _routingGauge) or (depth >= _routingGauge->getDepth()) )
+      throw Error( BadDepth, depth, getString(net->getName()).c_str() );
+
+  // Articulation contacts stay on the global layers.
+    return (_routingGauge->getLayerDirection(depth) == Constant::Horizontal)
+           ? Knik::KgbGMetalH : Knik::KgbGMetalV;
+  }
+
+
+  const Layer* SolutionBuilder::_getLayer ( unsigned int z, bool horizontal, DbU::Unit& width, Net* net ) const
+  {
+    if (z < Knik::KgbGaugeDepth) {
+      width = DbU::lambda(2.0);
+      return (horizontal) ? _gmetalh : _gmetalv;
+    }
+
+    size_t depth = z - Knik::KgbGaugeDepth;
+    if ( (not _routingGauge) or (depth >= _routingGauge->getDepth()) )
+      throw Error( BadDepth, depth, getString(net->getName()).c_str() );
+
+    width = _routingGauge->getLayerWireWidth( depth );
+    return _routingGauge->getRoutingLayer( depth );
+  }
+
+
+  void  SolutionBuilder::addNet ( Net* net, const KgbSegment* segments, size_t nbSegments )
+  {
+    unsigned int  nbRoutingPad = 0;
+
+    _contactMap.setNet( net );
+
+    for ( size_t i = 0 ; i < nbSegments ; i++ ) {
+      const KgbSegment& record  = segments[i];
+      DbU::Unit         xSource = record._xSource;
+      DbU::Unit         ySource = record._ySource;
+      DbU::Unit         xTarget = record._xTarget;
+      DbU::Unit         yTarget = record._yTarget;
+
+      Contact*     source  = _contactMap.find( xSource, ySource, _getContactZ(record._zSource,net) );
+      Contact*     target  = _contactMap.find( xTarget, yTarget, _getContactZ(record._zTarget,net) );
+      Segment*     segment = NULL;
+      const Layer* layer   = NULL;
+      DbU::Unit    width   = 0;
+
+      unsigned int type = ((ySource == yTarget)?1:0) + ((xSource == xTarget)?2:0);
+      switch ( type ) {
+        case 0:
+          throw Error( NotManhattan
+                     , DbU::getValueString(xSource).c_str()
+                     , DbU::getValueString(ySource).c_str()
+                     , DbU::getValueString(xTarget).c_str()
+                     , DbU::getValueString(yTarget).c_str()
+                     , getString(net->getName()).c_str()
+                     );
+        case 1:
+          layer   = _getLayer( record._zSource, true, width, net );
+          segment = Horizontal::create( source, target, layer, ySource, width );
+          ++_segmentCount;
+          break;
+        case 2:
+          layer   = _getLayer( record._zSource, false, width, net );
+          segment = Vertical::create( source, target, layer, xSource, width );
+          ++_segmentCount;
+          break;
+        case 3:
+          break;
+      }
+
+      if (segment) {
+        _knik->insertSegment( segment );
+        if (record._zSource >= Knik::KgbGaugeDepth) _knik->_addAssignedSegment( segment );
+      }
+    }
+
+    Box         rpBox;
+    RoutingPad* previousRp  = NULL;
+    if (NetRoutingExtension::isAutomaticGlobalRoute(net)) {
+      forEach ( RoutingPad*, rp, net->getRoutingPads() ) {
+        rpBox.merge( rp->getBoundingBox() );
+        Contact* gcontact = _contactMap.findVertexContact( rp->getBoundingBox() );
+        if (gcontact) {
+          rp->getBodyHook()->attach( gcontact->getBodyHook() );
+        } else {
+          if (previousRp)
+            rp->getBodyHook()->attach( previousRp->getBodyHook() );
+        }
+        previousRp = *rp;
+        ++nbRoutingPad;
+      //cerr << rp->_getString() << " should be attached to " << gcontact << endl;
+      }
+    }
+
+    if (   (nbRoutingPad > 1)
+       and (not _contactMap.size())
+       and (  (rpBox.getHeight() > _sliceHeight)
+           or (rpBox.getWidth () > _sliceHeight) ) ) {
+      ++_missingGlobalRouting;
+      cerr << Warning( "Net <%s> is missing global routing."
+                     , getString(net->getName()).c_str() ) << endl;
+    }
+
+    _contactCount += _contactMap.size();
+    _contactMap.clear();
+  }
+
+
+  void  SolutionBuilder::finish ()
+  {
+    if (_missingGlobalRouting)
+      throw Error( "At least %d nets are missing global routing. Maybe a corrupted solution file?"
+                 , _missingGlobalRouting
+                 );
+  }
+
+
   class SolutionParser {
     public:
                      SolutionParser      ( KnikEngine*, const string& loadFileName );
@@ -218,9 +389,6 @@ namespace {
       size_t       _lineNumber;
       string       _fileName;
       KnikEngine*  _knik;
-      const Layer* _gmetalh;
-      const Layer* _gmetalv;
-      const Layer* _gcontact;
   };
 
 
@@ -228,9 +396,6 @@ namespace {
     : _lineNumber(0)
     , _fileName  (fileName)
     , _knik      (knik)
-    , _gmetalh   (Configuration::getGMetalH())
-    , _gmetalv   (Configuration::getGMetalV())
-    , _gcontact  (Configuration::getGContact())
   { }
 
 
@@ -294,17 +459,13 @@ namespace {
     try {
       cmess1 << "  o  Loading solution: \"" << _fileName << "\"." << endl;
 
-
-      DbU::Unit   sliceHeight = AllianceFramework::get()->getCellGauge()->getSliceHeight();
       CRL::IoFile fileStream ( _fileName );
       fileStream.open( "r" );
       if (not fileStream.isOpen())
         throw Error( "Can't open/read file: %s.", _fileName.c_str() );
 
-      unsigned int missingGlobalRouting = 0;
-      unsigned int contactCount         = 0;
-      unsigned int segmentCount         = 0;
-      GContactMap  contactMap           ( _knik, _gmetalh, _gmetalv );
+      SolutionBuilder    builder  ( _knik );
+      vector<KgbSegment> segments;
 
       while ( not fileStream.eof() ) {
         fileStream.readLine( _rawLine, RawLineSize );
@@ -319,8 +480,6 @@ namespace {
         else {
           Name          netName      = Name    ( fields[0] );
           unsigned int  nbPins       = _getLong( fields[2] );
-          unsigned int  nbSegments   = 0;
-          unsigned int  nbRoutingPad = 0;
           Net*          net          = _knik->getCell()->getNet( netName );
 
           if (not net) {
@@ -329,8 +488,7 @@ namespace {
             throw Error( LoadError, message.c_str(), _fileName.c_str(), _lineNumber );
           }
 
-          contactMap.setNet( net );
-
+          segments.clear();
           for ( unsigned i = 0 ; i < nbPins ; i++ ) {
             fileStream.readLine( _rawLine, RawLineSize );
             _lineNumber++;
@@ -338,41 +496,14 @@ namespace {
             if (fields.size() != 6)
               throw Error( LoadError, "Malformed Net Line", _fileName.c_str(), _lineNumber );
             else {
-              DbU::Unit     xSource = DbU::lambda( _getLong(fields[0]) );
-              DbU::Unit     ySource = DbU::lambda( _getLong(fields[1]) );
-              unsigned int  zSource = (unsigned) ( _getLong(fields[2]) );
-              DbU::Unit     xTarget = DbU::lambda( _getLong(fields[3]) );
-              DbU::Unit     yTarget = DbU::lambda( _getLong(fields[4]) );
-              unsigned int  zTarget = (unsigned) ( _getLong(fields[5]) );
-
-              Contact* source  = contactMap.find( xSource, ySource, zSource );
-              Contact* target  = contactMap.find( xTarget, yTarget, zTarget );
-              Segment* segment = NULL;
-
-              unsigned int type = ((ySource == yTarget)?1:0) + ((xSource == xTarget)?2:0);
-              switch ( type ) {
-                case 0:
-                  throw Error( NotManhattan
-                             , DbU::getValueString(xSource).c_str()
-                             , DbU::getValueString(ySource).c_str()
-                             , DbU::getValueString(xTarget).c_str()
-                             , DbU::getValueString(yTarget).c_str()
-                             , _fileName.c_str()
-                             , _lineNumber
-                             );
-                case 1:
-                  segment = Horizontal::create( source, target, _gmetalh, ySource, DbU::lambda(2.0) );
-                  ++nbSegments;
-                  break;
-                case 2:
-                  segment = Vertical::create( source, target, _gmetalv, xSource, DbU::lambda(2.0) );
-                  ++nbSegments;
-                  break;
-                case 3:
-                  break;
-              }
-
-              if (segment) _knik->insertSegment( segment );
+              KgbSegment record;
+              record._xSource = DbU::lambda( _getLong(fields[0]) );
+              record._ySource = DbU::lambda( _getLong(fields[1]) );
+              record._zSource = (unsigned) ( _getLong(fields[2]) );
+              record._xTarget = DbU::lambda( _getLong(fields[3]) );
+              record._yTarget = DbU::lambda( _getLong(fields[4]) );
+              record._zTarget = (unsigned) ( _getLong(fields[5]) );
+              segments.push_back( record );
             }
           }
           fileStream.readLine( _rawLine, RawLineSize );
@@ -381,45 +512,12 @@ namespace {
             throw Error( "KnikEngine::loadSolution(): Tu t'es vu quand t'as bu! (%ld)."
                        , getString(_lineNumber).c_str());
 
-          Box         rpBox;
-          RoutingPad* previousRp  = NULL;
-          if (NetRoutingExtension::isAutomaticGlobalRoute(net)) {
-            forEach ( RoutingPad*, rp, net->getRoutingPads() ) {
-              rpBox.merge( rp->getBoundingBox() );
-              Contact* gcontact = contactMap.findVertexContact( rp->getBoundingBox() );
-              if (gcontact) {
-                rp->getBodyHook()->attach( gcontact->getBodyHook() );
-              } else {
-                if (previousRp)
-                  rp->getBodyHook()->attach( previousRp->getBodyHook() );
-              }
-              previousRp = *rp;
-              ++nbRoutingPad;
-            //cerr << rp->_getString() << " should be attached to " << gcontact << endl;
-            }
-          }
-
-          if (   (nbRoutingPad > 1)
-             and (not contactMap.size())
-             and (  (rpBox.getHeight() > sliceHeight)
-                 or (rpBox.getWidth () > sliceHeight) ) ) {
-            ++missingGlobalRouting;
-            cerr << Warning( "Net <%s> is missing global routing."
-                           , getString(net->getName()).c_str() ) << endl;
-          }
-
-          segmentCount += nbSegments;
-          contactCount += contactMap.size();
-          contactMap.clear();
+          builder.addNet( net, (segments.empty()) ? NULL : &segments[0], segments.size() );
         }
       }
 
       fileStream.close();
-
-      if (missingGlobalRouting)
-        throw Error( "At least %d nets are missing global routing. Maybe a corrupted <.kgr> file?"
-                   , missingGlobalRouting
-                   );
+      builder.finish();
     }
     catch ( Error& e ) {
       UpdateSession::close ();
@@ -430,6 +528,166 @@ namespace {
   }
 
 
+// -------------------------------------------------------------------
+// Class  :  "SolutionMapper".
+//
+// Loads a binary solution (.kgb). The file is mmap'ed and the segment
+// records are read in place, no intermediate copy is made.
+
+
+  class SolutionMapper {
+    public:
+      static bool         isBinary       ( const string& fileName );
+    public:
+                          SolutionMapper ( KnikEngine*, const string& fileName );
+                         ~SolutionMapper ();
+             void         load           ();
+    private:
+             void         _map           ();
+             void         _unmap         ();
+             void         _check         () const;
+    private:
+      KnikEngine*         _knik;
+      string              _fileName;
+      int                 _fd;
+      const char*         _base;
+      size_t              _size;
+      const KgbHeader*    _header;
+  };
+
+
+  bool  SolutionMapper::isBinary ( const string& fileName )
+  {
+    char  magic[4];
+    FILE* file = fopen( fileName.c_str(), "rb" );
+    if (not file) return false;
+
+    bool isKgb = (fread(magic,1,4,file) == 4) and (memcmp(magic,Knik::KgbMagic,4) == 0);
+    fclose( file );
+    return isKgb;
+  }
+
+
+  SolutionMapper::SolutionMapper ( KnikEngine* knik, const string& fileName )
+    : _knik    (knik)
+    , _fileName(fileName)
+    , _fd      (-1)
+    , _base    (NULL)
+    , _size    (0)
+    , _header  (NULL)
+  { }
+
+
+  SolutionMapper::~SolutionMapper ()
+  { _unmap(); }
+
+
+  void  SolutionMapper::_map ()
+  {
+    _fd = open( _fileName.c_str(), O_RDONLY );
+    if (_fd < 0)
+      throw Error( "Can't open/read file: %s.", _fileName.c_str() );
+
+    struct stat infos;
+    if (fstat(_fd,&infos) < 0)
+      throw Error( BadBinary, "Unable to stat", _fileName.c_str() );
+    _size = infos.st_size;
+
+    if (_size < sizeof(KgbHeader))
+      throw Error( BadBinary, "File is too small to hold a header", _fileName.c_str() );
+
+    void* base = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, _fd, 0 );
+    if (base == MAP_FAILED)
+      throw Error( BadBinary, "Unable to mmap", _fileName.c_str() );
+
+    _base   = static_cast<const char*>( base );
+    _header = reinterpret_cast<const KgbHeader*>( _base );
+    posix_madvise( base, _size, POSIX_MADV_SEQUENTIAL );
+  }
+
+
+  void  SolutionMapper::_unmap ()
+  {
+    if (_base)   munmap( const_cast<char*>(_base), _size );
+    if (_fd >= 0) close( _fd );
+    _base   = NULL;
+    _header = NULL;
+    _fd     = -1;
+  }
+
+
+  void  SolutionMapper::_check () const
+  {
+    if (memcmp(_header->_magic,Knik::KgbMagic,4) != 0)
+      throw Error( BadBinary, "Bad magic number", _fileName.c_str() );
+    if (_header->_version != Knik::KgbVersion)
+      throw Error( BadBinary, ("Unsupported version "+getString(_header->_version)).c_str(), _fileName.c_str() );
+    if (_header->_endianness != Knik::KgbEndianness)
+      throw Error( BadBinary, "Written with another byte order", _fileName.c_str() );
+
+    uint64_t netsEnd     = _header->_netsOffset     + (uint64_t)_header->_nbNets     * sizeof(KgbNet);
+    uint64_t segmentsEnd = _header->_segmentsOffset + (uint64_t)_header->_nbSegments * sizeof(KgbSegment);
+    uint64_t namesEnd    = _header->_namesOffset    + _header->_namesSize;
+
+    if ( (netsEnd > _size) or (segmentsEnd > _size) or (namesEnd > _size)
+       or (_header->_netsOffset % 8) or (_header->_segmentsOffset % 8) )
+      throw Error( BadBinary, "Truncated or corrupted tables", _fileName.c_str() );
+
+    Knik::Graph* graph = _knik->getRoutingGraph();
+    if ( graph and ( (graph->getXSize() != _header->_xSize) or (graph->getYSize() != _header->_ySize) ) )
+      throw Error( "KnikEngine::LoadSolution(): Solution grid %ux%u do not match routing graph %ux%u.\n"
+                   "        (file: %s)"
+                 , _header->_xSize, _header->_ySize
+                 , (unsigned int)graph->getXSize(), (unsigned int)graph->getYSize()
+                 , _fileName.c_str() );
+  }
+
+
+  void  SolutionMapper::load ()
+  {
+    cmess1 << "  o  Loading binary solution: \"" << _fileName << "\"." << endl;
+
+    _map  ();
+    _check();
+
+    const KgbNet*     nets     = reinterpret_cast<const KgbNet*    >( _base + _header->_netsOffset     );
+    const KgbSegment* segments = reinterpret_cast<const KgbSegment*>( _base + _header->_segmentsOffset );
+    const char*       names    = _base + _header->_namesOffset;
+
+    UpdateSession::open();
+    
+    try {
+      SolutionBuilder builder ( _knik );
+
+      for ( uint32_t inet=0 ; inet<_header->_nbNets ; ++inet ) {
+        const KgbNet& record = nets[inet];
+
+        if (   ((uint64_t)record._nameOffset + record._nameLength >= _header->_namesSize)
+            or (names[record._nameOffset + record._nameLength] != '\0')
+            or (record._firstSegment + record._nbSegments > _header->_nbSegments) )
+          throw Error( BadBinary, "Corrupted net record", _fileName.c_str() );
+
+        Name netName = Name( names + record._nameOffset );
+        Net* net     = _knik->getCell()->getNet( netName );
+        if (not net)
+          throw Error( "KnikEngine::LoadSolution(): Cell has no Net: %s.\n        (file: %s)"
+                     , getString(netName).c_str(), _fileName.c_str() );
+
+        builder.addNet( net, segments + record._firstSegment, record._nbSegments );
+      }
+
+      builder.finish();
+    }
+    catch ( Error& e ) {
+      UpdateSession::close ();
+      _unmap();
+      throw;
+    }
+    UpdateSession::close ();
+    _unmap();
+  }
+
+
 } // End of anonymous namespace.
 
 
@@ -441,11 +699,22 @@ namespace Knik {
   void  KnikEngine::loadSolution ( const string& fileName )
   {
     string loadFileName = fileName;
-    if ( loadFileName.empty() )
+    if ( loadFileName.empty() ) {
       loadFileName = _getSolutionName();
+      if ( access(loadFileName.c_str(),R_OK) != 0 ) {
+        string textFileName = _getSolutionName( ".kgr" );
+        if ( access(textFileName.c_str(),R_OK) == 0 )
+          loadFileName = textFileName;
+      }
+    }
 
-    SolutionParser parser ( this, loadFileName );
-    parser.load ();
+    if ( SolutionMapper::isBinary(loadFileName) ) {
+      SolutionMapper mapper ( this, loadFileName );
+      mapper.load ();
+    } else {
+      SolutionParser parser ( this, loadFileName );
+      parser.load ();
+    }
 
     addMeasure<double> ( getCell(), "knikT",  0.0, 8 );
     addMeasure<size_t> ( getCell(), "knikS",  0  , 8 );
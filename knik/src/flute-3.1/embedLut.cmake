@@ -0,0 +1,27 @@
+# -*- explicit-buffer-name: "embedLut.cmake<knik/flute-3.1>" -*-
+#
+# Converts the FLUTE lookup tables (POWV & POST) into a C++ source file
+# so they are compiled into libflute instead of being read at run time.
+#
+# Usage:
+#   cmake -DPOWV=<POWV9.dat> -DPOST=<POST9.dat> -DOUTPUT=<fluteLut.cpp> -P embedLut.cmake
+
+ macro(embed_lut_file symbol file)
+   file(READ "${file}" lutHex HEX)
+   string(LENGTH "${lutHex}" lutHexLength)
+   math(EXPR lutSize "${lutHexLength} / 2")
+   string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," lutBytes "${lutHex}")
+   string(REGEX REPLACE "(0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,)" "\\1\n" lutBytes "${lutBytes}")
+   file(APPEND "${OUTPUT}" "  extern const unsigned char ${symbol}[] = {\n${lutBytes}0x00 };\n")
+   file(APPEND "${OUTPUT}" "  extern const size_t        ${symbol}Size = ${lutSize};\n\n")
+ endmacro(embed_lut_file)
+
+
+ if(NOT POWV OR NOT POST OR NOT OUTPUT)
+   message(FATAL_ERROR "embedLut.cmake: POWV, POST and OUTPUT must be defined.")
+ endif()
+
+ file(WRITE  "${OUTPUT}" "// Generated by embedLut.cmake from FLUTE POWV/POST tables, do not edit.\n\n")
+ file(APPEND "${OUTPUT}" "#include <cstddef>\n\n")
+ embed_lut_file(fluteLutPowv "${POWV}")
+ embed_lut_file(fluteLutPost "${POST}")
@@ -5,16 +5,14 @@ using std::string;
 #include "hurricane/Error.h"
 using Hurricane::Error;
 
-#include "crlcore/Environment.h"
-#include "crlcore/AllianceFramework.h"
-using CRL::Environment;
-using CRL::AllianceFramework;
-
 // originals include
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <math.h>
+#include <string.h>
+#include <ctype.h>
+#include <mutex>
 #include "knik/flute.h"
 
 #if D<=7
@@ -63,10 +61,91 @@ void printtree(FTree t);
 void plottree(FTree t);
 
 
-void readLUT()
-{
+// Lookup tables are compiled into the library (see embedLut.cmake), they are
+// decoded once, under std::call_once, then only ever read. This is what makes
+// flute() & flute_wl() reentrant.
+extern const unsigned char fluteLutPowv[];
+extern const size_t        fluteLutPowvSize;
+extern const unsigned char fluteLutPost[];
+extern const size_t        fluteLutPostSize;
+
+namespace {
+
+  // Minimal in-memory replacement for the fscanf()/fgetc()/fgets()/fread()
+  // calls of the original FILE* based reader.
+  class LutStream {
+    public:
+      inline               LutStream ( const unsigned char* data, size_t size );
+      inline int           getc      ();
+      inline int           getInt    ();
+      inline void          skip      ( const char* );
+      inline void          skipSpaces();
+             unsigned char* gets     ( unsigned char* line, int size );
+             size_t         read     ( unsigned char* line, size_t size );
+    private:
+      const unsigned char* _data;
+      size_t               _size;
+      size_t               _offset;
+  };
+
+
+  inline LutStream::LutStream ( const unsigned char* data, size_t size )
+    : _data(data), _size(size), _offset(0)
+  { }
+
+
+  inline int  LutStream::getc ()
+  { return (_offset < _size) ? _data[_offset++] : EOF; }
+
+
+  inline void  LutStream::skipSpaces ()
+  { while ( (_offset < _size) and isspace(_data[_offset]) ) ++_offset; }
+
+
+  inline void  LutStream::skip ( const char* s )
+  { while ( *s and (_offset < _size) and (_data[_offset] == (unsigned char)*s) ) { ++_offset; ++s; } }
+
+
+  inline int  LutStream::getInt ()
+  {
+    int value = 0;
+    skipSpaces();
+    while ( (_offset < _size) and isdigit(_data[_offset]) )
+      value = value*10 + (_data[_offset++] - '0');
+    skipSpaces();
+    return value;
+  }
+
+
+  unsigned char* LutStream::gets ( unsigned char* line, int size )
+  {
+    if (_offset >= _size) return NULL;
+
+    int i = 0;
+    while ( (i < size-1) and (_offset < _size) ) {
+      line[i] = _data[_offset++];
+      if (line[i++] == '\n') break;
+    }
+    line[i] = '\0';
+    return line;
+  }
+
+
+  size_t  LutStream::read ( unsigned char* line, size_t size )
+  {
+    if (_offset+size > _size) size = _size - _offset;
+    memcpy( line, _data+_offset, size );
+    _offset += size;
+    return size;
+  }
+
+
+  std::once_flag  lutOnce;
+
+
+  void  decodeLUT ()
+  {
     unsigned char charnum[256], line[32], *linep, c;
-    FILE *fpwv, *fprt;
     struct csoln *p;
     int d, i, j, k, kk, ns, nn;
 
@@ -79,52 +158,36 @@ void readLUT()
             charnum[i] = 0;
     }
 
-    // added by d2 for coriolis : need to find the right path of .dat files.
-    Environment* env = AllianceFramework::get()->getEnvironment();
-
-    string POWVFILE_string = env->getCORIOLIS_TOP();
-    POWVFILE_string += "/share/coriolis2/flute-3.1/";
-    POWVFILE_string += POWVFILE;
-
-    fpwv=fopen(POWVFILE_string.c_str(), "r");
-    if (fpwv == NULL)
-      throw Error ( "flute::readLUT(): cannot find/open file:\n"
-                    "        %s."
-                  , POWVFILE_string.c_str()
-                  );
+    if ( (fluteLutPowvSize == 0) or (fluteLutPostSize == 0) )
+      throw Error( "flute::readLUT(): POWV and/or POST tables have not been embedded." );
 
+    LutStream fpwv ( fluteLutPowv, fluteLutPowvSize );
 #if ROUTING==1
-    string POSTFILE_string = env->getCORIOLIS_TOP();
-    POSTFILE_string += "/share/coriolis2/flute-3.1/";
-    POSTFILE_string += POSTFILE;
-    fprt=fopen(POSTFILE_string.c_str(), "r");
-    if (fprt == NULL)
-      throw Error ( "flute::readLUT(): cannot find/open file:\n"
-                    "        %s."
-                  , POSTFILE_string.c_str()
-                  );
+    LutStream fprt ( fluteLutPost, fluteLutPostSize );
 #endif
 
     for (d=4; d<=D; d++) {
-        fscanf(fpwv, "d=%d\n", &d);
+        fpwv.skip( "d=" ); d = fpwv.getInt();
 #if ROUTING==1
-        fscanf(fprt, "d=%d\n", &d);
+        fprt.skip( "d=" ); d = fprt.getInt();
 #endif
         for (k=0; k<numgrp[d]; k++) {
-            ns = (int) charnum[fgetc(fpwv)];
+            ns = (int) charnum[fpwv.getc() & 0xff];
 
             if (ns==0) {  // same as some previous group
-                fscanf(fpwv, "%d\n", &kk);
+                kk = fpwv.getInt();
                 numsoln[d][k] = numsoln[d][kk];
                 LUT[d][k] = LUT[d][kk];
             }
             else {
-                fgetc(fpwv);  // '\n'
+                fpwv.getc();  // '\n'
                 numsoln[d][k] = ns;
                 p = (struct csoln*) malloc(ns*sizeof(struct csoln));
                 LUT[d][k] = p;
                 for (i=1; i<=ns; i++) {
-                    linep = (unsigned char *) fgets((char *) line, 32, fpwv);
+                    linep = fpwv.gets(line, 32);
+                    if (not linep)
+                      throw Error( "flute::readLUT(): Premature end of embedded POWV table (d=%d).", d );
                     p->parent = charnum[*(linep++)];
                     j = 0;
                     while ((p->seg[j++] = charnum[*(linep++)]) != 0) ;
@@ -132,12 +195,12 @@ void readLUT()
                     while ((p->seg[j--] = charnum[*(linep++)]) != 0) ;
 #if ROUTING==1
                     nn = 2*d-2;
-                    fread(line, 1, d-2, fprt); linep=line;
+                    fprt.read(line, d-2); linep=line;
                     for (j=d; j<nn; j++) {
                         c = charnum[*(linep++)];
                         p->rowcol[j-d] = c;
                     }
-                    fread(line, 1, nn/2+1, fprt); linep=line;  // last char \n
+                    fprt.read(line, nn/2+1); linep=line;  // last char \n
                     for (j=0; j<nn; ) {
                         c = *(linep++);
                         p->neighbor[j++] = c/16;
@@ -149,9 +212,15 @@ void readLUT()
             }
         }
     }
+  }
+
 
-    fclose ( fpwv );
-    fclose ( fprt );
+}  // Anonymous namespace.
+
+
+void readLUT()
+{
+    std::call_once( lutOnce, decodeLUT );
 }
 
 
@@ -162,6 +231,8 @@ DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc)
     int i, j, minidx;
     struct point pt[MAXD], *ptp[MAXD], *tmpp;
 
+    readLUT();
+
     if (d==2)
         l = ADIFF(x[0], x[1]) + ADIFF(y[0], y[1]);
     else if (d==3) {
@@ -603,6 +674,8 @@ FTree flute(int d, DTYPE x[], DTYPE y[], int acc)
     int i, j, minidx;
     struct point *pt, **ptp, *tmpp;
     FTree t;
+
+    readLUT();
     
     if (d==2) {
         t.deg = 2;
@@ -1471,6 +1544,11 @@ DTYPE wirelength(FTree t)
     return l;
 }
 
+void freetree(FTree t)
+{
+    free(t.branch);
+}
+
 void printtree(FTree t)
 {
     int i;
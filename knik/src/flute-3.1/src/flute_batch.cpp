@@ -0,0 +1,48 @@
+// Batch interface to FLUTE, added for Coriolis: computes the Steiner trees
+// of a whole set of nets on a pool of threads. This relies on flute() being
+// reentrant (read-only LUTs, thread_local work areas in flute_mst, heap &
+// neighbors).
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "knik/flute.h"
+
+#define BATCH_CHUNK 64   // Nets grabbed at once by a worker thread
+#define BATCH_SERIAL 256 // Below this number of nets, do not spawn threads
+
+
+static void flute_batch_worker(int n, FluteNet nets[], int acc, std::atomic<int> *next)
+{
+    int i, first, last;
+
+    while ((first = next->fetch_add(BATCH_CHUNK)) < n) {
+        last = first + BATCH_CHUNK;
+        if (last > n) last = n;
+        for (i=first; i<last; i++)
+            nets[i].tree = flute(nets[i].deg, nets[i].x, nets[i].y, acc);
+    }
+}
+
+
+// Each tree depends only on its own net, so the result is identical to
+// calling flute() sequentially, whatever the number of threads.
+void flute_batch(int n, FluteNet nets[], int acc, unsigned int threads)
+{
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    unsigned int i;
+
+    readLUT();
+
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (n < BATCH_SERIAL) threads = 1;
+
+    for (i=1; i<threads; i++)
+        workers.push_back(std::thread(flute_batch_worker, n, nets, acc, &next));
+    flute_batch_worker(n, nets, acc, &next);
+
+    for (i=0; i<workers.size(); i++)
+        workers[i].join();
+}
@@ -26,6 +26,12 @@
 // DTYPE wirelength(FTree t);
 // void printtree(FTree t);
 // void plottree(FTree t);
+// void flute_batch(int n, FluteNet nets[], int acc, unsigned int threads);
+// void freetree(FTree t);
+//
+// The lookup tables are compiled into the library and readLUT() only
+// decodes them once (thread-safe), flute() & flute_wl() call it themselves.
+// All the entry points are reentrant (per-thread work areas).
 
 
 /*************************************/
@@ -51,6 +57,14 @@ struct FTree
     Branch *branch;   // array of tree branches
 };
 
+struct FluteNet
+{
+    int deg;   // degree
+    DTYPE *x;   // pins x coordinates
+    DTYPE *y;   // pins y coordinates
+    FTree tree;   // resulting tree (to be released with freetree())
+};
+
 // User-Callable Functions
 extern void readLUT();
 extern DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc);
@@ -60,6 +74,8 @@ extern FTree flute(int d, DTYPE x[], DTYPE y[], int acc);
 extern DTYPE wirelength(FTree t);
 extern void printtree(FTree t);
 extern void plottree(FTree t);
+extern void flute_batch(int n, FluteNet nets[], int acc, unsigned int threads);
+extern void freetree(FTree t);
 
 // Other useful functions
 extern void init_param();
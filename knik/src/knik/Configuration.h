@@ -36,6 +36,8 @@ namespace Knik {
       static const Layer*   getGMetalH    ();
       static const Layer*   getGMetalV    ();
       static const Layer*   getGContact   ();
+      static float          getHistoryIncrement ( unsigned int iteration );
+      static float          getPresentCost      ( unsigned int iteration );
       void destroy();
     private:
       static Configuration* _singleton;
@@ -43,6 +45,11 @@ namespace Knik {
              const Layer*   _gMetalH;
              const Layer*   _gMetalV;
              const Layer*   _gContact;
+             float          _historyIncrement;
+             float          _historyGrowth;
+             float          _presentCost;
+             float          _presentGrowth;
+             float          _presentCostMax;
     protected:
                             Configuration ( const Layer* pinMetal
                                           , const Layer* gMetalH
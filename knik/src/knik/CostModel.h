@@ -0,0 +1,139 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2006-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |        K n i k  -  G l o b a l   R o u t e r                    |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./knik/CostModel.h"                            |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KNIK_COST_MODEL_H
+#define  KNIK_COST_MODEL_H
+
+#include <cmath>
+#include <vector>
+#include "knik/Edge.h"
+
+
+namespace Knik {
+
+  using std::vector;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Knik::CostModel".
+//
+// Edge costs used by the maze routing. The congestion part of the cost
+// only depends on the integer (real or half-estimated) occupancy and
+// capacity of the edge, so it is tabulated once per capacity. The mode
+// (congestion, pre-congestion, rip-up) is a template parameter, so the
+// Dijkstra inner loop is specialized and has no flag test left.
+// In rip-up mode, the cost is PathFinder like: present congestion cost
+// (grown at each iteration) plus the edge history cost, both following
+// the schedule of Knik::Configuration.
+
+  class CostModel {
+    public:
+      enum Mode { NoCongestion  = 0
+                , Congestion    = 1
+                , PreCongestion = 2
+                , Ripup         = 3
+                };
+    public:
+      static CostModel*    get            ();
+      static unsigned int  getMode        ();
+             void          build          ( const vector<Edge*>& );
+             void          setIteration   ( unsigned int );
+      inline unsigned int  getIteration   () const;
+             float         getHistoryIncrement () const;
+             float         getCost        ( const Edge*, const Edge* arrivalEdge ) const;
+      template<unsigned int mode>
+      inline float         getCost        ( const Edge*, const Edge* arrivalEdge ) const;
+    private:
+                           CostModel      ();
+                           CostModel      ( const CostModel& );
+             CostModel&    operator=      ( const CostModel& );
+             void          _buildRipup    ();
+             float         _slowRouting   ( unsigned int capacity, unsigned int occupancy2 ) const;
+             float         _slowRipup     ( unsigned int capacity, unsigned int occupancy, float history ) const;
+      inline float         _routing       ( unsigned int capacity, unsigned int occupancy2 ) const;
+      inline float         _ripup         ( unsigned int capacity, unsigned int occupancy, float history ) const;
+    private:
+      static CostModel*     _singleton;
+             unsigned int   _maxCapacity;
+             unsigned int   _iteration;
+             float          _presentCost;
+             float          _viaCost;
+             vector<size_t> _offsets;       // Row of a capacity, occupancy up to 4 x capacity.
+             vector<float>  _routingTable;  // Indexed by 2 x occupancy (half estimations).
+             vector<float>  _presentTable;  // Rip-up present congestion cost.
+             vector<float>  _historyTable;  // Rip-up history cost factor.
+  };
+
+
+  inline unsigned int  CostModel::getIteration () const { return _iteration; }
+
+
+  inline float  CostModel::_routing ( unsigned int capacity, unsigned int occupancy2 ) const
+  {
+    if (capacity > _maxCapacity) return _slowRouting( capacity, occupancy2 );
+
+    size_t rowSize = _offsets[capacity+1] - _offsets[capacity];
+    if (occupancy2 >= rowSize) occupancy2 = rowSize-1;
+    return _routingTable[ _offsets[capacity] + occupancy2 ];
+  }
+
+
+  inline float  CostModel::_ripup ( unsigned int capacity, unsigned int occupancy, float history ) const
+  {
+    if (capacity > _maxCapacity) return _slowRipup( capacity, occupancy, history );
+
+    size_t rowSize = (_offsets[capacity+1] - _offsets[capacity]) / 2;
+    if (occupancy >= rowSize) return _slowRipup( capacity, occupancy, history );
+
+    size_t index = _offsets[capacity]/2 + occupancy;
+    return _presentTable[index] + history * _historyTable[index];
+  }
+
+
+  template<unsigned int mode>
+  inline float  CostModel::getCost ( const Edge* edge, const Edge* arrivalEdge ) const
+  {
+  // 20/10/2010: Check for null capacity, which may occurs after back-annotation
+  // by Kite.
+    unsigned int capacity = edge->getCapacity();
+    if (capacity == 0) return (float)(HUGE_VAL);
+
+    float cost = 1.0;
+    switch ( mode ) {
+      case Congestion:
+        cost = _routing( capacity, 2*edge->getRealOccupancy() );
+        break;
+      case PreCongestion: {
+        float estimate = edge->getEstimateOccupancy();
+        cost = _routing( capacity, 2*edge->getRealOccupancy() + ((estimate > 0.0) ? (unsigned int)(2.0*estimate+0.5) : 0) );
+        break;
+      }
+      case Ripup:
+        cost = _ripup( capacity, edge->getRealOccupancy(), edge->getHistory() );
+        break;
+    }
+
+  // Bends are vias.
+    if (arrivalEdge and (arrivalEdge->isVertical() != edge->isVertical()))
+      cost += _viaCost;
+
+    return cost;
+  }
+
+
+}  // Knik namespace.
+
+#endif  // KNIK_COST_MODEL_H
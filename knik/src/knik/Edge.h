@@ -27,10 +27,9 @@ namespace Knik {
         // **********
         protected:
             static const Name  _extensionName;
-            static float _h;
-            static float _k;
 
             Box       _boundingBox;
+            unsigned  _id;
             Vertex*   _from;
             Edge*     _nextFrom;
             Vertex*   _to;
@@ -39,7 +38,8 @@ namespace Knik {
             float     _cost;
             unsigned  _capacity;
             unsigned  _realOccupancy;
-            float     _estimateOccupancy; // used as estimateOccupancy in routing and historic cost during ripup & reroute
+            float     _estimateOccupancy;
+            float     _history;           // PathFinder history cost, accumulated during ripup & reroute
             float     _normalisedLength;
             unsigned  _netStamp;
             bool      _isCongested;
@@ -64,6 +64,7 @@ namespace Knik {
             void incOccupancy     ();
             void decOccupancy     ();
             void insertSegment    ( Segment* segment )   { assert(segment); incOccupancy(); _segments.push_back(segment); };
+            void setId            ( unsigned id )        { _id = id; };
             void setNextFrom      ( Edge* edge )         { _nextFrom = edge; };
             void setNextTo        ( Edge* edge )         { _nextTo = edge; };
             void setConnexID      ( int connexID )       { _connexID = connexID; };
@@ -73,16 +74,16 @@ namespace Knik {
             void setCost          ( float cost )         { _cost = cost; };
             void incCost          ( float inc )          { _cost += inc; };
             void setNetStamp      ( unsigned netStamp )  { _netStamp = netStamp; };
-            void setHParameter    ( float h )            { _h = h; };
-            void setKParameter    ( float k )            { _k = k; };
             void removeSegment    ( Segment* segment );
             void addSubEstimateOccupancy ( float increment, bool add );
+            void addHistory       ( float increment )    { _history += increment; };
 
         // Accessors
         // *********
         public:
             static const Name& staticGetName () { return _extensionName; };
                    const Name& getName       () const { return _extensionName; };
+            unsigned  getId               () const { return _id; };
             Vertex*   getFrom             () const { return _from; };
             Edge*     getNextFrom         () const { return _nextFrom; };
             Vertex*   getTo               () const { return _to; };
@@ -90,16 +91,15 @@ namespace Knik {
             int       getConnexID         () const { return _connexID; };
             unsigned  getCapacity         () const { return _capacity; };
             float     getEstimateOccupancy() const { return _estimateOccupancy; };
+            float     getHistory          () const { return _history; };
             unsigned  getNetStamp         () const { return _netStamp; };
-            float     getHParameter       ()       { return _h; };
-            float     getKParameter       ()       { return _k; };
             unsigned  getOverflow         () const { return (_realOccupancy>_capacity)?_realOccupancy-_capacity:0; };
             Vertex*   getOpposite ( const Vertex* v ) const { if (v == _from) return _to;
                                                               if (v == _to)   return _from;
                                                               assert ( (v==_from) || (v==_to) );
                                                               return NULL; /* to avoid warning, never reached */ };
             GenericCollection<Segment*> getSegments() { return getCollection ( _segments ); } ;
-            unsigned  getRealOccupancy    () const;
+            unsigned  getRealOccupancy    () const { return _realOccupancy; };
             Segment*  getSegmentFor       ( Net*net );
             float     getCost             ( Edge* arrivalEdge );
             float     getConstCost     () const { return _cost; };
@@ -29,6 +29,7 @@
 #include "knik/RoutingGrid.h"
 
 struct FTree;
+struct FluteNet;
 
 namespace Knik {
 
@@ -122,6 +123,8 @@ namespace Knik {
             Vertex*     getVertex               ( Point );
             Vertex*     getVertex               ( DbU::Unit x, DbU::Unit y );
             Vertexes    getVertexes             ()    { return VectorCollection<Vertex*>(_all_vertexes); };
+            const EdgeVector& getAllEdges       () const { return _all_edges; };
+            void        getSegmentEdges         ( Segment* segment, EdgeVector& edges );
             Vertex*     getLowerLeftVertex      () { return _lowerLeftVertex; };
             unsigned    getGridLength           ( Segment* segment );
             unsigned    getCongestEdgeNb        ( Segment* segment );
@@ -152,18 +155,19 @@ namespace Knik {
             int    countVertexes     ( Net* net );
             int    initRouting       ( Net* net );
             void   Dijkstra          ();
+            template<unsigned int mode>
+            void   _Dijkstra         ();
             void   Monotonic         ();
+            void   fillFluteNet      ( FluteNet& fluteNet );
             FTree* createFluteTree   ();
             void   CleanRoutingState ();
             void   UpdateEstimateCongestion ( bool create = false );
+            void   applyFluteTree    ( const FTree& fluteTree, bool create );
             void   UpdateMaxEstimateCongestion ();
             void   UpdateEdgeCapacity ( unsigned col1, unsigned row1, unsigned col2, unsigned row2, unsigned cap );
             void   increaseEdgeCapacity ( unsigned col1, unsigned row1, unsigned col2, unsigned row2, int cap );
             void   insertSegment ( Segment* segment );
             void   removeSegment ( Segment* segment );
-            void   increaseEdgesCostParameters() { Edge* edge = _all_edges[0]; assert(edge);
-                                                   edge->setHParameter(edge->getHParameter()*100);
-                                                   edge->setKParameter(edge->getKParameter()*100); };
 
     // Predicates
     // **********
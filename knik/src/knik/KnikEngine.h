@@ -135,6 +135,7 @@ typedef vector<NetRecord> NetVector;
         map<Segment*,SegRecord>            _segmentOverEdges;
         vector<pair<Segment*,SegRecord*> > _sortSegmentOv;
         set<Segment*> _segmentsToUnroute;
+        set<unsigned int>    _assignedSegments;   // Ids of the segments moved on routing layers.
 
 // Constructors & Destructors
 // **************************
@@ -185,6 +186,7 @@ typedef vector<NetRecord> NetVector;
            void          unrouteOvSegments       ();
            void          reroute                 ();
            void          unrouteSelected         ();
+           void          layerAssign             ();
         // for ispd07 reload                     
            void          createRoutingGraph      ();
            void          addRoutingPadToGraph    ( Hurricane::RoutingPad* routingPad );
@@ -210,8 +212,13 @@ typedef vector<NetRecord> NetVector;
                 void        getHorizontalCutLines     ( vector<DbU::Unit>& horizontalCutLines );
                 void        getVerticalCutLines       ( vector<DbU::Unit>& verticalCutLines );
                 void        saveSolution              ( const string& fileName="" );
+                void        exportSolution            ( const string& fileName="" );
                 void        loadSolution              ( const string& fileName="" );
-                string      _getSolutionName          () const;
+                string      _getSolutionName          ( const char* extension=".kgb" ) const;
+                void        _getSolutionNets          ( vector<Net*>& ) const;
+                void        _getSolutionComponents    ( Net*, vector<Segment*>&, vector<Contact*>& ) const;
+                void        _addAssignedSegment       ( Segment* );
+                bool        _isAssignedSegment        ( const Segment* ) const;
         virtual Record*     _getRecord                () const;
         virtual string      _getTypeName              () const { return _TName ( "KnikEngine" ); };
 };
@@ -0,0 +1,116 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2006-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |        K n i k  -  G l o b a l   R o u t e r                    |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./knik/LayerAssign.h"                          |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KNIK_LAYER_ASSIGN_H
+#define  KNIK_LAYER_ASSIGN_H
+
+#include <vector>
+#include "hurricane/DbU.h"
+
+namespace Hurricane {
+  class Layer;
+  class Net;
+  class Component;
+  class Segment;
+}
+
+namespace CRL {
+  class RoutingLayerGauge;
+}
+
+
+namespace Knik {
+
+  using std::vector;
+  using Hurricane::DbU;
+  using Hurricane::Layer;
+  using Hurricane::Net;
+  using Hurricane::Component;
+  using Hurricane::Segment;
+  using CRL::RoutingLayerGauge;
+
+  class Edge;
+  class KnikEngine;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Knik::LayerAssign".
+//
+// Projects the 2D global routing (gmetalh/gmetalv) onto the real
+// routing layers of the gauge. Every edge capacity is split between
+// the layers of its direction (in proportion of their track numbers)
+// and each net tree is assigned by dynamic programming, minimizing
+// the congestion of the per-layer edges plus the via cost.
+// Nets are processed in the order they are given, so the result is
+// deterministic.
+
+  class LayerAssign {
+    public:
+      struct Plane {
+        const Layer*       _layer;
+        unsigned int       _depth;
+        DbU::Unit          _wireWidth;
+        RoutingLayerGauge* _gauge;
+      };
+    public:
+                             LayerAssign     ( KnikEngine* );
+                            ~LayerAssign     ();
+             void            run             ( const vector<Net*>& );
+      inline unsigned int    getOverflow     () const;
+      inline unsigned int    getViaCount     () const;
+      inline unsigned int    getAssigneds    () const;
+    public:
+      static float           _viaCost;
+      static float           _overflowCost;
+    private:
+             void            _buildPlanes    ();
+             void            _assignNet      ( Net* );
+             unsigned int    _getPinDepth    ( Component* ) const;
+             float           _getWireCost    ( const vector<Edge*>&, size_t plane ) const;
+             void            _commit         ( Segment*, const vector<Edge*>&, size_t plane );
+             const vector<Plane>& _getPlanes ( Segment* ) const;
+             size_t          _getIndex       ( const Edge*, size_t plane ) const;
+    private:
+                             LayerAssign     ( const LayerAssign& );
+             LayerAssign&    operator=       ( const LayerAssign& );
+    private:
+      KnikEngine*           _knik;
+      vector<Plane>         _hPlanes;
+      vector<Plane>         _vPlanes;
+      size_t                _nbPlanes;
+      vector<unsigned int>  _capacities;
+      vector<unsigned int>  _occupancies;
+      unsigned int          _viaCount;
+      unsigned int          _assigneds;
+  };
+
+
+  inline unsigned int  LayerAssign::getViaCount  () const { return _viaCount; }
+  inline unsigned int  LayerAssign::getAssigneds () const { return _assigneds; }
+
+
+  inline unsigned int  LayerAssign::getOverflow () const
+  {
+    unsigned int overflow = 0;
+    for ( size_t i=0 ; i<_capacities.size() ; ++i )
+      if (_occupancies[i] > _capacities[i]) overflow += _occupancies[i] - _capacities[i];
+    return overflow;
+  }
+
+
+}  // Knik namespace.
+
+#endif  // KNIK_LAYER_ASSIGN_H
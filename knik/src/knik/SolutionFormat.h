@@ -0,0 +1,91 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) UPMC 2008-2015, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |               K n i k - Global Router                           |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :       "./knik/SolutionFormat.h"                  |
+// +-----------------------------------------------------------------+
+
+
+#ifndef  KNIK_SOLUTION_FORMAT_H
+#define  KNIK_SOLUTION_FORMAT_H
+
+#include <stdint.h>
+
+
+namespace Knik {
+
+
+// -------------------------------------------------------------------
+// Binary global routing solution (.kgb).
+//
+// The file is meant to be mmap'ed and used in place, so every record
+// is a multiple of 8 bytes and stored in the native byte order (the
+// _endianness field allows to reject a file from another machine).
+//
+//   [KgbHeader] [KgbNet x nbNets] [KgbSegment x nbSegments] [names]
+//
+// The segments of one net are contiguous. Coordinates are in DbU.
+// The z of a segment end uses the same convention than the text
+// format (1: gmetalh, 2: gmetalv) for the 2D global routing, or
+// KgbGaugeDepth + depth when it has been assigned to a real routing
+// layer. A via is a segment of null length between z=1 and z=2.
+
+
+  const char      KgbMagic[4]    = { 'K', 'G', 'B', 'S' };
+  const uint32_t  KgbVersion     = 1;
+  const uint32_t  KgbEndianness  = 0x01020304;
+  const uint32_t  KgbGMetalH     = 1;
+  const uint32_t  KgbGMetalV     = 2;
+  const uint32_t  KgbGaugeDepth  = 16;
+
+
+  struct KgbHeader {
+    char      _magic[4];
+    uint32_t  _version;
+    uint32_t  _endianness;
+    uint32_t  _nbNets;
+    uint64_t  _nbSegments;
+    uint32_t  _xSize;            // Routing graph, columns.
+    uint32_t  _ySize;            // Routing graph, rows.
+    int64_t   _xMin;             // Abutment box of the routed cell.
+    int64_t   _yMin;
+    int64_t   _xMax;
+    int64_t   _yMax;
+    uint64_t  _netsOffset;
+    uint64_t  _segmentsOffset;
+    uint64_t  _namesOffset;
+    uint64_t  _namesSize;
+  };
+
+
+  struct KgbNet {
+    uint64_t  _firstSegment;
+    uint32_t  _nbSegments;
+    uint32_t  _nameOffset;       // Null terminated, in the names table.
+    uint32_t  _nameLength;
+    uint32_t  _reserved;
+    int64_t   _id;               // NetExtension id.
+  };
+
+
+  struct KgbSegment {
+    int64_t   _xSource;
+    int64_t   _ySource;
+    int64_t   _xTarget;
+    int64_t   _yTarget;
+    uint32_t  _zSource;
+    uint32_t  _zTarget;
+  };
+
+
+}  // Knik namespace.
+
+#endif  // KNIK_SOLUTION_FORMAT_H